@@ -7,7 +7,7 @@ echo ""
 
 # Compilar con g++
 echo "[1/2] Compilando archivos fuente..."
-g++ -std=c++17 -pthread -Iinclude src/*.cpp -o kernel-sim
+g++ -std=c++20 -O3 -pthread -Iinclude src/*.cpp -o kernel-sim
 
 if [ $? -eq 0 ]; then
     echo " Compilación exitosa"
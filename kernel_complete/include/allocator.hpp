@@ -0,0 +1,181 @@
+#ifndef ALLOCATOR_HPP
+#define ALLOCATOR_HPP
+
+#include "metrics.hpp"
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <vector>
+
+// Buddy allocator sobre el arreglo de frames. Un bloque de orden k son 2^k
+// frames alineados a 2^k. Cada orden tiene un bitmap de bloques libres que
+// funciona como lista libre: se entrega siempre el bloque libre de menor
+// dirección del menor orden que alcanza, así el estado depende solo del
+// conjunto de frames libres (y un checkpoint lo reconstruye exacto).
+// Asignar divide y liberar fusiona con el buddy en O(log n).
+class BuddyAllocator {
+public:
+    static constexpr int MAX_ORDER = 20;
+
+    explicit BuddyAllocator(int frames);
+
+    // Primer frame del bloque de 2^order frames; -1 si no hay bloque libre
+    int allocate(int order);
+    void free(int frame, int order);
+
+    // Tomar un frame libre concreto (dividiendo el bloque que lo contiene)
+    bool claim(int frame);
+    bool is_free(int frame) const;
+
+    // Frame libre de menor dirección en [first, last); -1 si no hay (NUMA)
+    int find_free_in(int first, int last) const;
+
+    // Todos los frames ocupados (para reconstruir liberando los libres)
+    void reserve_all();
+
+    int get_frames() const { return frames_; }
+    int get_free_frames() const { return free_frames_; }
+    int get_max_order() const { return max_order_; }
+    int get_free_blocks(int order) const { return free_count_[order]; }
+    int largest_free_order() const;
+
+    // Índice de espacio libre inutilizable para un pedido de orden k:
+    // fracción de frames libres en bloques menores que 2^k (0 = sin fragmentación)
+    double fragmentation(int order) const;
+
+    long long get_splits() const { return splits_; }
+    long long get_merges() const { return merges_; }
+    long long get_failures() const { return failures_; }
+
+    void display_stats() const;
+
+private:
+    int frames_;
+    int max_order_;
+    int free_frames_;
+    std::vector<std::vector<uint64_t>> free_bits_;  // Bit por bloque libre, por orden
+    std::vector<int> free_count_;
+    std::vector<size_t> first_word_;                // Ninguna palabra anterior tiene bits
+    long long allocations_[MAX_ORDER + 1];
+    long long splits_;
+    long long merges_;
+    long long failures_;
+
+    void set_free(int order, int block);
+    void clear_free(int order, int block);
+    bool test_free(int order, int block) const {
+        return (free_bits_[order][block >> 6] >> (block & 63)) & 1;
+    }
+    int find_free(int order);
+    void split_down(int frame, int from, int to);
+};
+
+// Capa slab para objetos del kernel (Bonwick): cada cache corta slabs de
+// 2^order frames del buddy en objetos de tamaño fijo. Encima, cada CPU tiene
+// dos magazines (cargado y anterior) de hasta magazine_size objetos; un
+// depot guarda magazines llenos y vacíos. La mayoría de las operaciones
+// quedan en el magazine de la CPU sin tocar las listas de slabs.
+class SlabAllocator {
+public:
+    struct CacheStats {
+        long long allocations;
+        long long frees;
+        long long magazine_hits;      // Servidas por el magazine de la CPU
+        long long depot_exchanges;    // Intercambios de magazine con el depot
+        long long slab_allocs;        // Bajaron hasta las listas de slabs
+        long long failures;           // Sin memoria ni siquiera tras reclamar
+        long long slabs_created;
+        long long slabs_released;
+    };
+
+    // reclaim libera un frame de usuario (eviction); false si no puede.
+    // max_frames limita los frames en slabs (0 = todo el buddy).
+    SlabAllocator(BuddyAllocator& buddy, int cpus, int magazine_size,
+                  std::function<bool()> reclaim = nullptr, int max_frames = 0);
+    ~SlabAllocator();                 // Devuelve al buddy los frames de todos los slabs
+
+    // Caches por defecto: objetos típicos del kernel
+    void create_default_caches();
+    int create_cache(const std::string& name, int object_size);
+    int find_cache(const std::string& name) const;
+    int get_cache_count() const { return static_cast<int>(caches_.size()); }
+    const std::string& get_cache_name(int cache) const { return caches_[cache].name; }
+
+    // Handle del objeto (slab, índice); -1 sin memoria
+    long long alloc(int cache, int cpu);
+    void free(int cache, int cpu, long long object);
+
+    // Devolver los magazines a los slabs y liberar los slabs vacíos
+    void drain();
+
+    int get_cpus() const { return cpus_; }
+    int get_slab_frames() const { return slab_frames_; }
+    const CacheStats& get_stats(int cache) const { return caches_[cache].stats; }
+    void display_stats() const;
+
+private:
+    struct Slab {
+        int frame;                    // Primer frame del bloque (-1 = slot libre)
+        int cache;
+        int in_use;
+        std::vector<int> free_objects;
+        std::list<int>::iterator partial_pos;
+        bool in_partial;
+    };
+
+    struct Magazine {
+        std::vector<long long> rounds;
+    };
+
+    struct CpuMagazines {
+        Magazine loaded;
+        Magazine previous;
+    };
+
+    struct Cache {
+        std::string name;
+        int object_size;
+        int order;                    // Frames por slab = 2^order
+        int objects_per_slab;
+        std::list<int> partial;       // Slabs con objetos libres
+        int slabs;
+        int empty_slabs;
+        int live_objects;
+        std::vector<CpuMagazines> cpus;
+        std::vector<Magazine> full_magazines;   // Depot
+        std::vector<Magazine> empty_magazines;
+        CacheStats stats;
+    };
+
+    BuddyAllocator& buddy_;
+    int cpus_;
+    int magazine_size_;
+    std::function<bool()> reclaim_;
+    int max_frames_;
+    std::vector<Cache> caches_;
+    std::vector<Slab> slabs_;
+    std::vector<int> free_slab_ids_;
+    int slab_frames_;
+
+    long long slab_alloc(int cache);
+    void slab_free(long long object);
+    int grow(int cache);
+    void release_slab(int slab);
+};
+
+// Benchmark de carga mixta: páginas de usuario (orden 0), bloques grandes
+// (órdenes 1..huge) y objetos del kernel con vidas aleatorias, sobre un
+// buddy propio de frames frames. Mide latencia por operación y throughput.
+struct AllocatorBenchResult {
+    long long operations;
+    long long failures;
+    double seconds;
+    LogHistogram page_latency;        // ns por operación del buddy
+    LogHistogram object_latency;      // ns por operación de la capa slab
+};
+
+AllocatorBenchResult run_allocator_bench(long long operations, int frames, int cpus,
+                                         int magazine_size, uint64_t seed, bool verbose = true);
+
+#endif // ALLOCATOR_HPP
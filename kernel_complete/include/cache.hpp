@@ -0,0 +1,107 @@
+#ifndef CACHE_HPP
+#define CACHE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Un nivel de caché: tamaño, asociatividad (potencia de 2) y latencia de acierto
+struct CacheLevelConfig {
+    std::string name;
+    int size_kb;
+    int ways;
+    int latency;                       // Ciclos
+};
+
+struct CacheConfig {
+    std::vector<CacheLevelConfig> levels = {{"L1", 32, 8, 4}, {"L2", 256, 8, 12}, {"LLC", 8192, 16, 40}};
+    int line_size = 64;
+    int page_lines = 8;                // Líneas distintas que se tocan de cada página
+    int dram_latency = 200;            // Ciclos tras fallar en todos los niveles
+    int walk_cycles = 100;             // Page walk sin TLB (o con miss de TLB)
+    long long fault_cycles = 100000;   // Servicio de un page fault desde disco
+    long long pool_cycles = 10000;     // Fault servido descomprimiendo de zswap
+};
+
+// "l1=32:8:4", "line=64", "lines=8", "dram=200", "walk=100", "fault=100000", "pool=10000"
+bool parse_cache_option(const std::string& token, CacheConfig& config);
+
+// Nivel set-associative con Tree-PLRU. Las etiquetas de un conjunto son
+// contiguas y se comparan todas en un bucle sin saltos que el compilador
+// vectoriza; el árbol PLRU de un conjunto cabe en un uint64_t (ways ≤ 64).
+class CacheLevel {
+public:
+    CacheLevel(const CacheLevelConfig& config, int line_size);
+
+    bool access(uint64_t line);        // true = acierto; en fallo se llena
+    void invalidate(uint64_t line);
+
+    const std::string& get_name() const { return name_; }
+    int get_latency() const { return latency_; }
+    int get_sets() const { return static_cast<int>(sets_); }
+    int get_ways() const { return ways_; }
+    long long get_hits() const { return hits_; }
+    long long get_misses() const { return misses_; }
+
+private:
+    static constexpr uint64_t INVALID = ~0ULL;
+
+    std::string name_;
+    int latency_;
+    int ways_;
+    int depth_;                        // log2(ways)
+    uint64_t sets_;
+    int set_bits_;
+    std::vector<uint64_t> tags_;       // sets × ways
+    std::vector<uint64_t> plru_;       // Nodo k del árbol = bit k (raíz en 1)
+    long long hits_;
+    long long misses_;
+
+    unsigned long long match(const uint64_t* set, uint64_t tag) const {
+        unsigned long long mask = 0;
+        for (int w = 0; w < ways_; w++) {
+            mask |= static_cast<unsigned long long>(set[w] == tag) << w;
+        }
+        return mask;
+    }
+    void touch(uint64_t& tree, int way) const;
+    int victim(uint64_t tree) const;
+};
+
+// Jerarquía L1/L2/LLC indexada por dirección física. Las referencias no
+// traen desplazamiento: cada una toca la siguiente de las page_lines líneas
+// calientes de su página (recorrido circular desde un desplazamiento que
+// depende de la página, para no alinear todas en los mismos conjuntos), así
+// el reuso de caché sigue al reuso de páginas. Al cargar otra página en el
+// frame sus líneas se invalidan.
+// El costo de cada acceso suma latencias de caché o DRAM, el page walk y el
+// servicio del fault, y su promedio es el AMAT.
+class CacheHierarchy {
+public:
+    CacheHierarchy(const CacheConfig& config, int frames, int page_size);
+
+    // page: identidad de la página virtual; walk: la traducción no vino del
+    // TLB; fault_cycles: costo del fault (0 = hit)
+    void access(int frame, uint64_t page, bool walk, long long fault_cycles);
+    void invalidate_frame(int frame);
+
+    const CacheConfig& get_config() const { return config_; }
+    double amat() const;
+    void display_stats() const;
+
+private:
+    CacheConfig config_;
+    std::vector<CacheLevel> levels_;
+    int lines_per_page_;
+    int hot_lines_;                    // Líneas recorridas por página
+    std::vector<uint16_t> cursor_;     // Próxima línea a tocar en cada frame
+    long long accesses_;
+    long long dram_accesses_;
+    long long walks_;
+    long long faults_;
+    long long cache_cycles_;           // Caché + DRAM
+    long long walk_cycles_;
+    long long fault_cycles_;
+};
+
+#endif // CACHE_HPP
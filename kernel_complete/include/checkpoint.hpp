@@ -0,0 +1,143 @@
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Formato binario de checkpoint:
+//   [CheckpointHeader][SectionEntry × n][secciones alineadas a 8 bytes]
+// Cada sección es un arreglo de registros POD; al cargar el archivo se
+// mapea en memoria y los registros se copian en bloque, sin parseo.
+// v2: páginas copy-on-write (bandera por entrada y contador de fallos COW).
+// v3: pool comprimido zswap.
+// v4: huge pages y contenido del TLB.
+// v5: modo de page table invertida.
+// v6: costo y estado del cambio de contexto, quantum del despacho en curso.
+// v7: instantes y esperas de los procesos en 64 bits.
+constexpr uint32_t CHECKPOINT_VERSION = 7;
+
+enum class CheckpointSection : uint32_t {
+    KERNEL = 1,
+    EVENTS,
+    SCHEDULER,
+    PROCESSES,
+    READY_QUEUE,
+    SCHED_METRICS,
+    MEMORY,
+    FRAMES,
+    PAGE_TABLE,
+    FIFO_ORDER,
+    LRU_ORDER,
+    WORKLOAD,
+    LOCALITY,
+    BUFFER,
+    BUFFER_ITEMS,
+    REVERSE_MAP,
+    ZSWAP_POOL,
+    TLB
+};
+
+struct CheckpointHeader {
+    char magic[8];              // "KSIMCKPT"
+    uint32_t version;
+    uint32_t section_count;
+    uint64_t file_size;
+};
+
+struct SectionEntry {
+    uint32_t id;
+    uint32_t record_size;       // sizeof del registro: detecta cambios de layout
+    uint64_t offset;
+    uint64_t count;
+};
+
+class CheckpointWriter {
+public:
+    template <typename T>
+    void add(CheckpointSection id, const T* records, size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "registro no POD");
+        sections_.push_back({static_cast<uint32_t>(id), static_cast<uint32_t>(sizeof(T)), 0, count});
+        const char* bytes = reinterpret_cast<const char*>(records);
+        payloads_.emplace_back(bytes, bytes + sizeof(T) * count);
+    }
+
+    template <typename T>
+    void add_one(CheckpointSection id, const T& record) { add(id, &record, 1); }
+
+    template <typename T>
+    void add_vector(CheckpointSection id, const std::vector<T>& records) {
+        add(id, records.data(), records.size());
+    }
+
+    // Escribe el archivo completo; false si falla la E/S
+    bool write(const std::string& path);
+
+    size_t get_bytes() const { return bytes_; }
+
+private:
+    std::vector<SectionEntry> sections_;
+    std::vector<std::vector<char>> payloads_;
+    size_t bytes_ = 0;
+};
+
+class CheckpointReader {
+public:
+    CheckpointReader() = default;
+    ~CheckpointReader();
+    CheckpointReader(const CheckpointReader&) = delete;
+    CheckpointReader& operator=(const CheckpointReader&) = delete;
+
+    // Mapear y validar el archivo; en error deja el mensaje en get_error()
+    bool open(const std::string& path);
+
+    bool has(CheckpointSection id) const { return find(id) != nullptr; }
+
+    // Registros de una sección (apuntan al mapeo); nullptr si falta o no coincide el layout
+    template <typename T>
+    const T* records(CheckpointSection id, size_t& count) const {
+        static_assert(std::is_trivially_copyable<T>::value, "registro no POD");
+        const SectionEntry* entry = find(id);
+        if (entry == nullptr || entry->record_size != sizeof(T)) {
+            count = 0;
+            return nullptr;
+        }
+        count = entry->count;
+        return reinterpret_cast<const T*>(base_ + entry->offset);
+    }
+
+    template <typename T>
+    bool read_one(CheckpointSection id, T& out) const {
+        size_t count;
+        const T* data = records<T>(id, count);
+        if (data == nullptr || count != 1) return false;
+        std::memcpy(&out, data, sizeof(T));
+        return true;
+    }
+
+    template <typename T>
+    bool read_vector(CheckpointSection id, std::vector<T>& out) const {
+        size_t count;
+        const T* data = records<T>(id, count);
+        if (data == nullptr) return false;
+        out.assign(data, data + count);
+        return true;
+    }
+
+    const std::string& get_error() const { return error_; }
+    size_t get_bytes() const { return size_; }
+
+private:
+    const char* base_ = nullptr;
+    size_t size_ = 0;
+    const SectionEntry* table_ = nullptr;
+    uint32_t section_count_ = 0;
+    std::string error_;
+
+    const SectionEntry* find(CheckpointSection id) const;
+    void close();
+};
+
+#endif // CHECKPOINT_HPP
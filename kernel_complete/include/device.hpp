@@ -0,0 +1,116 @@
+#ifndef DEVICE_HPP
+#define DEVICE_HPP
+
+#include "simulation.hpp"
+#include "workload.hpp"
+#include <deque>
+#include <map>
+#include <string>
+#include <functional>
+
+// Orden de atención de solicitudes de disco
+enum class DiskPolicy {
+    FCFS,    // Orden de llegada
+    SSTF,    // Menor distancia de búsqueda primero
+    SCAN,    // Ascensor: barre hasta el borde y regresa
+    CLOOK    // Barre hacia arriba y salta a la solicitud más baja
+};
+
+struct IORequest {
+    int pid;
+    int cylinder;
+    SimTime issued;
+};
+
+// Disco con cola de solicitudes ordenada según la política
+class DiskDevice {
+public:
+    DiskDevice(int id, int cylinders, DiskPolicy policy,
+               int transfer_time, double seek_per_cylinder);
+
+    // Encolar solicitud; devuelve true si el disco estaba libre
+    bool enqueue(const IORequest& request, SimTime now);
+
+    // Tomar la siguiente solicitud según la política; devuelve su tiempo de servicio
+    int start_next(SimTime now);
+
+    // Completar la solicitud en servicio
+    IORequest complete(SimTime now);
+
+    bool is_busy() const { return busy_; }
+    int queue_depth() const { return static_cast<int>(pending_count_); }
+    void display_stats(SimTime now) const;
+
+private:
+    int id_;
+    int cylinders_;
+    DiskPolicy policy_;
+    int transfer_time_;                         // Ticks fijos por transferencia
+    double seek_per_cylinder_;                  // Ticks por cilindro recorrido
+
+    int head_;                                  // Posición actual del cabezal
+    bool moving_up_;                            // Dirección de SCAN
+    bool busy_;
+    IORequest in_service_;
+
+    // Colas: FIFO para FCFS, ordenada por cilindro para el resto
+    std::deque<IORequest> fifo_;
+    std::multimap<int, IORequest> by_cylinder_;
+    size_t pending_count_;
+
+    // Estadísticas
+    long long completed_;
+    long long total_seek_;
+    long long total_response_;                  // Emisión → fin
+    SimTime busy_time_;
+    SimTime busy_since_;
+    double depth_area_;                         // ∫ profundidad dt
+    SimTime depth_since_;
+    int max_depth_;
+
+    void note_depth_change(SimTime now);
+    std::multimap<int, IORequest>::iterator pick_sorted(int& distance);
+};
+
+// Subsistema de E/S: discos + interrupciones de fin de E/S por eventos
+class DeviceManager {
+public:
+    using WakeCallback = std::function<void(int pid)>;
+
+    // El índice del disco viaja en los 16 bits bajos de la interrupción
+    static constexpr int DISK_BITS = 16;
+    static constexpr int MAX_DISKS = 1 << DISK_BITS;
+
+    DeviceManager(SimulationKernel& kernel, int disks, DiskPolicy policy,
+                  int mean_cpu_between_io, uint64_t seed = 7, bool verbose = true);
+    ~DeviceManager();
+
+    // Un proceso emite una ráfaga de E/S y queda bloqueado hasta la interrupción
+    void submit(int pid);
+    void set_wake_callback(WakeCallback callback) { wake_ = std::move(callback); }
+
+    // Ticks de CPU antes de la próxima E/S de un proceso (exponencial)
+    int draw_cpu_burst();
+
+    void display_stats() const;
+    int get_in_flight() const { return in_flight_; }
+
+    static std::string policy_to_string(DiskPolicy policy);
+    static bool parse_policy(const std::string& name, DiskPolicy& policy);
+
+private:
+    SimulationKernel& kernel_;
+    std::vector<DiskDevice> disks_;
+    DiskPolicy policy_;
+    int mean_cpu_between_io_;
+    Xoshiro256 rng_;
+    WakeCallback wake_;
+    int in_flight_;
+    long long submitted_;
+    long long generation_;          // Descarta interrupciones de un subsistema anterior
+
+    void start_service(int disk);
+    void handle_completion(const Event& event);
+};
+
+#endif // DEVICE_HPP
@@ -0,0 +1,115 @@
+#ifndef GROUP_HPP
+#define GROUP_HPP
+
+#include "simulation.hpp"
+#include <deque>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Grupo de procesos (estilo cgroup): peso relativo entre hermanos y límite
+// de ancho de banda quota/period (quota ≤ 0 = sin límite)
+struct ProcessGroup {
+    std::string name;
+    int parent;                        // -1 solo la raíz
+    int depth;
+    int weight;
+    long long quota;                   // Ticks de CPU por período
+    long long period;
+
+    // Ancho de banda del período en curso
+    long long used;
+    SimTime period_start;
+    bool throttled;
+    SimTime throttled_since;
+
+    // Fair share: el grupo es una entidad en el conjunto de su padre
+    double vruntime;                   // Avanza ticks × 1024 / peso
+    bool queued;                       // Está en runnable del padre
+    double tasks_vruntime;             // Entidad de sus procesos directos (peso 1024)
+    bool tasks_queued;
+    double min_vruntime;               // Piso para entidades que vuelven a estar listas
+    std::deque<int> tasks;             // Procesos READY directos, en orden RR
+    std::set<std::pair<double, int>> runnable;   // (vruntime, hijo); -1 = procesos directos
+
+    // Estadísticas
+    long long cpu_ticks;               // Del subárbol
+    long long own_ticks;               // Solo de sus procesos directos
+    long long throttle_events;
+    long long throttled_ticks;
+    long long dispatches;
+    long long wait_sum;                // Espera en READY hasta el despacho
+    long long wait_max;
+};
+
+// Planificación jerárquica por grupos sobre Round Robin. Cada grupo tiene un
+// conjunto ordenado por vruntime con sus hijos listos y, como un hijo más de
+// peso 1024, la cola FIFO de sus procesos directos. Despachar baja desde la
+// raíz por el hijo de menor vruntime hasta una cola de procesos: O(profundidad
+// × log hermanos), así miles de grupos no cuestan un recorrido lineal. Un
+// grupo que agota su quota sale del conjunto de su padre (throttled) hasta el
+// fin de su período, que se programa como evento.
+class GroupScheduler {
+public:
+    static constexpr int ROOT = 0;
+    static constexpr int TASK_WEIGHT = 1024;
+
+    GroupScheduler(SimulationKernel& kernel, bool verbose = true);
+    ~GroupScheduler();
+
+    // Alta de un grupo; -1 si el padre no existe o el nombre se repite
+    int create_group(const std::string& name, int parent, int weight);
+    int find_group(const std::string& name) const;       // Nombre o id; -1 si no existe
+    bool set_weight(int group, int weight);
+    bool set_quota(int group, long long quota, long long period);
+    int get_group_count() const { return static_cast<int>(groups_.size()); }
+    const ProcessGroup& get_group(int group) const { return groups_[group]; }
+
+    // Grupo en el que entran los procesos nuevos
+    void set_default_group(int group) { default_group_ = group; }
+    int get_default_group() const { return default_group_; }
+    int group_of(int pid);
+    void move(int pid, int group, bool ready);
+
+    // Cola de listos del scheduler
+    void enqueue(int pid);
+    int pick();                                          // -1 si nada puede correr
+    bool has_ready() const { return !groups_[ROOT].runnable.empty(); }
+    size_t ready_count() const { return ready_count_; }
+    std::vector<int> drain();                            // Vaciar (al desactivar)
+
+    // Ejecución: cargar ticks al proceso y a sus ancestros
+    void charge(int pid, long long ticks);
+    void record_dispatch(int pid, long long wait);
+    bool is_throttled(int pid);
+    long long slice_budget(int pid);                     // Ticks antes de agotar una quota
+
+    void display_stats() const;
+
+private:
+    SimulationKernel& kernel_;
+    bool verbose_;
+    std::vector<ProcessGroup> groups_;
+    std::unordered_map<std::string, int> names_;
+    std::vector<int> membership_;                        // Grupo por PID (-1 = sin asignar)
+    int default_group_;
+    size_t ready_count_;
+    long long generation_;                               // Descarta recargas de otra instancia
+
+    void refresh_period(ProcessGroup& group);
+    void sync_tasks(int group);
+    void sync_queue(int group);
+    void reposition(ProcessGroup& parent, int key, double old_vruntime, double vruntime);
+    void update_min(ProcessGroup& parent, double running_vruntime);
+    void throttle(int group);
+    void handle_refill(const Event& event);
+};
+
+// Aislamiento y costo con muchos grupos: un cuarto de los grupos (inquilinos
+// "pesados") lanza 10 veces más procesos. Se compara la CPU que reciben con y
+// sin grupos y se mide el costo por despacho.
+void run_group_bench(int groups, int processes, long long ticks, int quota_percent);
+
+#endif // GROUP_HPP
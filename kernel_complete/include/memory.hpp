@@ -1,32 +1,82 @@
 #ifndef MEMORY_HPP
 #define MEMORY_HPP
 
+#include "allocator.hpp"
+#include "page_table.hpp"
+#include "cache.hpp"
 #include <vector>
 #include <map>
 #include <queue>
+#include <list>
+#include <memory>
 #include <string>
+#include <unordered_map>
+
+class SimulationKernel;
+class CheckpointWriter;
+class CheckpointReader;
+
+// Algoritmos de reemplazo de páginas
+enum class ReplacementPolicy {
+    FIFO,    // Primero en entrar, primero en salir
+    LRU,     // Menos recientemente usada (lista doble, O(1))
+    CLOCK    // Segunda oportunidad con bit de referencia
+};
 
 // Estructura de un frame físico
 struct Frame {
     int frame_id;
-    int page_number;   // Qué página está cargada
-    int process_id;    // A qué proceso pertenece
+    int page_number;   // Qué página está cargada (primer mapeo)
+    int process_id;    // A qué proceso pertenece (primer mapeo)
     bool occupied;
     int load_time;     // Para FIFO
+    bool referenced;   // Bit de referencia para CLOCK
+};
+
+// Mapeo (proceso, página) de un frame para el mapa inverso
+struct PageMapping {
+    int process_id;
+    int page_number;
+};
+
+// Página comprimida en el tier zswap
+struct ZswapEntry {
+    int process_id;
+    int page_number;
+    int bytes;         // Tamaño comprimido
 };
 
-// Estructura de entrada en page table
-struct PageTableEntry {
-    int frame_id;      // Marco físico asignado
-    bool valid;        // Está en memoria física?
+// Colocación de páginas en nodos NUMA
+enum class NumaPlacement {
+    FIRST_TOUCH,     // En el nodo del proceso que la toca primero
+    INTERLEAVE       // Repartidas por número de página entre todos los nodos
 };
 
+struct NumaConfig {
+    int nodes = 2;
+    NumaPlacement placement = NumaPlacement::FIRST_TOUCH;
+    int local_ns = 80;                 // Acceso a un frame del nodo propio
+    int remote_ns = 140;               // Acceso a un frame de otro nodo
+    int sample_period = 64;            // 1 de cada N accesos es una muestra
+    int copy_ns = 2000;                // Copiar una página al migrarla
+    bool migrate = true;
+};
+
+// "first|interleave", "local=80", "remote=140", "sample=64", "copy=2000", "migrate=on|off"
+bool parse_numa_option(const std::string& token, NumaConfig& config);
+
 class MemoryManager {
 public:
-    MemoryManager(int num_frames);
+    MemoryManager(int num_frames, ReplacementPolicy policy = ReplacementPolicy::FIFO,
+                  bool verbose = true);
+    
+    // Operaciones principales. Devuelve false si hubo page fault; escribir
+    // una página COW compartida copia el frame sin bloquear (fallo COW)
+    bool access_page(int process_id, int page_number, bool write = false);
     
-    // Operaciones principales
-    bool access_page(int process_id, int page_number);
+    // fork: el hijo hereda la page table del padre y ambos comparten los
+    // frames marcados copy-on-write hasta que alguno escriba
+    void fork(int parent_pid, int child_pid);
     void display_frames() const;
     void display_stats() const;
     void display_page_table(int process_id) const;
@@ -36,24 +86,202 @@ public:
     
     // Reset stats
     void reset_stats();
+    
+    // Tier comprimido (zswap): las páginas evictadas se comprimen en un pool
+    // de pool_frames frames en RAM. Un fault que encuentra la página en el
+    // pool cuesta decompress_time ticks en lugar del servicio de disco; si el
+    // pool se llena, las más antiguas se escriben a disco.
+    void enable_zswap(int pool_frames, int decompress_time);
+    void disable_zswap();
+    bool is_zswap_enabled() const { return zswap_budget_ > 0; }
+    bool last_fault_from_pool() const { return last_fault_from_pool_; }
+    int get_decompress_time() const { return decompress_time_; }
+    int get_zswap_hits() const { return zswap_hits_; }
+    double get_pool_hit_rate() const;                   // Faults servidos por el pool
+    void display_zswap_stats() const;
+    
+    // Páginas de varios tamaños: una huge page son huge_factor frames base
+    // contiguos y alineados. Una región virtual alineada con todas sus páginas
+    // residentes se promueve migrando sus páginas a un bloque físico libre;
+    // evictar un frame de una huge page la divide antes (democión). El TLB,
+    // totalmente asociativo con LRU, cubre huge_factor páginas por entrada
+    // huge. huge_factor 1 = solo páginas base (TLB para comparar).
+    void enable_huge_pages(int huge_factor, int tlb_entries);
+    void disable_huge_pages();
+    bool is_huge_enabled() const { return tlb_entries_ > 0; }
+    double get_tlb_hit_rate() const;
+    void display_huge_stats() const;
+    
+    // Jerarquía de cachés (L1/L2/LLC) alimentada por las mismas referencias,
+    // indexada por la dirección física del frame. Su estado no se guarda en
+    // checkpoints: al cargar se desactiva.
+    void enable_caches(const CacheConfig& config);
+    void disable_caches() { caches_.reset(); }
+    bool is_caches_enabled() const { return caches_ != nullptr; }
+    void display_cache_stats() const;
+    
+    // NUMA: los frames se parten en nodos contiguos y cada proceso corre en
+    // su nodo hogar (pid % nodos salvo que se fije; el hijo de fork hereda
+    // el del padre). Un acceso cuesta local_ns o remote_ns según el nodo del
+    // frame. Se muestrea 1 de cada sample_period accesos; si dos muestras
+    // seguidas de una página vienen del mismo nodo remoto y ese nodo tiene un
+    // frame libre, la página migra allá. Su estado no se guarda en checkpoints.
+    void enable_numa(const NumaConfig& config);
+    void disable_numa();
+    bool is_numa_enabled() const { return numa_nodes_ > 0; }
+    bool set_home_node(int process_id, int node);
+    void display_numa_stats() const;
+    
+    // Page tables: solo guardan páginas residentes (evictar borra la entrada).
+    // Directa = un árbol por proceso; invertida = una tabla hash global
+    // dimensionada por los frames. Cambiar de modo migra las entradas.
+    void set_inverted(bool inverted);
+    bool is_inverted() const { return inverted_ != nullptr; }
+    int get_mapped_pages() const;
+    size_t translation_bytes() const;                   // Memoria estimada de traducción
+    
+    // Reloj global compartido (nullptr = contador de accesos propio)
+    void attach_clock(const SimulationKernel* clock) { clock_ = clock; }
+    
+    // Modo silencioso para simulaciones masivas (sin trazas por acceso)
+    void set_verbose(bool verbose) { verbose_ = verbose; }
+    bool is_verbose() const { return verbose_; }
+    
+    int get_total_accesses() const { return total_accesses_; }
+    int get_page_faults() const { return page_faults_; }
+    int get_cow_faults() const { return cow_faults_; }
+    ReplacementPolicy get_policy() const { return policy_; }
+    
+    // Checkpoint: frames, page tables, estado del reemplazo y estadísticas
+    void save_state(CheckpointWriter& writer) const;
+    static std::unique_ptr<MemoryManager> from_checkpoint(const CheckpointReader& reader);
+    
+    static std::string policy_to_string(ReplacementPolicy policy);
+    static bool parse_policy(const std::string& name, ReplacementPolicy& policy);
+    
+    static constexpr int PAGE_SIZE = 4096;
+    
+    // Memoria física: los frames libres los administra un buddy allocator
+    // que comparten las páginas de usuario y la capa slab del kernel
+    BuddyAllocator& get_buddy() { return buddy_; }
+    const BuddyAllocator& get_buddy() const { return buddy_; }
+    int get_num_frames() const { return num_frames_; }
+    
+    // Presión del kernel: evictar una página de usuario y devolver su frame al buddy
+    bool reclaim_frame();
 
 private:
     int num_frames_;                                    // Cantidad de frames
     std::vector<Frame> frames_;                         // Tabla de frames
     std::map<int, std::map<int, PageTableEntry>> page_tables_; // Page table por proceso
+    std::unique_ptr<InvertedPageTable> inverted_;       // Reemplaza a page_tables_ si existe
+    ReplacementPolicy policy_;
     std::queue<int> fifo_queue_;                        // Cola FIFO para reemplazo
+    std::list<int> lru_list_;                           // Frente = menos reciente
+    std::vector<std::list<int>::iterator> lru_pos_;     // Posición de cada frame en lru_list_
+    int clock_hand_;                                    // Manecilla de CLOCK
+    std::vector<std::vector<PageMapping>> reverse_map_; // Mapeos de cada frame (refcount = tamaño)
+    BuddyAllocator buddy_;                              // Frames libres (páginas y slabs)
+    
+    // Pool zswap: lista en orden de llegada (frente = próxima a disco)
+    std::list<ZswapEntry> zswap_pool_;
+    std::unordered_map<long long, std::list<ZswapEntry>::iterator> zswap_index_;
+    long long zswap_budget_;                            // Bytes (0 = desactivado)
+    long long zswap_bytes_;                             // Bytes comprimidos en uso
+    int decompress_time_;
+    bool last_fault_from_pool_;
+    
+    // Huge pages y TLB
+    int huge_factor_;                                   // Frames base por huge page
+    std::vector<char> huge_blocks_;                     // Bloque alineado promovido
+    int tlb_entries_;                                   // 0 = sin modelo de TLB
+    std::list<long long> tlb_lru_;                      // Frente = menos reciente
+    std::unordered_map<long long, std::list<long long>::iterator> tlb_index_;
+    
+    std::unique_ptr<CacheHierarchy> caches_;            // nullptr = sin modelo de cachés
+    
+    // NUMA: por qué quedó cada frame donde está, para atribuir los remotos
+    enum class NumaReason : char { LOCAL, POLICY, CAPACITY, MIGRATED };
+    struct NumaFrame {
+        NumaReason reason;
+        signed char last_sample;                        // Nodo de la última muestra (-1 = ninguna)
+    };
+    struct NumaNodeStats {
+        long long local_accesses;                       // Hechos desde este nodo
+        long long remote_accesses;
+        long long placed[4];                            // Asignaciones por NumaReason
+        long long migrations_in;
+    };
+    NumaConfig numa_;
+    int numa_nodes_;                                    // 0 = sin NUMA
+    int frames_per_node_;
+    std::vector<NumaFrame> numa_frames_;
+    std::vector<NumaNodeStats> numa_stats_;
+    std::unordered_map<int, int> home_nodes_;           // Fijados con numa-home o por fork
+    long long numa_sample_clock_;
+    long long numa_samples_;
+    long long numa_migrations_;
+    long long numa_migration_failures_;                 // Nodo destino sin frames libres
+    long long remote_by_reason_[4];
     
     // Estadísticas
     int total_accesses_;
     int page_faults_;
     int page_hits_;
+    int cow_faults_;                                    // Copias por escritura a página compartida
+    int zswap_stores_;                                  // Páginas comprimidas al evictar
+    int zswap_rejects_;                                 // Incompresibles: directo a disco
+    int zswap_hits_;                                    // Faults servidos descomprimiendo
+    int zswap_writebacks_;                              // Expulsadas del pool a disco
+    long long zswap_stored_bytes_;                      // Tamaño comprimido de todo lo guardado
+    int promotions_;
+    int promotion_failures_;                            // Región completa sin bloque libre
+    int demotions_;
+    int migrated_pages_;                                // Copias para armar huge pages
+    long long tlb_hits_;
+    long long tlb_misses_;
     int current_time_;
+    int occupied_count_;                                // Frames ocupados (evita escaneo lineal)
+    const SimulationKernel* clock_;                     // Reloj virtual compartido
+    bool verbose_;
     
     // Helpers internos
+    PageTableEntry* find_entry(int process_id, int page_number);
+    PageTableEntry& map_entry(int process_id, int page_number);
+    void erase_entry(int process_id, int page_number);
+    std::vector<std::pair<int, PageTableEntry>> process_entries(int process_id) const;
     int find_free_frame();
+    int select_victim();
     int select_victim_fifo();
+    int select_victim_lru();
+    int select_victim_clock();
+    void touch_frame(int frame_id);
     void load_page(int process_id, int page_number, int frame_id);
     void evict_page(int frame_id);
+    int allocate_frame(int process_id, int page_number);
+    void unmap(int frame_id, int process_id, int page_number);
+    void break_cow(int process_id, int page_number);
+    static long long page_key(int process_id, int page_number) {
+        return (static_cast<long long>(process_id) << 32) | static_cast<unsigned>(page_number);
+    }
+    static long long tlb_key(int process_id, int page_number, bool huge) {
+        // Las entradas huge se indexan por región, con el bit alto como marca
+        return huge ? page_key(process_id, page_number) | (1LL << 62) : page_key(process_id, page_number);
+    }
+    bool tlb_access(int process_id, int page_number, bool huge);   // true = acierto
+    void tlb_shootdown(long long key);
+    void try_promote(int process_id, int region);
+    void demote(int block);
+    void swap_frames(int a, int b);
+    int node_of(int frame_id) const { return frame_id / frames_per_node_; }
+    int home_node(int process_id) const;
+    int numa_free_frame(int process_id, int page_number);
+    void numa_place(int frame_id, int process_id, int page_number);
+    void numa_access(int process_id, int page_number, int frame_id);
+    bool numa_migrate(int frame_id, int node);
+    static int compressed_size(int process_id, int page_number);
+    void zswap_store(int process_id, int page_number);
+    bool zswap_load(int process_id, int page_number);
 };
 
 #endif // MEMORY_HPP
@@ -0,0 +1,100 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include "simulation.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+
+// Histograma logarítmico: valores < 16 exactos, luego 16 sub-buckets por
+// potencia de 2 (error relativo ≤ 6.25%). Registrar es O(1) y la memoria fija.
+class LogHistogram {
+public:
+    static constexpr int SUB_BITS = 4;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BITS;
+    static constexpr int BUCKETS = SUB_BUCKETS * (64 - SUB_BITS + 1);
+
+    LogHistogram() { reset(); }
+
+    void record(uint64_t value) {
+        counts_[bucket_of(value)]++;
+        count_++;
+        sum_ += value;
+        if (value < min_) min_ = value;
+        if (value > max_) max_ = value;
+    }
+
+    // Cuantil q en [0, 1]: cota superior del bucket que lo contiene
+    uint64_t percentile(double q) const;
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+    void reset();
+
+private:
+    std::array<uint64_t, BUCKETS> counts_;
+    uint64_t count_;
+    uint64_t sum_;
+    uint64_t min_;
+    uint64_t max_;
+
+    static int bucket_of(uint64_t value) {
+        if (value < SUB_BUCKETS) {
+            return static_cast<int>(value);
+        }
+        int exponent = 63 - __builtin_clzll(value);          // Bit más alto
+        int shift = exponent - SUB_BITS;
+        int sub = static_cast<int>((value >> shift) & (SUB_BUCKETS - 1));
+        return (shift + 1) * SUB_BUCKETS + sub;
+    }
+    static uint64_t bucket_upper(int bucket);
+};
+
+// Métricas de planificación por proceso terminado, todas incrementales
+class SchedulerMetrics {
+public:
+    // Ráfagas agrupadas por potencia de 2: [1], [2,3], [4,7], ...
+    static constexpr int BURST_CLASSES = 21;
+
+    SchedulerMetrics() { reset(); }
+
+    // Primer despacho: respuesta = primer despacho - llegada. Las duraciones
+    // llegan ya restadas en SimTime, así no heredan un reloj truncado.
+    void record_response(SimTime response) { response_.record(static_cast<uint64_t>(response)); }
+
+    // Proceso terminado normalmente
+    void record_completion(int burst, SimTime wait, SimTime turnaround);
+
+    // Índice de Jain sobre la tasa de servicio burst/turnaround (1 = justo)
+    double jain_index() const;
+    
+    const LogHistogram& response() const { return response_; }
+    const LogHistogram& wait() const { return wait_; }
+    const LogHistogram& turnaround() const { return turnaround_; }
+    uint64_t completed() const { return completed_; }
+
+    void display() const;
+    void reset();
+
+private:
+    struct BurstClass {
+        LogHistogram slowdown;      // Slowdown × 100 (fijo, 2 decimales)
+    };
+
+    LogHistogram response_;
+    LogHistogram wait_;
+    LogHistogram turnaround_;
+    std::array<BurstClass, BURST_CLASSES> by_burst_;
+
+    // Jain: (Σx)² / (n · Σx²)
+    double rate_sum_;
+    double rate_sq_sum_;
+    uint64_t completed_;
+
+    static int burst_class(int burst);
+    static void print_row(const std::string& label, const LogHistogram& h, double scale);
+};
+
+#endif // METRICS_HPP
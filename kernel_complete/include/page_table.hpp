@@ -0,0 +1,93 @@
+#ifndef PAGE_TABLE_HPP
+#define PAGE_TABLE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Estructura de entrada en page table
+struct PageTableEntry {
+    int frame_id;      // Marco físico asignado
+    bool valid;        // Está en memoria física?
+    bool cow;          // Compartida tras fork: la escritura copia el frame
+    bool huge;         // Parte de una huge page (una entrada de TLB para toda la región)
+};
+
+// Page table invertida: una entrada por mapeo residente (≈ una por frame;
+// más solo con frames compartidos por COW), buscada por hash de (pid, vpn).
+// Direccionamiento abierto por grupos de 8 claves contiguas (una línea de
+// caché): cada sondeo compara el grupo entero en un bucle sin saltos que el
+// compilador vectoriza. Borrar deja lápida solo si el grupo ya estaba lleno;
+// cuando las lápidas pesan se rehashea y desaparecen. La memoria depende de
+// los frames físicos, no de cuántas páginas virtuales tocó cada proceso.
+class InvertedPageTable {
+public:
+    static constexpr int GROUP = 8;
+
+    explicit InvertedPageTable(int frames);
+
+    // nullptr si (pid, vpn) no está residente
+    PageTableEntry* find(int process_id, int page_number);
+    const PageTableEntry* find(int process_id, int page_number) const;
+
+    // Entrada existente o nueva (sin inicializar el contenido)
+    PageTableEntry& insert(int process_id, int page_number);
+    bool erase(int process_id, int page_number);
+
+    template <typename F>
+    void for_each(F visit) const {
+        for (size_t i = 0; i < keys_.size(); i++) {
+            if (keys_[i] < TOMBSTONE) {
+                visit(static_cast<int>(keys_[i] >> 32), static_cast<int>(keys_[i] & 0xFFFFFFFFu), values_[i]);
+            }
+        }
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return keys_.size(); }
+    size_t tombstones() const { return tombstones_; }
+    size_t memory_bytes() const {
+        return keys_.capacity() * sizeof(uint64_t) + values_.capacity() * sizeof(PageTableEntry);
+    }
+    double probes_per_lookup() const {
+        return lookups_ > 0 ? static_cast<double>(probes_) / lookups_ : 0.0;
+    }
+    long long get_rehashes() const { return rehashes_; }
+
+private:
+    static constexpr uint64_t EMPTY = ~0ULL;
+    static constexpr uint64_t TOMBSTONE = ~0ULL - 1;
+
+    std::vector<uint64_t> keys_;
+    std::vector<PageTableEntry> values_;
+    size_t group_mask_;
+    size_t size_;
+    size_t tombstones_;
+    mutable long long lookups_;
+    mutable long long probes_;                 // Grupos examinados
+    long long rehashes_;
+
+    static uint64_t make_key(int process_id, int page_number) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(process_id)) << 32) |
+               static_cast<uint32_t>(page_number);
+    }
+    size_t home_group(uint64_t key) const {
+        // Fibonacci hashing: los bits altos del producto reparten bien vpn consecutivas
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & group_mask_;
+    }
+    static unsigned match(const uint64_t* group, uint64_t key) {
+        unsigned mask = 0;
+        for (int i = 0; i < GROUP; i++) {
+            mask |= static_cast<unsigned>(group[i] == key) << i;
+        }
+        return mask;
+    }
+    long long locate(uint64_t key) const;     // Índice del slot; -1 si no está
+    void rehash(size_t groups);
+};
+
+// Benchmark: muchos procesos con espacios de direcciones dispersos sobre la
+// misma memoria física, con page table directa y con la invertida
+void run_page_table_bench(int processes, int pages_per_process, int frames, uint64_t seed);
+
+#endif // PAGE_TABLE_HPP
@@ -0,0 +1,88 @@
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+
+#include "sync.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Etapa de un pipeline: workers hilos que procesan cada item durante work_ns
+struct StageConfig {
+    std::string name;
+    int workers;
+    int work_ns;                       // Costo por item (espera activa)
+};
+
+struct PipelineConfig {
+    std::vector<StageConfig> stages;
+    long long items = 100000;          // Los genera la primera etapa
+    int capacity = 64;                 // Items por buffer entre etapas
+    int batch = 1;                     // Items por entrega (put/take)
+    bool pin = false;                  // Fijar cada worker a un núcleo
+};
+
+// Resultado por etapa: el tiempo de un worker se reparte entre trabajo,
+// espera de entrada (buffer anterior vacío) y espera de salida (siguiente lleno)
+struct StageReport {
+    std::string name;
+    int workers;
+    int work_ns;
+    long long items;
+    double busy_seconds;
+    double input_wait_seconds;
+    double output_wait_seconds;
+};
+
+struct QueueReport {
+    int capacity;
+    std::vector<int> samples;          // Ocupación muestreada durante la corrida
+    int producer_blocks;
+    int consumer_blocks;
+};
+
+struct PipelineReport {
+    double seconds;
+    long long items;
+    std::vector<StageReport> stages;
+    std::vector<QueueReport> queues;   // queues[i] une stages[i] con stages[i + 1]
+    int bottleneck;                    // Etapa de mayor utilización
+};
+
+// Cadena de etapas unidas por ProducerConsumer acotados. Cada worker saca
+// un lote de su buffer de entrada, lo procesa y lo entrega al siguiente;
+// los buffers llenos frenan a las etapas anteriores hasta la fuente, así que
+// la tasa de todo el pipeline la fija la etapa más lenta. Un hilo monitor
+// muestrea la ocupación de cada buffer.
+class Pipeline {
+public:
+    explicit Pipeline(const PipelineConfig& config);
+
+    PipelineReport run();
+
+    // "nombre:workers:ns,..." → etapas; false si el formato no es válido
+    static bool parse_stages(const std::string& spec, std::vector<StageConfig>& stages);
+
+    static void display_report(const PipelineReport& report, const PipelineConfig& config);
+
+private:
+    struct alignas(64) WorkerStats {
+        long long items;
+        long long busy_ns;
+        long long input_wait_ns;
+        long long output_wait_ns;
+    };
+
+    PipelineConfig config_;
+    std::vector<std::unique_ptr<ProducerConsumer>> queues_;
+    std::vector<std::vector<WorkerStats>> stats_;
+    std::vector<std::unique_ptr<std::atomic<int>>> live_workers_;
+    std::atomic<long long> next_item_;
+
+    void worker(int stage, int index, int core);
+};
+
+// La misma corrida con cada tamaño de buffer: throughput y bloqueos por capacidad
+void run_pipeline_capacity_sweep(PipelineConfig config, const std::vector<int>& capacities);
+
+#endif // PIPELINE_HPP
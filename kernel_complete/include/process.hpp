@@ -1,9 +1,13 @@
 #ifndef PROCESS_HPP
 #define PROCESS_HPP
 
+#include "simulation.hpp"
+#include <array>
+#include <cstdint>
 #include <string>
+#include <vector>
 
-enum class ProcessState {
+enum class ProcessState : uint8_t {
     NEW,
     READY,
     RUNNING,
@@ -11,31 +15,138 @@ enum class ProcessState {
     TERMINATED
 };
 
+// Imagen POD del PCB para checkpoints (instantes y esperas en 64 bits)
+struct ProcessImage {
+    int pid;
+    int state;
+    int burst_time;
+    int remaining_time;
+    SimTime wait_time;
+    SimTime turnaround_time;
+    SimTime arrival_time;
+    SimTime first_dispatch;
+    int address_space;
+    int page_faults;
+    SimTime ready_since;
+    int cpu_until_io;
+    int waiting_io;
+    int io_count;
+};
+
+class Process;
+
+// Tabla de PCBs en estructura de arreglos: un arreglo contiguo por campo
+// (el estado en bytes). P<n> ocupa la posición n-1 de cada arreglo, así las
+// operaciones masivas son bucles lineales que el compilador vectoriza.
+class ProcessTable {
+public:
+    static constexpr int STATE_COUNT = 5;
+
+    // Alta de un proceso NEW; devuelve su PID
+    int add(int burst_time, SimTime arrival_time);
+    int add_image(const ProcessImage& image);
+    void reserve(size_t count);
+
+    int size() const { return static_cast<int>(state_.size()); }
+    bool contains(int pid) const { return pid >= 1 && pid <= size(); }
+    Process get(int pid);
+    ProcessImage get_image(int pid) const;
+
+    // Operaciones masivas (vectorizadas)
+    void increment_ready_waits();                    // Espera +1 para cada READY
+    void mark_ready_since(SimTime now);              // ready_since = now para cada READY
+    void flush_ready_waits(SimTime now);               // Volcar espera medida por timestamps
+    void set_address_space_all(int pages);
+    std::array<int, STATE_COUNT> count_states() const;
+    long long sum_terminated_wait() const;
+    long long sum_terminated_turnaround() const;
+    long long sum_page_faults() const;
+    long long sum_io_count() const;
+    
+    // Medir el ancho de banda de las operaciones masivas sobre N procesos
+    static void benchmark(int processes);
+
+private:
+    friend class Process;
+
+    // Instantes y esperas van en SimTime (64 bits): el reloj supera 2^31
+    // en corridas largas. Las ráfagas y contadores siguen en 32 bits.
+    std::vector<uint8_t> state_;
+    std::vector<int32_t> burst_time_;        // Tiempo total CPU necesario
+    std::vector<int32_t> remaining_time_;    // Tiempo restante
+    std::vector<SimTime> wait_time_;         // Tiempo en cola READY
+    std::vector<SimTime> turnaround_time_;   // Tiempo total en sistema
+    std::vector<SimTime> arrival_time_;      // Momento de creación
+    std::vector<SimTime> first_dispatch_;    // Primera vez en CPU (-1 = nunca)
+    std::vector<int32_t> address_space_;     // Páginas virtuales del proceso (0 = sin memoria)
+    std::vector<int32_t> page_faults_;       // Fallos de página provocados
+    std::vector<SimTime> ready_since_;       // Instante en que entró a READY
+    std::vector<int32_t> cpu_until_io_;      // CPU restante antes de emitir E/S
+    std::vector<uint8_t> waiting_io_;        // BLOCKED esperando un dispositivo
+    std::vector<int32_t> io_count_;          // Ráfagas de E/S emitidas
+
+    long long sum_if_terminated(const std::vector<SimTime>& field) const;
+};
+
+// Vista de un PCB dentro de la tabla (puntero + índice, se copia por valor).
+// Sigue siendo válida aunque la tabla crezca.
 class Process {
 public:
-    Process(int pid, int burst_time);
+    Process(ProcessTable* table, int pid) : table_(table), index_(pid - 1) {}
     
     // Getters
-    int get_pid() const { return pid_; }
-    ProcessState get_state() const { return state_; }
-    int get_burst_time() const { return burst_time_; }
-    int get_remaining_time() const { return remaining_time_; }
-    int get_wait_time() const { return wait_time_; }
-    int get_turnaround_time() const { return turnaround_time_; }
-    int get_arrival_time() const { return arrival_time_; }
+    int get_pid() const { return index_ + 1; }
+    ProcessState get_state() const { return static_cast<ProcessState>(table_->state_[index_]); }
+    int get_burst_time() const { return table_->burst_time_[index_]; }
+    int get_remaining_time() const { return table_->remaining_time_[index_]; }
+    SimTime get_wait_time() const { return table_->wait_time_[index_]; }
+    SimTime get_turnaround_time() const { return table_->turnaround_time_[index_]; }
+    SimTime get_arrival_time() const { return table_->arrival_time_[index_]; }
+    int get_address_space() const { return table_->address_space_[index_]; }
+    int get_page_faults() const { return table_->page_faults_[index_]; }
+    SimTime get_first_dispatch() const { return table_->first_dispatch_[index_]; }
+    bool was_dispatched() const { return get_first_dispatch() >= 0; }
+    SimTime get_response_time() const { return get_first_dispatch() - get_arrival_time(); }
     
     // Setters
-    void set_state(ProcessState state) { state_ = state; }
-    void set_arrival_time(int time) { arrival_time_ = time; }
+    void set_state(ProcessState state) const { table_->state_[index_] = static_cast<uint8_t>(state); }
+    void set_arrival_time(SimTime time) const { table_->arrival_time_[index_] = time; }
+    void set_address_space(int pages) const { table_->address_space_[index_] = pages; }
+    void set_first_dispatch(SimTime time) const { table_->first_dispatch_[index_] = time; }
+    
+    // Nueva ráfaga de un programa: se suma al total y pasa a ser lo restante
+    void assign_burst(int ticks) const {
+        table_->burst_time_[index_] += ticks;
+        table_->remaining_time_[index_] = ticks;
+    }
+    
+    // Registrar un page fault propio (modo acoplado CPU+memoria)
+    void record_page_fault() const { table_->page_faults_[index_]++; }
+    
+    // Alternancia CPU/E-S: ticks de CPU que faltan para la próxima E/S (0 = nunca)
+    int get_cpu_until_io() const { return table_->cpu_until_io_[index_]; }
+    void set_cpu_until_io(int ticks) const { table_->cpu_until_io_[index_] = ticks; }
+    bool is_waiting_io() const { return table_->waiting_io_[index_] != 0; }
+    void set_waiting_io(bool waiting) const { table_->waiting_io_[index_] = waiting ? 1 : 0; }
+    int get_io_count() const { return table_->io_count_[index_]; }
+    void record_io() const { table_->io_count_[index_]++; }
     
     // Ejecutar el proceso por 1 unidad de tiempo
-    void execute();
+    void execute() const;
+    
+    // Ejecutar varias unidades de una vez (modo por eventos)
+    void execute(int ticks) const;
     
     // Incrementar tiempo de espera
-    void increment_wait_time() { wait_time_++; }
+    void increment_wait_time() const { table_->wait_time_[index_]++; }
+    
+    // Espera acumulada en bloque (modo por eventos): se mide desde ready_since
+    SimTime get_ready_since() const { return table_->ready_since_[index_]; }
+    void set_ready_since(SimTime time) const { table_->ready_since_[index_] = time; }
+    void add_wait_time(SimTime ticks) const { table_->wait_time_[index_] += ticks; }
     
     // Calcular turnaround al terminar
-    void calculate_turnaround(int current_time);
+    void calculate_turnaround(SimTime current_time) const;
     
     // Estado como string
     std::string state_to_string() const;
@@ -44,13 +155,12 @@ public:
     void print_info() const;
 
 private:
-    int pid_;
-    ProcessState state_;
-    int burst_time_;        // Tiempo total CPU necesario
-    int remaining_time_;    // Tiempo restante
-    int wait_time_;         // Tiempo en cola READY
-    int turnaround_time_;   // Tiempo total en sistema
-    int arrival_time_;      // Momento de creación
+    ProcessTable* table_;
+    int index_;
 };
 
+inline Process ProcessTable::get(int pid) {
+    return Process(this, pid);
+}
+
 #endif // PROCESS_HPP
@@ -0,0 +1,147 @@
+#ifndef PROGRAM_HPP
+#define PROGRAM_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <string>
+#include <utility>
+
+// Operaciones que un programa cede al kernel con co_await
+enum class ProgramOpKind : uint8_t {
+    COMPUTE,   // Usar la CPU arg ticks
+    ACCESS,    // Referenciar la página arg (un fault bloquea)
+    PRODUCE,   // Depositar arg en el buffer compartido (bloquea si está lleno)
+    CONSUME,   // Retirar un valor (bloquea si está vacío); co_await lo devuelve
+    IO,        // Ráfaga de E/S en disco (sin discos: espera arg ticks)
+    SLEEP,     // Dormir arg ticks
+    COUNT
+};
+
+struct ProgramOp {
+    ProgramOpKind kind;
+    int arg;
+};
+
+// Pool de frames de corrutina por clases de tamaño (múltiplos de 64 bytes).
+// Los frames se cortan de bloques grandes y al liberarse vuelven a una lista
+// libre por clase, así crear y destruir programas no llama al allocator global.
+// Un pool por hilo: los barridos paralelos no comparten listas.
+class FramePool {
+public:
+    struct Stats {
+        long long allocations;       // Frames entregados
+        long long reused;            // De ellos, tomados de una lista libre
+        long long live;              // Frames en uso
+        size_t reserved_bytes;       // Memoria reservada en bloques
+    };
+
+    static void* allocate(size_t bytes);
+    static void release(void* frame, size_t bytes);
+    static Stats stats();
+};
+
+// Proceso definido como corrutina C++20. El kernel llama a resume() cuando
+// el proceso necesita su siguiente operación; el programa corre hasta el
+// próximo co_await y queda suspendido con la operación en su promesa.
+class Program {
+public:
+    struct promise_type {
+        ProgramOp op{ProgramOpKind::COMPUTE, 0};
+        int result = 0;              // Valor que devuelve el co_await pendiente
+
+        Program get_return_object() {
+            return Program(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+
+        static void* operator new(size_t bytes) { return FramePool::allocate(bytes); }
+        static void operator delete(void* frame, size_t bytes) { FramePool::release(frame, bytes); }
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Program() = default;
+    explicit Program(Handle handle) : handle_(handle) {}
+    Program(Program&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Program& operator=(Program&& other) noexcept {
+        if (this != &other) {
+            reset();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    Program(const Program&) = delete;
+    Program& operator=(const Program&) = delete;
+    ~Program() { reset(); }
+
+    // Correr hasta la siguiente operación; false si el programa terminó
+    bool resume() {
+        handle_.resume();
+        return !handle_.done();
+    }
+
+    const ProgramOp& current() const { return handle_.promise().op; }
+    void set_result(int value) { handle_.promise().result = value; }
+    explicit operator bool() const { return static_cast<bool>(handle_); }
+
+    // Liberar el frame (fin del proceso o kill)
+    void reset() {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = {};
+        }
+    }
+
+    static std::string op_to_string(ProgramOpKind kind);
+
+    // Programas de ejemplo: "cpu", "interactive", "producer", "consumer",
+    // "memory", "io" o "mix" (los anteriores por turnos). index varía los
+    // parámetros de forma reproducible.
+    static bool make(const std::string& kind, int index, Program& program);
+
+private:
+    Handle handle_;
+};
+
+// Awaitable de una operación: deja la operación en la promesa y suspende
+struct ProgramAwait {
+    ProgramOp op;
+    Program::promise_type* promise = nullptr;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Program::Handle handle) noexcept {
+        promise = &handle.promise();
+        promise->op = op;
+    }
+    int await_resume() const noexcept { return promise->result; }
+};
+
+// Llamadas al sistema disponibles dentro de un programa
+namespace sys {
+    inline ProgramAwait compute(int ticks) { return {{ProgramOpKind::COMPUTE, ticks}}; }
+    inline ProgramAwait access(int page) { return {{ProgramOpKind::ACCESS, page}}; }
+    inline ProgramAwait produce(int item) { return {{ProgramOpKind::PRODUCE, item}}; }
+    inline ProgramAwait consume() { return {{ProgramOpKind::CONSUME, 0}}; }
+    inline ProgramAwait io(int ticks) { return {{ProgramOpKind::IO, ticks}}; }
+    inline ProgramAwait sleep(int ticks) { return {{ProgramOpKind::SLEEP, ticks}}; }
+}
+
+// Buffer acotado simulado que comparten los programas. Las esperas son
+// colas de PIDs bloqueados: no hay hilos ni mutex, todo ocurre en tiempo virtual.
+struct ProgramChannel {
+    int capacity = 8;
+    std::deque<int> items;
+    std::deque<int> waiting_producers;
+    std::deque<int> waiting_consumers;
+    long long produced = 0;
+    long long consumed = 0;
+    long long producer_blocks = 0;
+    long long consumer_blocks = 0;
+};
+
+#endif // PROGRAM_HPP
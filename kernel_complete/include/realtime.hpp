@@ -0,0 +1,91 @@
+#ifndef REALTIME_HPP
+#define REALTIME_HPP
+
+#include "simulation.hpp"
+#include "metrics.hpp"
+#include <string>
+#include <vector>
+
+// Política de la clase de tiempo real
+enum class RtPolicy {
+    EDF,     // Earliest Deadline First: prioridad dinámica por deadline absoluto
+    RM       // Rate Monotonic: prioridad fija, menor período primero
+};
+
+// Tarea periódica: cada período libera un trabajo de wcet ticks que debe
+// terminar antes de release + deadline
+struct PeriodicTask {
+    int id;
+    int period;
+    int wcet;
+    int deadline;                    // Relativo a la liberación (≤ período)
+    SimTime next_release;
+
+    long long released;
+    long long completed;
+    long long missed;                // Terminados después de su deadline
+    LogHistogram response;           // Liberación → fin; lateness = respuesta - deadline
+    double response_sum;
+    double response_sq_sum;
+};
+
+// Clase de tiempo real por encima de Round Robin: mientras haya un trabajo
+// listo ocupa la CPU y el proceso RR en CPU queda en pausa sin perder su
+// quantum. Los trabajos listos viven en un heap ordenado por deadline (EDF)
+// o por período (RM); solo el tope se ejecuta, así que ejecutar no reordena.
+class RealTimeClass {
+public:
+    RealTimeClass(SimulationKernel& kernel, RtPolicy policy, bool verbose = true);
+    ~RealTimeClass();
+
+    // Alta con control de admisión por utilización. EDF: Σ C/min(D,T) ≤ 1.
+    // RM: Σ C/min(D,T) ≤ n(2^(1/n) - 1) (Liu & Layland). force la omite.
+    bool admit(int period, int wcet, int deadline, bool force, std::string& reason);
+
+    bool has_ready() const { return !ready_.empty(); }
+
+    // Ticks que el trabajo del tope puede correr sin que nada lo interrumpa
+    SimTime slice_budget(SimTime limit) const;
+
+    // Próxima liberación (NEVER sin tareas): corta las porciones de RR
+    SimTime next_release() const;
+
+    // Ejecutar el trabajo del tope; al terminar registra su respuesta
+    void execute(SimTime ticks);
+
+    double utilization() const;
+    int get_task_count() const { return static_cast<int>(tasks_.size()); }
+    long long get_busy_ticks() const { return busy_ticks_; }
+    void display_stats(long long total_ticks) const;
+
+    static std::string policy_to_string(RtPolicy policy);
+    static bool parse_policy(const std::string& name, RtPolicy& policy);
+
+private:
+    struct Job {
+        long long key;               // Deadline absoluto (EDF) o período (RM)
+        long long seq;               // Desempate FIFO
+        int task;
+        int remaining;
+        SimTime release;
+        SimTime deadline;
+    };
+
+    SimulationKernel& kernel_;
+    RtPolicy policy_;
+    bool verbose_;
+    std::vector<PeriodicTask> tasks_;
+    std::vector<Job> ready_;         // Heap binario: el tope es el más prioritario
+    long long next_seq_;
+    long long busy_ticks_;
+    long long generation_;           // Descarta liberaciones de una clase anterior
+
+    static bool lower_priority(const Job& a, const Job& b) {
+        if (a.key != b.key) return a.key > b.key;
+        return a.seq > b.seq;
+    }
+    double admission_bound(size_t tasks) const;
+    void handle_release(const Event& event);
+};
+
+#endif // REALTIME_HPP
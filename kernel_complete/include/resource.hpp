@@ -0,0 +1,146 @@
+#ifndef RESOURCE_HPP
+#define RESOURCE_HPP
+
+#include "metrics.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+enum class ResourceMode {
+    DETECT,      // Se concede si alcanza; se rechaza el pedido que cierra un interbloqueo
+    AVOID        // Banquero: solo se concede si el estado resultante es seguro
+};
+
+enum class RequestResult {
+    GRANTED,     // Unidades asignadas
+    WAITING,     // El proceso espera unidades liberadas
+    POSTPONED,   // Alcanzaba, pero el estado no sería seguro (banquero)
+    DEADLOCK,    // Esperar cerraría un interbloqueo: pedido rechazado
+    INVALID      // Recurso inexistente, excede el total o el reclamo, o ya espera
+};
+
+// Recursos de varias instancias que los procesos piden y liberan. El grafo
+// de espera no se guarda aparte: un proceso que espera el recurso R apunta
+// a los que tienen unidades de R. Cada bloqueo agrega solo esas aristas, así
+// que basta buscar desde ellas si se vuelve al que pide (DFS por marcas de
+// época, solo atraviesa procesos que también esperan). Con varias instancias
+// un ciclo no alcanza: se confirma reduciendo el conjunto alcanzado.
+class ResourceManager {
+public:
+    using GrantCallback = std::function<void(int pid)>;
+
+    explicit ResourceManager(ResourceMode mode, bool verbose = true);
+
+    // Avisa cuando un proceso que esperaba obtiene sus unidades
+    void set_grant_callback(GrantCallback callback) { granted_callback_ = std::move(callback); }
+
+    int add_resource(const std::string& name, int units);      // Devuelve el id
+    bool set_claim(int pid, int resource, int max_units);      // Reclamo máximo (banquero)
+
+    RequestResult request(int pid, int resource, int units);
+    // units <= 0 libera todo lo que tiene de resource; devuelve las unidades liberadas
+    int release(int pid, int resource, int units);
+    void release_all(int pid);                                  // Fin o kill: suelta todo y deja de esperar
+
+    int get_resource_count() const { return static_cast<int>(resources_.size()); }
+    bool is_waiting(int pid) const {
+        return pid >= 0 && pid < static_cast<int>(procs_.size()) && procs_[pid].waiting >= 0;
+    }
+    int held_units(int pid, int resource) const;
+    ResourceMode get_mode() const { return mode_; }
+    const LogHistogram& get_detect_nodes() const { return detect_nodes_; }
+
+    // Detección completa sobre todos los procesos (referencia para el bench)
+    bool full_scan();
+
+    void display_state() const;
+    void display_stats() const;
+
+    static std::string mode_to_string(ResourceMode mode);
+    static std::string result_to_string(RequestResult result);
+
+private:
+    struct Units {
+        int id;                                     // Recurso o PID según la lista
+        int units;
+    };
+
+    struct Resource {
+        std::string name;
+        int total;
+        int available;
+        std::vector<Units> holders;                 // (pid, unidades)
+        std::vector<int> waiters;                   // En orden de llegada
+    };
+
+    struct Proc {
+        std::vector<Units> held;                    // (recurso, unidades)
+        std::vector<Units> claims;                  // (recurso, máximo)
+        int waiting = -1;                           // Recurso esperado
+        int wanted = 0;
+        bool postponed = false;                     // Espera por seguridad, no por unidades
+        uint32_t mark = 0;                          // Época de la última búsqueda
+        int holder_slot = -1;                       // Posición en holders_
+    };
+
+    ResourceMode mode_;
+    bool verbose_;
+    GrantCallback granted_callback_;
+    std::vector<Resource> resources_;
+    std::vector<Proc> procs_;
+    std::vector<int> holders_;                      // PIDs con alguna unidad asignada
+    std::vector<int> postponed_;                    // Esperas del banquero (se reintentan al liberar)
+
+    // Búsqueda y reducción: memoria reutilizada entre pedidos
+    uint32_t epoch_;
+    std::vector<int> stack_;
+    std::vector<int> reached_;
+    std::vector<uint32_t> work_epoch_;
+    std::vector<int> work_;
+    std::vector<int> unsatisfied_;
+    struct Demand {
+        int resource;
+        int units;
+        int pid;
+    };
+    std::vector<Demand> demands_;
+    std::vector<int> range_next_;                   // Demandas pendientes por recurso
+    std::vector<int> range_end_;
+
+    // Estadísticas
+    long long requests_;
+    long long granted_;
+    long long waits_;
+    long long postponements_;
+    long long deadlocks_;
+    long long false_cycles_;                        // Ciclos que la reducción resolvió
+    long long safety_checks_;                       // Reducciones completas del banquero
+    long long fast_safe_;                           // Seguros sin reducir: el que pide aún puede terminar
+    LogHistogram detect_nodes_;                     // Procesos visitados por bloqueo
+    LogHistogram check_nodes_;                      // Procesos en cada chequeo de seguridad
+
+    Proc& proc(int pid);
+    static int find(const std::vector<Units>& list, int id);
+    static void add_units(std::vector<Units>& list, int id, int units);
+    static void remove_units(std::vector<Units>& list, int id, int units);
+    void assign(int pid, int resource, int units);
+    void unassign(int pid, int resource, int units);
+    void start_wait(int pid, int resource, int units, bool postponed);
+    void stop_wait(int pid);
+
+    bool closes_deadlock(int pid);
+    bool safe_after(int pid, int resource, int units);
+    bool reduce(const std::vector<int>& procs, bool by_claims);
+    int work(int resource);
+    bool try_grant(int pid);
+    void wake_waiters(int resource);
+    void retry_postponed();
+};
+
+// Costo de detección por pedido con procesos y recursos a escala: la misma
+// carga aleatoria con detección incremental, con el banquero y, en una
+// muestra de pedidos, con una detección completa
+void run_resource_bench(int processes, int resources, long long requests, uint64_t seed);
+
+#endif // RESOURCE_HPP
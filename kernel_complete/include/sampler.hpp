@@ -0,0 +1,126 @@
+#ifndef SAMPLER_HPP
+#define SAMPLER_HPP
+
+#include "simulation.hpp"
+#include "stats_server.hpp"
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Métrica muestreable: se calcula con el snapshot actual, el de la muestra
+// anterior y los ticks transcurridos entre ambos
+struct MetricSpec {
+    const char* name;
+    const char* description;
+    double (*compute)(const StatsSnapshot& now, const StatsSnapshot& prev, double ticks);
+};
+
+struct SamplerConfig {
+    SimTime every = 100;                        // Ticks virtuales entre muestras
+    int capacity = 512;                         // Puntos por nivel en memoria
+    std::vector<std::string> metrics = {"ready", "blocked", "cpu", "faults", "fault%", "free", "buffer"};
+    std::string path;                           // Archivo columnar ("" = solo memoria)
+};
+
+// Opción "clave=valor" de la CLI (every, cap, metrics=a,b,c, file)
+bool parse_sampler_option(const std::string& token, SamplerConfig& config);
+
+// Formato del archivo: [SampleFileHeader][nombres char[16] × métricas] y luego
+// bloques [SampleBlockHeader][columnas float]. Cada bloque es de un nivel y
+// guarda por métrica la columna de medias y, si el nivel agrega, las de
+// mínimos y máximos. Los tiempos son implícitos: first_time + i × step.
+struct SampleFileHeader {
+    char magic[8];                              // "KSIMSTS1"
+    uint32_t version;
+    uint32_t metric_count;
+    int64_t period;                             // Ticks entre muestras crudas
+    uint32_t levels;
+    uint32_t factor;                            // Agregación entre niveles
+};
+
+struct SampleBlockHeader {
+    uint32_t level;
+    uint32_t rows;
+    int64_t first_time;
+    int64_t step;
+};
+
+// Muestreo periódico en tiempo virtual: un evento SAMPLE cada every ticks
+// toma un snapshot de contadores (StatsServer::capture, O(1)) y guarda las
+// métricas pedidas en anillos de tamaño fijo de tres resoluciones: cruda,
+// ×10 y ×100 (media, mínimo y máximo de cada grupo de 10 puntos del nivel
+// anterior). Cada nivel se vuelca al archivo en bloques columnares a medida
+// que se llenan, así la historia larga queda en disco sin crecer en memoria.
+class MetricsSampler {
+public:
+    static constexpr int LEVELS = 3;
+    static constexpr int FACTOR = 10;
+    static constexpr int BLOCK_ROWS = 256;
+
+    using Source = std::function<StatsSnapshot()>;
+
+    MetricsSampler(SimulationKernel& kernel, Source source, const SamplerConfig& config);
+    ~MetricsSampler();
+
+    bool is_file_ok() const { return config_.path.empty() || static_cast<bool>(file_); }
+    void flush();                               // Bloques parciales al archivo
+
+    void display(int level) const;              // Sparkline y rango por métrica
+    void display_stats() const;
+
+    static const std::vector<MetricSpec>& catalog();
+    static const MetricSpec* find_metric(const std::string& name);
+    static void list_metrics();
+
+private:
+    // Anillo columnar de un nivel: columna (métrica, estadística) contigua
+    struct Level {
+        std::vector<SimTime> times;
+        std::vector<float> values;              // [(métrica × 3 + stat) × capacity + slot]
+        int head = 0;                           // Próximo slot
+        int size = 0;
+        int unwritten = 0;                      // Puntos aún no volcados al archivo
+        long long points = 0;
+
+        // Acumulador del grupo de FACTOR puntos que formará un punto del nivel siguiente
+        std::vector<double> sum;
+        std::vector<float> min;
+        std::vector<float> max;
+        int pending = 0;
+    };
+
+    enum Stat { MEAN = 0, MIN = 1, MAX = 2 };
+
+    SimulationKernel& kernel_;
+    Source source_;
+    SamplerConfig config_;
+    std::vector<const MetricSpec*> metrics_;
+    Level levels_[LEVELS];
+    StatsSnapshot previous_;
+    long long generation_;                      // Descarta muestras de un muestreador anterior
+
+    std::ofstream file_;
+    long long blocks_written_;
+    long long bytes_written_;
+    double sample_seconds_;                     // Costo acumulado de las muestras
+
+    float& cell(Level& level, size_t metric, Stat stat, int slot) {
+        return level.values[(metric * 3 + stat) * config_.capacity + slot];
+    }
+    float cell(const Level& level, size_t metric, Stat stat, int slot) const {
+        return level.values[(metric * 3 + stat) * config_.capacity + slot];
+    }
+    int slot_of(const Level& level, int age) const;   // age 0 = el más viejo en el anillo
+
+    void handle_sample(const Event& event);
+    void push(int level, SimTime time, const float* mean, const float* min, const float* max);
+    void write_block(int level, int rows);
+};
+
+// Lee un archivo del muestreador: con csv escribe el nivel completo como
+// CSV (tiempo y columnas por métrica), si no muestra una tabla resumida
+bool read_sample_file(const std::string& path, int level, const std::string& csv);
+
+#endif // SAMPLER_HPP
@@ -2,43 +2,246 @@
 #define SCHEDULER_HPP
 
 #include "process.hpp"
+#include "simulation.hpp"
+#include "metrics.hpp"
+#include "program.hpp"
 #include <vector>
 #include <queue>
 #include <memory>
 
+class MemoryManager;
+class WorkloadGenerator;
+class DeviceManager;
+class RealTimeClass;
+class GroupScheduler;
+class QuantumTuner;
+class ResourceManager;
+class CheckpointWriter;
+class CheckpointReader;
+
+// Fuente de llegadas en streaming (carga sintética, trazas).
+// El scheduler pide la siguiente llegada solo cuando procesa la anterior.
+class ArrivalSource {
+public:
+    virtual ~ArrivalSource() = default;
+
+    // Devuelve false cuando no quedan llegadas
+    virtual bool next_arrival(SimTime& time, int& burst) = 0;
+};
+
 class RoundRobinScheduler {
 public:
-    RoundRobinScheduler(int quantum);
-    
+    // Sin kernel externo, el scheduler crea el suyo propio
+    RoundRobinScheduler(int quantum, SimulationKernel* kernel = nullptr);
+
     // Gestión de procesos
     void create_process(int burst_time);
     void kill_process(int pid);
+    int fork_process(int pid);                           // Hijo con la ráfaga restante; -1 si no se puede
+    void submit_arrival(SimTime time, int burst_time);   // Llegada programada
+    void set_arrival_source(ArrivalSource* source);
     
+    // Procesos como corrutinas: al quedarse sin ráfaga el scheduler reanuda
+    // el programa y atiende la siguiente operación que cede (CPU, página,
+    // buffer, E/S, sleep). Devuelve el PID.
+    int create_program(Program program);
+    void set_channel_capacity(int capacity);
+    int get_live_programs() const { return live_programs_; }
+    long long get_program_resumes() const { return program_resumes_; }
+    void show_program_stats() const;
+
     // Ejecución
     void tick();           // Ejecutar 1 unidad de tiempo
     void run(int n);       // Ejecutar N unidades
+    void run_until(SimTime limit);  // Avanzar por eventos hasta limit
+
+    // Modo acoplado CPU+memoria: el proceso en CPU emite referencias
+    // y un page fault lo bloquea durante fault_service_time ticks
+    void enable_paging(MemoryManager* memory, WorkloadGenerator* references,
+                       int fault_service_time, int refs_per_tick);
+    void disable_paging();
+    bool is_paging_enabled() const { return memory_ != nullptr; }
+    
+    // E/S: al agotar su ráfaga de CPU el proceso se bloquea en un disco
+    // hasta la interrupción de fin de E/S
+    void enable_io(DeviceManager* devices);
+    void disable_io();
+    bool is_io_enabled() const { return devices_ != nullptr; }
+    
+    // Tiempo real: mientras haya un trabajo periódico listo la CPU es suya
+    void enable_realtime(RealTimeClass* realtime) { realtime_ = realtime; }
+    void disable_realtime() { realtime_ = nullptr; }
+    bool is_realtime_enabled() const { return realtime_ != nullptr; }
+
+    // Grupos: la cola de listos pasa a la jerarquía de grupos (fair share
+    // por peso y quota por período); al desactivar vuelve a ser FIFO
+    void enable_groups(GroupScheduler* groups);
+    void disable_groups();
+    bool is_groups_enabled() const { return groups_ != nullptr; }
+    bool move_to_group(int pid, int group);
+
+    // Quantum ajustable en caliente y costo de cambio de contexto: al
+    // despachar un proceso distinto del último la CPU pierde switch_cost
+    // ticks (cuentan como ociosos). Con un tuner el quantum lo elige él.
+    void set_quantum(int quantum);
+    void set_switch_cost(int ticks) { switch_cost_ = ticks; }
+    int get_switch_cost() const { return switch_cost_; }
+    long long get_switches() const { return switches_; }
+    long long get_switch_ticks() const { return switch_ticks_; }
+    void enable_tuner(QuantumTuner* tuner) { tuner_ = tuner; }
+    void disable_tuner() { tuner_ = nullptr; }
+    bool is_tuner_enabled() const { return tuner_ != nullptr; }
+
+    // Recursos: un pedido que queda esperando bloquea al proceso hasta que
+    // se le conceden las unidades; al terminar o con kill suelta todo.
+    // Solo pide el proceso en CPU o uno listo (este se bloquea al despacharlo).
+    void enable_resources(ResourceManager* resources);
+    void disable_resources();
+    void wait_for_resource(int pid);
+    int get_resource_blocked() const { return resource_blocked_count_; }
+
+    // Checkpoint: procesos, cola de listos, contadores, métricas y kernel propio.
+    // El acoplamiento con memoria se guarda como parámetros; E/S y programas
+    // vivos (frames de corrutina) no se guardan.
+    void save_state(CheckpointWriter& writer) const;
+    static std::unique_ptr<RoundRobinScheduler> from_checkpoint(const CheckpointReader& reader,
+                                                                bool& paging);
+    int get_fault_service_time() const { return fault_service_time_; }
+    int get_refs_per_tick() const { return refs_per_tick_; }
     
     // Visualización
-    void list_processes() const;
+    void list_processes();
     void show_stats() const;
-    
+    void show_utilization_stats() const;
+
     // Getters
-    int get_current_time() const { return current_time_; }
+    SimTime get_current_time() const { return kernel_->now(); }
     int get_quantum() const { return quantum_; }
+    int get_running_pid() const { return running_pid_; }
+    size_t get_ready_count() const;
+    int get_process_count() const { return static_cast<int>(table_.size()); }
+    int get_blocked_count() const {
+        return blocked_count_ + io_blocked_count_ + program_sleeping_ + resource_blocked_count_;
+    }
+    SimulationKernel& get_kernel() { return *kernel_; }
+    const SchedulerMetrics& get_metrics() const { return metrics_; }
+    const ProcessTable& get_table() const { return table_; }
+    long long get_busy_ticks() const { return busy_ticks_; }
+    long long get_idle_ticks() const { return idle_ticks_; }
+
+    // Modo silencioso para simulaciones masivas (sin trazas por evento)
+    void set_verbose(bool verbose) { verbose_ = verbose; }
+    bool is_verbose() const { return verbose_; }
 
 private:
     int quantum_;                                    // Quantum de Round Robin
     int current_quantum_;                            // Quantum usado por proceso actual
-    std::vector<std::shared_ptr<Process>> processes_; // Todos los procesos
-    std::queue<std::shared_ptr<Process>> ready_queue_; // Cola de listos
-    std::shared_ptr<Process> current_process_;       // Proceso en CPU
+    int slice_quantum_;                              // Quantum del despacho en curso
+    ProcessTable table_;                             // PCBs en estructura de arreglos
+    std::queue<int> ready_queue_;                    // Cola de listos (PIDs)
+    int running_pid_;                                // Proceso en CPU (-1 = ninguno)
     int next_pid_;                                   // Siguiente PID a asignar
-    int current_time_;                               // Reloj del sistema
+    bool verbose_;                                   // Imprimir trazas por evento
+    int active_processes_;                           // Nivel de multiprogramación
+    int blocked_count_;                              // BLOCKED por page fault
+    int io_blocked_count_;                           // BLOCKED esperando E/S
+    int resource_blocked_count_;                     // BLOCKED esperando un recurso
+
+    // Reloj global: el tiempo lo lleva el núcleo de eventos
+    std::unique_ptr<SimulationKernel> own_kernel_;
+    SimulationKernel* kernel_;
+    bool slice_in_flight_;                           // Hay un SLICE_END pendiente
+    bool event_mode_;                                // Espera medida por timestamps
+    ArrivalSource* arrival_source_;
+    bool stream_pending_;                            // Hay un STREAM_ARRIVAL pendiente
+
+    // Acoplamiento con memoria
+    MemoryManager* memory_;
+    WorkloadGenerator* references_;
+    int fault_service_time_;                         // Ticks para servir un fault
+    int refs_per_tick_;                              // Referencias por tick de CPU
+    
+    // Subsistema de E/S
+    DeviceManager* devices_;
     
+    // Clase de tiempo real (prioridad sobre Round Robin)
+    RealTimeClass* realtime_;
+
+    // Grupos de procesos (nullptr = cola FIFO única)
+    GroupScheduler* groups_;
+
+    // Recursos con espera (nullptr = sin gestor)
+    ResourceManager* resources_;
+
+    // Cambio de contexto y ajuste del quantum
+    QuantumTuner* tuner_;
+    int switch_cost_;
+    int switch_left_;                                // Ticks de cambio pendientes del despacho
+    int last_pid_;                                   // Último proceso que tuvo la CPU
+    long long switches_;
+    long long switch_ticks_;
+
+    // Utilización de CPU
+    long long busy_ticks_;                           // Ticks con trabajo útil
+    long long idle_ticks_;                           // Ticks sin trabajo útil
+    long long paging_idle_ticks_;                    // Ociosos por culpa de faults
+    long long io_idle_ticks_;                        // Ociosos con procesos en E/S
+    long long fault_blocks_;                         // Bloqueos por fault
+    long long mpl_sum_;                              // Suma de MPL por tick
+    
+    // Respuesta, espera, turnaround y slowdown (percentiles, O(1) por evento)
+    SchedulerMetrics metrics_;
+    
+    // Programas: corrutina por PID (vacía = proceso definido por su ráfaga)
+    std::vector<Program> programs_;
+    ProgramChannel channel_;
+    int live_programs_;
+    int program_sleeping_;                           // BLOCKED en sleep o en el buffer
+    long long program_resumes_;
+    long long program_ops_[static_cast<int>(ProgramOpKind::COUNT)];
+
     // Helpers internos
+    SimTime now() const { return kernel_->now(); }
     void update_wait_times();
     void dispatch_next();
     void preempt_current();
+    Process running() { return table_.get(running_pid_); }
+    void make_ready(int pid);
+    void wake(int pid);
+    void block(int pid);
+    void block_for_fault(int pid, SimTime until);
+    int fault_service() const;                       // Ticks del último fault
+    void block_for_io(int pid);
+    bool io_due();
+    bool blocked_by_fault(int pid);
+    void block_for_resource(int pid);
+    void handle_resource_grant(int pid);
+    bool skip_on_dispatch(int pid);
+    void handle_io_completion(int pid);
+    void account_idle(SimTime ticks);
+    bool has_ready() const;
+    void charge_group(long long ticks);
+    void release_cpu(bool preempted);
+    void finish_process(int pid);
+    void complete_burst();
+    
+    // Programas
+    bool is_program(int pid) const {
+        return pid >= 1 && pid <= static_cast<int>(programs_.size()) && programs_[pid - 1];
+    }
+    void resume_program(int pid);
+    void program_wait(int pid);
+    int pop_waiter(std::deque<int>& waiters);
+    void handle_program_wake(const Event& event);
+    bool issue_references();
+    void pull_next_arrival();
+
+    // Modo por eventos
+    void start_slice(SimTime limit);
+    void start_realtime_slice(SimTime limit);
+    void handle_slice_end(const Event& event);
+    void handle_fault_service(const Event& event);
+    void flush_ready_waits();
 };
 
 #endif // SCHEDULER_HPP
@@ -0,0 +1,136 @@
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include <array>
+#include <climits>
+#include <functional>
+#include <vector>
+
+// Tiempo virtual global de la simulación (en ticks)
+using SimTime = long long;
+
+// Tipos de evento que los módulos pueden programar. En un mismo instante se
+// procesan en este orden (igual que el bucle por ticks): primero termina la
+// porción de CPU, luego llegan procesos y al final se atienden interrupciones.
+enum class EventType {
+    SLICE_END,       // Fin de porción de CPU: quantum, término o fault
+    ARRIVAL,         // Llegada de proceso (data = burst)
+    STREAM_ARRIVAL,  // Llegada desde una fuente en streaming (data = burst)
+    FAULT_SERVICE,   // Fault servido: el proceso vuelve a READY
+    IO_COMPLETION,   // Interrupción de fin de E/S
+    PROGRAM_WAKE,    // Programa despierta: sleep vencido o buffer disponible
+    RT_RELEASE,      // Liberación de un trabajo periódico de tiempo real
+    GROUP_REFILL,    // Fin del período de un grupo sin cuota: vuelve a competir
+    SAMPLE,          // Muestreo periódico de métricas (después del resto del instante)
+    CUSTOM,          // Libre para extensiones
+    COUNT
+};
+
+struct Event {
+    SimTime time;
+    long long seq;   // Orden de inserción: desempate FIFO determinista por tipo
+    EventType type;
+    int pid;
+    long long data;
+};
+
+class CheckpointWriter;
+class CheckpointReader;
+
+// Conjunto de eventos pendientes: pairing heap sobre un pool de nodos.
+// push O(1), pop O(log n) amortizado, sin reservas de memoria por evento.
+class EventQueue {
+public:
+    void push(const Event& event);
+    const Event& top() const { return nodes_[root_].event; }
+    void pop();
+    bool empty() const { return root_ == -1; }
+    size_t size() const { return size_; }
+    void clear();
+    
+    // Eventos pendientes en orden arbitrario (para checkpoints)
+    std::vector<Event> snapshot() const;
+
+private:
+    struct Node {
+        Event event;
+        int child;
+        int sibling;
+    };
+
+    std::vector<Node> nodes_;
+    std::vector<int> free_nodes_;
+    std::vector<int> scratch_;       // Reutilizado en la fusión de dos pasadas
+    int root_ = -1;
+    size_t size_ = 0;
+
+    static bool earlier(const Event& a, const Event& b) {
+        if (a.time != b.time) return a.time < b.time;
+        if (a.type != b.type) return a.type < b.type;
+        return a.seq < b.seq;
+    }
+    int meld(int a, int b);
+};
+
+// Núcleo de simulación de eventos discretos con reloj virtual compartido
+class SimulationKernel {
+public:
+    using Handler = std::function<void(const Event&)>;
+    static constexpr SimTime NEVER = LLONG_MAX;
+
+    SimulationKernel();
+
+    SimTime now() const { return now_; }
+
+    // Programar un evento (nunca en el pasado)
+    void schedule(SimTime at, EventType type, int pid = -1, long long data = 0);
+    void schedule_after(SimTime delay, EventType type, int pid = -1, long long data = 0) {
+        schedule(now_ + delay, type, pid, data);
+    }
+
+    // Registrar el manejador de un tipo de evento
+    void on(EventType type, Handler handler);
+
+    // Observador periódico (p. ej. publicar estadísticas): se llama cada
+    // every eventos procesados o avances del reloj. nullptr lo quita.
+    void set_observer(std::function<void()> observer, long long every);
+
+    // Ejecución
+    SimTime next_time() const { return pending_.empty() ? NEVER : pending_.top().time; }
+    const Event& peek() const { return pending_.top(); }
+    bool step();                      // Procesa un evento; false si no hay
+    void run_until(SimTime limit);    // Procesa eventos <= limit y avanza el reloj
+    void advance_to(SimTime time);    // Procesa eventos < time y avanza el reloj
+
+    void display_stats() const;
+    
+    // Checkpoint: reloj, secuencia y eventos pendientes (los handlers no se guardan)
+    void save_state(CheckpointWriter& writer) const;
+    bool load_state(const CheckpointReader& reader);
+    
+    long long get_events_processed() const { return events_processed_; }
+    size_t get_pending() const { return pending_.size(); }
+
+private:
+    SimTime now_;
+    long long next_seq_;
+    EventQueue pending_;
+    std::array<Handler, static_cast<size_t>(EventType::COUNT)> handlers_;
+
+    // Estadísticas
+    long long events_processed_;
+    size_t peak_pending_;
+
+    std::function<void()> observer_;
+    long long observe_every_;
+    long long since_observe_;
+
+    void notify() {
+        if (observer_ && ++since_observe_ >= observe_every_) {
+            since_observe_ = 0;
+            observer_();
+        }
+    }
+};
+
+#endif // SIMULATION_HPP
@@ -0,0 +1,583 @@
+#ifndef STATIC_SIM_HPP
+#define STATIC_SIM_HPP
+
+#include "workload.hpp"
+#include "metrics.hpp"
+#include "utils.hpp"
+#include <array>
+#include <chrono>
+#include <deque>
+#include <queue>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Núcleo de simulación especializado en compilación: política de
+// planificación, reemplazo, destino de trazas y nivel de estadísticas son
+// parámetros de plantilla. Lo desactivado no genera código (if constexpr y
+// miembros vacíos con [[no_unique_address]]) y el bucle caliente no tiene
+// llamadas virtuales ni switch por política. Modela lo mismo que el modo
+// acoplado CPU+memoria del scheduler: llegadas de Poisson, porciones de CPU
+// con refs_per_tick referencias por tick y bloqueo de fault_service ticks
+// por fault. Como las llegadas y los despertares por fault llegan en orden,
+// no hace falta cola de eventos: se mezclan dos flujos ya ordenados.
+
+// Parámetros de una corrida (los que no son de la configuración compilada)
+struct StaticParams {
+    int quantum = 4;
+    int frames = 16;
+    int fault_service = 5;
+    int refs_per_tick = 1;
+    SimTime ticks = 100000;
+    WorkloadConfig workload;
+};
+
+// Opción "clave=valor" de la CLI (q, frames, fault, refs)
+bool parse_static_option(const std::string& token, StaticParams& params);
+
+struct StaticResult {
+    long long arrivals;
+    long long completed;
+    long long busy_ticks;
+    long long idle_ticks;
+    long long dispatches;              // Desde COUNTERS
+    long long accesses;
+    long long page_faults;
+    double response_mean;              // Desde FULL
+    double response_p99;
+    double turnaround_mean;
+    double turnaround_p99;
+    double jain;
+    double seconds;
+};
+
+enum class StatsLevel {
+    NONE,        // Solo terminados y ticks de CPU
+    COUNTERS,    // + despachos, accesos y faults
+    FULL         // + histogramas de respuesta y turnaround (SchedulerMetrics)
+};
+
+namespace static_sim {
+
+    struct Empty {};
+
+    // ---- Planificación -------------------------------------------------
+
+    // Cola FIFO circular sobre un vector (sin nodos por elemento)
+    class RingQueue {
+    public:
+        bool empty() const { return size_ == 0; }
+        size_t size() const { return size_; }
+        void push(int pid) {
+            if (size_ == slots_.size()) grow();
+            slots_[(head_ + size_) & (slots_.size() - 1)] = pid;
+            size_++;
+        }
+        int pop() {
+            int pid = slots_[head_];
+            head_ = (head_ + 1) & (slots_.size() - 1);
+            size_--;
+            return pid;
+        }
+
+    private:
+        std::vector<int> slots_ = std::vector<int>(64);
+        size_t head_ = 0;
+        size_t size_ = 0;
+
+        void grow() {
+            std::vector<int> bigger(slots_.size() * 2);
+            for (size_t i = 0; i < size_; i++) {
+                bigger[i] = slots_[(head_ + i) & (slots_.size() - 1)];
+            }
+            slots_.swap(bigger);
+            head_ = 0;
+        }
+    };
+
+    struct RoundRobin {
+        static constexpr const char* NAME = "RR";
+        static constexpr bool PREEMPTIVE = true;
+        RingQueue queue;
+        bool empty() const { return queue.empty(); }
+        void push(int pid, int) { queue.push(pid); }
+        int pop() { return queue.pop(); }
+    };
+
+    // Sin expropiación: cada proceso corre hasta terminar o hasta un fault
+    struct Fcfs {
+        static constexpr const char* NAME = "FCFS";
+        static constexpr bool PREEMPTIVE = false;
+        RingQueue queue;
+        bool empty() const { return queue.empty(); }
+        void push(int pid, int) { queue.push(pid); }
+        int pop() { return queue.pop(); }
+    };
+
+    // Menor ráfaga restante primero, sin expropiación (desempate por PID)
+    struct ShortestJob {
+        static constexpr const char* NAME = "SJF";
+        static constexpr bool PREEMPTIVE = false;
+        std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>,
+                            std::greater<std::pair<int, int>>> heap;
+        bool empty() const { return heap.empty(); }
+        void push(int pid, int remaining) { heap.emplace(remaining, pid); }
+        int pop() {
+            int pid = heap.top().second;
+            heap.pop();
+            return pid;
+        }
+    };
+
+    // ---- Reemplazo -----------------------------------------------------
+
+    // Sin memoria: la CPU no emite referencias
+    struct NoPaging {
+        static constexpr const char* NAME = "-";
+        static constexpr bool ENABLED = false;
+        void init(int) {}
+        void on_hit(int) {}
+        void on_load(int) {}
+        int victim() { return 0; }
+    };
+
+    // Lista doblemente enlazada intrusiva sobre los frames: O(1) en todo
+    class FrameList {
+    public:
+        void init(int frames) {
+            prev_.assign(frames + 1, frames);
+            next_.assign(frames + 1, frames);
+            sentinel_ = frames;
+        }
+        void push_back(int frame) {
+            int last = prev_[sentinel_];
+            next_[last] = frame;
+            prev_[frame] = last;
+            next_[frame] = sentinel_;
+            prev_[sentinel_] = frame;
+        }
+        void unlink(int frame) {
+            next_[prev_[frame]] = next_[frame];
+            prev_[next_[frame]] = prev_[frame];
+        }
+        int pop_front() {
+            int frame = next_[sentinel_];
+            unlink(frame);
+            return frame;
+        }
+
+    private:
+        std::vector<int> prev_;
+        std::vector<int> next_;
+        int sentinel_ = 0;
+    };
+
+    struct FifoReplacement {
+        static constexpr const char* NAME = "FIFO";
+        static constexpr bool ENABLED = true;
+        FrameList order;
+        void init(int frames) { order.init(frames); }
+        void on_hit(int) {}
+        void on_load(int frame) { order.push_back(frame); }
+        int victim() { return order.pop_front(); }
+    };
+
+    struct LruReplacement {
+        static constexpr const char* NAME = "LRU";
+        static constexpr bool ENABLED = true;
+        FrameList order;
+        void init(int frames) { order.init(frames); }
+        void on_hit(int frame) {
+            order.unlink(frame);
+            order.push_back(frame);
+        }
+        void on_load(int frame) { order.push_back(frame); }
+        int victim() { return order.pop_front(); }
+    };
+
+    struct ClockReplacement {
+        static constexpr const char* NAME = "CLOCK";
+        static constexpr bool ENABLED = true;
+        std::vector<unsigned char> referenced;
+        int hand = 0;
+        void init(int frames) { referenced.assign(frames, 0); }
+        void on_hit(int frame) { referenced[frame] = 1; }
+        void on_load(int frame) { referenced[frame] = 1; }
+        int victim() {
+            // Solo se pide con todos los frames ocupados
+            while (referenced[hand]) {
+                referenced[hand] = 0;
+                hand = hand + 1 == static_cast<int>(referenced.size()) ? 0 : hand + 1;
+            }
+            int frame = hand;
+            hand = hand + 1 == static_cast<int>(referenced.size()) ? 0 : hand + 1;
+            return frame;
+        }
+    };
+
+    // ---- Trazas --------------------------------------------------------
+
+    enum class TraceKind { ARRIVAL, DISPATCH, PREEMPT, FAULT, WAKE, FINISH };
+
+    struct TraceRecord {
+        SimTime time;
+        TraceKind kind;
+        int pid;
+        long long data;
+    };
+
+    const char* trace_kind_to_string(TraceKind kind);
+
+    struct NullSink {
+        static constexpr const char* NAME = "nula";
+        static constexpr bool ENABLED = false;
+        void record(SimTime, TraceKind, int, long long) {}
+        void display() const {}
+    };
+
+    // Últimos CAPACITY eventos en un buffer circular fijo (para ver el final
+    // de una corrida larga sin pagar E/S por evento)
+    template <size_t CAPACITY>
+    struct RingSink {
+        static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY debe ser potencia de 2");
+        static constexpr const char* NAME = "anillo";
+        static constexpr bool ENABLED = true;
+        std::array<TraceRecord, CAPACITY> records{};
+        unsigned long long written = 0;
+
+        void record(SimTime time, TraceKind kind, int pid, long long data) {
+            records[written & (CAPACITY - 1)] = TraceRecord{time, kind, pid, data};
+            written++;
+        }
+        void display(size_t last = 16) const {
+            size_t shown = static_cast<size_t>(std::min<unsigned long long>({written, CAPACITY, last}));
+            std::cout << " Últimos " << shown << " de " << written << " eventos:" << std::endl;
+            for (unsigned long long i = written - shown; i < written; i++) {
+                const TraceRecord& r = records[i & (CAPACITY - 1)];
+                std::cout << "   [t=" << r.time << "] " << trace_kind_to_string(r.kind)
+                          << " P" << r.pid << " (" << r.data << ")" << std::endl;
+            }
+        }
+    };
+
+    struct ConsoleSink {
+        static constexpr const char* NAME = "consola";
+        static constexpr bool ENABLED = true;
+        void record(SimTime time, TraceKind kind, int pid, long long data);
+        void display() const {}
+    };
+
+    // ---- Estadísticas --------------------------------------------------
+
+    struct Counters {
+        long long dispatches = 0;
+        long long accesses = 0;
+        long long page_faults = 0;
+    };
+
+} // namespace static_sim
+
+template <class Sched, class Repl, class Sink, StatsLevel LEVEL>
+class StaticSimulator {
+public:
+    static constexpr bool PAGING = Repl::ENABLED;
+    static constexpr bool COUNTERS = LEVEL != StatsLevel::NONE;
+    static constexpr bool FULL = LEVEL == StatsLevel::FULL;
+
+    explicit StaticSimulator(const StaticParams& params)
+        : params_(params),
+          workload_(params.workload),
+          pages_(params.workload.pages_per_process) {
+        if constexpr (PAGING) {
+            repl_.init(params_.frames);
+            frame_owner_.assign(params_.frames, -1);
+            for (int f = params_.frames - 1; f >= 0; f--) free_frames_.push_back(f);
+        }
+    }
+
+    StaticResult run();
+    const Sink& get_sink() const { return sink_; }
+
+private:
+    struct Task {
+        int burst;
+        int remaining;
+        SimTime arrival;
+        SimTime ready_since;
+        long long wait;
+        int slot;                      // Page table en uso (solo con paging)
+        bool dispatched;
+    };
+
+    StaticParams params_;
+    WorkloadGenerator workload_;
+    int pages_;
+    Sched sched_;
+    [[no_unique_address]] Repl repl_;
+    [[no_unique_address]] Sink sink_;
+    [[no_unique_address]] std::conditional_t<COUNTERS, static_sim::Counters, static_sim::Empty> counters_;
+    [[no_unique_address]] std::conditional_t<FULL, SchedulerMetrics, static_sim::Empty> metrics_;
+
+    std::vector<Task> tasks_;          // Indexado por PID - 1
+    std::deque<std::pair<SimTime, int>> wakeups_;   // Fin de fault: en orden por construcción
+
+    // Memoria: page tables planas por slot; los frames de un proceso
+    // terminado quedan ocupados hasta que el reemplazo los elija
+    std::vector<int> page_frame_;
+    std::vector<int> frame_owner_;     // Entrada de page_frame_ (-1 = huérfano o libre)
+    std::vector<int> free_frames_;
+    std::vector<int> free_slots_;
+
+    // Llegada pendiente del generador
+    bool more_arrivals_ = false;
+    SimTime next_arrival_ = 0;
+    int next_burst_ = 0;
+    long long arrivals_ = 0;
+    long long completed_ = 0;
+    long long busy_ticks_ = 0;
+    long long idle_ticks_ = 0;
+
+    void trace(SimTime time, static_sim::TraceKind kind, int pid, long long data) {
+        if constexpr (Sink::ENABLED) {
+            sink_.record(time, kind, pid, data);
+        }
+    }
+
+    void make_ready(int pid, SimTime time) {
+        Task& task = tasks_[pid - 1];
+        task.ready_since = time;
+        sched_.push(pid, task.remaining);
+    }
+
+    void admit(SimTime time, int burst) {
+        Task task{burst, burst, time, time, 0, -1, false};
+        if constexpr (PAGING) {
+            if (free_slots_.empty()) {
+                task.slot = static_cast<int>(page_frame_.size() / pages_);
+                page_frame_.resize(page_frame_.size() + pages_, -1);
+            } else {
+                task.slot = free_slots_.back();
+                free_slots_.pop_back();
+            }
+        }
+        tasks_.push_back(task);
+        arrivals_++;
+        int pid = static_cast<int>(tasks_.size());
+        trace(time, static_sim::TraceKind::ARRIVAL, pid, burst);
+        make_ready(pid, time);
+        more_arrivals_ = workload_.next_arrival(next_arrival_, next_burst_);
+    }
+
+    // Entregar llegadas y despertares hasta limit (incluido o no), en orden
+    // de tiempo; a igual tiempo la llegada va primero, como en el kernel
+    void deliver(SimTime limit, bool inclusive) {
+        for (;;) {
+            SimTime wake = wakeups_.empty() ? SimulationKernel::NEVER : wakeups_.front().first;
+            SimTime arrival = more_arrivals_ ? next_arrival_ : SimulationKernel::NEVER;
+            SimTime next = std::min(wake, arrival);
+            if (next > limit || (next == limit && !inclusive)) {
+                return;
+            }
+            if (arrival <= wake) {
+                admit(arrival, next_burst_);
+            } else {
+                int pid = wakeups_.front().second;
+                wakeups_.pop_front();
+                trace(wake, static_sim::TraceKind::WAKE, pid, 0);
+                make_ready(pid, wake);
+            }
+        }
+    }
+
+    // true = acierto. Un fallo carga la página (frame libre o víctima)
+    bool access(int slot, int page) {
+        if constexpr (COUNTERS) counters_.accesses++;
+        int entry = slot * pages_ + page;
+        int frame = page_frame_[entry];
+        if (frame >= 0) {
+            repl_.on_hit(frame);
+            return true;
+        }
+        if (!free_frames_.empty()) {
+            frame = free_frames_.back();
+            free_frames_.pop_back();
+        } else {
+            frame = repl_.victim();
+            if (frame_owner_[frame] >= 0) {
+                page_frame_[frame_owner_[frame]] = -1;
+            }
+        }
+        frame_owner_[frame] = entry;
+        page_frame_[entry] = frame;
+        repl_.on_load(frame);
+        if constexpr (COUNTERS) counters_.page_faults++;
+        return false;
+    }
+
+    void finish(int pid, SimTime now) {
+        Task& task = tasks_[pid - 1];
+        completed_++;
+        trace(now, static_sim::TraceKind::FINISH, pid, now - task.arrival);
+        if constexpr (FULL) {
+            metrics_.record_completion(task.burst, task.wait, now - task.arrival);
+        }
+        if constexpr (PAGING) {
+            // La page table se recicla; sus frames quedan huérfanos pero ocupados
+            int base = task.slot * pages_;
+            for (int page = 0; page < pages_; page++) {
+                int frame = page_frame_[base + page];
+                if (frame >= 0) {
+                    frame_owner_[frame] = -1;
+                    page_frame_[base + page] = -1;
+                }
+            }
+            free_slots_.push_back(task.slot);
+        }
+    }
+};
+
+template <class Sched, class Repl, class Sink, StatsLevel LEVEL>
+StaticResult StaticSimulator<Sched, Repl, Sink, LEVEL>::run() {
+    using static_sim::TraceKind;
+    auto start = std::chrono::steady_clock::now();
+
+    const SimTime limit = params_.ticks;
+    const int quantum = Sched::PREEMPTIVE ? params_.quantum : INT_MAX;
+    more_arrivals_ = workload_.next_arrival(next_arrival_, next_burst_);
+
+    SimTime now = 0;
+    int running = -1;
+    int used = 0;                      // Ticks del quantum consumidos
+    while (now < limit) {
+        deliver(now, true);
+
+        if (running < 0) {
+            if (sched_.empty()) {
+                // CPU ociosa hasta la próxima llegada o despertar
+                SimTime next = std::min({limit,
+                                         more_arrivals_ ? next_arrival_ : SimulationKernel::NEVER,
+                                         wakeups_.empty() ? SimulationKernel::NEVER : wakeups_.front().first});
+                idle_ticks_ += next - now;
+                now = next;
+                continue;
+            }
+            running = sched_.pop();
+            used = 0;
+            Task& task = tasks_[running - 1];
+            task.wait += now - task.ready_since;
+            if constexpr (COUNTERS) counters_.dispatches++;
+            if constexpr (FULL) {
+                if (!task.dispatched) metrics_.record_response(now - task.arrival);
+            }
+            task.dispatched = true;
+            trace(now, TraceKind::DISPATCH, running, task.remaining);
+        }
+
+        Task& task = tasks_[running - 1];
+        SimTime budget = std::min<SimTime>({static_cast<SimTime>(quantum - used),
+                                            static_cast<SimTime>(task.remaining), limit - now});
+
+        // Las referencias de toda la porción se emiten ya: nadie más toca la memoria
+        SimTime executed = budget;
+        int faulted = 0;
+        if constexpr (PAGING) {
+            for (SimTime i = 0; i < budget && !faulted; i++) {
+                for (int r = 0; r < params_.refs_per_tick; r++) {
+                    if (!access(task.slot, workload_.next_page(running))) {
+                        executed = i;
+                        faulted = 1;
+                        break;
+                    }
+                }
+            }
+        }
+
+        now += executed + faulted;
+        busy_ticks_ += executed;
+        idle_ticks_ += faulted;        // El tick del fault no hace trabajo útil
+        task.remaining -= static_cast<int>(executed);
+        used += static_cast<int>(executed);
+
+        if (faulted) {
+            trace(now, TraceKind::FAULT, running, task.remaining);
+            wakeups_.emplace_back(now + params_.fault_service, running);
+            running = -1;
+        } else if (task.remaining == 0) {
+            finish(running, now);
+            running = -1;
+        } else if (used >= quantum) {
+            // Los que llegaron durante la porción entran antes que el expropiado.
+            // admit() puede reubicar tasks_: task no sirve después de deliver()
+            int remaining = task.remaining;
+            deliver(now, false);
+            trace(now, TraceKind::PREEMPT, running, remaining);
+            make_ready(running, now);
+            running = -1;
+        }
+    }
+
+    StaticResult result{};
+    result.arrivals = arrivals_;
+    result.completed = completed_;
+    result.busy_ticks = busy_ticks_;
+    result.idle_ticks = idle_ticks_;
+    if constexpr (COUNTERS) {
+        result.dispatches = counters_.dispatches;
+        result.accesses = counters_.accesses;
+        result.page_faults = counters_.page_faults;
+    }
+    if constexpr (FULL) {
+        result.response_mean = metrics_.response().mean();
+        result.response_p99 = static_cast<double>(metrics_.response().percentile(0.99));
+        result.turnaround_mean = metrics_.turnaround().mean();
+        result.turnaround_p99 = static_cast<double>(metrics_.turnaround().percentile(0.99));
+        result.jain = metrics_.jain_index();
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+// Configuraciones ya instanciadas en static_sim.cpp, elegidas por nombre
+struct StaticConfig {
+    const char* name;
+    const char* scheduling;
+    const char* replacement;
+    const char* sink;
+    StatsLevel level;
+    StaticResult (*run)(const StaticParams& params);
+};
+
+const std::vector<StaticConfig>& static_configs();
+const StaticConfig* find_static_config(const std::string& name);
+std::string stats_level_to_string(StatsLevel level);
+
+void list_static_configs();
+void display_static_result(const StaticConfig& config, const StaticParams& params,
+                           const StaticResult& result);
+
+// Mismos parámetros en el scheduler general (eventos + MemoryManager) y en
+// las configuraciones compiladas equivalentes: ns por tick y aceleración
+void run_static_bench(const StaticParams& params);
+
+// Se instancian una sola vez, en static_sim.cpp
+extern template class StaticSimulator<static_sim::RoundRobin, static_sim::FifoReplacement,
+                                      static_sim::NullSink, StatsLevel::COUNTERS>;
+extern template class StaticSimulator<static_sim::RoundRobin, static_sim::LruReplacement,
+                                      static_sim::NullSink, StatsLevel::COUNTERS>;
+extern template class StaticSimulator<static_sim::RoundRobin, static_sim::ClockReplacement,
+                                      static_sim::NullSink, StatsLevel::COUNTERS>;
+extern template class StaticSimulator<static_sim::RoundRobin, static_sim::LruReplacement,
+                                      static_sim::NullSink, StatsLevel::FULL>;
+extern template class StaticSimulator<static_sim::RoundRobin, static_sim::LruReplacement,
+                                      static_sim::RingSink<1024>, StatsLevel::FULL>;
+extern template class StaticSimulator<static_sim::RoundRobin, static_sim::LruReplacement,
+                                      static_sim::ConsoleSink, StatsLevel::FULL>;
+extern template class StaticSimulator<static_sim::RoundRobin, static_sim::NoPaging,
+                                      static_sim::NullSink, StatsLevel::NONE>;
+extern template class StaticSimulator<static_sim::Fcfs, static_sim::NoPaging,
+                                      static_sim::NullSink, StatsLevel::COUNTERS>;
+extern template class StaticSimulator<static_sim::ShortestJob, static_sim::LruReplacement,
+                                      static_sim::NullSink, StatsLevel::FULL>;
+
+#endif // STATIC_SIM_HPP
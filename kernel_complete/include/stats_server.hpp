@@ -0,0 +1,155 @@
+#ifndef STATS_SERVER_HPP
+#define STATS_SERVER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+class RoundRobinScheduler;
+class MemoryManager;
+class ProducerConsumer;
+
+// Contadores publicados: todos de 8 bytes para copiarlos palabra por palabra
+struct StatsSnapshot {
+    // Núcleo de eventos
+    long long sim_time;
+    long long events_processed;
+    long long events_pending;
+    long long publications;            // Snapshots publicados por la simulación
+
+    // Scheduler
+    long long processes;
+    long long ready;
+    long long running;
+    long long blocked;
+    long long completed;
+    long long busy_ticks;
+    long long idle_ticks;
+    double response_mean;
+    double wait_mean;
+    double turnaround_mean;
+
+    // Memoria (memory_enabled = 0: sin mem-init)
+    long long memory_enabled;
+    long long frames;
+    long long free_frames;
+    long long accesses;
+    long long page_faults;
+    long long cow_faults;
+    long long zswap_hits;
+
+    // Productor-consumidor (sync_enabled = 0: sin pc-init)
+    long long sync_enabled;
+    long long buffer_capacity;
+    long long buffer_occupancy;
+    long long produced;
+    long long consumed;
+    long long producer_blocks;
+    long long consumer_blocks;
+};
+
+// Seqlock de un solo escritor: el escritor nunca espera (contador impar
+// mientras escribe, par al terminar) y el lector reintenta si el contador
+// cambió durante su copia. Los datos se guardan como palabras atómicas con
+// acceso relaxed, así la lectura concurrente no es una carrera de datos.
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T> && sizeof(T) % sizeof(uint64_t) == 0,
+                  "SeqLock necesita un tipo trivial de palabras de 8 bytes");
+
+public:
+    SeqLock() : sequence_(0) {
+        for (auto& word : words_) word.store(0, std::memory_order_relaxed);
+    }
+
+    void write(const T& value) {
+        uint64_t raw[WORDS];
+        std::memcpy(raw, &value, sizeof(T));
+        unsigned long long seq = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; i++) {
+            words_[i].store(raw[i], std::memory_order_relaxed);
+        }
+        sequence_.store(seq + 2, std::memory_order_release);
+    }
+
+    // Devuelve cuántas veces tuvo que reintentar (lectura solapada con una escritura)
+    int read(T& value) const {
+        uint64_t raw[WORDS];
+        int retries = 0;
+        for (;;) {
+            unsigned long long before = sequence_.load(std::memory_order_acquire);
+            if ((before & 1) == 0) {
+                for (size_t i = 0; i < WORDS; i++) {
+                    raw[i] = words_[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence_.load(std::memory_order_relaxed) == before) {
+                    break;
+                }
+            }
+            retries++;
+            std::this_thread::yield();
+        }
+        std::memcpy(&value, raw, sizeof(T));
+        return retries;
+    }
+
+private:
+    static constexpr size_t WORDS = sizeof(T) / sizeof(uint64_t);
+
+    alignas(64) std::atomic<unsigned long long> sequence_;
+    std::atomic<uint64_t> words_[WORDS];
+};
+
+// Servidor de estadísticas en un socket Unix. La simulación publica un
+// snapshot en el seqlock cada publish_every eventos (y tras cada comando);
+// un hilo aparte atiende cada conexión con el último snapshot en formato de
+// exposición de texto (# HELP / # TYPE / nombre valor) y la cierra. Los
+// lectores nunca bloquean a la simulación: el costo para ella es copiar el
+// snapshot en el seqlock.
+class StatsServer {
+public:
+    StatsServer();
+    ~StatsServer();
+
+    bool start(const std::string& path);
+    void stop();
+    bool is_running() const { return listen_fd_ >= 0; }
+    const std::string& get_path() const { return path_; }
+    const std::string& get_error() const { return error_; }
+
+    // Lo llama solo el hilo de la simulación
+    void publish(const StatsSnapshot& snapshot);
+
+    // Armar un snapshot con los módulos activos (memory y buffer pueden ser nullptr)
+    static StatsSnapshot capture(RoundRobinScheduler& scheduler, const MemoryManager* memory,
+                                 const ProducerConsumer* buffer);
+
+    // Snapshot en formato de texto
+    static std::string format(const StatsSnapshot& snapshot);
+
+    // Cliente: leer la respuesta completa de un servidor (vacío si falla)
+    static std::string scrape(const std::string& path);
+
+    void display_stats() const;
+
+private:
+    SeqLock<StatsSnapshot> snapshot_;
+    long long publications_;           // Solo el escritor
+    std::string path_;
+    std::string error_;
+    int listen_fd_;
+    std::thread thread_;
+    std::atomic<bool> stopping_;
+    std::atomic<long long> scrapes_;
+    std::atomic<long long> read_retries_;
+
+    void serve();
+};
+
+#endif // STATS_SERVER_HPP
@@ -0,0 +1,129 @@
+#ifndef SWEEP_HPP
+#define SWEEP_HPP
+
+#include "workload.hpp"
+#include "memory.hpp"
+#include "device.hpp"
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Pool de hilos con robo de trabajo: cada hilo consume su cola por el final
+// y, al vaciarla, roba del frente de la cola de otro hilo
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int threads);
+
+    // Ejecutar task(i) para i en [0, count); retorna cuando todas terminaron
+    void run(size_t count, const std::function<void(size_t)>& task);
+
+    int get_threads() const { return threads_; }
+    long long get_steals() const { return steals_.load(); }
+
+private:
+    struct WorkerQueue {
+        std::mutex lock;
+        std::deque<size_t> tasks;
+    };
+
+    int threads_;
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::atomic<long long> steals_;
+
+    bool pop_local(int worker, size_t& task);
+    bool steal(int thief, size_t& task);
+};
+
+// Grilla de parámetros: se simula el producto cartesiano completo
+struct SweepGrid {
+    std::vector<int> quanta = {4};
+    std::vector<int> frames = {16};
+    std::vector<int> zswap = {0};               // Frames de pool descontados de frames
+    std::vector<ReplacementPolicy> replacements = {ReplacementPolicy::FIFO};
+    std::vector<DiskPolicy> disk_policies;      // Vacío = sin E/S
+    int replicas = 1;                           // Semillas por configuración
+
+    SimTime ticks = 10000;
+    WorkloadConfig workload;                    // workload.seed es la semilla base
+    int fault_service_time = 5;
+    int decompress_time = 1;
+    int refs_per_tick = 1;
+    int disks = 2;
+    int cpu_between_io = 8;
+};
+
+// Una configuración de la grilla, promediada sobre sus réplicas
+struct SweepRow {
+    int quantum;
+    int frames;
+    int zswap;
+    ReplacementPolicy replacement;
+    bool with_io;
+    DiskPolicy disk_policy;
+
+    double completed;
+    double throughput;          // Procesos por 1000 ticks
+    double response_mean;
+    double response_p99;
+    double turnaround_mean;
+    double turnaround_p99;
+    double cpu_utilization;     // %
+    double fault_rate;          // %
+    double pool_hit_rate;       // % de faults servidos por zswap
+    double jain;
+    double events;
+};
+
+// Opción "clave=v1,v2,..." de la CLI (q, frames, zswap, repl, disk, reps, threads,
+// fault, decomp, refs)
+bool parse_sweep_option(const std::string& token, SweepGrid& grid, int& threads);
+
+class SweepRunner {
+public:
+    explicit SweepRunner(const SweepGrid& grid);
+
+    // Simular todos los puntos; el resultado no depende de threads
+    void run(int threads);
+
+    bool write_csv(const std::string& path) const;
+    bool write_json(const std::string& path) const;
+    void display_summary() const;
+
+    size_t get_points() const { return points_.size(); }
+
+private:
+    struct Point {
+        int quantum;
+        int frames;
+        int zswap;
+        ReplacementPolicy replacement;
+        bool with_io;
+        DiskPolicy disk_policy;
+        int replica;
+    };
+
+    // Métricas de una simulación individual
+    struct Sample {
+        double completed, throughput, response_mean, response_p99;
+        double turnaround_mean, turnaround_p99, cpu_utilization, fault_rate;
+        double pool_hit_rate, jain, events;
+    };
+
+    SweepGrid grid_;
+    std::vector<Point> points_;
+    std::vector<Sample> samples_;
+    std::vector<SweepRow> rows_;
+    int threads_used_;
+    long long steals_;
+    double elapsed_;
+
+    Sample simulate(const Point& point) const;
+    void aggregate();
+    static uint64_t replica_seed(uint64_t base, int replica);
+};
+
+#endif // SWEEP_HPP
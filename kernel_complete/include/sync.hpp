@@ -4,15 +4,34 @@
 #include <mutex>
 #include <condition_variable>
 #include <vector>
+#include <memory>
+
+class CheckpointWriter;
+class CheckpointReader;
 
 class ProducerConsumer {
 public:
-    ProducerConsumer(int buffer_size);
+    ProducerConsumer(int buffer_size, bool verbose = true);
     
     // Operaciones principales
     bool produce(int item);     // Retorna true si tuvo éxito
     bool consume(int& item);    // Retorna true si tuvo éxito, item por referencia
     
+    // Modo bloqueante por lotes (pipelines, sin trazas): put_batch espera
+    // con not_full_ hasta colocar los n items y take_batch espera con
+    // not_empty_ hasta sacar al menos uno (0 = cerrado y vacío). Un buffer
+    // lleno frena al productor: la contrapresión se propaga hacia atrás.
+    void put_batch(const int* items, int n);
+    int take_batch(int* items, int max);
+    void close();               // Sin más items: despierta a los consumidores
+    
+    int get_capacity() const { return buffer_size_; }
+    int get_occupancy() const;
+    int get_producer_blocks() const;
+    int get_consumer_blocks() const;
+    int get_total_produced() const;
+    int get_total_consumed() const;
+    
     // Visualización
     void display_buffer() const;
     void display_stats() const;
@@ -20,6 +39,10 @@ public:
     // Control
     void reset();
     
+    // Checkpoint: contenido del buffer circular, índices y estadísticas
+    void save_state(CheckpointWriter& writer) const;
+    static std::unique_ptr<ProducerConsumer> from_checkpoint(const CheckpointReader& reader);
+    
 private:
     int buffer_size_;                  // Tamaño del buffer
     std::vector<int> buffer_;          // Buffer circular
@@ -31,6 +54,7 @@ private:
     mutable std::mutex mutex_;
     std::condition_variable not_full_;
     std::condition_variable not_empty_;
+    bool closed_;
     
     // Estadísticas
     int total_produced_;
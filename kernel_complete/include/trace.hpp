@@ -0,0 +1,92 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include "scheduler.hpp"
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Formato de la traza de trabajos
+enum class TraceFormat {
+    SWF,     // Standard Workload Format: 18 campos por espacios, ';' = comentario
+    CSV      // Columnas submit, runtime, procs (con o sin encabezado)
+};
+
+struct TraceOptions {
+    double scale = 1.0;                // Segundos de la traza por tick virtual
+    bool use_procs = true;             // Ráfaga = runtime × procesadores pedidos
+    long long max_jobs = 0;            // 0 = toda la traza
+};
+
+// Lector de trazas en streaming como fuente de llegadas: lee el archivo en
+// bloques de tamaño fijo y corta cada línea en campos con string_view sobre
+// el mismo bloque (sin copias ni asignaciones por trabajo). El scheduler pide
+// un trabajo a la vez, así que la memoria no depende del largo de la traza.
+class TraceReader : public ArrivalSource {
+public:
+    static constexpr size_t BLOCK_SIZE = 1 << 20;
+
+    TraceReader(const std::string& path, const TraceOptions& options, SimTime start);
+    ~TraceReader();
+
+    bool is_open() const { return fd_ >= 0; }
+    const std::string& get_error() const { return error_; }
+    TraceFormat get_format() const { return format_; }
+
+    bool next_arrival(SimTime& time, int& burst) override;
+
+    long long get_jobs() const { return jobs_; }
+    bool exhausted() const {
+        return (eof_ && begin_ == end_) || (options_.max_jobs > 0 && jobs_ >= options_.max_jobs);
+    }
+
+    // Las llegadas siguientes no pueden ser anteriores a now (el reloj pudo
+    // avanzar mientras la traza no estaba conectada)
+    void set_floor(SimTime now) { last_time_ = std::max(last_time_, now); }
+    void display_stats() const;
+
+    static std::string format_to_string(TraceFormat format);
+
+    // Recorrer la traza completa sin simular: MB/s y trabajos/s del parser
+    static void benchmark(const std::string& path, const TraceOptions& options);
+
+private:
+    int fd_;
+    std::string path_;
+    TraceFormat format_;
+    TraceOptions options_;
+    std::string error_;
+    std::vector<char> block_;
+    size_t begin_;                     // Primer byte sin consumir del bloque
+    size_t end_;                       // Fin de los datos leídos
+    bool eof_;
+    bool discarding_;                  // Línea más larga que el bloque: saltar hasta '\n'
+
+    // Columnas (base 0) de los campos usados
+    int submit_column_;
+    int runtime_column_;
+    int procs_column_;
+    int alt_procs_column_;             // SWF: asignados si no hay pedidos
+    bool header_checked_;
+
+    SimTime start_;
+    double first_submit_;
+    SimTime last_time_;
+
+    long long lines_;
+    long long jobs_;
+    long long comments_;
+    long long skipped_;                // Runtime inválido (cancelados) o línea mal formada
+    long long reordered_;              // Llegadas fuera de orden llevadas a la anterior
+    long long bytes_;
+    long long burst_sum_;
+    long long procs_sum_;
+
+    bool next_line(std::string_view& line);
+    bool refill();
+    bool parse_job(std::string_view line, double& submit, double& runtime, int& procs);
+    void read_csv_header(std::string_view line);
+};
+
+#endif // TRACE_HPP
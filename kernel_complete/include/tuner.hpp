@@ -0,0 +1,98 @@
+#ifndef TUNER_HPP
+#define TUNER_HPP
+
+#include "metrics.hpp"
+#include "simulation.hpp"
+#include <array>
+#include <string>
+#include <vector>
+
+struct WorkloadConfig;
+
+enum class TunerMode {
+    GLOBAL,      // Un quantum para todos
+    CLASS        // Interactivos (sueltan la CPU antes del quantum) y batch por separado
+};
+
+struct TunerConfig {
+    TunerMode mode = TunerMode::GLOBAL;
+    int min_quantum = 1;
+    int max_quantum = 64;
+    double percentile = 0.8;           // Fracción de ráfagas que debe caber en un quantum
+    double overhead = 0.10;            // Máximo costo de cambio de contexto por porción
+    int response_target = 0;           // p99 de respuesta deseado (0 = sin objetivo)
+    SimTime window = 500;              // Ticks entre ajustes
+};
+
+// Opción "clave=valor" de la CLI (min, max, pct, overhead, resp, window)
+bool parse_tuner_option(const std::string& token, TunerConfig& config);
+
+// Controlador en línea del quantum. En cada ventana observa las ráfagas de
+// CPU (una porción expropiada cuenta como "más larga que el quantum", dato
+// censurado que empuja el percentil hacia arriba) y el p99 de respuesta. El
+// quantum nuevo es el percentil pedido de las ráfagas, nunca menor que el
+// piso que mantiene el costo de cambio de contexto c bajo la fracción f
+// (c / (q + c) ≤ f), y se reduce si la respuesta supera su objetivo. Se
+// mueve la mitad del camino por ventana para no oscilar.
+class QuantumTuner {
+public:
+    static constexpr int INTERACTIVE = 0;
+    static constexpr int BATCH = 1;
+
+    QuantumTuner(const TunerConfig& config, int initial_quantum, int switch_cost, SimTime now);
+
+    // Quantum para el próximo despacho de pid
+    int quantum_for(int pid) const {
+        return quantum_[config_.mode == TunerMode::CLASS ? class_of(pid) : INTERACTIVE];
+    }
+    int get_quantum(int process_class) const { return quantum_[process_class]; }
+    int class_of(int pid) const {
+        return pid < static_cast<int>(batch_.size()) && batch_[pid] ? BATCH : INTERACTIVE;
+    }
+
+    // Observaciones del scheduler
+    void record_burst(int pid, int length, bool preempted);
+    void record_response(SimTime response) { response_.record(static_cast<uint64_t>(response)); }
+
+    bool due(SimTime now) const { return now >= next_update_; }
+    void update(SimTime now);
+
+    void set_switch_cost(int cost) { switch_cost_ = cost; }
+    int overhead_floor() const;
+    const TunerConfig& get_config() const { return config_; }
+    void display_stats() const;
+
+    static std::string mode_to_string(TunerMode mode);
+
+private:
+    struct Step {
+        SimTime time;
+        int quantum[2];
+        uint64_t burst_percentile[2];
+        long long samples[2];
+        double preempted;              // % de porciones expropiadas en la ventana
+        uint64_t response_p99;
+        bool response_capped;          // Se recortó por el objetivo de respuesta
+    };
+
+    TunerConfig config_;
+    int switch_cost_;
+    std::array<int, 2> quantum_;
+    std::vector<unsigned char> batch_;               // Clase por PID (1 = batch)
+
+    // Ventana en curso
+    std::array<LogHistogram, 2> bursts_;
+    LogHistogram response_;
+    long long preempted_;
+
+    SimTime next_update_;
+    std::vector<Step> trajectory_;
+    long long total_bursts_;
+};
+
+// Compromiso throughput/latencia: la carga sintética con quanta fijos y con
+// el controlador global y por clase, con el mismo costo de cambio de contexto
+void run_tuner_bench(const WorkloadConfig& workload, SimTime ticks, int switch_cost,
+                     const TunerConfig& config);
+
+#endif // TUNER_HPP
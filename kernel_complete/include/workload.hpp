@@ -0,0 +1,162 @@
+#ifndef WORKLOAD_HPP
+#define WORKLOAD_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include "scheduler.hpp"
+
+class MemoryManager;
+class CheckpointWriter;
+class CheckpointReader;
+
+// Distribuciones de ráfaga de CPU
+enum class BurstDistribution {
+    EXPONENTIAL,
+    PARETO,
+    BIMODAL
+};
+
+// Patrones de referencia a páginas
+enum class PagePattern {
+    ZIPF,        // Pocas páginas calientes dentro de la fase
+    SEQUENTIAL,  // Recorrido secuencial del espacio de direcciones
+    LOOP         // Ciclo sobre el working set de la fase
+};
+
+// Generador pseudoaleatorio xoshiro256** (rápido y reproducible)
+class Xoshiro256 {
+public:
+    explicit Xoshiro256(uint64_t seed = 0) { reseed(seed); }
+
+    void reseed(uint64_t seed) {
+        // SplitMix64 para expandir la semilla a 256 bits
+        for (auto& word : state_) {
+            seed += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t next() {
+        const uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        const uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+        return result;
+    }
+
+    // Uniforme en [0, 1)
+    double uniform() { return (next() >> 11) * 0x1.0p-53; }
+
+    // Entero uniforme en [0, n)
+    uint32_t below(uint32_t n) {
+        return static_cast<uint32_t>(((next() >> 32) * n) >> 32);
+    }
+
+private:
+    uint64_t state_[4];
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+// Parámetros de la carga sintética
+struct WorkloadConfig {
+    uint64_t seed = 42;
+
+    // Llegadas (proceso de Poisson)
+    double arrival_rate = 0.2;          // λ: llegadas por tick
+
+    // Ráfagas de CPU
+    BurstDistribution burst_dist = BurstDistribution::EXPONENTIAL;
+    double burst_mean = 10.0;
+    double pareto_alpha = 1.5;          // Cola pesada (α > 1)
+    int bimodal_short = 3;
+    int bimodal_long = 40;
+    double bimodal_short_prob = 0.8;
+    int max_burst = 1000000;
+
+    // Referencias a memoria
+    PagePattern page_pattern = PagePattern::ZIPF;
+    int pages_per_process = 64;         // Tamaño del espacio de direcciones
+    int working_set = 8;                // Páginas activas por fase
+    int phase_length = 1000;            // Referencias antes de cambiar de fase
+    double zipf_s = 1.0;                // Exponente de Zipf
+};
+
+class WorkloadGenerator : public ArrivalSource {
+public:
+    explicit WorkloadGenerator(const WorkloadConfig& config);
+
+    // ArrivalSource: siguiente llegada de Poisson en tiempo virtual
+    bool next_arrival(SimTime& time, int& burst) override;
+
+    // Generación en streaming (un evento por llamada, sin materializar)
+    double next_interarrival();
+    int next_burst();
+    int next_page(int process_id);
+
+    // Alimentar scheduler y memoria durante N ticks
+    void run(RoundRobinScheduler& scheduler, MemoryManager* memory,
+             int ticks, int refs_per_tick);
+
+    // Alimentar el scheduler por eventos durante N ticks virtuales
+    void run_events(RoundRobinScheduler& scheduler, MemoryManager* memory, SimTime ticks);
+
+    // Medir throughput puro del generador
+    void benchmark(long long events);
+
+    void display_config() const;
+    void display_stats() const;
+
+    const WorkloadConfig& get_config() const { return config_; }
+    
+    // Checkpoint: configuración, estado de ambos RNG, reloj de llegadas y localidad
+    void save_state(CheckpointWriter& writer) const;
+    static std::unique_ptr<WorkloadGenerator> from_checkpoint(const CheckpointReader& reader);
+
+    static std::string burst_to_string(BurstDistribution dist);
+    static std::string pattern_to_string(PagePattern pattern);
+    static bool parse_burst(const std::string& name, BurstDistribution& dist);
+    static bool parse_pattern(const std::string& name, PagePattern& pattern);
+
+private:
+    // Estado de localidad por proceso
+    struct Locality {
+        int phase_base = 0;             // Primera página de la fase actual
+        int refs_in_phase = 0;
+        int cursor = 0;                 // Posición para SEQUENTIAL / LOOP
+        bool initialized = false;
+    };
+
+    WorkloadConfig config_;
+    Xoshiro256 rng_;                    // Llegadas y ráfagas
+    Xoshiro256 page_rng_;               // Referencias: flujo independiente del orden de eventos
+    std::vector<Locality> locality_;    // Indexado por PID
+
+    // Tabla alias de Walker para Zipf: muestreo O(1)
+    std::vector<double> zipf_prob_;
+    std::vector<uint32_t> zipf_alias_;
+
+    // Reloj de llegadas (tiempo continuo)
+    double next_arrival_time_;
+
+    // Estadísticas
+    long long arrivals_generated_;
+    long long bursts_generated_;
+    long long pages_generated_;
+    long long phase_changes_;
+
+    void build_zipf_table();
+    int sample_zipf();
+    Locality& locality_for(int process_id);
+    void start_phase(Locality& loc);
+};
+
+#endif // WORKLOAD_HPP
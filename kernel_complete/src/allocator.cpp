@@ -0,0 +1,620 @@
+#include "../include/allocator.hpp"
+#include "../include/workload.hpp"
+#include "../include/utils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+
+namespace {
+    constexpr int FRAME_BYTES = 4096;            // Igual que MemoryManager::PAGE_SIZE
+    constexpr int MAX_SLAB_ORDER = 3;
+    constexpr int MIN_OBJECTS_PER_SLAB = 8;
+}
+
+BuddyAllocator::BuddyAllocator(int frames)
+    : frames_(frames),
+      max_order_(0),
+      free_frames_(0),
+      splits_(0),
+      merges_(0),
+      failures_(0) {
+
+    while (max_order_ < MAX_ORDER && (2 << max_order_) <= frames_) {
+        max_order_++;
+    }
+    free_bits_.resize(max_order_ + 1);
+    for (int k = 0; k <= max_order_; k++) {
+        free_bits_[k].assign(((frames_ >> k) >> 6) + 1, 0);
+    }
+    free_count_.assign(max_order_ + 1, 0);
+    first_word_.assign(max_order_ + 1, 0);
+    std::fill(std::begin(allocations_), std::end(allocations_), 0);
+
+    // Descomponer [0, frames) en los bloques alineados más grandes posibles
+    for (int addr = 0; addr < frames_;) {
+        int k = max_order_;
+        while (k > 0 && ((addr & ((1 << k) - 1)) != 0 || addr + (1 << k) > frames_)) {
+            k--;
+        }
+        set_free(k, addr >> k);
+        addr += 1 << k;
+    }
+    free_frames_ = frames_;
+}
+
+void BuddyAllocator::set_free(int order, int block) {
+    size_t word = static_cast<size_t>(block) >> 6;
+    free_bits_[order][word] |= 1ULL << (block & 63);
+    free_count_[order]++;
+    first_word_[order] = std::min(first_word_[order], word);
+}
+
+void BuddyAllocator::clear_free(int order, int block) {
+    free_bits_[order][static_cast<size_t>(block) >> 6] &= ~(1ULL << (block & 63));
+    free_count_[order]--;
+}
+
+int BuddyAllocator::find_free(int order) {
+    // La pista avanza sobre palabras vacías: costo amortizado constante
+    const auto& bits = free_bits_[order];
+    size_t word = first_word_[order];
+    while (bits[word] == 0) {
+        word++;
+    }
+    first_word_[order] = word;
+    return static_cast<int>(word * 64 + __builtin_ctzll(bits[word]));
+}
+
+int BuddyAllocator::allocate(int order) {
+    if (order < 0 || order > max_order_) {
+        failures_++;
+        return -1;
+    }
+    for (int k = order; k <= max_order_; k++) {
+        if (free_count_[k] == 0) {
+            continue;
+        }
+        int block = find_free(k);
+        clear_free(k, block);
+        int frame = block << k;
+
+        // Dividir: la mitad baja sigue, la alta queda libre un orden abajo
+        split_down(frame, k, order);
+        free_frames_ -= 1 << order;
+        allocations_[order]++;
+        return frame;
+    }
+    failures_++;
+    return -1;
+}
+
+void BuddyAllocator::split_down(int frame, int from, int to) {
+    for (int k = from; k > to;) {
+        k--;
+        int half = frame >> k;
+        set_free(k, half ^ 1);
+        splits_++;
+    }
+}
+
+void BuddyAllocator::free(int frame, int order) {
+    free_frames_ += 1 << order;
+
+    // Fusionar mientras el buddy esté libre entero en el mismo orden
+    int k = order;
+    while (k < max_order_) {
+        int buddy = (frame >> k) ^ 1;
+        if (((buddy + 1) << k) > frames_ || !test_free(k, buddy)) {
+            break;
+        }
+        clear_free(k, buddy);
+        frame &= ~(1 << k);
+        merges_++;
+        k++;
+    }
+    set_free(k, frame >> k);
+}
+
+bool BuddyAllocator::is_free(int frame) const {
+    for (int k = 0; k <= max_order_; k++) {
+        int block = frame >> k;
+        if (((block + 1) << k) <= frames_ && test_free(k, block)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int BuddyAllocator::find_free_in(int first, int last) const {
+    // En cada orden, el primer bloque libre que toca el rango; el menor gana
+    int best = -1;
+    for (int k = 0; k <= max_order_ && first < last; k++) {
+        if (free_count_[k] == 0) {
+            continue;
+        }
+        const auto& bits = free_bits_[k];
+        size_t low = static_cast<size_t>(first >> k);
+        size_t high = static_cast<size_t>((last - 1) >> k);
+        for (size_t word = low >> 6; word <= high >> 6 && word < bits.size(); word++) {
+            uint64_t mask = bits[word];
+            if (word == low >> 6) mask &= ~0ULL << (low & 63);
+            if (word == high >> 6 && (high & 63) != 63) mask &= (2ULL << (high & 63)) - 1;
+            if (mask != 0) {
+                int block = static_cast<int>(word * 64 + __builtin_ctzll(mask));
+                int frame = std::max(block << k, first);
+                if (best < 0 || frame < best) best = frame;
+                break;
+            }
+        }
+    }
+    return best;
+}
+
+bool BuddyAllocator::claim(int frame) {
+    for (int k = 0; k <= max_order_; k++) {
+        int block = frame >> k;
+        if (((block + 1) << k) > frames_ || !test_free(k, block)) {
+            continue;
+        }
+        // Dividir hacia el frame pedido: cada mitad que no lo contiene queda libre
+        clear_free(k, block);
+        split_down(frame, k, 0);
+        free_frames_--;
+        allocations_[0]++;
+        return true;
+    }
+    return false;
+}
+
+void BuddyAllocator::reserve_all() {
+    for (int k = 0; k <= max_order_; k++) {
+        std::fill(free_bits_[k].begin(), free_bits_[k].end(), 0);
+        free_count_[k] = 0;
+        first_word_[k] = 0;
+    }
+    free_frames_ = 0;
+}
+
+int BuddyAllocator::largest_free_order() const {
+    for (int k = max_order_; k >= 0; k--) {
+        if (free_count_[k] > 0) return k;
+    }
+    return -1;
+}
+
+double BuddyAllocator::fragmentation(int order) const {
+    if (free_frames_ == 0) return 0.0;
+    long long usable = 0;
+    for (int k = order; k <= max_order_; k++) {
+        usable += static_cast<long long>(free_count_[k]) << k;
+    }
+    return static_cast<double>(free_frames_ - usable) / free_frames_;
+}
+
+void BuddyAllocator::display_stats() const {
+    print_header("BUDDY ALLOCATOR");
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << " Frames:                " << frames_ << " (orden máximo " << max_order_ << ")" << std::endl;
+    std::cout << "  ├─ Libres:            " << free_frames_ << std::endl;
+    std::cout << "  └─ Bloque más grande: "
+              << (largest_free_order() >= 0 ? 1 << largest_free_order() : 0) << " frames" << std::endl;
+    std::cout << " Divisiones:            " << splits_ << std::endl;
+    std::cout << " Fusiones:              " << merges_ << std::endl;
+    std::cout << " Pedidos fallidos:      " << failures_ << std::endl;
+
+    std::cout << "\n " << std::left << std::setw(7) << "Orden" << std::right
+              << std::setw(9) << "Frames" << std::setw(9) << "Libres"
+              << std::setw(12) << "Asignados" << std::setw(10) << "Frag %" << std::endl;
+    print_separator(47);
+    for (int k = 0; k <= max_order_; k++) {
+        std::cout << " " << std::left << std::setw(7) << k << std::right
+                  << std::setw(9) << (1 << k) << std::setw(9) << free_count_[k]
+                  << std::setw(12) << allocations_[k]
+                  << std::setw(10) << fragmentation(k) * 100 << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+SlabAllocator::SlabAllocator(BuddyAllocator& buddy, int cpus, int magazine_size,
+                             std::function<bool()> reclaim, int max_frames)
+    : buddy_(buddy),
+      cpus_(std::max(1, cpus)),
+      magazine_size_(std::max(1, magazine_size)),
+      reclaim_(std::move(reclaim)),
+      max_frames_(max_frames > 0 ? max_frames : buddy.get_frames()),
+      slab_frames_(0) {
+}
+
+SlabAllocator::~SlabAllocator() {
+    for (const auto& slab : slabs_) {
+        if (slab.frame >= 0) {
+            buddy_.free(slab.frame, caches_[slab.cache].order);
+        }
+    }
+}
+
+void SlabAllocator::create_default_caches() {
+    create_cache("kmalloc-64", 64);
+    create_cache("dentry", 192);
+    create_cache("skbuff", 256);
+    create_cache("inode", 600);
+    create_cache("task_struct", 1024);
+}
+
+int SlabAllocator::create_cache(const std::string& name, int object_size) {
+    // El menor slab que aloje al menos MIN_OBJECTS_PER_SLAB objetos
+    int order = 0;
+    while (order < MAX_SLAB_ORDER && (FRAME_BYTES << order) / object_size < MIN_OBJECTS_PER_SLAB) {
+        order++;
+    }
+
+    Cache cache;
+    cache.name = name;
+    cache.object_size = object_size;
+    cache.order = order;
+    cache.objects_per_slab = std::max(1, (FRAME_BYTES << order) / object_size);
+    cache.slabs = 0;
+    cache.empty_slabs = 0;
+    cache.live_objects = 0;
+    cache.cpus.resize(cpus_);
+    for (auto& cpu : cache.cpus) {
+        cpu.loaded.rounds.reserve(magazine_size_);
+        cpu.previous.rounds.reserve(magazine_size_);
+    }
+    cache.stats = CacheStats{0, 0, 0, 0, 0, 0, 0, 0};
+    caches_.push_back(std::move(cache));
+    return static_cast<int>(caches_.size()) - 1;
+}
+
+int SlabAllocator::find_cache(const std::string& name) const {
+    for (size_t i = 0; i < caches_.size(); i++) {
+        if (caches_[i].name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+long long SlabAllocator::alloc(int cache, int cpu) {
+    Cache& c = caches_[cache];
+    CpuMagazines& m = c.cpus[cpu % cpus_];
+
+    // Cargado vacío y anterior con objetos: intercambiarlos
+    if (m.loaded.rounds.empty() && !m.previous.rounds.empty()) {
+        std::swap(m.loaded, m.previous);
+    }
+    // Ambos vacíos: cambiar el vacío por uno lleno del depot
+    if (m.loaded.rounds.empty() && !c.full_magazines.empty()) {
+        c.empty_magazines.push_back(std::move(m.loaded));
+        m.loaded = std::move(c.full_magazines.back());
+        c.full_magazines.pop_back();
+        c.stats.depot_exchanges++;
+    }
+
+    long long object;
+    if (!m.loaded.rounds.empty()) {
+        object = m.loaded.rounds.back();
+        m.loaded.rounds.pop_back();
+        c.stats.magazine_hits++;
+    } else {
+        object = slab_alloc(cache);
+        if (object < 0) {
+            c.stats.failures++;
+            return -1;
+        }
+    }
+    c.stats.allocations++;
+    c.live_objects++;
+    return object;
+}
+
+void SlabAllocator::free(int cache, int cpu, long long object) {
+    Cache& c = caches_[cache];
+    CpuMagazines& m = c.cpus[cpu % cpus_];
+    c.stats.frees++;
+    c.live_objects--;
+
+    if (static_cast<int>(m.loaded.rounds.size()) >= magazine_size_) {
+        if (m.previous.rounds.empty()) {
+            std::swap(m.loaded, m.previous);
+        } else {
+            // Ambos llenos: el anterior va al depot y se carga uno vacío
+            c.full_magazines.push_back(std::move(m.previous));
+            m.previous = std::move(m.loaded);
+            if (!c.empty_magazines.empty()) {
+                m.loaded = std::move(c.empty_magazines.back());
+                c.empty_magazines.pop_back();
+            } else {
+                m.loaded = Magazine();
+                m.loaded.rounds.reserve(magazine_size_);
+            }
+            m.loaded.rounds.clear();
+            c.stats.depot_exchanges++;
+        }
+    }
+    m.loaded.rounds.push_back(object);
+}
+
+long long SlabAllocator::slab_alloc(int cache) {
+    Cache& c = caches_[cache];
+    c.stats.slab_allocs++;
+    if (c.partial.empty() && grow(cache) < 0) {
+        return -1;
+    }
+
+    int id = c.partial.front();
+    Slab& slab = slabs_[id];
+    if (slab.in_use == 0) {
+        c.empty_slabs--;
+    }
+    int index = slab.free_objects.back();
+    slab.free_objects.pop_back();
+    slab.in_use++;
+    if (slab.free_objects.empty()) {
+        c.partial.erase(slab.partial_pos);
+        slab.in_partial = false;
+    }
+    return (static_cast<long long>(id) << 16) | index;
+}
+
+void SlabAllocator::slab_free(long long object) {
+    int id = static_cast<int>(object >> 16);
+    Slab& slab = slabs_[id];
+    Cache& c = caches_[slab.cache];
+    slab.free_objects.push_back(static_cast<int>(object & 0xFFFF));
+    slab.in_use--;
+
+    // Los slabs a medio usar van al frente: se llenan antes de abrir vacíos
+    if (!slab.in_partial) {
+        slab.partial_pos = c.partial.insert(c.partial.begin(), id);
+        slab.in_partial = true;
+    }
+    if (slab.in_use == 0) {
+        // Se conserva un slab vacío por cache; el resto vuelve al buddy
+        c.empty_slabs++;
+        if (c.empty_slabs > 1) {
+            release_slab(id);
+        } else {
+            c.partial.splice(c.partial.end(), c.partial, slab.partial_pos);
+        }
+    }
+}
+
+int SlabAllocator::grow(int cache) {
+    Cache& c = caches_[cache];
+    int frames = 1 << c.order;
+    if (slab_frames_ + frames > max_frames_) {
+        return -1;
+    }
+
+    // Bajo presión se reclaman páginas de usuario hasta hallar un bloque contiguo
+    int frame = buddy_.allocate(c.order);
+    for (int tries = 0; frame < 0 && reclaim_ && tries < 64 && reclaim_(); tries++) {
+        frame = buddy_.allocate(c.order);
+    }
+    if (frame < 0) {
+        return -1;
+    }
+
+    int id;
+    if (!free_slab_ids_.empty()) {
+        id = free_slab_ids_.back();
+        free_slab_ids_.pop_back();
+    } else {
+        id = static_cast<int>(slabs_.size());
+        slabs_.emplace_back();
+    }
+    Slab& slab = slabs_[id];
+    slab.frame = frame;
+    slab.cache = cache;
+    slab.in_use = 0;
+    slab.free_objects.resize(c.objects_per_slab);
+    for (int i = 0; i < c.objects_per_slab; i++) {
+        slab.free_objects[i] = c.objects_per_slab - 1 - i;
+    }
+    slab.partial_pos = c.partial.insert(c.partial.end(), id);
+    slab.in_partial = true;
+
+    c.slabs++;
+    c.empty_slabs++;
+    c.stats.slabs_created++;
+    slab_frames_ += frames;
+    return id;
+}
+
+void SlabAllocator::release_slab(int id) {
+    Slab& slab = slabs_[id];
+    Cache& c = caches_[slab.cache];
+    c.partial.erase(slab.partial_pos);
+    slab.in_partial = false;
+    buddy_.free(slab.frame, c.order);
+    slab_frames_ -= 1 << c.order;
+    slab.frame = -1;
+    slab.free_objects.clear();
+    free_slab_ids_.push_back(id);
+
+    c.slabs--;
+    c.empty_slabs--;
+    c.stats.slabs_released++;
+}
+
+void SlabAllocator::drain() {
+    for (auto& c : caches_) {
+        auto flush = [this](Magazine& magazine) {
+            for (long long object : magazine.rounds) {
+                slab_free(object);
+            }
+            magazine.rounds.clear();
+        };
+        for (auto& cpu : c.cpus) {
+            flush(cpu.loaded);
+            flush(cpu.previous);
+        }
+        for (auto& magazine : c.full_magazines) {
+            flush(magazine);
+        }
+        c.full_magazines.clear();
+        c.empty_magazines.clear();
+    }
+    // Ya sin objetos en magazines, también el slab vacío de reserva vuelve al buddy
+    for (size_t id = 0; id < slabs_.size(); id++) {
+        if (slabs_[id].frame >= 0 && slabs_[id].in_use == 0) {
+            release_slab(static_cast<int>(id));
+        }
+    }
+}
+
+void SlabAllocator::display_stats() const {
+    print_header("SLAB ALLOCATOR");
+
+    long long allocations = 0, hits = 0;
+    for (const auto& c : caches_) {
+        allocations += c.stats.allocations;
+        hits += c.stats.magazine_hits;
+    }
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << " CPUs:                  " << cpus_ << " (magazines de " << magazine_size_ << ")" << std::endl;
+    std::cout << " Frames en slabs:       " << slab_frames_ << " (límite " << max_frames_ << ")" << std::endl;
+    std::cout << " Asignaciones:          " << allocations << std::endl;
+    std::cout << "  └─ Desde magazines:   " << hits << " ("
+              << (allocations > 0 ? 100.0 * hits / allocations : 0.0) << "%)" << std::endl;
+
+    // Uso = bytes de objetos vivos sobre bytes de slabs del cache
+    std::cout << "\n " << std::left << std::setw(13) << "Cache" << std::right
+              << std::setw(7) << "Tamaño" << std::setw(6) << "Obj" << std::setw(7) << "Orden"
+              << std::setw(7) << "Slabs" << std::setw(8) << "Vivos" << std::setw(8) << "Uso %"
+              << std::setw(8) << "Mag %" << std::setw(9) << "Depot" << std::setw(7) << "Fallos" << std::endl;
+    print_separator(82);
+    for (const auto& c : caches_) {
+        long long bytes = static_cast<long long>(c.slabs) * (FRAME_BYTES << c.order);
+        const CacheStats& s = c.stats;
+        std::cout << " " << std::left << std::setw(13) << c.name << std::right
+                  << std::setw(7) << c.object_size << std::setw(6) << c.objects_per_slab
+                  << std::setw(7) << c.order << std::setw(7) << c.slabs
+                  << std::setw(8) << c.live_objects
+                  << std::setw(8) << (bytes > 0 ? 100.0 * c.live_objects * c.object_size / bytes : 0.0)
+                  << std::setw(8) << (s.allocations > 0 ? 100.0 * s.magazine_hits / s.allocations : 0.0)
+                  << std::setw(9) << s.depot_exchanges << std::setw(7) << s.failures << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+AllocatorBenchResult run_allocator_bench(long long operations, int frames, int cpus,
+                                         int magazine_size, uint64_t seed, bool verbose) {
+    BuddyAllocator buddy(frames);
+    SlabAllocator slab(buddy, cpus, magazine_size);
+    slab.create_default_caches();
+    Xoshiro256 rng(seed);
+
+    struct Block {
+        int frame;
+        int order;
+    };
+    struct Object {
+        int cache;
+        long long handle;
+    };
+    std::vector<Block> blocks;
+    std::vector<Object> objects;
+    int huge_order = std::min(9, buddy.get_max_order());
+
+    AllocatorBenchResult result{0, 0, 0.0, LogHistogram(), LogHistogram()};
+
+    // Costo de leer el reloj: se descuenta de cada medición
+    using Clock = std::chrono::steady_clock;
+    long long overhead = 1LL << 62;
+    for (int i = 0; i < 1000; i++) {
+        auto a = Clock::now();
+        auto b = Clock::now();
+        overhead = std::min<long long>(overhead, std::chrono::duration_cast<std::chrono::nanoseconds>(b - a).count());
+    }
+    auto elapsed_ns = [overhead](Clock::time_point a, Clock::time_point b) {
+        long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(b - a).count() - overhead;
+        return static_cast<uint64_t>(std::max(0LL, ns));
+    };
+
+    auto start = Clock::now();
+    for (long long i = 0; i < operations; i++) {
+        int cpu = static_cast<int>(rng.below(static_cast<uint64_t>(cpus)));
+
+        if (rng.below(100) < 60) {
+            // Objetos del kernel: 50/50 mientras haya vivos
+            bool allocate = objects.empty() || rng.below(2) == 0;
+            if (allocate) {
+                int cache = static_cast<int>(rng.below(static_cast<uint64_t>(slab.get_cache_count())));
+                auto a = Clock::now();
+                long long handle = slab.alloc(cache, cpu);
+                auto b = Clock::now();
+                result.object_latency.record(elapsed_ns(a, b));
+                if (handle < 0) {
+                    result.failures++;
+                } else {
+                    objects.push_back({cache, handle});
+                }
+            } else {
+                size_t victim = rng.below(objects.size());
+                Object object = objects[victim];
+                objects[victim] = objects.back();
+                objects.pop_back();
+                auto a = Clock::now();
+                slab.free(object.cache, cpu, object.handle);
+                auto b = Clock::now();
+                result.object_latency.record(elapsed_ns(a, b));
+            }
+        } else {
+            // Páginas: mayoría de orden 0, algunos bloques y pocas huge pages;
+            // se libera más cuando queda menos de un cuarto libre
+            bool allocate = blocks.empty() ||
+                            rng.below(100) < (buddy.get_free_frames() * 4 > frames ? 55u : 35u);
+            if (allocate) {
+                uint64_t kind = rng.below(100);
+                int order = kind < 80 ? 0 : kind < 95 ? 1 + static_cast<int>(rng.below(3)) : huge_order;
+                auto a = Clock::now();
+                int frame = buddy.allocate(order);
+                auto b = Clock::now();
+                result.page_latency.record(elapsed_ns(a, b));
+                if (frame < 0) {
+                    result.failures++;
+                } else {
+                    blocks.push_back({frame, order});
+                }
+            } else {
+                size_t victim = rng.below(blocks.size());
+                Block block = blocks[victim];
+                blocks[victim] = blocks.back();
+                blocks.pop_back();
+                auto a = Clock::now();
+                buddy.free(block.frame, block.order);
+                auto b = Clock::now();
+                result.page_latency.record(elapsed_ns(a, b));
+            }
+        }
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    result.operations = operations;
+
+    if (verbose) {
+        std::cout << Color::BLUE << Color::BOLD << "\n▶ Benchmark de asignadores: " << operations
+                  << " operaciones sobre " << frames << " frames, " << cpus << " CPUs"
+                  << Color::RESET << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "   ├─ Throughput:         "
+                  << (result.seconds > 0 ? operations / result.seconds / 1e6 : 0.0) << " M ops/s" << std::endl;
+        std::cout << "   ├─ Fallidas:           " << result.failures << std::endl;
+        std::cout << "   ├─ Buddy (ns):         media " << result.page_latency.mean()
+                  << ", p50 " << result.page_latency.percentile(0.5)
+                  << ", p99 " << result.page_latency.percentile(0.99) << std::endl;
+        std::cout << "   ├─ Slab (ns):          media " << result.object_latency.mean()
+                  << ", p50 " << result.object_latency.percentile(0.5)
+                  << ", p99 " << result.object_latency.percentile(0.99) << std::endl;
+        std::cout << "   ├─ Frames libres:      " << buddy.get_free_frames() << " de " << frames
+                  << " (" << slab.get_slab_frames() << " en slabs)" << std::endl;
+        std::cout << "   └─ Fragmentación:      orden 3 " << buddy.fragmentation(3) * 100
+                  << "%, orden " << huge_order << " " << buddy.fragmentation(huge_order) * 100
+                  << "%" << std::endl;
+        std::cout << std::endl;
+        slab.display_stats();
+    }
+    return result;
+}
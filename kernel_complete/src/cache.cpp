@@ -0,0 +1,247 @@
+#include "../include/cache.hpp"
+#include "../include/utils.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+
+namespace {
+    int log2_floor(uint64_t n) {
+        int bits = 0;
+        while (n > 1) {
+            n >>= 1;
+            bits++;
+        }
+        return bits;
+    }
+}
+
+bool parse_cache_option(const std::string& token, CacheConfig& config) {
+    size_t eq = token.find('=');
+    if (eq == std::string::npos) {
+        return false;
+    }
+    std::string key = token.substr(0, eq);
+    std::string value = token.substr(eq + 1);
+
+    // Niveles: tamaño_kb:ways:latencia; "off" quita el nivel
+    for (const char* level : {"l1", "l2", "llc"}) {
+        if (key != level) {
+            continue;
+        }
+        std::string name = key == "llc" ? "LLC" : key == "l1" ? "L1" : "L2";
+        auto it = std::find_if(config.levels.begin(), config.levels.end(),
+                               [&name](const CacheLevelConfig& c) { return c.name == name; });
+        if (value == "off") {
+            if (it != config.levels.end()) config.levels.erase(it);
+            return true;
+        }
+        CacheLevelConfig parsed{name, 0, 0, 0};
+        char sep1 = 0, sep2 = 0;
+        std::istringstream fields(value);
+        if (!(fields >> parsed.size_kb >> sep1 >> parsed.ways >> sep2 >> parsed.latency) ||
+            sep1 != ':' || sep2 != ':' || parsed.size_kb <= 0 || parsed.latency <= 0 ||
+            parsed.ways <= 0 || parsed.ways > 64 || (parsed.ways & (parsed.ways - 1)) != 0) {
+            return false;
+        }
+        if (it != config.levels.end()) {
+            *it = parsed;
+        } else {
+            // Mantener el orden L1, L2, LLC
+            auto rank = [](const std::string& n) { return n == "L1" ? 0 : n == "L2" ? 1 : 2; };
+            auto pos = std::find_if(config.levels.begin(), config.levels.end(),
+                                    [&](const CacheLevelConfig& c) { return rank(c.name) > rank(name); });
+            config.levels.insert(pos, parsed);
+        }
+        return true;
+    }
+
+    long long number = std::atoll(value.c_str());
+    if (number <= 0) {
+        return false;
+    }
+    if (key == "lines") {
+        config.page_lines = static_cast<int>(std::min(number, 4096LL));
+    } else if (key == "line") {
+        if ((number & (number - 1)) != 0 || number > 4096) return false;
+        config.line_size = static_cast<int>(number);
+    } else if (key == "dram") {
+        config.dram_latency = static_cast<int>(number);
+    } else if (key == "walk") {
+        config.walk_cycles = static_cast<int>(number);
+    } else if (key == "fault") {
+        config.fault_cycles = number;
+    } else if (key == "pool") {
+        config.pool_cycles = number;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+CacheLevel::CacheLevel(const CacheLevelConfig& config, int line_size)
+    : name_(config.name),
+      latency_(config.latency),
+      ways_(config.ways),
+      depth_(log2_floor(static_cast<uint64_t>(config.ways))),
+      hits_(0),
+      misses_(0) {
+    // Conjuntos en potencia de 2 (se redondea hacia abajo), al menos uno
+    uint64_t lines = static_cast<uint64_t>(config.size_kb) * 1024 / line_size;
+    set_bits_ = log2_floor(std::max<uint64_t>(1, lines / ways_));
+    sets_ = 1ULL << set_bits_;
+    tags_.assign(sets_ * ways_, INVALID);
+    plru_.assign(sets_, 0);
+}
+
+void CacheLevel::touch(uint64_t& tree, int way) const {
+    // Cada nodo del camino apunta a la mitad que no se acaba de usar
+    int node = 1;
+    for (int d = depth_ - 1; d >= 0; d--) {
+        int bit = (way >> d) & 1;
+        if (bit) {
+            tree &= ~(1ULL << node);
+        } else {
+            tree |= 1ULL << node;
+        }
+        node = 2 * node + bit;
+    }
+}
+
+int CacheLevel::victim(uint64_t tree) const {
+    int node = 1, way = 0;
+    for (int d = 0; d < depth_; d++) {
+        int bit = static_cast<int>((tree >> node) & 1);
+        way = 2 * way + bit;
+        node = 2 * node + bit;
+    }
+    return way;
+}
+
+bool CacheLevel::access(uint64_t line) {
+    uint64_t set = line & (sets_ - 1);
+    uint64_t tag = line >> set_bits_;
+    uint64_t* slots = &tags_[set * ways_];
+
+    unsigned long long hit = match(slots, tag);
+    if (hit != 0) {
+        hits_++;
+        touch(plru_[set], __builtin_ctzll(hit));
+        return true;
+    }
+
+    // Fallo: primero un slot inválido, si no la víctima del árbol
+    misses_++;
+    unsigned long long empty = match(slots, INVALID);
+    int way = empty != 0 ? __builtin_ctzll(empty) : victim(plru_[set]);
+    slots[way] = tag;
+    touch(plru_[set], way);
+    return false;
+}
+
+void CacheLevel::invalidate(uint64_t line) {
+    uint64_t set = line & (sets_ - 1);
+    uint64_t* slots = &tags_[set * ways_];
+    unsigned long long hit = match(slots, line >> set_bits_);
+    if (hit != 0) {
+        slots[__builtin_ctzll(hit)] = INVALID;
+    }
+}
+
+CacheHierarchy::CacheHierarchy(const CacheConfig& config, int frames, int page_size)
+    : config_(config),
+      lines_per_page_(std::max(1, page_size / config.line_size)),
+      hot_lines_(std::clamp(config.page_lines, 1, lines_per_page_)),
+      cursor_(frames, 0),
+      accesses_(0),
+      dram_accesses_(0),
+      walks_(0),
+      faults_(0),
+      cache_cycles_(0),
+      walk_cycles_(0),
+      fault_cycles_(0) {
+    for (const auto& level : config_.levels) {
+        levels_.emplace_back(level, config_.line_size);
+    }
+}
+
+void CacheHierarchy::access(int frame, uint64_t page, bool walk, long long fault_cycles) {
+    accesses_++;
+    if (walk) {
+        walks_++;
+        walk_cycles_ += config_.walk_cycles;
+    }
+    if (fault_cycles > 0) {
+        faults_++;
+        fault_cycles_ += fault_cycles;
+    }
+
+    // Dirección física: frame y línea siguiente del recorrido dentro de la página
+    int step = cursor_[frame];
+    cursor_[frame] = static_cast<uint16_t>(step + 1 == hot_lines_ ? 0 : step + 1);
+    uint64_t first = ((page * 0x9E3779B97F4A7C15ULL) >> 40) % static_cast<uint64_t>(lines_per_page_);
+    uint64_t line = static_cast<uint64_t>(frame) * lines_per_page_ + (first + step) % lines_per_page_;
+
+    // Se baja nivel por nivel sumando latencias; cada fallo llena ese nivel
+    for (auto& level : levels_) {
+        cache_cycles_ += level.get_latency();
+        if (level.access(line)) {
+            return;
+        }
+    }
+    dram_accesses_++;
+    cache_cycles_ += config_.dram_latency;
+}
+
+void CacheHierarchy::invalidate_frame(int frame) {
+    // Contenido nuevo por DMA: ninguna línea vieja del frame sigue valiendo
+    uint64_t first = static_cast<uint64_t>(frame) * lines_per_page_;
+    for (auto& level : levels_) {
+        for (int i = 0; i < lines_per_page_; i++) {
+            level.invalidate(first + i);
+        }
+    }
+    cursor_[frame] = 0;
+}
+
+double CacheHierarchy::amat() const {
+    if (accesses_ == 0) return 0.0;
+    return static_cast<double>(cache_cycles_ + walk_cycles_ + fault_cycles_) / accesses_;
+}
+
+void CacheHierarchy::display_stats() const {
+    print_header("JERARQUÍA DE CACHÉS");
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << " Accesos:               " << accesses_ << " (línea de " << config_.line_size
+              << " B, " << hot_lines_ << " líneas por página)" << std::endl;
+
+    std::cout << "\n " << std::left << std::setw(6) << "Nivel" << std::right
+              << std::setw(10) << "Tamaño" << std::setw(7) << "Ways" << std::setw(8) << "Sets"
+              << std::setw(9) << "Ciclos" << std::setw(12) << "Aciertos" << std::setw(11) << "Fallos"
+              << std::setw(9) << "Hit %" << std::setw(10) << "Global %" << std::endl;
+    print_separator(82);
+    for (const auto& level : levels_) {
+        long long lookups = level.get_hits() + level.get_misses();
+        long long kb = static_cast<long long>(level.get_sets()) * level.get_ways() * config_.line_size / 1024;
+        std::cout << " " << std::left << std::setw(6) << level.get_name() << std::right
+                  << std::setw(10) << (std::to_string(kb).append(" KB"))
+                  << std::setw(7) << level.get_ways() << std::setw(8) << level.get_sets()
+                  << std::setw(9) << level.get_latency()
+                  << std::setw(12) << level.get_hits() << std::setw(11) << level.get_misses()
+                  << std::setw(9) << (lookups > 0 ? 100.0 * level.get_hits() / lookups : 0.0)
+                  << std::setw(10) << (accesses_ > 0 ? 100.0 * level.get_hits() / accesses_ : 0.0)
+                  << std::endl;
+    }
+    std::cout << " " << std::left << std::setw(6) << "DRAM" << std::right << std::setw(34)
+              << config_.dram_latency << std::setw(12) << dram_accesses_ << std::endl;
+
+    // AMAT desglosado: cuánto aporta cada fuente de latencia por acceso
+    double n = accesses_ > 0 ? static_cast<double>(accesses_) : 1.0;
+    std::cout << "\n AMAT:                  " << amat() << " ciclos/acceso" << std::endl;
+    std::cout << "  ├─ Cachés + DRAM:     " << cache_cycles_ / n << std::endl;
+    std::cout << "  ├─ Page walks:        " << walk_cycles_ / n << " (" << walks_ << " walks de "
+              << config_.walk_cycles << " ciclos)" << std::endl;
+    std::cout << "  └─ Page faults:       " << fault_cycles_ / n << " (" << faults_ << " faults)" << std::endl;
+    std::cout << std::endl;
+}
@@ -0,0 +1,123 @@
+#include "../include/checkpoint.hpp"
+#include <algorithm>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    const char MAGIC[8] = {'K', 'S', 'I', 'M', 'C', 'K', 'P', 'T'};
+
+    uint64_t align8(uint64_t value) {
+        return (value + 7) & ~uint64_t(7);
+    }
+}
+
+bool CheckpointWriter::write(const std::string& path) {
+    // Calcular offsets: tabla de secciones seguida de los datos alineados
+    uint64_t offset = align8(sizeof(CheckpointHeader) + sizeof(SectionEntry) * sections_.size());
+    for (size_t i = 0; i < sections_.size(); i++) {
+        sections_[i].offset = offset;
+        offset = align8(offset + payloads_[i].size());
+    }
+
+    CheckpointHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = CHECKPOINT_VERSION;
+    header.section_count = static_cast<uint32_t>(sections_.size());
+    header.file_size = offset;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    std::vector<char> image(offset, 0);
+    std::memcpy(image.data(), &header, sizeof(header));
+    std::memcpy(image.data() + sizeof(header), sections_.data(),
+                sizeof(SectionEntry) * sections_.size());
+    for (size_t i = 0; i < sections_.size(); i++) {
+        if (!payloads_[i].empty()) {
+            std::memcpy(image.data() + sections_[i].offset, payloads_[i].data(), payloads_[i].size());
+        }
+    }
+    out.write(image.data(), static_cast<std::streamsize>(image.size()));
+    bytes_ = image.size();
+    return static_cast<bool>(out);
+}
+
+CheckpointReader::~CheckpointReader() {
+    close();
+}
+
+void CheckpointReader::close() {
+    if (base_ != nullptr) {
+        munmap(const_cast<char*>(base_), size_);
+    }
+    base_ = nullptr;
+    size_ = 0;
+    table_ = nullptr;
+    section_count_ = 0;
+}
+
+bool CheckpointReader::open(const std::string& path) {
+    close();
+    error_.clear();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error_ = "no se pudo abrir " + path;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(CheckpointHeader))) {
+        ::close(fd);
+        error_ = "archivo demasiado corto";
+        return false;
+    }
+    void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        error_ = "mmap falló";
+        return false;
+    }
+    base_ = static_cast<const char*>(mapped);
+    size_ = static_cast<size_t>(info.st_size);
+
+    // Validar encabezado, versión y límites de cada sección
+    const CheckpointHeader* header = reinterpret_cast<const CheckpointHeader*>(base_);
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        error_ = "no es un checkpoint del simulador";
+    } else if (header->version != CHECKPOINT_VERSION) {
+        error_ = "versión " + std::to_string(header->version) + " no soportada (se espera "
+                 + std::to_string(CHECKPOINT_VERSION) + ")";
+    } else if (header->file_size != size_ ||
+               sizeof(CheckpointHeader) + sizeof(SectionEntry) * uint64_t(header->section_count) > size_) {
+        error_ = "archivo truncado";
+    } else {
+        table_ = reinterpret_cast<const SectionEntry*>(base_ + sizeof(CheckpointHeader));
+        section_count_ = header->section_count;
+        for (uint32_t i = 0; i < section_count_; i++) {
+            const SectionEntry& entry = table_[i];
+            if (entry.offset % 8 != 0 || entry.offset > size_ ||
+                entry.count > (size_ - entry.offset) / std::max<uint32_t>(entry.record_size, 1)) {
+                error_ = "sección " + std::to_string(entry.id) + " fuera de rango";
+                break;
+            }
+        }
+        if (error_.empty()) {
+            return true;
+        }
+    }
+    close();
+    return false;
+}
+
+const SectionEntry* CheckpointReader::find(CheckpointSection id) const {
+    for (uint32_t i = 0; i < section_count_; i++) {
+        if (table_[i].id == static_cast<uint32_t>(id)) {
+            return &table_[i];
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,252 @@
+#include "../include/device.hpp"
+#include "../include/utils.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <atomic>
+
+DiskDevice::DiskDevice(int id, int cylinders, DiskPolicy policy,
+                       int transfer_time, double seek_per_cylinder)
+    : id_(id),
+      cylinders_(cylinders),
+      policy_(policy),
+      transfer_time_(transfer_time),
+      seek_per_cylinder_(seek_per_cylinder),
+      head_(0),
+      moving_up_(true),
+      busy_(false),
+      in_service_{-1, 0, 0},
+      pending_count_(0),
+      completed_(0),
+      total_seek_(0),
+      total_response_(0),
+      busy_time_(0),
+      busy_since_(0),
+      depth_area_(0.0),
+      depth_since_(0),
+      max_depth_(0) {
+}
+
+void DiskDevice::note_depth_change(SimTime now) {
+    depth_area_ += static_cast<double>(pending_count_) * (now - depth_since_);
+    depth_since_ = now;
+}
+
+bool DiskDevice::enqueue(const IORequest& request, SimTime now) {
+    note_depth_change(now);
+    if (policy_ == DiskPolicy::FCFS) {
+        fifo_.push_back(request);
+    } else {
+        by_cylinder_.emplace(request.cylinder, request);
+    }
+    pending_count_++;
+    max_depth_ = std::max(max_depth_, static_cast<int>(pending_count_));
+    return !busy_;
+}
+
+std::multimap<int, IORequest>::iterator DiskDevice::pick_sorted(int& distance) {
+    auto up = by_cylinder_.lower_bound(head_);
+
+    switch (policy_) {
+        case DiskPolicy::SSTF: {
+            // Vecino más cercano a cada lado del cabezal
+            auto best = up;
+            if (up == by_cylinder_.end() ||
+                (up != by_cylinder_.begin() &&
+                 head_ - std::prev(up)->first <= up->first - head_)) {
+                best = std::prev(up);
+            }
+            distance = std::abs(best->first - head_);
+            return best;
+        }
+        case DiskPolicy::SCAN: {
+            if (moving_up_) {
+                if (up != by_cylinder_.end()) {
+                    distance = up->first - head_;
+                    return up;
+                }
+                // Llega al borde superior y regresa
+                moving_up_ = false;
+                auto down = std::prev(by_cylinder_.end());
+                distance = (cylinders_ - 1 - head_) + (cylinders_ - 1 - down->first);
+                return down;
+            }
+            auto above = by_cylinder_.upper_bound(head_);
+            if (above != by_cylinder_.begin()) {
+                auto down = std::prev(above);
+                distance = head_ - down->first;
+                return down;
+            }
+            // Llega al cilindro 0 y regresa
+            moving_up_ = true;
+            auto first = by_cylinder_.begin();
+            distance = head_ + first->first;
+            return first;
+        }
+        case DiskPolicy::CLOOK:
+        default: {
+            if (up != by_cylinder_.end()) {
+                distance = up->first - head_;
+                return up;
+            }
+            // Salto a la solicitud más baja
+            auto first = by_cylinder_.begin();
+            distance = head_ - first->first;
+            return first;
+        }
+    }
+}
+
+int DiskDevice::start_next(SimTime now) {
+    note_depth_change(now);
+
+    int distance = 0;
+    if (policy_ == DiskPolicy::FCFS) {
+        in_service_ = fifo_.front();
+        fifo_.pop_front();
+        distance = std::abs(in_service_.cylinder - head_);
+    } else {
+        auto it = pick_sorted(distance);
+        in_service_ = it->second;
+        by_cylinder_.erase(it);
+    }
+    pending_count_--;
+
+    head_ = in_service_.cylinder;
+    total_seek_ += distance;
+    busy_ = true;
+    busy_since_ = now;
+
+    return transfer_time_ + static_cast<int>(std::lround(distance * seek_per_cylinder_));
+}
+
+IORequest DiskDevice::complete(SimTime now) {
+    busy_ = false;
+    busy_time_ += now - busy_since_;
+    completed_++;
+    total_response_ += now - in_service_.issued;
+    return in_service_;
+}
+
+void DiskDevice::display_stats(SimTime now) const {
+    SimTime busy = busy_time_ + (busy_ ? now - busy_since_ : 0);
+    double area = depth_area_ + static_cast<double>(pending_count_) * (now - depth_since_);
+
+    std::cout << " Disco " << id_ << " (" << cylinders_ << " cilindros, cabezal en "
+              << head_ << ")" << std::endl;
+    std::cout << "   ├─ Completadas:        " << completed_ << std::endl;
+    std::cout << "   ├─ Utilización:        "
+              << (now > 0 ? 100.0 * busy / now : 0.0) << "%" << std::endl;
+    std::cout << "   ├─ Cola actual/máx:    " << pending_count_ << " / " << max_depth_ << std::endl;
+    std::cout << "   ├─ Cola promedio:      " << (now > 0 ? area / now : 0.0) << std::endl;
+    std::cout << "   ├─ Seek promedio:      "
+              << (completed_ > 0 ? (double)total_seek_ / completed_ : 0.0) << " cilindros" << std::endl;
+    std::cout << "   └─ Respuesta promedio: "
+              << (completed_ > 0 ? (double)total_response_ / completed_ : 0.0) << " ticks" << std::endl;
+}
+
+DeviceManager::DeviceManager(SimulationKernel& kernel, int disks, DiskPolicy policy,
+                             int mean_cpu_between_io, uint64_t seed, bool verbose)
+    : kernel_(kernel),
+      policy_(policy),
+      mean_cpu_between_io_(mean_cpu_between_io),
+      rng_(seed),
+      in_flight_(0),
+      submitted_(0) {
+
+    // Atómico: los barridos crean subsistemas en varios hilos
+    static std::atomic<long long> next_generation{0};
+    generation_ = ++next_generation;
+
+    for (int i = 0; i < disks; i++) {
+        disks_.emplace_back(i, 200, policy, 2, 0.05);
+    }
+
+    kernel_.on(EventType::IO_COMPLETION, [this](const Event& e) { handle_completion(e); });
+
+    if (verbose) {
+        std::cout << Color::GREEN << "[IO] " << disks << " disco(s) " << policy_to_string(policy)
+                  << " (E/S cada ~" << mean_cpu_between_io << " ticks de CPU)"
+                  << Color::RESET << std::endl;
+    }
+}
+
+DeviceManager::~DeviceManager() {
+    // El kernel sobrevive al subsistema: no debe quedar un handler colgando
+    kernel_.on(EventType::IO_COMPLETION, nullptr);
+}
+
+int DeviceManager::draw_cpu_burst() {
+    double value = -std::log1p(-rng_.uniform()) * mean_cpu_between_io_;
+    return std::max(1, static_cast<int>(std::ceil(value)));
+}
+
+void DeviceManager::submit(int pid) {
+    int disk = pid % static_cast<int>(disks_.size());
+    int cylinder = static_cast<int>(rng_.below(200));
+    submitted_++;
+    in_flight_++;
+
+    if (disks_[disk].enqueue({pid, cylinder, kernel_.now()}, kernel_.now())) {
+        start_service(disk);
+    }
+}
+
+void DeviceManager::start_service(int disk) {
+    int service = disks_[disk].start_next(kernel_.now());
+    kernel_.schedule_after(service, EventType::IO_COMPLETION, -1, (generation_ << DISK_BITS) | disk);
+}
+
+void DeviceManager::handle_completion(const Event& event) {
+    // Interrupción de fin de E/S
+    if ((event.data >> DISK_BITS) != generation_) {
+        return;
+    }
+    int disk = static_cast<int>(event.data & (MAX_DISKS - 1));
+    IORequest done = disks_[disk].complete(kernel_.now());
+    in_flight_--;
+
+    if (disks_[disk].queue_depth() > 0) {
+        start_service(disk);
+    }
+    if (wake_) {
+        wake_(done.pid);
+    }
+}
+
+void DeviceManager::display_stats() const {
+    print_header("DISPOSITIVOS DE E/S (t=" + std::to_string(kernel_.now()) + ")");
+
+    std::cout << " Política de disco:     " << policy_to_string(policy_) << std::endl;
+    std::cout << " CPU entre E/S:         ~" << mean_cpu_between_io_ << " ticks" << std::endl;
+    std::cout << " Solicitudes emitidas:  " << submitted_ << std::endl;
+    std::cout << "  └─ En curso:          " << in_flight_ << std::endl;
+    std::cout << std::endl;
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& disk : disks_) {
+        disk.display_stats(kernel_.now());
+    }
+    std::cout << std::endl;
+}
+
+std::string DeviceManager::policy_to_string(DiskPolicy policy) {
+    switch (policy) {
+        case DiskPolicy::FCFS: return "FCFS";
+        case DiskPolicy::SSTF: return "SSTF";
+        case DiskPolicy::SCAN: return "SCAN";
+        case DiskPolicy::CLOOK: return "C-LOOK";
+        default: return "UNKNOWN";
+    }
+}
+
+bool DeviceManager::parse_policy(const std::string& name, DiskPolicy& policy) {
+    if (name == "fcfs") policy = DiskPolicy::FCFS;
+    else if (name == "sstf") policy = DiskPolicy::SSTF;
+    else if (name == "scan") policy = DiskPolicy::SCAN;
+    else if (name == "clook") policy = DiskPolicy::CLOOK;
+    else return false;
+    return true;
+}
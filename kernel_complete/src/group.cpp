@@ -0,0 +1,501 @@
+#include "../include/group.hpp"
+#include "../include/scheduler.hpp"
+#include "../include/utils.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+namespace {
+    // El id del grupo viaja en los 20 bits bajos del evento de recarga
+    constexpr int MAX_GROUPS = 1 << 20;
+    constexpr int MAX_WEIGHT = 10000;
+    constexpr size_t MAX_ROWS = 40;
+}
+
+GroupScheduler::GroupScheduler(SimulationKernel& kernel, bool verbose)
+    : kernel_(kernel),
+      verbose_(verbose),
+      default_group_(ROOT),
+      ready_count_(0) {
+
+    static std::atomic<long long> next_generation{0};
+    generation_ = ++next_generation;
+
+    kernel_.on(EventType::GROUP_REFILL, [this](const Event& e) { handle_refill(e); });
+
+    ProcessGroup root{};
+    root.name.assign(1, '/');
+    root.parent = -1;
+    root.weight = TASK_WEIGHT;
+    root.period = 100;
+    root.period_start = kernel_.now();
+    groups_.push_back(root);
+    names_[root.name] = ROOT;
+
+    if (verbose_) {
+        std::cout << Color::GREEN << "[GRP] Planificación por grupos activa (raíz \"/\")"
+                  << Color::RESET << std::endl;
+    }
+}
+
+GroupScheduler::~GroupScheduler() {
+    kernel_.on(EventType::GROUP_REFILL, nullptr);
+}
+
+int GroupScheduler::create_group(const std::string& name, int parent, int weight) {
+    if (name.empty() || names_.count(name) || parent < 0 || parent >= get_group_count() ||
+        weight < 1 || weight > MAX_WEIGHT || get_group_count() >= MAX_GROUPS) {
+        return -1;
+    }
+    ProcessGroup group{};
+    group.name = name;
+    group.parent = parent;
+    group.depth = groups_[parent].depth + 1;
+    group.weight = weight;
+    group.period = 100;
+    group.period_start = kernel_.now();
+    group.vruntime = groups_[parent].min_vruntime;
+
+    int id = get_group_count();
+    groups_.push_back(std::move(group));
+    names_[name] = id;
+    return id;
+}
+
+int GroupScheduler::find_group(const std::string& name) const {
+    auto it = names_.find(name);
+    if (it != names_.end()) {
+        return it->second;
+    }
+    // También se acepta el id numérico
+    if (name.empty() || name.find_first_not_of("0123456789") != std::string::npos || name.size() > 7) {
+        return -1;
+    }
+    int id = std::stoi(name);
+    return id < get_group_count() ? id : -1;
+}
+
+bool GroupScheduler::set_weight(int group, int weight) {
+    if (group <= ROOT || group >= get_group_count() || weight < 1 || weight > MAX_WEIGHT) {
+        return false;
+    }
+    groups_[group].weight = weight;
+    return true;
+}
+
+bool GroupScheduler::set_quota(int group, long long quota, long long period) {
+    if (group <= ROOT || group >= get_group_count() || period <= 0 || quota > period) {
+        return false;
+    }
+    ProcessGroup& g = groups_[group];
+    g.quota = std::max(0LL, quota);
+    g.period = period;
+    g.period_start = kernel_.now();
+    g.used = 0;
+
+    // El nuevo límite rige desde ahora: un grupo frenado vuelve a competir
+    // (la recarga pendiente del período viejo se descarta por su instante)
+    if (g.throttled) {
+        g.throttled_ticks += kernel_.now() - g.throttled_since;
+        g.throttled = false;
+        sync_queue(group);
+    }
+    return true;
+}
+
+int GroupScheduler::group_of(int pid) {
+    if (pid >= static_cast<int>(membership_.size())) {
+        membership_.resize(std::max<size_t>(static_cast<size_t>(pid) + 1, membership_.size() * 2), -1);
+    }
+    if (membership_[pid] < 0) {
+        membership_[pid] = default_group_;
+    }
+    return membership_[pid];
+}
+
+void GroupScheduler::move(int pid, int group, bool ready) {
+    int old = group_of(pid);
+    if (old == group) {
+        return;
+    }
+    membership_[pid] = group;
+    if (!ready) {
+        return;
+    }
+    std::deque<int>& tasks = groups_[old].tasks;
+    auto it = std::find(tasks.begin(), tasks.end(), pid);
+    if (it != tasks.end()) {
+        tasks.erase(it);
+        sync_tasks(old);
+        groups_[group].tasks.push_back(pid);
+        sync_tasks(group);
+    }
+}
+
+void GroupScheduler::enqueue(int pid) {
+    int group = group_of(pid);
+    groups_[group].tasks.push_back(pid);
+    ready_count_++;
+    if (!groups_[group].tasks_queued) {
+        sync_tasks(group);
+    }
+}
+
+int GroupScheduler::pick() {
+    if (!has_ready()) {
+        return -1;
+    }
+    // Bajar por el menor vruntime de cada nivel hasta una cola de procesos
+    int id = ROOT;
+    for (;;) {
+        int next = groups_[id].runnable.begin()->second;
+        if (next < 0) {
+            break;
+        }
+        id = next;
+    }
+    ProcessGroup& g = groups_[id];
+    int pid = g.tasks.front();
+    g.tasks.pop_front();
+    ready_count_--;
+    if (g.tasks.empty()) {
+        sync_tasks(id);
+    }
+    return pid;
+}
+
+std::vector<int> GroupScheduler::drain() {
+    std::vector<int> pids;
+    pids.reserve(ready_count_);
+    for (auto& g : groups_) {
+        pids.insert(pids.end(), g.tasks.begin(), g.tasks.end());
+        g.tasks.clear();
+        g.runnable.clear();
+        g.queued = false;
+        g.tasks_queued = false;
+    }
+    ready_count_ = 0;
+    return pids;
+}
+
+void GroupScheduler::charge(int pid, long long ticks) {
+    if (ticks <= 0) {
+        return;
+    }
+    int id = group_of(pid);
+    ProcessGroup& own = groups_[id];
+    own.own_ticks += ticks;
+    double old = own.tasks_vruntime;
+    own.tasks_vruntime += static_cast<double>(ticks);
+    if (own.tasks_queued) {
+        reposition(own, -1, old, own.tasks_vruntime);
+    }
+    update_min(own, own.tasks_vruntime);
+
+    // Cada ancestro paga los ticks con su peso y con su quota
+    for (; id >= 0; id = groups_[id].parent) {
+        ProcessGroup& g = groups_[id];
+        refresh_period(g);
+        g.cpu_ticks += ticks;
+        if (id != ROOT) {
+            ProcessGroup& parent = groups_[g.parent];
+            old = g.vruntime;
+            g.vruntime += static_cast<double>(ticks) * TASK_WEIGHT / g.weight;
+            if (g.queued) {
+                reposition(parent, id, old, g.vruntime);
+            }
+            update_min(parent, g.vruntime);
+        }
+        if (g.quota > 0) {
+            g.used += ticks;
+            if (g.used >= g.quota && !g.throttled) {
+                throttle(id);
+            }
+        }
+    }
+}
+
+void GroupScheduler::record_dispatch(int pid, long long wait) {
+    ProcessGroup& g = groups_[group_of(pid)];
+    g.dispatches++;
+    g.wait_sum += wait;
+    g.wait_max = std::max(g.wait_max, wait);
+}
+
+bool GroupScheduler::is_throttled(int pid) {
+    for (int id = group_of(pid); id >= 0; id = groups_[id].parent) {
+        if (groups_[id].throttled) {
+            return true;
+        }
+    }
+    return false;
+}
+
+long long GroupScheduler::slice_budget(int pid) {
+    long long budget = SimulationKernel::NEVER;
+    for (int id = group_of(pid); id >= 0; id = groups_[id].parent) {
+        ProcessGroup& g = groups_[id];
+        if (g.quota > 0) {
+            refresh_period(g);
+            budget = std::min(budget, g.quota - g.used);
+        }
+    }
+    return budget;
+}
+
+void GroupScheduler::refresh_period(ProcessGroup& group) {
+    // Los grupos que no llegan a su quota no programan eventos: el período
+    // se renueva al cargarles ticks
+    SimTime now = kernel_.now();
+    if (group.throttled || now < group.period_start + group.period) {
+        return;
+    }
+    group.period_start = now - (now - group.period_start) % group.period;
+    group.used = 0;
+}
+
+void GroupScheduler::sync_tasks(int group) {
+    ProcessGroup& g = groups_[group];
+    bool want = !g.tasks.empty();
+    if (want == g.tasks_queued) {
+        return;
+    }
+    if (want) {
+        g.tasks_vruntime = std::max(g.tasks_vruntime, g.min_vruntime);
+        g.runnable.emplace(g.tasks_vruntime, -1);
+    } else {
+        g.runnable.erase({g.tasks_vruntime, -1});
+    }
+    g.tasks_queued = want;
+    sync_queue(group);
+}
+
+void GroupScheduler::sync_queue(int group) {
+    // Un grupo compite en su padre si tiene algo listo y no está frenado;
+    // el cambio puede vaciar o llenar al padre, así que se propaga hacia arriba
+    for (int id = group; id != ROOT; id = groups_[id].parent) {
+        ProcessGroup& g = groups_[id];
+        ProcessGroup& parent = groups_[g.parent];
+        bool want = !g.throttled && !g.runnable.empty();
+        if (want == g.queued) {
+            return;
+        }
+        if (want) {
+            // Sin crédito acumulado por el tiempo que no compitió
+            g.vruntime = std::max(g.vruntime, parent.min_vruntime);
+            parent.runnable.emplace(g.vruntime, id);
+        } else {
+            parent.runnable.erase({g.vruntime, id});
+        }
+        g.queued = want;
+    }
+}
+
+void GroupScheduler::reposition(ProcessGroup& parent, int key, double old_vruntime, double vruntime) {
+    parent.runnable.erase({old_vruntime, key});
+    parent.runnable.emplace(vruntime, key);
+}
+
+void GroupScheduler::update_min(ProcessGroup& parent, double running_vruntime) {
+    double floor = running_vruntime;
+    if (!parent.runnable.empty()) {
+        floor = std::min(floor, parent.runnable.begin()->first);
+    }
+    parent.min_vruntime = std::max(parent.min_vruntime, floor);
+}
+
+void GroupScheduler::throttle(int group) {
+    ProcessGroup& g = groups_[group];
+    g.throttled = true;
+    g.throttled_since = kernel_.now();
+    g.throttle_events++;
+    sync_queue(group);
+
+    kernel_.schedule(g.period_start + g.period, EventType::GROUP_REFILL, -1,
+                     (generation_ << 20) | group);
+    if (verbose_) {
+        std::cout << Color::YELLOW << "[t=" << kernel_.now() << "] Grupo " << g.name
+                  << " agotó su quota (" << g.used << "/" << g.quota << ") hasta t="
+                  << g.period_start + g.period << Color::RESET << std::endl;
+    }
+}
+
+void GroupScheduler::handle_refill(const Event& event) {
+    if ((event.data >> 20) != generation_) {
+        return;
+    }
+    int id = static_cast<int>(event.data & (MAX_GROUPS - 1));
+    ProcessGroup& g = groups_[id];
+    // Recarga de un período reemplazado por set_quota
+    if (!g.throttled || event.time != g.period_start + g.period) {
+        return;
+    }
+    g.throttled_ticks += event.time - g.throttled_since;
+    g.throttled = false;
+    refresh_period(g);
+    sync_queue(id);
+}
+
+void GroupScheduler::display_stats() const {
+    print_header("GRUPOS DE PROCESOS");
+
+    const ProcessGroup& root = groups_[ROOT];
+    long long throttles = 0;
+    long long throttled_ticks = 0;
+    for (const auto& g : groups_) {
+        throttles += g.throttle_events;
+        throttled_ticks += g.throttled_ticks + (g.throttled ? kernel_.now() - g.throttled_since : 0);
+    }
+    std::cout << " Grupos:                " << groups_.size() << std::endl;
+    std::cout << " Listos:                " << ready_count_ << std::endl;
+    std::cout << " CPU cargada:           " << root.cpu_ticks << " ticks" << std::endl;
+    std::cout << " Throttles:             " << throttles << " (" << throttled_ticks
+              << " ticks frenados en total)" << std::endl;
+
+    // Recorrido en profundidad para mostrar la jerarquía
+    std::vector<std::vector<int>> children(groups_.size());
+    for (size_t id = 1; id < groups_.size(); id++) {
+        children[groups_[id].parent].push_back(static_cast<int>(id));
+    }
+
+    // Justo% = parte que el peso le da entre los hermanos con algo listo (los
+    // procesos directos del padre cuentan con peso 1024), por la del padre;
+    // la quota puede dejar a un grupo por debajo de esa parte
+    std::vector<double> fair(groups_.size(), 0.0);
+    fair[ROOT] = 1.0;
+
+    std::cout << "\n " << std::left << std::setw(24) << "Grupo" << std::right
+              << std::setw(6) << "Peso" << std::setw(10) << "Quota" << std::setw(10) << "CPU"
+              << std::setw(8) << "CPU%" << std::setw(8) << "Justo%" << std::setw(6) << "Thr"
+              << std::setw(10) << "Frenado" << std::setw(9) << "Espera" << std::setw(8) << "Máx"
+              << std::setw(7) << "Listos" << std::endl;
+    print_separator(106);
+
+    size_t rows = 0;
+    std::vector<int> stack{ROOT};
+    while (!stack.empty()) {
+        int id = stack.back();
+        stack.pop_back();
+        const ProcessGroup& g = groups_[id];
+
+        long long active = g.tasks_queued ? TASK_WEIGHT : 0;
+        for (int child : children[id]) {
+            if (!groups_[child].runnable.empty()) active += groups_[child].weight;
+        }
+        for (int child : children[id]) {
+            if (!groups_[child].runnable.empty()) {
+                fair[child] = fair[id] * groups_[child].weight / active;
+            }
+        }
+        for (auto it = children[id].rbegin(); it != children[id].rend(); ++it) {
+            stack.push_back(*it);
+        }
+
+        if (rows++ >= MAX_ROWS) {
+            continue;
+        }
+        std::string quota = g.quota > 0 ? std::to_string(g.quota).append("/").append(std::to_string(g.period)) : "-";
+        std::string name = std::string(static_cast<size_t>(std::min(g.depth, 6)) * 2, ' ').append(g.name);
+        if (g.throttled) name.append(" *");
+        if (name.size() > 23) name.resize(23);
+        long long throttled = g.throttled_ticks + (g.throttled ? kernel_.now() - g.throttled_since : 0);
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << " " << std::left << std::setw(24) << name << std::right
+                  << std::setw(6) << g.weight << std::setw(10) << quota << std::setw(10) << g.cpu_ticks
+                  << std::setw(8) << (root.cpu_ticks > 0 ? 100.0 * g.cpu_ticks / root.cpu_ticks : 0.0)
+                  << std::setw(8) << 100.0 * fair[id] << std::setw(6) << g.throttle_events
+                  << std::setw(10) << throttled
+                  << std::setw(9) << (g.dispatches > 0 ? static_cast<double>(g.wait_sum) / g.dispatches : 0.0)
+                  << std::setw(8) << g.wait_max << std::setw(7) << g.tasks.size() << std::endl;
+    }
+    if (rows > MAX_ROWS) {
+        std::cout << " ... " << rows - MAX_ROWS << " grupos más" << std::endl;
+    }
+    std::cout << " (* = frenado; Frenado en ticks; Espera = media en READY hasta el despacho)"
+              << std::endl << std::endl;
+}
+
+void run_group_bench(int groups, int processes, long long ticks, int quota_percent) {
+    // Los inquilinos pesados (uno de cada cuatro grupos) reciben 10 partes de procesos
+    const int heavy_share = 10;
+    int heavy = (groups + 3) / 4;
+    int shares = heavy * heavy_share + (groups - heavy);
+    std::vector<int> owner;
+    for (int g = 0; g < groups; g++) {
+        int count = std::max(1, processes * (g % 4 == 0 ? heavy_share : 1) / shares);
+        owner.insert(owner.end(), static_cast<size_t>(count), g);
+    }
+
+    std::cout << Color::BOLD << Color::BLUE << "\n▶ Grupos: " << groups << " inquilinos ("
+              << heavy << " pesados ×" << heavy_share << "), " << owner.size() << " procesos, "
+              << ticks << " ticks";
+    if (quota_percent > 0) {
+        std::cout << ", quota " << quota_percent << "% por grupo";
+    }
+    std::cout << Color::RESET << std::endl;
+
+    std::cout << std::left << "   " << std::setw(12) << "Modo" << std::right
+              << std::setw(14) << "CPU pesados%" << std::setw(12) << "Justo%"
+              << std::setw(12) << "ns/tick" << std::setw(12) << "Despachos"
+              << std::setw(11) << "Throttles" << std::endl;
+
+    int burst = static_cast<int>(std::min<long long>(ticks + 1, 1 << 30));
+    for (bool grouped : {false, true}) {
+        SimulationKernel kernel;
+        RoundRobinScheduler scheduler(4, &kernel);
+        scheduler.set_verbose(false);
+        std::unique_ptr<GroupScheduler> group_scheduler;
+        if (grouped) {
+            group_scheduler = std::make_unique<GroupScheduler>(kernel, false);
+            for (int g = 0; g < groups; g++) {
+                group_scheduler->create_group(std::string("t").append(std::to_string(g)),
+                                              GroupScheduler::ROOT, GroupScheduler::TASK_WEIGHT);
+                if (quota_percent > 0) {
+                    group_scheduler->set_quota(g + 1, std::max(1, quota_percent), 100);
+                }
+            }
+            scheduler.enable_groups(group_scheduler.get());
+        }
+
+        for (int g : owner) {
+            if (group_scheduler) group_scheduler->set_default_group(g + 1);
+            scheduler.create_process(burst);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        scheduler.run_until(ticks);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        long long heavy_cpu = 0;
+        long long total_cpu = 0;
+        for (size_t i = 0; i < owner.size(); i++) {
+            ProcessImage image = scheduler.get_table().get_image(static_cast<int>(i) + 1);
+            long long cpu = image.burst_time - image.remaining_time;
+            total_cpu += cpu;
+            if (owner[i] % 4 == 0) heavy_cpu += cpu;
+        }
+        long long dispatches = 0;
+        long long throttles = 0;
+        if (group_scheduler) {
+            for (int g = 0; g < group_scheduler->get_group_count(); g++) {
+                dispatches += group_scheduler->get_group(g).dispatches;
+                throttles += group_scheduler->get_group(g).throttle_events;
+            }
+            scheduler.disable_groups();
+        }
+
+        std::cout << std::fixed << std::setprecision(2) << std::left << "   "
+                  << std::setw(12) << (grouped ? "grupos" : "round robin") << std::right
+                  << std::setw(14) << (total_cpu > 0 ? 100.0 * heavy_cpu / total_cpu : 0.0)
+                  << std::setw(12) << 100.0 * heavy / groups
+                  << std::setw(12) << seconds * 1e9 / std::max(1LL, ticks);
+        if (grouped) {
+            std::cout << std::setw(12) << dispatches << std::setw(11) << throttles;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl;
+}
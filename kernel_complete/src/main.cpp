@@ -1,10 +1,30 @@
 #include "../include/scheduler.hpp"
 #include "../include/memory.hpp"
 #include "../include/sync.hpp"
+#include "../include/workload.hpp"
+#include "../include/device.hpp"
+#include "../include/sweep.hpp"
+#include "../include/static_sim.hpp"
+#include "../include/checkpoint.hpp"
+#include "../include/program.hpp"
+#include "../include/realtime.hpp"
+#include "../include/group.hpp"
+#include "../include/tuner.hpp"
+#include "../include/resource.hpp"
+#include "../include/sampler.hpp"
+#include "../include/allocator.hpp"
+#include "../include/pipeline.hpp"
+#include "../include/trace.hpp"
+#include "../include/stats_server.hpp"
 #include "../include/utils.hpp"
 #include <iostream>
+#include <thread>
 #include <sstream>
 #include <memory>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <cstdlib>
 
 void print_banner()
 {
@@ -33,16 +53,127 @@ void print_help()
     std::cout << "  tick              - Ejecutar 1 tick\n";
     std::cout << "  run <n>           - Ejecutar N ticks\n";
     std::cout << "  kill <pid>        - Terminar proceso\n";
+    std::cout << "  fork <pid> [n]    - Crear n hijos que comparten memoria (COW)\n";
+    std::cout << "  ps-bench <n>      - Medir operaciones masivas sobre n procesos\n";
     std::cout << "  cpu-stats         - Estadísticas del scheduler\n";
+    std::cout << "  quantum <n>       - Cambiar el quantum de Round Robin\n";
+    std::cout << "  ctx-cost <ticks>  - Costo de cada cambio de contexto\n";
+    std::cout << "  tune-init [global|class] [min=1] [max=64] [pct=80] [overhead=10] [resp=N] [window=500]\n";
+    std::cout << "                    - Ajustar el quantum en línea (ráfagas y respuesta)\n";
+    std::cout << "  tune-stats        - Trayectoria del quantum elegido\n";
+    std::cout << "  tune-off          - Dejar el quantum fijo en el último valor\n";
+    std::cout << "  tune-bench <ticks> [cost=1] [pct=..] [overhead=..] [resp=..] [window=..] - Fijos vs ajustado\n";
+
+    std::cout << "\n"
+              << Color::YELLOW << " TIEMPO REAL " << Color::RESET << std::endl;
+    std::cout << "  rt-init <edf|rm>  - Activar la clase de tiempo real\n";
+    std::cout << "  rt-new <período> <wcet> [deadline] [force] - Tarea periódica (admisión)\n";
+    std::cout << "  rt-off            - Desactivar tiempo real\n";
+    std::cout << "  rt-stats          - Deadlines perdidos, lateness y jitter\n";
+
+    std::cout << "\n"
+              << Color::YELLOW << " GRUPOS DE PROCESOS " << Color::RESET << std::endl;
+    std::cout << "  grp-init          - Planificar por grupos jerárquicos (raíz \"/\")\n";
+    std::cout << "  grp-new <nombre> [padre=/] [peso=1024] - Crear un grupo\n";
+    std::cout << "  grp-weight <grupo> <peso> - Peso relativo entre hermanos\n";
+    std::cout << "  grp-quota <grupo> <quota|off> [período=100] - Límite de CPU por período\n";
+    std::cout << "  grp-use <grupo>   - Grupo de los procesos nuevos\n";
+    std::cout << "  grp-move <pid> <grupo> - Mover un proceso de grupo\n";
+    std::cout << "  grp-stats         - CPU por grupo, parte justa, throttling y espera\n";
+    std::cout << "  grp-off           - Volver a la cola única de Round Robin\n";
+    std::cout << "  grp-bench <grupos> <procesos> <ticks> [quota%] - Aislamiento y costo con muchos grupos\n";
+
+    std::cout << "\n"
+              << Color::YELLOW << " PROGRAMAS (CORRUTINAS) " << Color::RESET << std::endl;
+    std::cout << "  spawn <cpu|interactive|producer|consumer|memory|io|mix> [n] - Crear programas\n";
+    std::cout << "  prog-buffer <capacidad> - Capacidad del buffer compartido\n";
+    std::cout << "  prog-stats        - Operaciones, buffer y pool de frames\n";
+    std::cout << "  prog-bench <n>    - Simular n programas sin trazas y medir\n";
 
     std::cout << "\n"
               << Color::YELLOW << " MEMORY MANAGEMENT " << Color::RESET << std::endl;
-    std::cout << "  mem-init <frames> - Inicializar memoria\n";
-    std::cout << "  mem-access <pid> <page> - Acceder a página\n";
+    std::cout << "  mem-init <frames> [fifo|lru|clock] - Inicializar memoria\n";
+    std::cout << "  mem-access <pid> <page> [w] - Acceder a página (w = escritura)\n";
     std::cout << "  mem-frames        - Ver estado de frames\n";
     std::cout << "  mem-table <pid>   - Ver page table de proceso\n";
     std::cout << "  mem-stats         - Estadísticas de memoria\n";
     std::cout << "  mem-reset         - Reiniciar estadísticas\n";
+    std::cout << "  mem-zswap <frames|off> [ticks] - Pool comprimido y costo de descompresión\n";
+    std::cout << "  zswap-stats       - Ratio, aciertos del pool y capacidad efectiva\n";
+    std::cout << "  mem-huge <factor|off> [tlb] - Huge pages de factor frames y TLB (1 = solo TLB)\n";
+    std::cout << "  huge-stats        - Promociones, alcance del TLB y fragmentación\n";
+    std::cout << "  mem-ipt <on|off>  - Page table invertida (hash global por frames)\n";
+    std::cout << "  cache-init [l1=kb:ways:ciclos] [l2=..] [llc=..|off] [line=64] [lines=8] [dram=200] [walk=100] [fault=100000] [pool=10000]\n";
+    std::cout << "                    - Cachés L1/L2/LLC con PLRU sobre los frames\n";
+    std::cout << "  cache-stats       - Aciertos por nivel y AMAT desglosado\n";
+    std::cout << "  cache-off         - Quitar el modelo de cachés\n";
+    std::cout << "  numa-init <nodos> [first|interleave] [local=80] [remote=140] [sample=64] [copy=2000] [migrate=on|off]\n";
+    std::cout << "                    - Frames en nodos NUMA con migración por muestreo\n";
+    std::cout << "  numa-home <pid> <nodo> - Fijar el nodo hogar de un proceso\n";
+    std::cout << "  numa-stats        - Accesos locales, causas de remotos y latencia efectiva\n";
+    std::cout << "  numa-off          - Quitar el modelo NUMA\n";
+    std::cout << "  pt-bench <procesos> [páginas] [frames] - Page table directa vs invertida\n";
+
+    std::cout << "\n"
+              << Color::YELLOW << " MEMORIA DEL KERNEL " << Color::RESET << std::endl;
+    std::cout << "  buddy-stats       - Listas libres por orden y fragmentación\n";
+    std::cout << "  slab-init <cpus> [magazine] - Capa slab sobre los frames de la memoria\n";
+    std::cout << "  kmalloc <cache> <n> [cpu] - Asignar n objetos del cache\n";
+    std::cout << "  kfree <cache> <n> [cpu] - Liberar los últimos n objetos del cache\n";
+    std::cout << "  slab-stats        - Caches, magazines y uso de slabs\n";
+    std::cout << "  slab-off          - Liberar objetos y slabs\n";
+    std::cout << "  alloc-bench <ops> [frames] [cpus] [magazine] - Carga mixta buddy+slab\n";
+
+    std::cout << "\n"
+              << Color::YELLOW << " CPU + MEMORIA " << Color::RESET << std::endl;
+    std::cout << "  couple <fault_ticks> [refs/tick] - Acoplar scheduler y memoria\n";
+    std::cout << "  decouple          - Volver a módulos independientes\n";
+    std::cout << "  paging-stats      - Utilización de CPU perdida por paging y E/S\n";
+
+    std::cout << "\n"
+              << Color::YELLOW << " DISPOSITIVOS DE E/S " << Color::RESET << std::endl;
+    std::cout << "  io-init <discos> <fcfs|sstf|scan|clook> [cpu/E-S] - Activar E/S\n";
+    std::cout << "  io-off            - Desactivar E/S\n";
+    std::cout << "  io-stats          - Utilización y colas de dispositivos\n";
+
+    std::cout << "\n"
+              << Color::YELLOW << " CHECKPOINTS " << Color::RESET << std::endl;
+    std::cout << "  save <archivo>    - Guardar estado completo (binario versionado)\n";
+    std::cout << "  load <archivo>    - Restaurar estado (mapeo en memoria)\n";
+
+    std::cout << "\n"
+              << Color::YELLOW << " BARRIDO DE PARÁMETROS " << Color::RESET << std::endl;
+    std::cout << "  sweep <ticks> <salida.csv|.json> [q=..] [frames=..] [zswap=..] [repl=..] [disk=..]\n";
+    std::cout << "        [reps=N] [threads=N] [fault=N] [decomp=N] [refs=N] - Grilla en paralelo\n";
+
+    std::cout << "\n"
+              << Color::YELLOW << " SIMULACIÓN POR EVENTOS " << Color::RESET << std::endl;
+    std::cout << "  des-run <ticks>   - Avanzar por eventos (usa la carga si existe)\n";
+    std::cout << "  des-stats         - Estado del núcleo de eventos\n";
+    std::cout << "  static-list       - Configuraciones del núcleo compilado\n";
+    std::cout << "  static-run <config> <ticks> [q=4] [frames=16] [fault=5] [refs=1] - Réplica rápida con la carga\n";
+    std::cout << "  static-bench <ticks> [q=..] [frames=..] [fault=..] [refs=..] - Compilado vs scheduler general\n";
+
+    std::cout << "\n"
+              << Color::YELLOW << " TRAZAS DE TRABAJOS " << Color::RESET << std::endl;
+    std::cout << "  trace-open <archivo.swf|.csv> [scale=N] [procs=on|off] [max=N] - Abrir traza\n";
+    std::cout << "  trace-run <ticks> - Reproducir llegadas de la traza por eventos\n";
+    std::cout << "  trace-stats       - Progreso y contadores del lector\n";
+    std::cout << "  trace-bench <archivo> [scale=N] - Throughput del parser sin simular\n";
+
+    std::cout << "\n"
+              << Color::YELLOW << " ESTADÍSTICAS EN VIVO " << Color::RESET << std::endl;
+    std::cout << "  stats-serve <socket> [eventos] - Servir snapshots en un socket Unix\n";
+    std::cout << "  stats-scrape [socket] - Leer el snapshot como un cliente externo\n";
+    std::cout << "  stats-server      - Publicaciones y lecturas del servidor\n";
+    std::cout << "  stats-stop        - Detener el servidor\n";
+    std::cout << "  sample-start [every=100] [cap=512] [metrics=a,b,..] [file=ruta]\n";
+    std::cout << "                    - Muestrear métricas cada K ticks (niveles ×1, ×10, ×100)\n";
+    std::cout << "  sample-show [nivel] - Rango e historia de cada métrica (0, 1 o 2)\n";
+    std::cout << "  sample-stats      - Puntos, memoria, costo y archivo del muestreador\n";
+    std::cout << "  sample-stop       - Volcar al archivo y detener el muestreo\n";
+    std::cout << "  sample-metrics    - Métricas disponibles\n";
+    std::cout << "  sample-read <archivo> [nivel] [salida.csv] - Leer un archivo de muestras\n";
 
     std::cout << "\n"
               << Color::YELLOW << " SYNCHRONIZATION " << Color::RESET << std::endl;
@@ -52,6 +183,25 @@ void print_help()
     std::cout << "  pc-buffer         - Ver estado del buffer\n";
     std::cout << "  pc-stats          - Estadísticas de sincronización\n";
     std::cout << "  pc-reset          - Reiniciar buffer\n";
+    std::cout << "  pipe-run <items> <etapa:workers:ns,...> [cap[,cap..]] [batch] [pin]\n";
+    std::cout << "                    - Pipeline de etapas con hilos y buffers acotados\n";
+    std::cout << "  res-init [detect|banker] - Recursos con detección de interbloqueos o banquero\n";
+    std::cout << "  res-new <nombre> <unidades> - Crear un recurso de varias instancias\n";
+    std::cout << "  res-claim <pid> <recurso> <máximo> - Reclamo máximo (banquero)\n";
+    std::cout << "  res-req <pid> <recurso> [n] - Pedir n unidades (si espera, queda BLOCKED)\n";
+    std::cout << "  res-rel <pid> <recurso> [n] - Liberar n unidades (todas si se omite)\n";
+    std::cout << "  res-state         - Dueños y esperas por recurso\n";
+    std::cout << "  res-stats         - Pedidos, interbloqueos y costo de detección\n";
+    std::cout << "  res-bench <procesos> <recursos> <pedidos> - Costo por pedido a escala\n";
+
+    std::cout << "\n"
+              << Color::YELLOW << " CARGA SINTÉTICA " << Color::RESET << std::endl;
+    std::cout << "  wl-init <seed> [λ]          - Inicializar generador reproducible\n";
+    std::cout << "  wl-burst <exp|pareto|bimodal> [media] - Distribución de ráfagas\n";
+    std::cout << "  wl-pages <zipf|seq|loop> [páginas] [ws] [fase] - Patrón de referencias\n";
+    std::cout << "  wl-run <ticks> [refs/tick]  - Inyectar carga en CPU y memoria\n";
+    std::cout << "  wl-bench <eventos>          - Medir throughput del generador\n";
+    std::cout << "  wl-stats                    - Configuración y eventos generados\n";
 
     std::cout << "\n"
               << Color::YELLOW << " GENERAL " << Color::RESET << std::endl;
@@ -69,6 +219,19 @@ int main()
     std::unique_ptr<RoundRobinScheduler> scheduler = nullptr;
     std::unique_ptr<MemoryManager> memory = nullptr;
     std::unique_ptr<ProducerConsumer> pc_buffer = nullptr;
+    std::unique_ptr<WorkloadGenerator> workload = nullptr;
+    std::unique_ptr<DeviceManager> devices = nullptr;
+    std::unique_ptr<RealTimeClass> realtime = nullptr;
+    std::unique_ptr<GroupScheduler> groups = nullptr;
+    std::unique_ptr<QuantumTuner> tuner = nullptr;
+    std::unique_ptr<ResourceManager> resources = nullptr;
+    std::unique_ptr<MetricsSampler> sampler = nullptr;
+    std::unique_ptr<SlabAllocator> slab = nullptr;
+    std::unique_ptr<TraceReader> trace = nullptr;
+    std::unique_ptr<StatsServer> stats_server = nullptr;
+    long long stats_every = 4096;                           // Eventos entre publicaciones
+    std::vector<std::vector<long long>> kernel_objects;     // Handles vivos por cache
+    WorkloadConfig workload_config;
 
     // Configuración por defecto
     int default_quantum = 3;
@@ -79,9 +242,26 @@ int main()
     std::cout << "\n Escribe 'help' para ver todos los comandos\n"
               << std::endl;
 
+    // Los recursos se piden a nombre de procesos vivos del scheduler
+    auto live_process = [&](int pid)
+    {
+        return scheduler->get_table().contains(pid) &&
+               scheduler->get_table().get_image(pid).state != static_cast<int>(ProcessState::TERMINATED);
+    };
+
+    // Copia los contadores al seqlock del servidor; corre en el hilo de la simulación
+    auto publish_stats = [&]()
+    {
+        if (stats_server && stats_server->is_running())
+        {
+            stats_server->publish(StatsServer::capture(*scheduler, memory.get(), pc_buffer.get()));
+        }
+    };
+
     std::string line;
     while (true)
     {
+        publish_stats();
         std::cout << Color::BOLD << "kernel> " << Color::RESET;
         std::getline(std::cin, line);
 
@@ -158,185 +338,2110 @@ int main()
                               << Color::RESET << std::endl;
                 }
             }
+            else if (command == "fork")
+            {
+                int pid;
+                if (!(iss >> pid))
+                {
+                    std::cout << Color::RED << "Uso: fork <pid> [n]"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                int n = 1;
+                if (!(iss >> n) || n <= 0)
+                {
+                    n = 1;
+                }
+
+                for (int i = 0; i < n; i++)
+                {
+                    int child = scheduler->fork_process(pid);
+                    if (child < 0)
+                    {
+                        std::cout << Color::RED << "Error: P" << pid
+                                  << " no existe, terminó o es un programa"
+                                  << Color::RESET << std::endl;
+                        break;
+                    }
+                    if (memory)
+                    {
+                        memory->fork(pid, child);
+                    }
+                }
+            }
             else if (command == "cpu-stats")
             {
                 scheduler->show_stats();
             }
+            else if (command == "ps-bench")
+            {
+                int n;
+                if (iss >> n && n > 0)
+                {
+                    ProcessTable::benchmark(n);
+                }
+                else
+                {
+                    std::cout << Color::RED << "Uso: ps-bench <procesos>"
+                              << Color::RESET << std::endl;
+                }
+            }
 
-            //  MEMORY MANAGEMENT
-            else if (command == "mem-init")
+            //  TIEMPO REAL
+            else if (command == "rt-init")
             {
-                int frames;
-                if (iss >> frames && frames > 0)
+                std::string name;
+                RtPolicy policy;
+                if (iss >> name && RealTimeClass::parse_policy(name, policy))
                 {
-                    memory = std::make_unique<MemoryManager>(frames);
+                    // El anterior suelta su handler antes de registrar el nuevo
+                    scheduler->disable_realtime();
+                    realtime.reset();
+                    realtime = std::make_unique<RealTimeClass>(scheduler->get_kernel(), policy);
+                    scheduler->enable_realtime(realtime.get());
                 }
                 else
                 {
-                    std::cout << Color::RED << "Error: frames debe ser > 0"
+                    std::cout << Color::RED << "Uso: rt-init <edf|rm>"
                               << Color::RESET << std::endl;
                 }
             }
-            else if (command == "mem-access")
+            else if (command == "rt-new")
             {
-                if (!memory)
+                if (!realtime)
                 {
-                    std::cout << Color::RED << "Error: Primero inicializa memoria con mem-init"
+                    std::cout << Color::RED << "Error: Primero activa la clase con rt-init"
                               << Color::RESET << std::endl;
                     continue;
                 }
 
-                int pid, page;
-                if (iss >> pid >> page && page >= 0)
+                int period, wcet;
+                if (!(iss >> period >> wcet))
+                {
+                    std::cout << Color::RED << "Uso: rt-new <período> <wcet> [deadline] [force]"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                int deadline = period;
+                bool force = false;
+                std::string token;
+                while (iss >> token)
+                {
+                    if (token == "force")
+                    {
+                        force = true;
+                    }
+                    else
+                    {
+                        deadline = std::atoi(token.c_str());
+                    }
+                }
+
+                std::string reason;
+                if (realtime->admit(period, wcet, deadline, force, reason))
                 {
-                    memory->access_page(pid, page);
+                    std::cout << Color::GREEN << "[RT] Tarea RT" << realtime->get_task_count() - 1
+                              << " admitida (T=" << period << ", C=" << wcet << ", D=" << deadline
+                              << ", U=" << std::fixed << std::setprecision(3) << realtime->utilization()
+                              << ")" << Color::RESET << std::endl;
                 }
                 else
                 {
-                    std::cout << Color::RED << "Uso: mem-access <pid> <page>"
+                    std::cout << Color::RED << "[RT] Tarea rechazada: " << reason
                               << Color::RESET << std::endl;
                 }
             }
-            else if (command == "mem-frames")
+            else if (command == "rt-off")
             {
-                if (!memory)
+                scheduler->disable_realtime();
+                realtime.reset();
+                std::cout << Color::CYAN << "[RT] Clase de tiempo real desactivada"
+                          << Color::RESET << std::endl;
+            }
+            else if (command == "rt-stats")
+            {
+                if (!realtime)
                 {
-                    std::cout << Color::RED << "Error: Memoria no inicializada"
+                    std::cout << Color::RED << "Error: Clase de tiempo real no activa"
                               << Color::RESET << std::endl;
                 }
                 else
                 {
-                    memory->display_frames();
+                    realtime->display_stats(scheduler->get_busy_ticks() + scheduler->get_idle_ticks());
                 }
             }
-            else if (command == "mem-table")
+
+            //  AJUSTE DEL QUANTUM
+            else if (command == "quantum")
             {
-                if (!memory)
+                int quantum;
+                if (!(iss >> quantum) || quantum <= 0)
                 {
-                    std::cout << Color::RED << "Error: Memoria no inicializada"
+                    std::cout << Color::RED << "Uso: quantum <n>" << Color::RESET << std::endl;
+                }
+                else if (tuner)
+                {
+                    std::cout << Color::RED << "Error: el quantum lo controla el tuner (tune-off)"
+                              << Color::RESET << std::endl;
+                }
+                else
+                {
+                    scheduler->set_quantum(quantum);
+                    std::cout << Color::GREEN << "[CPU] Quantum = " << quantum << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "ctx-cost")
+            {
+                int cost;
+                if (!(iss >> cost) || cost < 0)
+                {
+                    std::cout << Color::RED << "Uso: ctx-cost <ticks>" << Color::RESET << std::endl;
+                    continue;
+                }
+                scheduler->set_switch_cost(cost);
+                if (tuner)
+                {
+                    tuner->set_switch_cost(cost);
+                }
+                std::cout << Color::GREEN << "[CPU] Cambio de contexto: " << cost << " ticks"
+                          << Color::RESET << std::endl;
+            }
+            else if (command == "tune-init" || command == "tune-bench")
+            {
+                bool bench = command == "tune-bench";
+                TunerConfig config;
+                long long ticks = 0;
+                int cost = scheduler->get_switch_cost();
+                if (bench && !(iss >> ticks && ticks > 0))
+                {
+                    std::cout << Color::RED << "Uso: tune-bench <ticks> [cost=N] [opciones de tune-init]"
                               << Color::RESET << std::endl;
                     continue;
                 }
+                if (bench)
+                {
+                    cost = std::max(cost, 1);
+                }
 
-                int pid;
-                if (iss >> pid)
+                bool ok = true;
+                std::string option;
+                while (iss >> option)
                 {
-                    memory->display_page_table(pid);
+                    if (option == "global" || option == "class")
+                    {
+                        config.mode = option == "class" ? TunerMode::CLASS : TunerMode::GLOBAL;
+                    }
+                    else if (bench && option.rfind("cost=", 0) == 0)
+                    {
+                        cost = std::max(0, std::atoi(option.c_str() + 5));
+                    }
+                    else if (!parse_tuner_option(option, config))
+                    {
+                        std::cout << Color::RED << "Error: opción inválida: " << option
+                                  << Color::RESET << std::endl;
+                        ok = false;
+                        break;
+                    }
+                }
+                if (!ok)
+                {
+                    continue;
+                }
+
+                if (bench)
+                {
+                    run_tuner_bench(workload_config, ticks, cost, config);
+                    continue;
+                }
+                scheduler->disable_tuner();
+                tuner = std::make_unique<QuantumTuner>(config, scheduler->get_quantum(), cost,
+                                                       scheduler->get_kernel().now());
+                scheduler->enable_tuner(tuner.get());
+                std::cout << Color::GREEN << "[CPU] Ajuste de quantum " << QuantumTuner::mode_to_string(config.mode)
+                          << " activo (" << config.min_quantum << ".." << config.max_quantum
+                          << ", cambio de contexto " << cost << " ticks)" << Color::RESET << std::endl;
+            }
+            else if (command == "tune-stats")
+            {
+                if (!tuner)
+                {
+                    std::cout << Color::RED << "Error: ajuste de quantum no activo" << Color::RESET << std::endl;
                 }
                 else
                 {
-                    std::cout << Color::RED << "Uso: mem-table <pid>"
+                    tuner->display_stats();
+                }
+            }
+            else if (command == "tune-off")
+            {
+                scheduler->disable_tuner();
+                tuner.reset();
+                std::cout << Color::CYAN << "[CPU] Quantum fijo en " << scheduler->get_quantum()
+                          << Color::RESET << std::endl;
+            }
+
+            //  GRUPOS DE PROCESOS
+            else if (command == "grp-init")
+            {
+                // El anterior devuelve sus listos a la cola antes de soltar su handler
+                scheduler->disable_groups();
+                groups.reset();
+                groups = std::make_unique<GroupScheduler>(scheduler->get_kernel());
+                scheduler->enable_groups(groups.get());
+            }
+            else if (command == "grp-bench")
+            {
+                int n_groups, processes;
+                long long ticks;
+                int quota_percent = 0;
+                if (iss >> n_groups >> processes >> ticks && n_groups > 0 && processes > 0 && ticks > 0)
+                {
+                    iss >> quota_percent;
+                    run_group_bench(n_groups, processes, ticks, std::clamp(quota_percent, 0, 100));
+                }
+                else
+                {
+                    std::cout << Color::RED << "Uso: grp-bench <grupos> <procesos> <ticks> [quota%]"
                               << Color::RESET << std::endl;
                 }
             }
-            else if (command == "mem-stats")
+            else if (command.rfind("grp-", 0) == 0 && !groups)
             {
-                if (!memory)
+                std::cout << Color::RED << "Error: Primero activa los grupos con grp-init"
+                          << Color::RESET << std::endl;
+            }
+            else if (command == "grp-new")
+            {
+                std::string name;
+                std::string parent_name = "/";
+                int weight = GroupScheduler::TASK_WEIGHT;
+                if (!(iss >> name))
                 {
-                    std::cout << Color::RED << "Error: Memoria no inicializada"
+                    std::cout << Color::RED << "Uso: grp-new <nombre> [padre] [peso]"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                iss >> parent_name >> weight;
+                int parent = groups->find_group(parent_name);
+                int id = parent < 0 ? -1 : groups->create_group(name, parent, weight);
+                if (id < 0)
+                {
+                    std::cout << Color::RED << "Error: padre inexistente, nombre repetido o peso fuera de 1..10000"
                               << Color::RESET << std::endl;
                 }
                 else
                 {
-                    memory->display_stats();
+                    std::cout << Color::GREEN << "[GRP] Grupo " << name << " (id " << id << ") bajo "
+                              << groups->get_group(parent).name << ", peso " << weight
+                              << Color::RESET << std::endl;
                 }
             }
-            else if (command == "mem-reset")
+            else if (command == "grp-weight")
             {
-                if (!memory)
+                std::string name;
+                int weight;
+                if (!(iss >> name >> weight))
                 {
-                    std::cout << Color::RED << "Error: Memoria no inicializada"
+                    std::cout << Color::RED << "Uso: grp-weight <grupo> <peso>" << Color::RESET << std::endl;
+                }
+                else if (!groups->set_weight(groups->find_group(name), weight))
+                {
+                    std::cout << Color::RED << "Error: grupo inexistente (o raíz) o peso fuera de 1..10000"
                               << Color::RESET << std::endl;
                 }
                 else
                 {
-                    memory->reset_stats();
+                    std::cout << Color::GREEN << "[GRP] Peso de " << name << " = " << weight
+                              << Color::RESET << std::endl;
                 }
             }
-
-            //  SYNCHRONIZATION
-            else if (command == "pc-init")
+            else if (command == "grp-quota")
             {
-                int size;
-                if (iss >> size && size > 0)
+                std::string name, quota_text;
+                long long period = 100;
+                if (!(iss >> name >> quota_text))
                 {
-                    pc_buffer = std::make_unique<ProducerConsumer>(size);
+                    std::cout << Color::RED << "Uso: grp-quota <grupo> <quota|off> [período]"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                iss >> period;
+                long long quota = quota_text == "off" ? 0 : std::atoll(quota_text.c_str());
+                if (!groups->set_quota(groups->find_group(name), quota, period))
+                {
+                    std::cout << Color::RED << "Error: grupo inexistente (o raíz) o no se cumple quota ≤ período"
+                              << Color::RESET << std::endl;
+                }
+                else if (quota > 0)
+                {
+                    std::cout << Color::GREEN << "[GRP] " << name << ": " << quota << " ticks cada "
+                              << period << Color::RESET << std::endl;
                 }
                 else
                 {
-                    std::cout << Color::RED << "Error: size debe ser > 0"
+                    std::cout << Color::GREEN << "[GRP] " << name << ": sin límite de CPU"
                               << Color::RESET << std::endl;
                 }
             }
-            else if (command == "produce")
+            else if (command == "grp-use")
             {
-                if (!pc_buffer)
+                std::string name;
+                int id = iss >> name ? groups->find_group(name) : -1;
+                if (id < 0)
                 {
-                    std::cout << Color::RED << "Error: Primero inicializa con pc-init"
+                    std::cout << Color::RED << "Uso: grp-use <grupo existente>" << Color::RESET << std::endl;
+                }
+                else
+                {
+                    groups->set_default_group(id);
+                    std::cout << Color::GREEN << "[GRP] Procesos nuevos en " << groups->get_group(id).name
+                              << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "grp-move")
+            {
+                int pid;
+                std::string name;
+                if (!(iss >> pid >> name))
+                {
+                    std::cout << Color::RED << "Uso: grp-move <pid> <grupo>" << Color::RESET << std::endl;
+                }
+                else if (!scheduler->move_to_group(pid, groups->find_group(name)))
+                {
+                    std::cout << Color::RED << "Error: proceso o grupo inexistente" << Color::RESET << std::endl;
+                }
+                else
+                {
+                    std::cout << Color::GREEN << "[GRP] P" << pid << " → " << name << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "grp-stats")
+            {
+                groups->display_stats();
+            }
+            else if (command == "grp-off")
+            {
+                scheduler->disable_groups();
+                groups.reset();
+                std::cout << Color::CYAN << "[GRP] Planificación por grupos desactivada"
+                          << Color::RESET << std::endl;
+            }
+
+            //  PROGRAMAS (CORRUTINAS)
+            else if (command == "spawn")
+            {
+                std::string kind;
+                int n = 1;
+                if (!(iss >> kind))
+                {
+                    std::cout << Color::RED << "Uso: spawn <cpu|interactive|producer|consumer|memory|io|mix> [n]"
                               << Color::RESET << std::endl;
                     continue;
                 }
+                if (!(iss >> n) || n <= 0)
+                {
+                    n = 1;
+                }
 
-                int item;
-                if (iss >> item)
+                // Con muchos programas solo se informa el resumen
+                bool verbose = scheduler->is_verbose();
+                scheduler->set_verbose(verbose && n == 1);
+                Program program;
+                int created = 0;
+                for (int i = 0; i < n && Program::make(kind, i, program); i++)
                 {
-                    pc_buffer->produce(item);
+                    scheduler->create_program(std::move(program));
+                    created++;
+                }
+                scheduler->set_verbose(verbose);
+
+                if (created == 0)
+                {
+                    std::cout << Color::RED << "Error: tipo de programa desconocido: " << kind
+                              << Color::RESET << std::endl;
+                }
+                else if (n > 1)
+                {
+                    std::cout << Color::GREEN << "[PROG] " << created << " programa(s) " << kind
+                              << " creados (vivos=" << scheduler->get_live_programs() << ")"
+                              << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "prog-buffer")
+            {
+                int capacity;
+                if (iss >> capacity && capacity > 0)
+                {
+                    scheduler->set_channel_capacity(capacity);
+                    std::cout << Color::GREEN << "[PROG] Buffer compartido de " << capacity
+                              << " elemento(s)" << Color::RESET << std::endl;
                 }
                 else
                 {
-                    std::cout << Color::RED << "Uso: produce <item>"
+                    std::cout << Color::RED << "Uso: prog-buffer <capacidad>"
                               << Color::RESET << std::endl;
                 }
             }
-            else if (command == "consume")
+            else if (command == "prog-stats")
             {
-                if (!pc_buffer)
+                scheduler->show_program_stats();
+            }
+            else if (command == "prog-bench")
+            {
+                int n;
+                if (!(iss >> n) || n <= 0)
                 {
-                    std::cout << Color::RED << "Error: Primero inicializa con pc-init"
+                    std::cout << Color::RED << "Uso: prog-bench <programas>"
                               << Color::RESET << std::endl;
                     continue;
                 }
 
-                int item;
-                if (pc_buffer->consume(item))
+                RoundRobinScheduler bench(default_quantum);
+                bench.set_verbose(false);
+                FramePool::Stats before = FramePool::stats();
+                auto start = std::chrono::steady_clock::now();
+
+                Program program;
+                for (int i = 0; i < n; i++)
                 {
-                    // Éxito ya reportado en la función
+                    Program::make("mix", i, program);
+                    bench.create_program(std::move(program));
+                }
+                FramePool::Stats spawned = FramePool::stats();
+                auto created = std::chrono::steady_clock::now();
+
+                // Hasta que terminen todos o nadie pueda avanzar
+                SimulationKernel& kernel = bench.get_kernel();
+                while (bench.get_live_programs() > 0)
+                {
+                    int live = bench.get_live_programs();
+                    bench.run_until(kernel.now() + 100000);
+                    if (bench.get_live_programs() == live && bench.get_running_pid() < 0 &&
+                        bench.get_ready_count() == 0 && kernel.get_pending() == 0)
+                    {
+                        break;
+                    }
                 }
+                auto done = std::chrono::steady_clock::now();
+
+                double spawn_s = std::chrono::duration<double>(created - start).count();
+                double run_s = std::chrono::duration<double>(done - created).count();
+                long long resumes = bench.get_program_resumes();
+                std::cout << std::fixed << std::setprecision(2);
+                std::cout << Color::BLUE << Color::BOLD << "\n▶ " << n << " programas simulados (t="
+                          << kernel.now() << ")" << Color::RESET << std::endl;
+                std::cout << "   ├─ Terminados:         " << bench.get_metrics().completed() << std::endl;
+                std::cout << "   ├─ Creación:           " << spawn_s * 1000 << " ms ("
+                          << spawn_s * 1e9 / n << " ns/programa)" << std::endl;
+                std::cout << "   ├─ Frames reservados:  "
+                          << (spawned.reserved_bytes - before.reserved_bytes) / 1024 << " KB ("
+                          << static_cast<double>(spawned.reserved_bytes - before.reserved_bytes) / n
+                          << " bytes/programa)" << std::endl;
+                std::cout << "   ├─ Simulación:         " << run_s * 1000 << " ms" << std::endl;
+                std::cout << "   ├─ Reanudaciones:      " << resumes << std::endl;
+                std::cout << "   ├─ Eventos:            " << kernel.get_events_processed() << std::endl;
+                std::cout << "   └─ Costo por reanudación: "
+                          << (resumes > 0 ? (spawn_s + run_s) * 1e9 / resumes : 0.0)
+                          << " ns (incluye scheduler)" << std::endl;
+                std::cout << std::endl;
             }
-            else if (command == "pc-buffer")
+
+            //  MEMORY MANAGEMENT
+            else if (command == "mem-init")
             {
-                if (!pc_buffer)
+                int frames;
+                if (iss >> frames && frames > 0)
                 {
-                    std::cout << Color::RED << "Error: Buffer no inicializado"
-                              << Color::RESET << std::endl;
+                    ReplacementPolicy policy = ReplacementPolicy::FIFO;
+                    std::string name;
+                    if (iss >> name && !MemoryManager::parse_policy(name, policy))
+                    {
+                        std::cout << Color::RED << "Uso: mem-init <frames> [fifo|lru|clock]"
+                                  << Color::RESET << std::endl;
+                        continue;
+                    }
+                    if (scheduler->is_paging_enabled())
+                    {
+                        scheduler->disable_paging();
+                        std::cout << Color::YELLOW << "[CPU+MEM] Modo acoplado desactivado (memoria reiniciada)"
+                                  << Color::RESET << std::endl;
+                    }
+                    // Los slabs viven en los frames de la memoria anterior
+                    slab.reset();
+                    memory = std::make_unique<MemoryManager>(frames, policy);
                 }
                 else
                 {
-                    pc_buffer->display_buffer();
+                    std::cout << Color::RED << "Error: frames debe ser > 0"
+                              << Color::RESET << std::endl;
                 }
             }
-            else if (command == "pc-stats")
+            else if (command == "mem-access")
             {
-                if (!pc_buffer)
+                if (!memory)
                 {
-                    std::cout << Color::RED << "Error: Buffer no inicializado"
+                    std::cout << Color::RED << "Error: Primero inicializa memoria con mem-init"
                               << Color::RESET << std::endl;
+                    continue;
+                }
+
+                int pid, page;
+                if (iss >> pid >> page && page >= 0)
+                {
+                    std::string mode;
+                    memory->access_page(pid, page, iss >> mode && mode == "w");
                 }
                 else
                 {
-                    pc_buffer->display_stats();
+                    std::cout << Color::RED << "Uso: mem-access <pid> <page> [w]"
+                              << Color::RESET << std::endl;
                 }
             }
-            else if (command == "pc-reset")
+            else if (command == "mem-frames")
             {
-                if (!pc_buffer)
+                if (!memory)
                 {
-                    std::cout << Color::RED << "Error: Buffer no inicializado"
+                    std::cout << Color::RED << "Error: Memoria no inicializada"
                               << Color::RESET << std::endl;
                 }
                 else
                 {
-                    pc_buffer->reset();
+                    memory->display_frames();
+                }
+            }
+            else if (command == "mem-table")
+            {
+                if (!memory)
+                {
+                    std::cout << Color::RED << "Error: Memoria no inicializada"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+
+                int pid;
+                if (iss >> pid)
+                {
+                    memory->display_page_table(pid);
+                }
+                else
+                {
+                    std::cout << Color::RED << "Uso: mem-table <pid>"
+                              << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "mem-stats")
+            {
+                if (!memory)
+                {
+                    std::cout << Color::RED << "Error: Memoria no inicializada"
+                              << Color::RESET << std::endl;
+                }
+                else
+                {
+                    memory->display_stats();
+                }
+            }
+            else if (command == "mem-reset")
+            {
+                if (!memory)
+                {
+                    std::cout << Color::RED << "Error: Memoria no inicializada"
+                              << Color::RESET << std::endl;
+                }
+                else
+                {
+                    memory->reset_stats();
+                }
+            }
+            else if (command == "mem-zswap")
+            {
+                if (!memory)
+                {
+                    std::cout << Color::RED << "Error: Memoria no inicializada"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+
+                std::string arg;
+                iss >> arg;
+                int pool_frames = std::atoi(arg.c_str());
+                if (arg == "off")
+                {
+                    memory->disable_zswap();
+                    std::cout << Color::YELLOW << "[ZSWAP] Pool desactivado (páginas a disco)"
+                              << Color::RESET << std::endl;
+                }
+                else if (pool_frames > 0)
+                {
+                    int ticks = 1;
+                    if (!(iss >> ticks) || ticks <= 0)
+                    {
+                        ticks = 1;
+                    }
+                    memory->enable_zswap(pool_frames, ticks);
+                }
+                else
+                {
+                    std::cout << Color::RED << "Uso: mem-zswap <frames_pool|off> [ticks_descompresión]"
+                              << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "mem-huge")
+            {
+                if (!memory)
+                {
+                    std::cout << Color::RED << "Error: Memoria no inicializada"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+
+                std::string arg;
+                iss >> arg;
+                int factor = std::atoi(arg.c_str());
+                if (arg == "off")
+                {
+                    memory->disable_huge_pages();
+                    std::cout << Color::YELLOW << "[HUGE] Huge pages y TLB desactivados"
+                              << Color::RESET << std::endl;
+                }
+                else if (factor > 0)
+                {
+                    int tlb = 64;
+                    if (!(iss >> tlb) || tlb <= 0)
+                    {
+                        tlb = 64;
+                    }
+                    memory->enable_huge_pages(factor, tlb);
+                }
+                else
+                {
+                    std::cout << Color::RED << "Uso: mem-huge <factor|off> [entradas_tlb]"
+                              << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "mem-ipt")
+            {
+                if (!memory)
+                {
+                    std::cout << Color::RED << "Error: Memoria no inicializada"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+
+                std::string arg;
+                iss >> arg;
+                if (arg != "on" && arg != "off")
+                {
+                    std::cout << Color::RED << "Uso: mem-ipt <on|off>"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                memory->set_inverted(arg == "on");
+                std::cout << Color::GREEN << "[MEMORY] Page table "
+                          << (memory->is_inverted() ? "invertida" : "directa") << " ("
+                          << memory->get_mapped_pages() << " entradas migradas)"
+                          << Color::RESET << std::endl;
+            }
+            else if (command == "cache-init")
+            {
+                if (!memory)
+                {
+                    std::cout << Color::RED << "Error: Memoria no inicializada"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+
+                CacheConfig config;
+                std::string token;
+                bool valid = true;
+                while (iss >> token)
+                {
+                    if (!parse_cache_option(token, config))
+                    {
+                        std::cout << Color::RED << "Opción inválida: " << token
+                                  << " (niveles kb:ways:ciclos, ways potencia de 2 ≤ 64)"
+                                  << Color::RESET << std::endl;
+                        valid = false;
+                        break;
+                    }
+                }
+                if (valid)
+                {
+                    memory->enable_caches(config);
+                }
+            }
+            else if (command == "cache-stats")
+            {
+                if (!memory)
+                {
+                    std::cout << Color::RED << "Error: Memoria no inicializada"
+                              << Color::RESET << std::endl;
+                }
+                else
+                {
+                    memory->display_cache_stats();
+                }
+            }
+            else if (command == "cache-off")
+            {
+                if (memory)
+                {
+                    memory->disable_caches();
+                }
+                std::cout << Color::YELLOW << "[CACHE] Modelo de cachés desactivado"
+                          << Color::RESET << std::endl;
+            }
+            else if (command == "numa-init")
+            {
+                if (!memory)
+                {
+                    std::cout << Color::RED << "Error: Memoria no inicializada"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+
+                NumaConfig config;
+                if (!(iss >> config.nodes) || config.nodes < 1)
+                {
+                    std::cout << Color::RED << "Uso: numa-init <nodos> [first|interleave] [local=ns] [remote=ns] [sample=N] [copy=ns] [migrate=on|off]"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                std::string token;
+                bool valid = true;
+                while (iss >> token)
+                {
+                    if (!parse_numa_option(token, config))
+                    {
+                        std::cout << Color::RED << "Opción inválida: " << token << Color::RESET << std::endl;
+                        valid = false;
+                        break;
+                    }
+                }
+                if (valid)
+                {
+                    memory->enable_numa(config);
+                }
+            }
+            else if (command == "numa-home")
+            {
+                int pid, node;
+                if (!(iss >> pid >> node))
+                {
+                    std::cout << Color::RED << "Uso: numa-home <pid> <nodo>" << Color::RESET << std::endl;
+                }
+                else if (!memory || !memory->set_home_node(pid, node))
+                {
+                    std::cout << Color::RED << "Error: NUMA inactivo o nodo fuera de rango"
+                              << Color::RESET << std::endl;
+                }
+                else
+                {
+                    std::cout << Color::GREEN << "[NUMA] P" << pid << " corre en el nodo " << node
+                              << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "numa-stats")
+            {
+                if (!memory)
+                {
+                    std::cout << Color::RED << "Error: Memoria no inicializada"
+                              << Color::RESET << std::endl;
+                }
+                else
+                {
+                    memory->display_numa_stats();
+                }
+            }
+            else if (command == "numa-off")
+            {
+                if (memory)
+                {
+                    memory->disable_numa();
+                }
+                std::cout << Color::YELLOW << "[NUMA] Modelo NUMA desactivado"
+                          << Color::RESET << std::endl;
+            }
+            else if (command == "pt-bench")
+            {
+                int processes;
+                if (!(iss >> processes) || processes <= 0)
+                {
+                    std::cout << Color::RED << "Uso: pt-bench <procesos> [páginas] [frames]"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                int pages = 64, frames = 4096;
+                if (!(iss >> pages) || pages <= 0)
+                {
+                    pages = 64;
+                }
+                else if (!(iss >> frames) || frames <= 0)
+                {
+                    frames = 4096;
+                }
+                run_page_table_bench(processes, pages, frames, workload_config.seed);
+            }
+            else if (command == "huge-stats")
+            {
+                if (!memory)
+                {
+                    std::cout << Color::RED << "Error: Memoria no inicializada"
+                              << Color::RESET << std::endl;
+                }
+                else
+                {
+                    memory->display_huge_stats();
+                }
+            }
+            else if (command == "zswap-stats")
+            {
+                if (!memory)
+                {
+                    std::cout << Color::RED << "Error: Memoria no inicializada"
+                              << Color::RESET << std::endl;
+                }
+                else
+                {
+                    memory->display_zswap_stats();
+                }
+            }
+
+            //  CPU + MEMORIA
+            else if (command == "couple")
+            {
+                if (!memory || !workload)
+                {
+                    std::cout << Color::RED << "Error: Se requiere mem-init y wl-init antes de acoplar"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+
+                int fault_ticks;
+                if (iss >> fault_ticks && fault_ticks >= 0)
+                {
+                    int refs = 1;
+                    if (!(iss >> refs) || refs <= 0)
+                    {
+                        refs = 1;
+                    }
+                    scheduler->enable_paging(memory.get(), workload.get(), fault_ticks, refs);
+                }
+                else
+                {
+                    std::cout << Color::RED << "Uso: couple <fault_ticks> [refs/tick]"
+                              << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "decouple")
+            {
+                scheduler->disable_paging();
+                std::cout << Color::CYAN << "[CPU+MEM] Modo acoplado desactivado"
+                          << Color::RESET << std::endl;
+            }
+            else if (command == "paging-stats")
+            {
+                scheduler->show_utilization_stats();
+            }
+
+            //  DISPOSITIVOS DE E/S
+            else if (command == "io-init")
+            {
+                int disks;
+                std::string name;
+                DiskPolicy policy;
+                if (iss >> disks >> name && disks > 0 && disks <= DeviceManager::MAX_DISKS &&
+                    DeviceManager::parse_policy(name, policy))
+                {
+                    int cpu_per_io = 8;
+                    if (!(iss >> cpu_per_io) || cpu_per_io <= 0)
+                    {
+                        cpu_per_io = 8;
+                    }
+                    if (devices)
+                    {
+                        scheduler->disable_io();
+                        devices.reset();
+                    }
+                    devices = std::make_unique<DeviceManager>(scheduler->get_kernel(), disks,
+                                                              policy, cpu_per_io);
+                    scheduler->enable_io(devices.get());
+                }
+                else
+                {
+                    std::cout << Color::RED << "Uso: io-init <discos> <fcfs|sstf|scan|clook> [cpu/E-S]"
+                              << " (hasta " << DeviceManager::MAX_DISKS << " discos)" << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "io-off")
+            {
+                if (devices)
+                {
+                    scheduler->disable_io();
+                    devices.reset();
+                }
+                std::cout << Color::CYAN << "[IO] Dispositivos desactivados"
+                          << Color::RESET << std::endl;
+            }
+            else if (command == "io-stats")
+            {
+                if (!devices)
+                {
+                    std::cout << Color::RED << "Error: E/S no inicializada (io-init)"
+                              << Color::RESET << std::endl;
+                }
+                else
+                {
+                    devices->display_stats();
+                    scheduler->show_utilization_stats();
+                }
+            }
+
+            //  BARRIDO DE PARÁMETROS
+            else if (command == "sweep")
+            {
+                long long ticks;
+                std::string output;
+                if (!(iss >> ticks >> output) || ticks <= 0)
+                {
+                    std::cout << Color::RED << "Uso: sweep <ticks> <salida.csv|.json> [clave=v1,v2 ...]"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                
+                // La carga configurada con wl-* define la semilla base y las distribuciones
+                SweepGrid grid;
+                grid.ticks = ticks;
+                grid.workload = workload_config;
+                grid.quanta = {scheduler->get_quantum()};
+                int threads = static_cast<int>(std::thread::hardware_concurrency());
+                
+                std::string option;
+                bool valid = true;
+                while (iss >> option)
+                {
+                    if (!parse_sweep_option(option, grid, threads))
+                    {
+                        std::cout << Color::RED << "Opción inválida: " << option
+                                  << Color::RESET << std::endl;
+                        valid = false;
+                        break;
+                    }
+                }
+                if (!valid)
+                {
+                    continue;
+                }
+                
+                SweepRunner runner(grid);
+                std::cout << Color::CYAN << "[SWEEP] " << runner.get_points() << " puntos en "
+                          << threads << " hilos..." << Color::RESET << std::endl;
+                runner.run(threads);
+                
+                bool json = output.size() >= 5 && output.substr(output.size() - 5) == ".json";
+                bool written = json ? runner.write_json(output) : runner.write_csv(output);
+                runner.display_summary();
+                if (written)
+                {
+                    std::cout << Color::GREEN << "[SWEEP] Tabla escrita en " << output
+                              << Color::RESET << std::endl;
+                }
+                else
+                {
+                    std::cout << Color::RED << "Error: no se pudo escribir " << output
+                              << Color::RESET << std::endl;
+                }
+            }
+
+            //  SIMULACIÓN POR EVENTOS
+            else if (command == "des-run")
+            {
+                long long ticks;
+                if (iss >> ticks && ticks > 0)
+                {
+                    if (workload)
+                    {
+                        workload->run_events(*scheduler, memory.get(), ticks);
+                    }
+                    else
+                    {
+                        scheduler->run_until(scheduler->get_kernel().now() + ticks);
+                        std::cout << Color::BLUE << Color::BOLD << "\n Simulación completada (t="
+                                  << scheduler->get_current_time() << ")\n"
+                                  << Color::RESET << std::endl;
+                    }
+                }
+                else
+                {
+                    std::cout << Color::RED << "Uso: des-run <ticks>"
+                              << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "des-stats")
+            {
+                scheduler->get_kernel().display_stats();
+            }
+            else if (command == "static-list")
+            {
+                list_static_configs();
+            }
+            else if (command == "static-run" || command == "static-bench")
+            {
+                bool bench = command == "static-bench";
+                std::string name;
+                StaticParams params;
+                params.workload = workload_config;
+                if ((!bench && !(iss >> name)) || !(iss >> params.ticks) || params.ticks <= 0)
+                {
+                    std::cout << Color::RED
+                              << (bench ? "Uso: static-bench <ticks> [q=..] [frames=..] [fault=..] [refs=..]"
+                                        : "Uso: static-run <config> <ticks> [q=..] [frames=..] [fault=..] [refs=..]")
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                const StaticConfig* config = bench ? nullptr : find_static_config(name);
+                if (!bench && !config)
+                {
+                    std::cout << Color::RED << "Error: configuración desconocida (ver static-list)"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+
+                bool ok = true;
+                std::string option;
+                while (iss >> option)
+                {
+                    if (!parse_static_option(option, params))
+                    {
+                        std::cout << Color::RED << "Error: opción inválida: " << option
+                                  << Color::RESET << std::endl;
+                        ok = false;
+                        break;
+                    }
+                }
+                if (!ok)
+                {
+                    continue;
+                }
+
+                if (bench)
+                {
+                    run_static_bench(params);
+                }
+                else
+                {
+                    // Corrida aislada: no toca el scheduler ni la memoria de la sesión
+                    StaticResult result = config->run(params);
+                    display_static_result(*config, params, result);
+                }
+            }
+
+            //  TRAZAS DE TRABAJOS
+            else if (command == "trace-open" || command == "trace-bench")
+            {
+                std::string path;
+                if (!(iss >> path))
+                {
+                    std::cout << Color::RED << "Uso: " << command
+                              << " <archivo.swf|.csv> [scale=N] [procs=on|off] [max=N]"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+
+                TraceOptions options;
+                std::string token;
+                bool valid = true;
+                while (iss >> token)
+                {
+                    if (token.rfind("scale=", 0) == 0)
+                    {
+                        options.scale = std::atof(token.c_str() + 6);
+                        valid = valid && options.scale > 0.0;
+                    }
+                    else if (token == "procs=on" || token == "procs=off")
+                    {
+                        options.use_procs = token == "procs=on";
+                    }
+                    else if (token.rfind("max=", 0) == 0)
+                    {
+                        options.max_jobs = std::atoll(token.c_str() + 4);
+                        valid = valid && options.max_jobs > 0;
+                    }
+                    else
+                    {
+                        valid = false;
+                    }
+                }
+                if (!valid)
+                {
+                    std::cout << Color::RED << "Opciones: scale=N (>0), procs=on|off, max=N (>0)"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+
+                if (command == "trace-bench")
+                {
+                    TraceReader::benchmark(path, options);
+                    continue;
+                }
+
+                // Las llegadas empiezan en el tiempo virtual actual
+                auto opened = std::make_unique<TraceReader>(path, options, scheduler->get_kernel().now());
+                if (!opened->is_open())
+                {
+                    std::cout << Color::RED << "Error: " << opened->get_error() << Color::RESET << std::endl;
+                    continue;
+                }
+                trace = std::move(opened);
+                std::cout << Color::GREEN << "[TRACE] " << path << " abierta ("
+                          << TraceReader::format_to_string(trace->get_format()) << ", escala "
+                          << options.scale << " s/tick, buffer "
+                          << TraceReader::BLOCK_SIZE / 1024 << " KB)" << Color::RESET << std::endl;
+            }
+            else if (command == "trace-run")
+            {
+                long long ticks;
+                if (!(iss >> ticks) || ticks <= 0)
+                {
+                    std::cout << Color::RED << "Uso: trace-run <ticks>" << Color::RESET << std::endl;
+                    continue;
+                }
+                if (!trace)
+                {
+                    std::cout << Color::RED << "Error: Primero abre una traza con trace-open"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+
+                bool sched_verbose = scheduler->is_verbose();
+                bool mem_verbose = memory ? memory->is_verbose() : false;
+                scheduler->set_verbose(false);
+                if (memory) memory->set_verbose(false);
+
+                SimulationKernel& kernel = scheduler->get_kernel();
+                long long start_events = kernel.get_events_processed();
+                long long start_jobs = trace->get_jobs();
+                auto start = std::chrono::steady_clock::now();
+
+                // El scheduler pide el siguiente trabajo al procesar cada llegada
+                trace->set_floor(kernel.now());
+                scheduler->set_arrival_source(trace.get());
+                scheduler->run_until(kernel.now() + ticks);
+                scheduler->set_arrival_source(nullptr);
+
+                auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                scheduler->set_verbose(sched_verbose);
+                if (memory) memory->set_verbose(mem_verbose);
+
+                long long events = kernel.get_events_processed() - start_events;
+                std::cout << Color::BLUE << Color::BOLD << "\n▶ Reproducción de traza: " << ticks
+                          << " ticks virtuales (t=" << kernel.now() << ")" << Color::RESET << std::endl;
+                std::cout << "   ├─ Trabajos leídos:    " << trace->get_jobs() - start_jobs << std::endl;
+                std::cout << "   ├─ Eventos:            " << events << std::endl;
+                std::cout << std::fixed << std::setprecision(2);
+                std::cout << "   ├─ Tiempo real:        " << elapsed * 1000 << " ms" << std::endl;
+                std::cout << "   └─ Traza:              "
+                          << (trace->exhausted() ? "agotada" : "con trabajos pendientes") << std::endl;
+                std::cout << std::endl;
+            }
+            else if (command == "trace-stats")
+            {
+                if (!trace)
+                {
+                    std::cout << Color::RED << "Error: No hay traza abierta" << Color::RESET << std::endl;
+                }
+                else
+                {
+                    trace->display_stats();
+                }
+            }
+
+            //  ESTADÍSTICAS EN VIVO
+            else if (command == "stats-serve")
+            {
+                std::string path;
+                long long every = 4096;
+                if (!(iss >> path) || ((iss >> every) && every <= 0))
+                {
+                    std::cout << Color::RED << "Uso: stats-serve <socket> [eventos]"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                if (!stats_server)
+                {
+                    stats_server = std::make_unique<StatsServer>();
+                }
+                if (!stats_server->start(path))
+                {
+                    std::cout << Color::RED << "Error: " << stats_server->get_error()
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                stats_every = every;
+                scheduler->get_kernel().set_observer(publish_stats, stats_every);
+                publish_stats();
+                std::cout << Color::GREEN << "[STATS] Sirviendo en " << path << " (snapshot cada "
+                          << stats_every << " eventos y tras cada comando)" << Color::RESET << std::endl;
+            }
+            else if (command == "stats-scrape")
+            {
+                std::string path;
+                if (!(iss >> path))
+                {
+                    if (!stats_server || !stats_server->is_running())
+                    {
+                        std::cout << Color::RED << "Uso: stats-scrape <socket>" << Color::RESET << std::endl;
+                        continue;
+                    }
+                    path = stats_server->get_path();
+                }
+                std::string body = StatsServer::scrape(path);
+                if (body.empty())
+                {
+                    std::cout << Color::RED << "Error: sin respuesta de " << path << Color::RESET << std::endl;
+                }
+                else
+                {
+                    std::cout << body << std::endl;
+                }
+            }
+            else if (command == "stats-server")
+            {
+                if (!stats_server)
+                {
+                    std::cout << Color::RED << "Error: Servidor no iniciado (stats-serve)"
+                              << Color::RESET << std::endl;
+                }
+                else
+                {
+                    stats_server->display_stats();
+                }
+            }
+            else if (command == "stats-stop")
+            {
+                if (stats_server)
+                {
+                    scheduler->get_kernel().set_observer(nullptr, 1);
+                    stats_server->stop();
+                }
+                std::cout << Color::YELLOW << "[STATS] Servidor detenido" << Color::RESET << std::endl;
+            }
+            else if (command == "sample-start")
+            {
+                SamplerConfig config;
+                bool ok = true;
+                std::string option;
+                while (iss >> option)
+                {
+                    if (!parse_sampler_option(option, config))
+                    {
+                        std::cout << Color::RED << "Error: opción inválida: " << option
+                                  << " (sample-metrics lista las métricas)" << Color::RESET << std::endl;
+                        ok = false;
+                        break;
+                    }
+                }
+                if (!ok)
+                {
+                    continue;
+                }
+                sampler.reset();
+                sampler = std::make_unique<MetricsSampler>(
+                    scheduler->get_kernel(),
+                    [&]() { return StatsServer::capture(*scheduler, memory.get(), pc_buffer.get()); },
+                    config);
+                if (!sampler->is_file_ok())
+                {
+                    std::cout << Color::RED << "Error: no se pudo abrir " << config.path
+                              << " (se muestrea solo en memoria)" << Color::RESET << std::endl;
+                }
+                std::cout << Color::GREEN << "[MUESTRAS] Cada " << config.every << " ticks, "
+                          << config.metrics.size() << " métricas";
+                if (!config.path.empty())
+                {
+                    std::cout << " → " << config.path;
+                }
+                std::cout << Color::RESET << std::endl;
+            }
+            else if (command == "sample-show" || command == "sample-stats")
+            {
+                int level = 0;
+                if (!sampler)
+                {
+                    std::cout << Color::RED << "Error: muestreo no iniciado (sample-start)"
+                              << Color::RESET << std::endl;
+                }
+                else if (command == "sample-stats")
+                {
+                    sampler->display_stats();
+                }
+                else if (iss >> level && (level < 0 || level >= MetricsSampler::LEVELS))
+                {
+                    std::cout << Color::RED << "Uso: sample-show [0|1|2]" << Color::RESET << std::endl;
+                }
+                else
+                {
+                    sampler->display(level);
+                }
+            }
+            else if (command == "sample-stop")
+            {
+                sampler.reset();
+                std::cout << Color::YELLOW << "[MUESTRAS] Muestreo detenido" << Color::RESET << std::endl;
+            }
+            else if (command == "sample-metrics")
+            {
+                MetricsSampler::list_metrics();
+            }
+            else if (command == "sample-read")
+            {
+                std::string path, csv;
+                int level = 0;
+                if (!(iss >> path))
+                {
+                    std::cout << Color::RED << "Uso: sample-read <archivo> [nivel] [salida.csv]"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                if (iss >> level && (level < 0 || level >= MetricsSampler::LEVELS))
+                {
+                    std::cout << Color::RED << "Error: nivel 0, 1 o 2" << Color::RESET << std::endl;
+                    continue;
+                }
+                iss >> csv;
+                if (sampler)
+                {
+                    sampler->flush();   // Que el archivo en curso tenga lo último
+                }
+                read_sample_file(path, level, csv);
+            }
+
+            //  CHECKPOINTS
+            else if (command == "save")
+            {
+                std::string path;
+                if (!(iss >> path))
+                {
+                    std::cout << Color::RED << "Uso: save <archivo>" << Color::RESET << std::endl;
+                    continue;
+                }
+                // Las solicitudes de disco en curso no forman parte del checkpoint
+                if (scheduler->is_io_enabled())
+                {
+                    std::cout << Color::RED << "Error: desactivar E/S (io-off) antes de guardar"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                // Las tareas periódicas tampoco forman parte del checkpoint
+                if (realtime)
+                {
+                    std::cout << Color::RED << "Error: desactivar tiempo real (rt-off) antes de guardar"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                // Ni el ajuste de quantum: su estimador no se guarda
+                if (tuner)
+                {
+                    std::cout << Color::RED << "Error: desactivar el ajuste de quantum (tune-off) antes de guardar"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                // Ni las esperas de recursos: nadie despertaría a los bloqueados
+                if (scheduler->get_resource_blocked() > 0)
+                {
+                    std::cout << Color::RED << "Error: hay procesos bloqueados esperando recursos"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                // Ni el muestreo periódico (sus eventos quedarían en la cola)
+                if (sampler)
+                {
+                    std::cout << Color::RED << "Error: detener el muestreo (sample-stop) antes de guardar"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                // La jerarquía de grupos tampoco
+                if (groups)
+                {
+                    std::cout << Color::RED << "Error: desactivar grupos (grp-off) antes de guardar"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                // Los objetos del kernel tampoco
+                if (slab)
+                {
+                    std::cout << Color::RED << "Error: liberar la capa slab (slab-off) antes de guardar"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                // El frame de una corrutina no se puede serializar
+                if (scheduler->get_live_programs() > 0)
+                {
+                    std::cout << Color::RED << "Error: hay programas vivos; esperar a que terminen"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                
+                CheckpointWriter writer;
+                scheduler->save_state(writer);
+                if (memory) memory->save_state(writer);
+                if (workload) workload->save_state(writer);
+                if (pc_buffer) pc_buffer->save_state(writer);
+                
+                if (writer.write(path))
+                {
+                    std::cout << Color::GREEN << "[CKPT] Guardado en " << path << " ("
+                              << writer.get_bytes() << " bytes, t=" << scheduler->get_current_time()
+                              << ")" << Color::RESET << std::endl;
+                }
+                else
+                {
+                    std::cout << Color::RED << "Error: no se pudo escribir " << path
+                              << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "load")
+            {
+                std::string path;
+                if (!(iss >> path))
+                {
+                    std::cout << Color::RED << "Uso: load <archivo>" << Color::RESET << std::endl;
+                    continue;
+                }
+                
+                auto start = std::chrono::steady_clock::now();
+                CheckpointReader reader;
+                if (!reader.open(path))
+                {
+                    std::cout << Color::RED << "Error: " << reader.get_error()
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                
+                // Reconstruir todo antes de reemplazar: si algo falla, el estado actual queda intacto
+                bool paging = false;
+                auto loaded_scheduler = RoundRobinScheduler::from_checkpoint(reader, paging);
+                std::unique_ptr<MemoryManager> loaded_memory;
+                std::unique_ptr<WorkloadGenerator> loaded_workload;
+                std::unique_ptr<ProducerConsumer> loaded_pc;
+                bool valid = loaded_scheduler != nullptr;
+                if (valid && reader.has(CheckpointSection::MEMORY))
+                {
+                    loaded_memory = MemoryManager::from_checkpoint(reader);
+                    valid = loaded_memory != nullptr;
+                }
+                if (valid && reader.has(CheckpointSection::WORKLOAD))
+                {
+                    loaded_workload = WorkloadGenerator::from_checkpoint(reader);
+                    valid = loaded_workload != nullptr;
+                }
+                if (valid && reader.has(CheckpointSection::BUFFER))
+                {
+                    loaded_pc = ProducerConsumer::from_checkpoint(reader);
+                    valid = loaded_pc != nullptr;
+                }
+                if (!valid)
+                {
+                    std::cout << Color::RED << "Error: checkpoint corrupto o incompleto"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                
+                // Los discos programan eventos en el kernel anterior
+                if (devices)
+                {
+                    scheduler->disable_io();
+                    devices.reset();
+                }
+                scheduler->disable_realtime();
+                realtime.reset();
+                scheduler->disable_groups();
+                groups.reset();
+                scheduler->disable_tuner();
+                tuner.reset();
+                scheduler->disable_resources();
+                resources.reset();  // Sus PIDs eran del scheduler anterior
+                sampler.reset();    // Sus eventos son del kernel anterior
+                slab.reset();
+                trace.reset();      // Sus tiempos son del reloj anterior
+                scheduler->disable_paging();
+                scheduler = std::move(loaded_scheduler);
+                if (stats_server)
+                {
+                    scheduler->get_kernel().set_observer(publish_stats, stats_every);
+                }
+                memory = std::move(loaded_memory);
+                workload = std::move(loaded_workload);
+                pc_buffer = std::move(loaded_pc);
+                if (workload)
+                {
+                    workload_config = workload->get_config();
+                }
+                if (paging && memory && workload)
+                {
+                    scheduler->enable_paging(memory.get(), workload.get(),
+                                             scheduler->get_fault_service_time(),
+                                             scheduler->get_refs_per_tick());
+                }
+                
+                auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                std::cout << Color::GREEN << "[CKPT] Restaurado " << path << " ("
+                          << reader.get_bytes() << " bytes, t=" << scheduler->get_current_time()
+                          << ", " << std::fixed << std::setprecision(2) << elapsed * 1000 << " ms)"
+                          << Color::RESET << std::endl;
+            }
+
+            //  SYNCHRONIZATION
+            //  MEMORIA DEL KERNEL
+            else if (command == "buddy-stats")
+            {
+                if (!memory)
+                {
+                    std::cout << Color::RED << "Error: Memoria no inicializada"
+                              << Color::RESET << std::endl;
+                }
+                else
+                {
+                    memory->get_buddy().display_stats();
+                }
+            }
+            else if (command == "slab-init")
+            {
+                if (!memory)
+                {
+                    std::cout << Color::RED << "Error: Primero inicializa con mem-init"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+
+                int cpus;
+                if (!(iss >> cpus) || cpus <= 0)
+                {
+                    std::cout << Color::RED << "Uso: slab-init <cpus> [magazine]"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                int magazine = 16;
+                if (!(iss >> magazine) || magazine <= 0)
+                {
+                    magazine = 16;
+                }
+
+                // Siempre queda al menos un frame para páginas de usuario
+                MemoryManager* owner = memory.get();
+                slab.reset();
+                slab = std::make_unique<SlabAllocator>(memory->get_buddy(), cpus, magazine,
+                                                       [owner]() { return owner->reclaim_frame(); },
+                                                       memory->get_num_frames() - 1);
+                slab->create_default_caches();
+                kernel_objects.assign(slab->get_cache_count(), {});
+
+                std::cout << Color::GREEN << "[SLAB] " << slab->get_cache_count() << " caches, "
+                          << cpus << " CPUs, magazines de " << magazine << " objetos:";
+                for (int c = 0; c < slab->get_cache_count(); c++)
+                {
+                    std::cout << " " << slab->get_cache_name(c);
+                }
+                std::cout << Color::RESET << std::endl;
+            }
+            else if (command == "kmalloc" || command == "kfree")
+            {
+                if (!slab)
+                {
+                    std::cout << Color::RED << "Error: Primero inicializa con slab-init"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+
+                std::string name;
+                int n;
+                if (!(iss >> name >> n) || n <= 0)
+                {
+                    std::cout << Color::RED << "Uso: " << command << " <cache> <n> [cpu]"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                int cache = slab->find_cache(name);
+                if (cache < 0)
+                {
+                    std::cout << Color::RED << "Error: cache desconocido " << name
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                int cpu = 0;
+                if (!(iss >> cpu) || cpu < 0)
+                {
+                    cpu = 0;
+                }
+
+                auto& live = kernel_objects[cache];
+                int done = 0;
+                if (command == "kmalloc")
+                {
+                    for (; done < n; done++)
+                    {
+                        long long object = slab->alloc(cache, cpu);
+                        if (object < 0)
+                        {
+                            break;
+                        }
+                        live.push_back(object);
+                    }
+                }
+                else
+                {
+                    for (; done < n && !live.empty(); done++)
+                    {
+                        slab->free(cache, cpu, live.back());
+                        live.pop_back();
+                    }
+                }
+
+                std::cout << Color::CYAN << "[SLAB] " << name << ": "
+                          << done << (command == "kmalloc" ? " asignados" : " liberados")
+                          << " en CPU " << cpu % slab->get_cpus() << " (vivos=" << live.size()
+                          << ", frames en slabs=" << slab->get_slab_frames() << ")" << Color::RESET << std::endl;
+                if (done < n && command == "kmalloc")
+                {
+                    std::cout << Color::RED << "[SLAB] Sin memoria tras reclamar: " << n - done
+                              << " fallidos" << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "slab-stats")
+            {
+                if (!slab)
+                {
+                    std::cout << Color::RED << "Error: Capa slab no inicializada"
+                              << Color::RESET << std::endl;
+                }
+                else
+                {
+                    slab->display_stats();
+                }
+            }
+            else if (command == "slab-off")
+            {
+                // Al destruirse devuelve todos los frames de los slabs al buddy
+                slab.reset();
+                kernel_objects.clear();
+                std::cout << Color::YELLOW << "[SLAB] Capa slab desactivada"
+                          << Color::RESET << std::endl;
+            }
+            else if (command == "alloc-bench")
+            {
+                long long ops;
+                if (!(iss >> ops) || ops <= 0)
+                {
+                    std::cout << Color::RED << "Uso: alloc-bench <ops> [frames] [cpus] [magazine]"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                int frames = 65536, cpus = 4, magazine = 16;
+                if (iss >> frames && frames > 0 && iss >> cpus && cpus > 0)
+                {
+                    if (!(iss >> magazine) || magazine <= 0)
+                    {
+                        magazine = 16;
+                    }
+                }
+                frames = frames > 0 ? frames : 65536;
+                cpus = cpus > 0 ? cpus : 4;
+                run_allocator_bench(ops, frames, cpus, magazine, workload_config.seed);
+            }
+
+            else if (command == "pipe-run")
+            {
+                PipelineConfig config;
+                std::string spec, capacities;
+                if (!(iss >> config.items >> spec) || config.items <= 0 ||
+                    !Pipeline::parse_stages(spec, config.stages))
+                {
+                    std::cout << Color::RED << "Uso: pipe-run <items> <etapa:workers:ns,...> [cap[,cap..]] [batch] [pin]"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+
+                std::vector<int> sizes;
+                if (iss >> capacities)
+                {
+                    std::istringstream list(capacities);
+                    std::string size;
+                    while (std::getline(list, size, ','))
+                    {
+                        if (std::atoi(size.c_str()) > 0)
+                        {
+                            sizes.push_back(std::atoi(size.c_str()));
+                        }
+                    }
+                }
+                if (!(iss >> config.batch) || config.batch <= 0)
+                {
+                    config.batch = 1;
+                }
+                std::string pin;
+                config.pin = (iss >> pin) && pin == "pin";
+                if (sizes.size() > 1)
+                {
+                    run_pipeline_capacity_sweep(config, sizes);
+                    continue;
+                }
+
+                config.capacity = sizes.empty() ? 64 : sizes[0];
+                std::cout << Color::BLUE << "[PIPE] " << config.stages.size() << " etapas, "
+                          << config.items << " items..." << Color::RESET << std::endl;
+                Pipeline pipeline(config);
+                PipelineReport report = pipeline.run();
+                Pipeline::display_report(report, config);
+            }
+            else if (command == "pc-init")
+            {
+                int size;
+                if (iss >> size && size > 0)
+                {
+                    pc_buffer = std::make_unique<ProducerConsumer>(size);
+                }
+                else
+                {
+                    std::cout << Color::RED << "Error: size debe ser > 0"
+                              << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "produce")
+            {
+                if (!pc_buffer)
+                {
+                    std::cout << Color::RED << "Error: Primero inicializa con pc-init"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+
+                int item;
+                if (iss >> item)
+                {
+                    pc_buffer->produce(item);
+                }
+                else
+                {
+                    std::cout << Color::RED << "Uso: produce <item>"
+                              << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "consume")
+            {
+                if (!pc_buffer)
+                {
+                    std::cout << Color::RED << "Error: Primero inicializa con pc-init"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+
+                int item;
+                if (pc_buffer->consume(item))
+                {
+                    // Éxito ya reportado en la función
+                }
+            }
+            else if (command == "pc-buffer")
+            {
+                if (!pc_buffer)
+                {
+                    std::cout << Color::RED << "Error: Buffer no inicializado"
+                              << Color::RESET << std::endl;
+                }
+                else
+                {
+                    pc_buffer->display_buffer();
+                }
+            }
+            else if (command == "pc-stats")
+            {
+                if (!pc_buffer)
+                {
+                    std::cout << Color::RED << "Error: Buffer no inicializado"
+                              << Color::RESET << std::endl;
+                }
+                else
+                {
+                    pc_buffer->display_stats();
+                }
+            }
+            else if (command == "pc-reset")
+            {
+                if (!pc_buffer)
+                {
+                    std::cout << Color::RED << "Error: Buffer no inicializado"
+                              << Color::RESET << std::endl;
+                }
+                else
+                {
+                    pc_buffer->reset();
+                }
+            }
+            else if (command == "res-init")
+            {
+                std::string mode = "detect";
+                iss >> mode;
+                if (mode != "detect" && mode != "banker")
+                {
+                    std::cout << Color::RED << "Uso: res-init [detect|banker]" << Color::RESET << std::endl;
+                    continue;
+                }
+                scheduler->disable_resources();
+                resources = std::make_unique<ResourceManager>(mode == "banker" ? ResourceMode::AVOID
+                                                                               : ResourceMode::DETECT);
+                scheduler->enable_resources(resources.get());
+                std::cout << Color::GREEN << "[RECURSO] Gestor de recursos ("
+                          << ResourceManager::mode_to_string(resources->get_mode()) << ")"
+                          << Color::RESET << std::endl;
+            }
+            else if (command == "res-new" || command == "res-claim" || command == "res-req" ||
+                     command == "res-rel")
+            {
+                if (!resources)
+                {
+                    std::cout << Color::RED << "Error: gestor de recursos no inicializado (res-init)"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                if (command == "res-new")
+                {
+                    std::string name;
+                    int units;
+                    if (!(iss >> name >> units) || units <= 0)
+                    {
+                        std::cout << Color::RED << "Uso: res-new <nombre> <unidades>" << Color::RESET << std::endl;
+                        continue;
+                    }
+                    int id = resources->add_resource(name, units);
+                    std::cout << Color::GREEN << "[RECURSO] " << name << " = recurso " << id << " ("
+                              << units << " unidades)" << Color::RESET << std::endl;
+                    continue;
+                }
+
+                int pid, resource;
+                int units = command == "res-rel" ? 0 : 1;
+                if (!(iss >> pid >> resource))
+                {
+                    std::cout << Color::RED << "Uso: " << command
+                              << (command == "res-claim" ? " <pid> <recurso> <máximo>" : " <pid> <recurso> [n]")
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+                iss >> units;
+                if (!live_process(pid))
+                {
+                    std::cout << Color::RED << "Error: P" << pid << " no existe o terminó"
+                              << Color::RESET << std::endl;
+                }
+                else if (command != "res-claim" &&
+                         scheduler->get_table().get_image(pid).state == static_cast<int>(ProcessState::BLOCKED))
+                {
+                    // Pide y libera el proceso que corre o uno listo, no uno bloqueado
+                    std::cout << Color::RED << "Error: P" << pid << " está bloqueado"
+                              << Color::RESET << std::endl;
+                }
+                else if (command == "res-claim")
+                {
+                    if (resources->set_claim(pid, resource, units))
+                    {
+                        std::cout << Color::GREEN << "[RECURSO] P" << pid << " reclama hasta " << units
+                                  << " de " << resource << Color::RESET << std::endl;
+                    }
+                    else
+                    {
+                        std::cout << Color::RED << "Error: reclamo inválido" << Color::RESET << std::endl;
+                    }
+                }
+                else if (command == "res-req")
+                {
+                    RequestResult result = resources->request(pid, resource, units);
+                    if (result == RequestResult::INVALID)
+                    {
+                        std::cout << Color::RED << "Error: pedido inválido (recurso, unidades, reclamo "
+                                  << "o P" << pid << " ya espera)" << Color::RESET << std::endl;
+                    }
+                    else if (result == RequestResult::WAITING || result == RequestResult::POSTPONED)
+                    {
+                        scheduler->wait_for_resource(pid);
+                    }
+                }
+                else if (resources->release(pid, resource, units) == 0)
+                {
+                    std::cout << Color::RED << "Error: P" << pid << " no tiene unidades de " << resource
+                              << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "res-state" || command == "res-stats")
+            {
+                if (!resources)
+                {
+                    std::cout << Color::RED << "Error: gestor de recursos no inicializado (res-init)"
+                              << Color::RESET << std::endl;
+                }
+                else if (command == "res-state")
+                {
+                    resources->display_state();
+                }
+                else
+                {
+                    resources->display_stats();
+                }
+            }
+            else if (command == "res-bench")
+            {
+                int processes, count;
+                long long requests;
+                if (iss >> processes >> count >> requests && processes > 0 && count > 0 && requests > 0)
+                {
+                    run_resource_bench(processes, count, requests, workload_config.seed);
+                }
+                else
+                {
+                    std::cout << Color::RED << "Uso: res-bench <procesos> <recursos> <pedidos>"
+                              << Color::RESET << std::endl;
+                }
+            }
+
+            //  CARGA SINTÉTICA
+            else if (command == "wl-init")
+            {
+                unsigned long long seed;
+                if (iss >> seed)
+                {
+                    workload_config.seed = seed;
+                    double rate;
+                    if (iss >> rate && rate >= 0)
+                    {
+                        workload_config.arrival_rate = rate;
+                    }
+                    if (scheduler->is_paging_enabled())
+                    {
+                        scheduler->disable_paging();
+                        std::cout << Color::YELLOW << "[CPU+MEM] Modo acoplado desactivado (carga reiniciada)"
+                                  << Color::RESET << std::endl;
+                    }
+                    workload = std::make_unique<WorkloadGenerator>(workload_config);
+                    workload->display_config();
+                }
+                else
+                {
+                    std::cout << Color::RED << "Uso: wl-init <seed> [λ]"
+                              << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "wl-burst")
+            {
+                std::string name;
+                if (iss >> name && WorkloadGenerator::parse_burst(name, workload_config.burst_dist))
+                {
+                    double mean;
+                    if (iss >> mean && mean > 0)
+                    {
+                        workload_config.burst_mean = mean;
+                    }
+                    if (scheduler->is_paging_enabled())
+                    {
+                        scheduler->disable_paging();
+                        std::cout << Color::YELLOW << "[CPU+MEM] Modo acoplado desactivado (carga reiniciada)"
+                                  << Color::RESET << std::endl;
+                    }
+                    workload = std::make_unique<WorkloadGenerator>(workload_config);
+                    workload->display_config();
+                }
+                else
+                {
+                    std::cout << Color::RED << "Uso: wl-burst <exp|pareto|bimodal> [media]"
+                              << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "wl-pages")
+            {
+                std::string name;
+                if (iss >> name && WorkloadGenerator::parse_pattern(name, workload_config.page_pattern))
+                {
+                    int pages, ws, phase;
+                    if (iss >> pages && pages > 0)
+                    {
+                        workload_config.pages_per_process = pages;
+                        if (iss >> ws && ws > 0)
+                        {
+                            workload_config.working_set = ws;
+                            if (iss >> phase && phase > 0)
+                            {
+                                workload_config.phase_length = phase;
+                            }
+                        }
+                    }
+                    if (scheduler->is_paging_enabled())
+                    {
+                        scheduler->disable_paging();
+                        std::cout << Color::YELLOW << "[CPU+MEM] Modo acoplado desactivado (carga reiniciada)"
+                                  << Color::RESET << std::endl;
+                    }
+                    workload = std::make_unique<WorkloadGenerator>(workload_config);
+                    workload->display_config();
+                }
+                else
+                {
+                    std::cout << Color::RED << "Uso: wl-pages <zipf|seq|loop> [páginas] [ws] [fase]"
+                              << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "wl-run")
+            {
+                if (!workload)
+                {
+                    std::cout << Color::RED << "Error: Primero inicializa con wl-init"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+
+                int ticks;
+                if (iss >> ticks && ticks > 0)
+                {
+                    int refs = 1;
+                    if (!(iss >> refs) || refs < 0)
+                    {
+                        refs = 1;
+                    }
+                    workload->run(*scheduler, memory.get(), ticks, refs);
+                }
+                else
+                {
+                    std::cout << Color::RED << "Uso: wl-run <ticks> [refs/tick]"
+                              << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "wl-bench")
+            {
+                if (!workload)
+                {
+                    std::cout << Color::RED << "Error: Primero inicializa con wl-init"
+                              << Color::RESET << std::endl;
+                    continue;
+                }
+
+                long long events;
+                if (iss >> events && events > 0)
+                {
+                    workload->benchmark(events);
+                }
+                else
+                {
+                    std::cout << Color::RED << "Uso: wl-bench <eventos>"
+                              << Color::RESET << std::endl;
+                }
+            }
+            else if (command == "wl-stats")
+            {
+                if (!workload)
+                {
+                    std::cout << Color::RED << "Error: Generador no inicializado"
+                              << Color::RESET << std::endl;
+                }
+                else
+                {
+                    workload->display_stats();
                 }
             }
 
@@ -1,15 +1,48 @@
 #include "../include/memory.hpp"
+#include "../include/simulation.hpp"
+#include "../include/checkpoint.hpp"
 #include "../include/utils.hpp"
+#include "../include/workload.hpp"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
 
-MemoryManager::MemoryManager(int num_frames)
+MemoryManager::MemoryManager(int num_frames, ReplacementPolicy policy, bool verbose)
     : num_frames_(num_frames),
+      policy_(policy),
+      clock_hand_(0),
+      buddy_(num_frames),
+      zswap_budget_(0),
+      zswap_bytes_(0),
+      decompress_time_(1),
+      last_fault_from_pool_(false),
+      huge_factor_(1),
+      tlb_entries_(0),
+      numa_nodes_(0),
+      frames_per_node_(std::max(1, num_frames)),
+      numa_sample_clock_(0),
+      numa_samples_(0),
+      numa_migrations_(0),
+      numa_migration_failures_(0),
       total_accesses_(0),
       page_faults_(0),
       page_hits_(0),
-      current_time_(0) {
+      cow_faults_(0),
+      zswap_stores_(0),
+      zswap_rejects_(0),
+      zswap_hits_(0),
+      zswap_writebacks_(0),
+      zswap_stored_bytes_(0),
+      promotions_(0),
+      promotion_failures_(0),
+      demotions_(0),
+      migrated_pages_(0),
+      tlb_hits_(0),
+      tlb_misses_(0),
+      current_time_(0),
+      occupied_count_(0),
+      clock_(nullptr),
+      verbose_(verbose) {
     
     // Inicializar frames
     frames_.resize(num_frames);
@@ -19,63 +52,333 @@ MemoryManager::MemoryManager(int num_frames)
         frames_[i].process_id = -1;
         frames_[i].occupied = false;
         frames_[i].load_time = -1;
+        frames_[i].referenced = false;
     }
+    lru_pos_.resize(num_frames, lru_list_.end());
+    reverse_map_.resize(num_frames);
+    std::fill(std::begin(remote_by_reason_), std::end(remote_by_reason_), 0);
     
-    std::cout << Color::GREEN << "[MEMORY] Inicializada con " 
-              << num_frames << " frames" << Color::RESET << std::endl;
+    if (verbose_) {
+        std::cout << Color::GREEN << "[MEMORY] Inicializada con " 
+                  << num_frames << " frames (" << policy_to_string(policy_) << ")"
+                  << Color::RESET << std::endl;
+    }
 }
 
-bool MemoryManager::access_page(int process_id, int page_number) {
+bool MemoryManager::access_page(int process_id, int page_number, bool write) {
     total_accesses_++;
     current_time_++;
     
     // Verificar si la página ya está en memoria (HIT)
-    if (page_tables_[process_id].count(page_number) > 0 && 
-        page_tables_[process_id][page_number].valid) {
+    PageTableEntry* entry = find_entry(process_id, page_number);
+    if (entry != nullptr) {
         page_hits_++;
-        int frame_id = page_tables_[process_id][page_number].frame_id;
-        
-        std::cout << Color::GREEN << "[HIT] "
-                  << "P" << process_id << " página " << page_number 
-                  << " → frame " << frame_id
-                  << " (hits=" << page_hits_ << ")"
-                  << Color::RESET << std::endl;
+        touch_frame(entry->frame_id);
+        if (verbose_) {
+            int frame_id = entry->frame_id;
+            std::cout << Color::GREEN << "[HIT] "
+                      << "P" << process_id << " página " << page_number 
+                      << " → frame " << frame_id
+                      << " (hits=" << page_hits_ << ")"
+                      << Color::RESET << std::endl;
+        }
+        bool walk = tlb_entries_ == 0 || !tlb_access(process_id, page_number, entry->huge);
+        if (write && entry->cow) {
+            break_cow(process_id, page_number);
+        }
+        if (caches_) {
+            caches_->access(find_entry(process_id, page_number)->frame_id,
+                            page_key(process_id, page_number), walk, 0);
+        }
+        if (numa_nodes_ > 0) {
+            numa_access(process_id, page_number, find_entry(process_id, page_number)->frame_id);
+        }
         return true;
     }
     
     // PAGE FAULT
     page_faults_++;
-    std::cout << Color::YELLOW << "[PAGE FAULT #" << page_faults_ << "] "
-              << "P" << process_id << " página " << page_number 
-              << Color::RESET << std::endl;
+    if (verbose_) {
+        std::cout << Color::YELLOW << "[PAGE FAULT #" << page_faults_ << "] "
+                  << "P" << process_id << " página " << page_number 
+                  << Color::RESET << std::endl;
+    }
+    
+    // Si la página está en el pool comprimido basta con descomprimirla
+    last_fault_from_pool_ = zswap_load(process_id, page_number);
+    
+    // Cargar la página en un frame libre o en la víctima de la política
+    int frame_id = allocate_frame(process_id, page_number);
+    load_page(process_id, page_number, frame_id);
     
-    // Buscar frame libre
-    int frame_id = find_free_frame();
+    if (verbose_) {
+        std::cout << Color::CYAN << "  └─ Página cargada en frame " << frame_id
+                  << Color::RESET << std::endl;
+    }
     
-    // Si no hay frame libre, usar FIFO para seleccionar víctima
+    if (tlb_entries_ > 0) {
+        if (huge_factor_ > 1) {
+            try_promote(process_id, page_number / huge_factor_);
+        }
+        tlb_access(process_id, page_number, find_entry(process_id, page_number)->huge);
+    }
+    if (caches_) {
+        // La página pudo migrar al promoverse: el frame se relee de la tabla
+        const CacheConfig& costs = caches_->get_config();
+        caches_->access(find_entry(process_id, page_number)->frame_id, page_key(process_id, page_number),
+                        true, last_fault_from_pool_ ? costs.pool_cycles : costs.fault_cycles);
+    }
+    if (numa_nodes_ > 0) {
+        numa_access(process_id, page_number, find_entry(process_id, page_number)->frame_id);
+    }
+    return false;
+}
+
+int MemoryManager::allocate_frame(int process_id, int page_number) {
+    // Buscar frame libre (con NUMA, primero en el nodo que pide la colocación)
+    int frame_id = numa_nodes_ > 0 ? numa_free_frame(process_id, page_number) : find_free_frame();
+    
+    // Si no hay frame libre, la política elige la víctima
     if (frame_id == -1) {
-        frame_id = select_victim_fifo();
-        std::cout << Color::RED << "  └─ Evictando frame " << frame_id 
-                  << " (FIFO)" << Color::RESET << std::endl;
+        frame_id = select_victim();
+        if (verbose_) {
+            std::cout << Color::RED << "  └─ Evictando frame " << frame_id 
+                      << " (" << policy_to_string(policy_) << ")" << Color::RESET << std::endl;
+        }
         evict_page(frame_id);
     }
+    if (numa_nodes_ > 0) {
+        numa_place(frame_id, process_id, page_number);
+    }
+    return frame_id;
+}
+
+void MemoryManager::fork(int parent_pid, int child_pid) {
+    if (numa_nodes_ > 0 && parent_pid != child_pid) {
+        home_nodes_[child_pid] = home_node(parent_pid);
+    }
+    auto parent = process_entries(parent_pid);
+    if (parent.empty() || parent_pid == child_pid) {
+        return;
+    }
     
-    // Cargar la página en el frame
-    load_page(process_id, page_number, frame_id);
+    // Las huge pages del padre se dividen: COW se resuelve por página base
+    for (const auto& entry : parent) {
+        if (entry.second.huge && find_entry(parent_pid, entry.first)->huge) {
+            demote(entry.second.frame_id / huge_factor_);
+        }
+    }
     
-    std::cout << Color::CYAN << "  └─ Página cargada en frame " << frame_id
-              << Color::RESET << std::endl;
+    // Sin copiar frames: solo la page table, con ambas partes en COW
+    int shared = 0;
+    for (const auto& entry : parent) {
+        find_entry(parent_pid, entry.first)->cow = true;
+        map_entry(child_pid, entry.first) = {entry.second.frame_id, true, true, false};
+        reverse_map_[entry.second.frame_id].push_back({child_pid, entry.first});
+        shared++;
+    }
     
-    return false;
+    if (verbose_) {
+        std::cout << Color::CYAN << "[FORK] P" << child_pid << " comparte " << shared
+                  << " página(s) de P" << parent_pid << " (copy-on-write)"
+                  << Color::RESET << std::endl;
+    }
 }
 
-int MemoryManager::find_free_frame() {
-    for (int i = 0; i < num_frames_; i++) {
-        if (!frames_[i].occupied) {
-            return i;
+void MemoryManager::break_cow(int process_id, int page_number) {
+    PageTableEntry& entry = *find_entry(process_id, page_number);
+    int shared = entry.frame_id;
+    
+    // Último mapeo: escribe en su lugar sin copiar
+    if (reverse_map_[shared].size() == 1) {
+        entry.cow = false;
+        return;
+    }
+    
+    // Fallo COW: copia privada en otro frame. Se desmapea antes de reservar
+    // para que una eviction del frame compartido no invalide esta página.
+    cow_faults_++;
+    unmap(shared, process_id, page_number);
+    int copy = allocate_frame(process_id, page_number);
+    load_page(process_id, page_number, copy);
+    
+    if (verbose_) {
+        std::cout << Color::YELLOW << "  └─ Fallo COW: frame " << shared
+                  << " copiado a frame " << copy << " (COW=" << cow_faults_ << ")"
+                  << Color::RESET << std::endl;
+    }
+}
+
+void MemoryManager::unmap(int frame_id, int process_id, int page_number) {
+    if (tlb_entries_ > 0) {
+        tlb_shootdown(tlb_key(process_id, page_number, false));
+    }
+    auto& mappings = reverse_map_[frame_id];
+    mappings.erase(std::find_if(mappings.begin(), mappings.end(), [&](const PageMapping& m) {
+        return m.process_id == process_id && m.page_number == page_number;
+    }));
+    
+    // El frame queda a nombre del siguiente mapeo
+    if (!mappings.empty()) {
+        frames_[frame_id].process_id = mappings.front().process_id;
+        frames_[frame_id].page_number = mappings.front().page_number;
+    }
+}
+
+PageTableEntry* MemoryManager::find_entry(int process_id, int page_number) {
+    if (inverted_) {
+        return inverted_->find(process_id, page_number);
+    }
+    auto table = page_tables_.find(process_id);
+    if (table == page_tables_.end()) {
+        return nullptr;
+    }
+    auto entry = table->second.find(page_number);
+    return entry == table->second.end() ? nullptr : &entry->second;
+}
+
+PageTableEntry& MemoryManager::map_entry(int process_id, int page_number) {
+    if (inverted_) {
+        return inverted_->insert(process_id, page_number);
+    }
+    return page_tables_[process_id][page_number];
+}
+
+void MemoryManager::erase_entry(int process_id, int page_number) {
+    if (inverted_) {
+        inverted_->erase(process_id, page_number);
+        return;
+    }
+    // Sin entradas inválidas: el árbol de un proceso sin páginas desaparece
+    auto table = page_tables_.find(process_id);
+    if (table != page_tables_.end()) {
+        table->second.erase(page_number);
+        if (table->second.empty()) {
+            page_tables_.erase(table);
+        }
+    }
+}
+
+std::vector<std::pair<int, PageTableEntry>> MemoryManager::process_entries(int process_id) const {
+    std::vector<std::pair<int, PageTableEntry>> entries;
+    if (inverted_) {
+        // La tabla invertida no agrupa por proceso: se recorre entera
+        inverted_->for_each([&](int pid, int page, const PageTableEntry& entry) {
+            if (pid == process_id) {
+                entries.emplace_back(page, entry);
+            }
+        });
+        std::sort(entries.begin(), entries.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+    } else {
+        auto table = page_tables_.find(process_id);
+        if (table != page_tables_.end()) {
+            entries.assign(table->second.begin(), table->second.end());
+        }
+    }
+    return entries;
+}
+
+void MemoryManager::set_inverted(bool inverted) {
+    if (inverted == is_inverted()) {
+        return;
+    }
+    if (inverted) {
+        inverted_ = std::make_unique<InvertedPageTable>(num_frames_);
+        for (const auto& table : page_tables_) {
+            for (const auto& entry : table.second) {
+                inverted_->insert(table.first, entry.first) = entry.second;
+            }
         }
+        page_tables_.clear();
+    } else {
+        std::unique_ptr<InvertedPageTable> table = std::move(inverted_);
+        table->for_each([this](int pid, int page, const PageTableEntry& entry) {
+            page_tables_[pid][page] = entry;
+        });
+    }
+}
+
+int MemoryManager::get_mapped_pages() const {
+    if (inverted_) {
+        return static_cast<int>(inverted_->size());
+    }
+    int pages = 0;
+    for (const auto& table : page_tables_) {
+        pages += static_cast<int>(table.second.size());
+    }
+    return pages;
+}
+
+size_t MemoryManager::translation_bytes() const {
+    if (inverted_) {
+        return inverted_->memory_bytes();
+    }
+    // Nodo de árbol rojo-negro de libstdc++: 32 bytes de enlaces y color + el par
+    constexpr size_t NODE = 32;
+    size_t bytes = page_tables_.size() * (NODE + sizeof(std::pair<const int, std::map<int, PageTableEntry>>));
+    for (const auto& table : page_tables_) {
+        bytes += table.second.size() * (NODE + sizeof(std::pair<const int, PageTableEntry>));
+    }
+    return bytes;
+}
+
+int MemoryManager::find_free_frame() {
+    if (buddy_.get_free_frames() == 0) {
+        return -1; // Memoria llena (páginas de usuario y slabs)
+    }
+    return buddy_.allocate(0);
+}
+
+bool MemoryManager::reclaim_frame() {
+    if (occupied_count_ == 0) {
+        return false;
+    }
+    int frame_id = select_victim();
+    if (verbose_) {
+        std::cout << Color::RED << "[RECLAIM] Evictando frame " << frame_id
+                  << " para el kernel" << Color::RESET << std::endl;
+    }
+    evict_page(frame_id);
+    buddy_.free(frame_id, 0);
+    return true;
+}
+
+int MemoryManager::select_victim() {
+    switch (policy_) {
+        case ReplacementPolicy::LRU: return select_victim_lru();
+        case ReplacementPolicy::CLOCK: return select_victim_clock();
+        case ReplacementPolicy::FIFO:
+        default: return select_victim_fifo();
+    }
+}
+
+int MemoryManager::select_victim_lru() {
+    // LRU: el frente de la lista es el menos recientemente usado
+    int victim = lru_list_.front();
+    lru_list_.pop_front();
+    lru_pos_[victim] = lru_list_.end();
+    return victim;
+}
+
+int MemoryManager::select_victim_clock() {
+    // Segunda oportunidad: limpiar bits de referencia hasta hallar uno en 0.
+    // Los frames que no son de usuario (slabs, libres) no son candidatos.
+    while (frames_[clock_hand_].referenced || !frames_[clock_hand_].occupied) {
+        frames_[clock_hand_].referenced = false;
+        clock_hand_ = (clock_hand_ + 1) % num_frames_;
+    }
+    int victim = clock_hand_;
+    clock_hand_ = (clock_hand_ + 1) % num_frames_;
+    return victim;
+}
+
+void MemoryManager::touch_frame(int frame_id) {
+    if (policy_ == ReplacementPolicy::LRU) {
+        lru_list_.splice(lru_list_.end(), lru_list_, lru_pos_[frame_id]);
+    } else if (policy_ == ReplacementPolicy::CLOCK) {
+        frames_[frame_id].referenced = true;
     }
-    return -1; // No hay frames libres
 }
 
 int MemoryManager::select_victim_fifo() {
@@ -91,34 +394,700 @@ int MemoryManager::select_victim_fifo() {
 
 void MemoryManager::load_page(int process_id, int page_number, int frame_id) {
     // Actualizar frame
+    if (!frames_[frame_id].occupied) {
+        occupied_count_++;
+    }
     frames_[frame_id].occupied = true;
     frames_[frame_id].page_number = page_number;
     frames_[frame_id].process_id = process_id;
-    frames_[frame_id].load_time = current_time_;
+    frames_[frame_id].load_time = clock_ ? static_cast<int>(clock_->now()) : current_time_;
     
-    // Agregar a cola FIFO
-    fifo_queue_.push(frame_id);
+    // Registrar en la estructura de la política
+    if (policy_ == ReplacementPolicy::FIFO) {
+        fifo_queue_.push(frame_id);
+    } else if (policy_ == ReplacementPolicy::LRU) {
+        lru_pos_[frame_id] = lru_list_.insert(lru_list_.end(), frame_id);
+    } else {
+        frames_[frame_id].referenced = true;
+    }
+    
+    if (caches_) {
+        caches_->invalidate_frame(frame_id);
+    }
     
-    // Actualizar page table
-    page_tables_[process_id][page_number].frame_id = frame_id;
-    page_tables_[process_id][page_number].valid = true;
+    // Actualizar page table y mapa inverso
+    map_entry(process_id, page_number) = {frame_id, true, false, false};
+    reverse_map_[frame_id].assign(1, {process_id, page_number});
 }
 
 void MemoryManager::evict_page(int frame_id) {
+    // Presión de memoria: una huge page se divide y solo sale este frame
+    if (huge_factor_ > 1 && frame_id / huge_factor_ < static_cast<int>(huge_blocks_.size()) &&
+        huge_blocks_[frame_id / huge_factor_]) {
+        demote(frame_id / huge_factor_);
+    }
     if (frames_[frame_id].occupied) {
-        int old_process = frames_[frame_id].process_id;
-        int old_page = frames_[frame_id].page_number;
-        
-        // Invalidar entrada en page table
-        page_tables_[old_process][old_page].valid = false;
+        // Borrar todos los mapeos del frame a través del mapa inverso.
+        // Con zswap cada mapeo deja su copia comprimida (un swap entry por PTE).
+        for (const PageMapping& mapping : reverse_map_[frame_id]) {
+            erase_entry(mapping.process_id, mapping.page_number);
+            if (tlb_entries_ > 0) {
+                tlb_shootdown(tlb_key(mapping.process_id, mapping.page_number, false));
+            }
+            if (zswap_budget_ > 0) {
+                zswap_store(mapping.process_id, mapping.page_number);
+            }
+        }
+        reverse_map_[frame_id].clear();
         
         // Marcar frame como libre
         frames_[frame_id].occupied = false;
+        occupied_count_--;
         frames_[frame_id].process_id = -1;
         frames_[frame_id].page_number = -1;
     }
 }
 
+void MemoryManager::enable_zswap(int pool_frames, int decompress_time) {
+    zswap_budget_ = static_cast<long long>(pool_frames) * PAGE_SIZE;
+    decompress_time_ = std::max(1, decompress_time);
+    
+    // Al achicar el pool, las más antiguas van a disco
+    while (zswap_bytes_ > zswap_budget_) {
+        const ZswapEntry& oldest = zswap_pool_.front();
+        zswap_bytes_ -= oldest.bytes;
+        zswap_index_.erase(page_key(oldest.process_id, oldest.page_number));
+        zswap_pool_.pop_front();
+        zswap_writebacks_++;
+    }
+    
+    if (verbose_) {
+        std::cout << Color::GREEN << "[ZSWAP] Pool de " << pool_frames << " frames ("
+                  << zswap_budget_ / 1024 << " KB), descompresión " << decompress_time_
+                  << " ticks" << Color::RESET << std::endl;
+    }
+}
+
+void MemoryManager::disable_zswap() {
+    zswap_writebacks_ += static_cast<int>(zswap_pool_.size());
+    zswap_pool_.clear();
+    zswap_index_.clear();
+    zswap_bytes_ = 0;
+    zswap_budget_ = 0;
+}
+
+void MemoryManager::enable_huge_pages(int huge_factor, int tlb_entries) {
+    disable_huge_pages();
+    huge_factor_ = std::max(1, huge_factor);
+    tlb_entries_ = std::max(1, tlb_entries);
+    huge_blocks_.assign(huge_factor_ > 1 ? num_frames_ / huge_factor_ : 0, 0);
+    
+    if (verbose_) {
+        std::cout << Color::GREEN << "[HUGE] Huge pages de " << huge_factor_ << " frames ("
+                  << huge_factor_ * PAGE_SIZE / 1024 << " KB), " << huge_blocks_.size()
+                  << " bloques alineados, TLB de " << tlb_entries_ << " entradas"
+                  << Color::RESET << std::endl;
+    }
+}
+
+void MemoryManager::disable_huge_pages() {
+    for (int block = 0; block < static_cast<int>(huge_blocks_.size()); block++) {
+        if (huge_blocks_[block]) {
+            demote(block);
+        }
+    }
+    huge_blocks_.clear();
+    huge_factor_ = 1;
+    tlb_entries_ = 0;
+    tlb_lru_.clear();
+    tlb_index_.clear();
+}
+
+void MemoryManager::enable_caches(const CacheConfig& config) {
+    caches_ = std::make_unique<CacheHierarchy>(config, num_frames_, PAGE_SIZE);
+    if (verbose_) {
+        std::cout << Color::GREEN << "[CACHE] Jerarquía de " << config.levels.size()
+                  << " nivel(es), línea de " << config.line_size << " B" << Color::RESET << std::endl;
+    }
+}
+
+void MemoryManager::display_cache_stats() const {
+    if (!caches_) {
+        std::cout << Color::YELLOW << "Modelo de cachés inactivo (cache-init)"
+                  << Color::RESET << std::endl;
+        return;
+    }
+    caches_->display_stats();
+}
+
+bool parse_numa_option(const std::string& token, NumaConfig& config) {
+    if (token == "first" || token == "first-touch") {
+        config.placement = NumaPlacement::FIRST_TOUCH;
+        return true;
+    }
+    if (token == "interleave") {
+        config.placement = NumaPlacement::INTERLEAVE;
+        return true;
+    }
+    if (token == "migrate=on" || token == "migrate=off") {
+        config.migrate = token == "migrate=on";
+        return true;
+    }
+    size_t eq = token.find('=');
+    if (eq == std::string::npos) {
+        return false;
+    }
+    std::string key = token.substr(0, eq);
+    int value = std::atoi(token.c_str() + eq + 1);
+    if (value <= 0) {
+        return false;
+    }
+    if (key == "local") {
+        config.local_ns = value;
+    } else if (key == "remote") {
+        config.remote_ns = value;
+    } else if (key == "sample") {
+        config.sample_period = value;
+    } else if (key == "copy") {
+        config.copy_ns = value;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void MemoryManager::enable_numa(const NumaConfig& config) {
+    disable_numa();
+    numa_ = config;
+    int nodes = std::clamp(config.nodes, 1, std::min(64, std::max(1, num_frames_)));
+    frames_per_node_ = (num_frames_ + nodes - 1) / nodes;
+    numa_nodes_ = (num_frames_ + frames_per_node_ - 1) / frames_per_node_;
+    numa_.nodes = numa_nodes_;
+    
+    // Las páginas ya residentes se atribuyen según su nodo actual
+    numa_frames_.assign(num_frames_, {NumaReason::LOCAL, -1});
+    for (int f = 0; f < num_frames_; f++) {
+        if (frames_[f].occupied && node_of(f) != home_node(frames_[f].process_id)) {
+            numa_frames_[f].reason = NumaReason::POLICY;
+        }
+    }
+    numa_stats_.assign(numa_nodes_, NumaNodeStats{});
+    
+    if (verbose_) {
+        std::cout << Color::GREEN << "[NUMA] " << numa_nodes_ << " nodos de " << frames_per_node_
+                  << " frames (" << (numa_.placement == NumaPlacement::INTERLEAVE ? "interleave" : "first-touch")
+                  << "), local " << numa_.local_ns << " ns, remoto " << numa_.remote_ns << " ns, migración "
+                  << (numa_.migrate ? "1 muestra cada " + std::to_string(numa_.sample_period) + " accesos" : "apagada")
+                  << Color::RESET << std::endl;
+    }
+}
+
+void MemoryManager::disable_numa() {
+    numa_nodes_ = 0;
+    frames_per_node_ = std::max(1, num_frames_);
+    numa_frames_.clear();
+    numa_stats_.clear();
+    home_nodes_.clear();
+    numa_sample_clock_ = 0;
+    numa_samples_ = 0;
+    numa_migrations_ = 0;
+    numa_migration_failures_ = 0;
+    std::fill(std::begin(remote_by_reason_), std::end(remote_by_reason_), 0);
+}
+
+bool MemoryManager::set_home_node(int process_id, int node) {
+    if (numa_nodes_ == 0 || node < 0 || node >= numa_nodes_) {
+        return false;
+    }
+    home_nodes_[process_id] = node;
+    return true;
+}
+
+int MemoryManager::home_node(int process_id) const {
+    auto it = home_nodes_.find(process_id);
+    if (it != home_nodes_.end()) {
+        return it->second;
+    }
+    return std::max(0, process_id) % numa_nodes_;
+}
+
+int MemoryManager::numa_free_frame(int process_id, int page_number) {
+    // Nodo pedido por la política y, si está lleno, los siguientes en orden
+    int target = numa_.placement == NumaPlacement::INTERLEAVE ? std::max(0, page_number) % numa_nodes_
+                                                               : home_node(process_id);
+    for (int i = 0; i < numa_nodes_; i++) {
+        int first = ((target + i) % numa_nodes_) * frames_per_node_;
+        int frame = buddy_.find_free_in(first, std::min(num_frames_, first + frames_per_node_));
+        if (frame >= 0) {
+            buddy_.claim(frame);
+            return frame;
+        }
+    }
+    return -1;
+}
+
+void MemoryManager::numa_place(int frame_id, int process_id, int page_number) {
+    int node = node_of(frame_id);
+    int home = home_node(process_id);
+    int target = numa_.placement == NumaPlacement::INTERLEAVE ? std::max(0, page_number) % numa_nodes_ : home;
+    
+    // Remoto por decisión de la política o porque el nodo pedido estaba lleno
+    NumaReason reason = node == home ? NumaReason::LOCAL
+                      : node == target ? NumaReason::POLICY : NumaReason::CAPACITY;
+    numa_frames_[frame_id] = {reason, -1};
+    numa_stats_[node].placed[static_cast<int>(reason)]++;
+}
+
+void MemoryManager::numa_access(int process_id, int page_number, int frame_id) {
+    int node = node_of(frame_id);
+    int from = home_node(process_id);
+    NumaFrame& info = numa_frames_[frame_id];
+    if (node == from) {
+        numa_stats_[from].local_accesses++;
+    } else {
+        numa_stats_[from].remote_accesses++;
+        remote_by_reason_[static_cast<int>(info.reason)]++;
+    }
+    
+    if (!numa_.migrate || ++numa_sample_clock_ < numa_.sample_period) {
+        return;
+    }
+    
+    // Filtro de dos etapas: migrar solo si la muestra anterior vino del mismo nodo
+    numa_sample_clock_ = 0;
+    numa_samples_++;
+    if (node != from && info.last_sample == from) {
+        if (numa_migrate(frame_id, from) && verbose_) {
+            std::cout << Color::MAGENTA << "  └─ NUMA: página " << page_number << " de P" << process_id
+                      << " migrada al nodo " << from << " (frame "
+                      << find_entry(process_id, page_number)->frame_id << ")" << Color::RESET << std::endl;
+        }
+    } else {
+        info.last_sample = static_cast<signed char>(from);
+    }
+}
+
+bool MemoryManager::numa_migrate(int frame_id, int node) {
+    // Solo páginas privadas y base: las compartidas y las huge se quedan
+    bool huge = huge_factor_ > 1 && frame_id / huge_factor_ < static_cast<int>(huge_blocks_.size()) &&
+                huge_blocks_[frame_id / huge_factor_];
+    if (reverse_map_[frame_id].size() != 1 || huge) {
+        return false;
+    }
+    int first = node * frames_per_node_;
+    int target = buddy_.find_free_in(first, std::min(num_frames_, first + frames_per_node_));
+    if (target < 0) {
+        numa_migration_failures_++;
+        return false;
+    }
+    
+    PageMapping mapping = reverse_map_[frame_id].front();
+    swap_frames(frame_id, target);
+    if (tlb_entries_ > 0) {
+        tlb_shootdown(tlb_key(mapping.process_id, mapping.page_number, false));
+    }
+    numa_frames_[target] = {NumaReason::MIGRATED, -1};
+    numa_migrations_++;
+    numa_stats_[node].migrations_in++;
+    return true;
+}
+
+void MemoryManager::display_numa_stats() const {
+    if (numa_nodes_ == 0) {
+        std::cout << Color::YELLOW << "NUMA inactivo (numa-init)" << Color::RESET << std::endl;
+        return;
+    }
+    print_header("MEMORIA NUMA");
+    
+    std::cout << " Nodos:                 " << numa_nodes_ << " × " << frames_per_node_ << " frames, colocación "
+              << (numa_.placement == NumaPlacement::INTERLEAVE ? "interleave" : "first-touch") << std::endl;
+    std::cout << " Costos:                local " << numa_.local_ns << " ns, remoto " << numa_.remote_ns
+              << " ns, copia " << numa_.copy_ns << " ns/página" << std::endl;
+    
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "\n " << std::left << std::setw(6) << "Nodo" << std::right << std::setw(8) << "Frames"
+              << std::setw(8) << "Libres" << std::setw(12) << "Locales" << std::setw(12) << "Remotos"
+              << std::setw(9) << "% local" << std::setw(11) << "Asig. rem." << std::setw(10) << "Migr. in" << std::endl;
+    print_separator(78);
+    long long local = 0, remote = 0;
+    for (int n = 0; n < numa_nodes_; n++) {
+        const NumaNodeStats& s = numa_stats_[n];
+        int first = n * frames_per_node_;
+        int last = std::min(num_frames_, first + frames_per_node_);
+        int free_frames = 0;
+        for (int f = first; f < last; f++) {
+            free_frames += buddy_.is_free(f) ? 1 : 0;
+        }
+        long long accesses = s.local_accesses + s.remote_accesses;
+        long long placed_remote = s.placed[static_cast<int>(NumaReason::POLICY)] +
+                                  s.placed[static_cast<int>(NumaReason::CAPACITY)];
+        std::cout << " " << std::left << std::setw(6) << n << std::right << std::setw(8) << last - first
+                  << std::setw(8) << free_frames << std::setw(12) << s.local_accesses
+                  << std::setw(12) << s.remote_accesses
+                  << std::setw(9) << (accesses > 0 ? 100.0 * s.local_accesses / accesses : 0.0)
+                  << std::setw(11) << placed_remote << std::setw(10) << s.migrations_in << std::endl;
+        local += s.local_accesses;
+        remote += s.remote_accesses;
+    }
+    
+    long long accesses = local + remote;
+    double n = accesses > 0 ? static_cast<double>(accesses) : 1.0;
+    long long by_policy = remote_by_reason_[static_cast<int>(NumaReason::POLICY)];
+    long long by_capacity = remote_by_reason_[static_cast<int>(NumaReason::CAPACITY)];
+    long long by_sharing = remote - by_policy - by_capacity;
+    std::cout << "\n Accesos:               " << accesses << " (" << 100.0 * local / n << "% locales)" << std::endl;
+    std::cout << " Remotos por causa:     " << remote << std::endl;
+    std::cout << "  ├─ Colocación:        " << by_policy << " (la política eligió otro nodo)" << std::endl;
+    std::cout << "  ├─ Capacidad:         " << by_capacity << " (nodo hogar lleno al asignar)" << std::endl;
+    std::cout << "  └─ Compartidas:       " << by_sharing << " (de otro proceso o cambio de hogar)" << std::endl;
+    std::cout << " Migración:             " << (numa_.migrate ? "" : "apagada, ") << numa_samples_ << " muestras, "
+              << numa_migrations_ << " páginas (" << numa_migrations_ * PAGE_SIZE / 1024 << " KB)" << std::endl;
+    std::cout << "  └─ Sin frame libre:   " << numa_migration_failures_ << std::endl;
+    
+    double access_ns = (local * static_cast<double>(numa_.local_ns) + remote * static_cast<double>(numa_.remote_ns)) / n;
+    double copy_ns = numa_migrations_ * static_cast<double>(numa_.copy_ns) / n;
+    std::cout << std::setprecision(2);
+    std::cout << "\n Latencia efectiva:     " << access_ns + copy_ns << " ns/acceso" << std::endl;
+    std::cout << "  ├─ Accesos:           " << access_ns << " (todo local: " << numa_.local_ns << ")" << std::endl;
+    std::cout << "  └─ Migraciones:       " << copy_ns << std::endl;
+    
+    // Qué domina los accesos remotos: la política o la falta de memoria local
+    std::cout << " Diagnóstico:           ";
+    if (remote * 10 <= accesses) {
+        std::cout << Color::GREEN << "casi todo local" << Color::RESET;
+    } else if (by_capacity + numa_migration_failures_ >= std::max(by_policy, by_sharing)) {
+        std::cout << Color::YELLOW << "capacidad: los nodos hogar no alcanzan" << Color::RESET;
+    } else if (by_policy >= by_sharing) {
+        std::cout << Color::YELLOW << "colocación: la política reparte páginas a nodos remotos" << Color::RESET;
+    } else {
+        std::cout << Color::YELLOW << "compartición entre nodos" << Color::RESET;
+    }
+    std::cout << std::endl << std::endl;
+}
+
+bool MemoryManager::tlb_access(int process_id, int page_number, bool huge) {
+    long long key = tlb_key(process_id, huge ? page_number / huge_factor_ : page_number, huge);
+    auto it = tlb_index_.find(key);
+    if (it != tlb_index_.end()) {
+        tlb_hits_++;
+        tlb_lru_.splice(tlb_lru_.end(), tlb_lru_, it->second);
+        return true;
+    }
+    
+    // Miss: page walk y la traducción reemplaza a la menos reciente
+    tlb_misses_++;
+    if (static_cast<int>(tlb_lru_.size()) >= tlb_entries_) {
+        tlb_index_.erase(tlb_lru_.front());
+        tlb_lru_.pop_front();
+    }
+    tlb_index_[key] = tlb_lru_.insert(tlb_lru_.end(), key);
+    return false;
+}
+
+void MemoryManager::tlb_shootdown(long long key) {
+    auto it = tlb_index_.find(key);
+    if (it != tlb_index_.end()) {
+        tlb_lru_.erase(it->second);
+        tlb_index_.erase(it);
+    }
+}
+
+void MemoryManager::try_promote(int process_id, int region) {
+    // Solo regiones con todas sus páginas residentes y privadas
+    int first = region * huge_factor_;
+    for (int i = 0; i < huge_factor_; i++) {
+        const PageTableEntry* entry = find_entry(process_id, first + i);
+        if (entry == nullptr || entry->cow || entry->huge ||
+            reverse_map_[entry->frame_id].size() != 1) {
+            return;
+        }
+    }
+    
+    // Bloque físico alineado cuyos frames estén libres o ya sean de la región;
+    // se elige el que exige menos migraciones
+    auto owned = [&](int frame) {
+        if (!frames_[frame].occupied) return buddy_.is_free(frame) ? 0 : -1;
+        const PageMapping& m = reverse_map_[frame].front();
+        bool mine = reverse_map_[frame].size() == 1 && m.process_id == process_id &&
+                    m.page_number / huge_factor_ == region;
+        return mine ? 1 : -1;
+    };
+    int best = -1, best_inside = -1;
+    for (int block = 0; block < static_cast<int>(huge_blocks_.size()); block++) {
+        if (huge_blocks_[block]) {
+            continue;
+        }
+        int inside = 0;
+        bool usable = true;
+        for (int k = 0; k < huge_factor_ && usable; k++) {
+            int state = owned(block * huge_factor_ + k);
+            usable = state >= 0;
+            inside += state;
+        }
+        if (usable && inside > best_inside) {
+            best = block;
+            best_inside = inside;
+        }
+    }
+    if (best < 0) {
+        promotion_failures_++;
+        if (verbose_) {
+            std::cout << Color::RED << "  └─ Región " << region << " de P" << process_id
+                      << " sin bloque alineado libre (fragmentación)" << Color::RESET << std::endl;
+        }
+        return;
+    }
+    
+    // Colapsar: cada página a su posición dentro del bloque
+    int base = best * huge_factor_;
+    int moved = 0;
+    for (int i = 0; i < huge_factor_; i++) {
+        PageTableEntry& entry = *find_entry(process_id, first + i);
+        if (entry.frame_id != base + i) {
+            swap_frames(entry.frame_id, base + i);
+            moved++;
+        }
+        entry.huge = true;
+        tlb_shootdown(tlb_key(process_id, first + i, false));
+    }
+    huge_blocks_[best] = 1;
+    promotions_++;
+    migrated_pages_ += moved;
+    
+    if (verbose_) {
+        std::cout << Color::MAGENTA << "  └─ Región " << region << " de P" << process_id
+                  << " promovida a huge page en frames " << base << "-" << base + huge_factor_ - 1
+                  << " (" << moved << " migradas)" << Color::RESET << std::endl;
+    }
+}
+
+void MemoryManager::demote(int block) {
+    int base = block * huge_factor_;
+    const PageMapping& owner = reverse_map_[base].front();
+    tlb_shootdown(tlb_key(owner.process_id, owner.page_number / huge_factor_, true));
+    for (int k = 0; k < huge_factor_; k++) {
+        const PageMapping& m = reverse_map_[base + k].front();
+        find_entry(m.process_id, m.page_number)->huge = false;
+    }
+    huge_blocks_[block] = 0;
+    demotions_++;
+    
+    if (verbose_) {
+        std::cout << Color::YELLOW << "  └─ Huge page en frames " << base << "-"
+                  << base + huge_factor_ - 1 << " dividida" << Color::RESET << std::endl;
+    }
+}
+
+void MemoryManager::swap_frames(int a, int b) {
+    // Si uno de los dos está libre, el buddy pasa a tener libre al otro
+    if (frames_[a].occupied != frames_[b].occupied) {
+        int taken = frames_[a].occupied ? b : a;
+        buddy_.claim(taken);
+        buddy_.free(taken == a ? b : a, 0);
+    }
+    
+    // Las líneas en caché son de la dirección física vieja
+    if (caches_) {
+        caches_->invalidate_frame(a);
+        caches_->invalidate_frame(b);
+    }
+    
+    // Intercambiar contenido (página, metadatos y posición en el reemplazo)
+    std::swap(frames_[a], frames_[b]);
+    std::swap(frames_[a].frame_id, frames_[b].frame_id);
+    std::swap(reverse_map_[a], reverse_map_[b]);
+    if (numa_nodes_ > 0) {
+        std::swap(numa_frames_[a], numa_frames_[b]);
+    }
+    for (int frame : {a, b}) {
+        for (const PageMapping& m : reverse_map_[frame]) {
+            find_entry(m.process_id, m.page_number)->frame_id = frame;
+        }
+    }
+    
+    if (policy_ == ReplacementPolicy::LRU) {
+        std::swap(lru_pos_[a], lru_pos_[b]);
+        if (lru_pos_[a] != lru_list_.end()) *lru_pos_[a] = a;
+        if (lru_pos_[b] != lru_list_.end()) *lru_pos_[b] = b;
+    } else if (policy_ == ReplacementPolicy::FIFO) {
+        std::queue<int> order;
+        for (; !fifo_queue_.empty(); fifo_queue_.pop()) {
+            int f = fifo_queue_.front();
+            order.push(f == a ? b : f == b ? a : f);
+        }
+        fifo_queue_.swap(order);
+    }
+}
+
+double MemoryManager::get_tlb_hit_rate() const {
+    long long lookups = tlb_hits_ + tlb_misses_;
+    return lookups > 0 ? (double)tlb_hits_ / lookups : 0.0;
+}
+
+void MemoryManager::display_huge_stats() const {
+    print_header("HUGE PAGES Y TLB");
+    
+    if (tlb_entries_ == 0) {
+        std::cout << Color::YELLOW << " Desactivado (mem-huge <factor> [entradas_tlb])"
+                  << Color::RESET << std::endl << std::endl;
+        return;
+    }
+    
+    int active = static_cast<int>(std::count(huge_blocks_.begin(), huge_blocks_.end(), 1));
+    int huge_pages = active * huge_factor_;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << " Huge page:             " << huge_factor_ << " frames ("
+              << huge_factor_ * PAGE_SIZE / 1024 << " KB)" << std::endl;
+    std::cout << " Huge pages activas:    " << active << " (" << huge_pages << " páginas, "
+              << (occupied_count_ > 0 ? 100.0 * huge_pages / occupied_count_ : 0.0)
+              << "% de lo residente)" << std::endl;
+    std::cout << "  ├─ Promociones:       " << promotions_ << std::endl;
+    std::cout << "  ├─ Fallidas (frag.):  " << promotion_failures_ << std::endl;
+    std::cout << "  ├─ Páginas migradas:  " << migrated_pages_ << std::endl;
+    std::cout << "  └─ Demociones:        " << demotions_ << std::endl;
+    
+    // Alcance: memoria que cubren las traducciones cacheadas
+    long long reach = 0;
+    for (long long key : tlb_lru_) {
+        reach += key & (1LL << 62) ? huge_factor_ : 1;
+    }
+    int translations = occupied_count_ - huge_pages + active;
+    std::cout << "\n TLB:                   " << tlb_entries_ << " entradas" << std::endl;
+    std::cout << "  ├─ Hits:              " << tlb_hits_ << " (" << get_tlb_hit_rate() * 100
+              << "%)" << std::endl;
+    std::cout << "  ├─ Misses:            " << tlb_misses_ << std::endl;
+    std::cout << "  ├─ Alcance actual:    " << reach * PAGE_SIZE / 1024 << " KB" << std::endl;
+    std::cout << "  ├─ Alcance máximo:    "
+              << static_cast<long long>(tlb_entries_) * huge_factor_ * PAGE_SIZE / 1024 << " KB" << std::endl;
+    std::cout << "  └─ Traducciones para lo residente: " << translations << std::endl;
+    
+    // Fragmentación externa: frames libres que no forman un bloque alineado
+    int free_frames = buddy_.get_free_frames();
+    int free_blocks = 0;
+    for (int block = 0; block < static_cast<int>(huge_blocks_.size()); block++) {
+        bool all_free = true;
+        for (int k = 0; k < huge_factor_ && all_free; k++) {
+            all_free = buddy_.is_free(block * huge_factor_ + k);
+        }
+        free_blocks += all_free ? 1 : 0;
+    }
+    std::cout << "\n Frames libres:         " << free_frames << std::endl;
+    std::cout << "  ├─ En bloques libres: " << free_blocks * huge_factor_ << " (" << free_blocks
+              << " huge pages posibles)" << std::endl;
+    std::cout << "  └─ Fragmentación:     "
+              << (free_frames > 0 ? 100.0 * (free_frames - free_blocks * huge_factor_) / free_frames : 0.0)
+              << "%" << std::endl;
+    std::cout << std::endl;
+}
+
+int MemoryManager::compressed_size(int process_id, int page_number) {
+    // Contenido simulado, reproducible por página: ~15% páginas de ceros,
+    // datos de heap (ratio 2-4.5), código (1.6-2.5) y ~10% incompresibles
+    Xoshiro256 rng(static_cast<uint64_t>(page_key(process_id, page_number)));
+    uint64_t kind = rng.below(100);
+    if (kind < 15) return 64;
+    if (kind < 70) return 900 + static_cast<int>(rng.below(1000));
+    if (kind < 90) return 1600 + static_cast<int>(rng.below(1000));
+    return 3600 + static_cast<int>(rng.below(PAGE_SIZE - 3600 + 1));
+}
+
+void MemoryManager::zswap_store(int process_id, int page_number) {
+    // Como zswap, no vale la pena guardar lo que comprime a más de 3/4 de página
+    int bytes = compressed_size(process_id, page_number);
+    if (bytes > PAGE_SIZE * 3 / 4 || bytes > zswap_budget_) {
+        zswap_rejects_++;
+        return;
+    }
+    
+    // Hacer lugar escribiendo a disco las más antiguas
+    while (zswap_bytes_ + bytes > zswap_budget_) {
+        const ZswapEntry& oldest = zswap_pool_.front();
+        zswap_bytes_ -= oldest.bytes;
+        zswap_index_.erase(page_key(oldest.process_id, oldest.page_number));
+        zswap_pool_.pop_front();
+        zswap_writebacks_++;
+    }
+    
+    zswap_stores_++;
+    zswap_stored_bytes_ += bytes;
+    zswap_bytes_ += bytes;
+    zswap_index_[page_key(process_id, page_number)] =
+        zswap_pool_.insert(zswap_pool_.end(), {process_id, page_number, bytes});
+    
+    if (verbose_) {
+        std::cout << Color::CYAN << "  └─ P" << process_id << " página " << page_number
+                  << " comprimida en zswap (" << bytes << " B)" << Color::RESET << std::endl;
+    }
+}
+
+bool MemoryManager::zswap_load(int process_id, int page_number) {
+    if (zswap_index_.empty()) {
+        return false;
+    }
+    auto it = zswap_index_.find(page_key(process_id, page_number));
+    if (it == zswap_index_.end()) {
+        return false;
+    }
+    
+    zswap_hits_++;
+    zswap_bytes_ -= it->second->bytes;
+    if (verbose_) {
+        std::cout << Color::CYAN << "  └─ Descomprimida desde zswap (" << it->second->bytes
+                  << " B, " << decompress_time_ << " ticks)" << Color::RESET << std::endl;
+    }
+    zswap_pool_.erase(it->second);
+    zswap_index_.erase(it);
+    return true;
+}
+
+double MemoryManager::get_pool_hit_rate() const {
+    if (page_faults_ == 0) return 0.0;
+    return (double)zswap_hits_ / page_faults_;
+}
+
+void MemoryManager::display_zswap_stats() const {
+    print_header("ZSWAP - TIER COMPRIMIDO");
+    
+    if (zswap_budget_ == 0) {
+        std::cout << Color::YELLOW << " zswap desactivado (mem-zswap <frames_pool>)"
+                  << Color::RESET << std::endl << std::endl;
+        return;
+    }
+    
+    int pool_frames = static_cast<int>(zswap_budget_ / PAGE_SIZE);
+    int pooled = static_cast<int>(zswap_pool_.size());
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << " Pool:                  " << zswap_bytes_ / 1024.0 << " / " << zswap_budget_ / 1024.0
+              << " KB (" << 100.0 * zswap_bytes_ / zswap_budget_ << "%)" << std::endl;
+    std::cout << std::setprecision(2);
+    std::cout << "  ├─ Páginas:           " << pooled << std::endl;
+    std::cout << "  └─ Ratio actual:      "
+              << (zswap_bytes_ > 0 ? static_cast<double>(pooled) * PAGE_SIZE / zswap_bytes_ : 0.0)
+              << ":1" << std::endl;
+    
+    std::cout << "\n Páginas evictadas:     " << zswap_stores_ + zswap_rejects_ << std::endl;
+    std::cout << "  ├─ Comprimidas:       " << zswap_stores_ << " (ratio "
+              << (zswap_stored_bytes_ > 0
+                      ? static_cast<double>(zswap_stores_) * PAGE_SIZE / zswap_stored_bytes_ : 0.0)
+              << ":1)" << std::endl;
+    std::cout << "  ├─ Incompresibles:    " << zswap_rejects_ << std::endl;
+    std::cout << "  └─ Writeback a disco: " << zswap_writebacks_ << std::endl;
+    
+    std::cout << "\n Page faults:           " << page_faults_ << std::endl;
+    std::cout << "  ├─ Desde el pool:     " << zswap_hits_ << " (" << get_pool_hit_rate() * 100
+              << "%, " << decompress_time_ << " ticks)" << std::endl;
+    std::cout << "  └─ Desde disco:       " << page_faults_ - zswap_hits_ << std::endl;
+    
+    // Capacidad efectiva: páginas retenidas en RAM por frame de RAM usado
+    int ram_frames = num_frames_ + pool_frames;
+    int held = occupied_count_ + pooled;
+    std::cout << "\n RAM:                   " << ram_frames << " frames (" << num_frames_
+              << " + " << pool_frames << " de pool)" << std::endl;
+    std::cout << "  └─ Capacidad efectiva: " << held << " páginas ("
+              << static_cast<double>(held) / ram_frames << " por frame)" << std::endl;
+    std::cout << std::endl;
+}
+
 void MemoryManager::display_frames() const {
     print_header("ESTADO DE FRAMES");
     
@@ -128,21 +1097,26 @@ void MemoryManager::display_frames() const {
               << std::setw(12) << "Proceso"
               << std::setw(12) << "Página"
               << std::setw(15) << "Load Time"
+              << std::setw(6) << "Refs"
               << std::endl;
-    print_separator(60);
+    print_separator(66);
     
     for (const auto& frame : frames_) {
         std::string status_color = frame.occupied ? Color::GREEN : Color::WHITE;
-        std::string status = frame.occupied ? "OCUPADO" : "LIBRE";
+        bool huge = frame.frame_id / huge_factor_ < static_cast<int>(huge_blocks_.size()) &&
+                    huge_blocks_[frame.frame_id / huge_factor_];
+        std::string status = huge ? "HUGE" : frame.occupied ? "OCUPADO"
+                           : buddy_.is_free(frame.frame_id) ? "LIBRE" : "KERNEL";
         
         std::cout << status_color
                   << std::setw(10) << frame.frame_id
                   << std::setw(12) << status;
         
         if (frame.occupied) {
-            std::cout << std::setw(12) << ("P" + std::to_string(frame.process_id))
+            std::cout << std::setw(12) << std::string("P").append(std::to_string(frame.process_id))
                       << std::setw(12) << frame.page_number
-                      << std::setw(15) << frame.load_time;
+                      << std::setw(15) << frame.load_time
+                      << std::setw(6) << reverse_map_[frame.frame_id].size();
         } else {
             std::cout << std::setw(12) << "-"
                       << std::setw(12) << "-"
@@ -158,12 +1132,28 @@ void MemoryManager::display_stats() const {
     
     int occupied_frames = std::count_if(frames_.begin(), frames_.end(),
                                        [](const Frame& f) { return f.occupied; });
-    int free_frames = num_frames_ - occupied_frames;
+    int free_frames = buddy_.get_free_frames();
+    int kernel_frames = num_frames_ - occupied_frames - free_frames;
     
     std::cout << "  Frames totales:       " << num_frames_ << std::endl;
     std::cout << "   ├─ Ocupados:           " << occupied_frames << std::endl;
+    if (kernel_frames > 0) {
+        std::cout << "   ├─ Kernel (slab):      " << kernel_frames << std::endl;
+    }
     std::cout << "   └─ Libres:             " << free_frames << std::endl;
     
+    // Compartición por fork: mapeos que apuntan a frames ajenos
+    size_t mappings = 0;
+    int shared_frames = 0;
+    for (const auto& frame_maps : reverse_map_) {
+        mappings += frame_maps.size();
+        shared_frames += frame_maps.size() > 1 ? 1 : 0;
+    }
+    std::cout << "\n Páginas mapeadas:      " << mappings << std::endl;
+    std::cout << "    ├─ Frames compartidos: " << shared_frames << std::endl;
+    std::cout << "    ├─ Frames ahorrados:   " << mappings - occupied_frames << std::endl;
+    std::cout << "    └─ Fallos COW:         " << cow_faults_ << std::endl;
+    
     std::cout << "\n Accesos a memoria:     " << total_accesses_ << std::endl;
     std::cout << "    ├─ Page Hits:          " << page_hits_ 
               << " (" << std::fixed << std::setprecision(1) 
@@ -171,28 +1161,45 @@ void MemoryManager::display_stats() const {
     std::cout << "    └─ Page Faults:        " << page_faults_ 
               << " (" << std::fixed << std::setprecision(1) 
               << get_fault_rate() * 100 << "%)" << std::endl;
+    if (zswap_budget_ > 0) {
+        std::cout << "        └─ Desde zswap:    " << zswap_hits_
+                  << " (" << get_pool_hit_rate() * 100 << "%)" << std::endl;
+    }
     
-    std::cout << "\nAlgoritmo:             FIFO (First-In-First-Out)" << std::endl;
+    std::cout << "\nAlgoritmo:             " << policy_to_string(policy_) << std::endl;
+    std::cout << "Page table:            " << (inverted_ ? "invertida" : "directa")
+              << " (" << get_mapped_pages() << " entradas, "
+              << std::setprecision(1) << translation_bytes() / 1024.0 << " KB)" << std::endl;
+    if (inverted_) {
+        std::cout << " ├─ Slots:              " << inverted_->capacity()
+                  << " (lápidas " << inverted_->tombstones() << ", rehashes "
+                  << inverted_->get_rehashes() << ")" << std::endl;
+        std::cout << " └─ Grupos por búsqueda: " << std::setprecision(3)
+                  << inverted_->probes_per_lookup() << std::endl;
+    }
     std::cout << std::endl;
 }
 
 void MemoryManager::display_page_table(int process_id) const {
-    if (page_tables_.count(process_id) == 0 || page_tables_.at(process_id).empty()) {
+    auto entries = process_entries(process_id);
+    if (entries.empty()) {
         std::cout << Color::YELLOW << "Proceso P" << process_id 
                   << " no tiene páginas cargadas" << Color::RESET << std::endl;
         return;
     }
     
-    print_header("PAGE TABLE - P" + std::to_string(process_id));
+    print_header(std::string("PAGE TABLE - P").append(std::to_string(process_id)));
     
     std::cout << std::left
               << std::setw(15) << "Página Virtual"
               << std::setw(15) << "Frame Físico"
               << std::setw(10) << "Válido"
+              << std::setw(6) << "COW"
+              << std::setw(6) << "Huge"
               << std::endl;
-    print_separator(40);
+    print_separator(52);
     
-    for (const auto& entry : page_tables_.at(process_id)) {
+    for (const auto& entry : entries) {
         int page_num = entry.first;
         const PageTableEntry& pte = entry.second;
         
@@ -203,6 +1210,8 @@ void MemoryManager::display_page_table(int process_id) const {
                   << std::setw(15) << page_num
                   << std::setw(15) << (pte.valid ? std::to_string(pte.frame_id) : "-")
                   << std::setw(10) << valid_str
+                  << std::setw(6) << (pte.cow ? "SÍ" : "-")
+                  << std::setw(6) << (pte.huge ? "SÍ" : "-")
                   << Color::RESET << std::endl;
     }
     std::cout << std::endl;
@@ -218,11 +1227,237 @@ double MemoryManager::get_fault_rate() const {
     return (double)page_faults_ / total_accesses_;
 }
 
+std::string MemoryManager::policy_to_string(ReplacementPolicy policy) {
+    switch (policy) {
+        case ReplacementPolicy::FIFO: return "FIFO";
+        case ReplacementPolicy::LRU: return "LRU";
+        case ReplacementPolicy::CLOCK: return "CLOCK";
+        default: return "UNKNOWN";
+    }
+}
+
+bool MemoryManager::parse_policy(const std::string& name, ReplacementPolicy& policy) {
+    if (name == "fifo") policy = ReplacementPolicy::FIFO;
+    else if (name == "lru") policy = ReplacementPolicy::LRU;
+    else if (name == "clock") policy = ReplacementPolicy::CLOCK;
+    else return false;
+    return true;
+}
+
 void MemoryManager::reset_stats() {
     total_accesses_ = 0;
     page_faults_ = 0;
     page_hits_ = 0;
+    cow_faults_ = 0;
+    zswap_stores_ = 0;
+    zswap_rejects_ = 0;
+    zswap_hits_ = 0;
+    zswap_writebacks_ = 0;
+    zswap_stored_bytes_ = 0;
+    promotions_ = 0;
+    promotion_failures_ = 0;
+    demotions_ = 0;
+    migrated_pages_ = 0;
+    tlb_hits_ = 0;
+    tlb_misses_ = 0;
     current_time_ = 0;
     std::cout << Color::CYAN << "[MEMORY] Estadísticas reiniciadas" 
               << Color::RESET << std::endl;
 }
+
+namespace {
+    struct MemoryImage {
+        int num_frames;
+        int policy;
+        int clock_hand;
+        int total_accesses;
+        int page_faults;
+        int page_hits;
+        int cow_faults;
+        int current_time;
+        int occupied_count;
+        int decompress_time;
+        int zswap_stores;
+        int zswap_rejects;
+        int zswap_hits;
+        int zswap_writebacks;
+        long long zswap_budget;
+        long long zswap_stored_bytes;
+        int huge_factor;
+        int tlb_entries;
+        int promotions;
+        int promotion_failures;
+        int demotions;
+        int migrated_pages;
+        long long tlb_hits;
+        long long tlb_misses;
+        int inverted;
+    };
+
+    struct PageImage {
+        int process_id;
+        int page_number;
+        int frame_id;
+        int valid;
+        int cow;
+        int huge;
+    };
+
+    struct MappingImage {
+        int frame_id;
+        int process_id;
+        int page_number;
+    };
+}
+
+void MemoryManager::save_state(CheckpointWriter& writer) const {
+    MemoryImage image{num_frames_, static_cast<int>(policy_), clock_hand_, total_accesses_,
+                      page_faults_, page_hits_, cow_faults_, current_time_, occupied_count_,
+                      decompress_time_, zswap_stores_, zswap_rejects_, zswap_hits_,
+                      zswap_writebacks_, zswap_budget_, zswap_stored_bytes_,
+                      huge_factor_, tlb_entries_, promotions_, promotion_failures_, demotions_,
+                      migrated_pages_, tlb_hits_, tlb_misses_, inverted_ ? 1 : 0};
+    writer.add_one(CheckpointSection::MEMORY, image);
+    writer.add_vector(CheckpointSection::FRAMES, frames_);
+
+    std::vector<PageImage> pages;
+    auto save_entry = [&pages](int process_id, int page_number, const PageTableEntry& entry) {
+        pages.push_back({process_id, page_number, entry.frame_id, entry.valid ? 1 : 0,
+                         entry.cow ? 1 : 0, entry.huge ? 1 : 0});
+    };
+    if (inverted_) {
+        inverted_->for_each(save_entry);
+    } else {
+        for (const auto& table : page_tables_) {
+            for (const auto& entry : table.second) {
+                save_entry(table.first, entry.first, entry.second);
+            }
+        }
+    }
+    writer.add_vector(CheckpointSection::PAGE_TABLE, pages);
+
+    // El orden de los mapeos decide a nombre de quién queda un frame compartido
+    std::vector<MappingImage> mappings;
+    for (int f = 0; f < num_frames_; f++) {
+        for (const PageMapping& mapping : reverse_map_[f]) {
+            mappings.push_back({f, mapping.process_id, mapping.page_number});
+        }
+    }
+    writer.add_vector(CheckpointSection::REVERSE_MAP, mappings);
+
+    std::vector<int> fifo;
+    std::queue<int> copy = fifo_queue_;
+    while (!copy.empty()) {
+        fifo.push_back(copy.front());
+        copy.pop();
+    }
+    writer.add_vector(CheckpointSection::FIFO_ORDER, fifo);
+    writer.add_vector(CheckpointSection::LRU_ORDER, std::vector<int>(lru_list_.begin(), lru_list_.end()));
+    writer.add_vector(CheckpointSection::ZSWAP_POOL,
+                      std::vector<ZswapEntry>(zswap_pool_.begin(), zswap_pool_.end()));
+    writer.add_vector(CheckpointSection::TLB, std::vector<long long>(tlb_lru_.begin(), tlb_lru_.end()));
+}
+
+std::unique_ptr<MemoryManager> MemoryManager::from_checkpoint(const CheckpointReader& reader) {
+    MemoryImage image;
+    size_t frame_count, page_count, fifo_count, lru_count, mapping_count, pool_count, tlb_count;
+    const Frame* frames = reader.records<Frame>(CheckpointSection::FRAMES, frame_count);
+    const PageImage* pages = reader.records<PageImage>(CheckpointSection::PAGE_TABLE, page_count);
+    const int* fifo = reader.records<int>(CheckpointSection::FIFO_ORDER, fifo_count);
+    const int* lru = reader.records<int>(CheckpointSection::LRU_ORDER, lru_count);
+    const MappingImage* mappings = reader.records<MappingImage>(CheckpointSection::REVERSE_MAP, mapping_count);
+    const ZswapEntry* pool = reader.records<ZswapEntry>(CheckpointSection::ZSWAP_POOL, pool_count);
+    const long long* tlb = reader.records<long long>(CheckpointSection::TLB, tlb_count);
+    if (!reader.read_one(CheckpointSection::MEMORY, image) || frames == nullptr ||
+        pages == nullptr || fifo == nullptr || lru == nullptr || mappings == nullptr || pool == nullptr ||
+        tlb == nullptr || image.huge_factor <= 0 || image.tlb_entries < 0 ||
+        image.num_frames <= 0 || frame_count != static_cast<size_t>(image.num_frames) ||
+        image.policy < static_cast<int>(ReplacementPolicy::FIFO) ||
+        image.policy > static_cast<int>(ReplacementPolicy::CLOCK) ||
+        image.clock_hand < 0 || image.clock_hand >= image.num_frames) {
+        return nullptr;
+    }
+    // Todo índice de frame que se usa sin revisar después debe estar en rango
+    for (size_t f = 0; f < frame_count; f++) {
+        if (frames[f].frame_id != static_cast<int>(f)) return nullptr;
+    }
+    for (size_t i = 0; i < page_count; i++) {
+        int low = pages[i].valid != 0 ? 0 : -1;
+        if (pages[i].frame_id < low || pages[i].frame_id >= image.num_frames) return nullptr;
+    }
+
+    auto memory = std::make_unique<MemoryManager>(image.num_frames,
+                                                  static_cast<ReplacementPolicy>(image.policy), false);
+    memory->frames_.assign(frames, frames + frame_count);
+    if (image.inverted != 0) {
+        memory->inverted_ = std::make_unique<InvertedPageTable>(image.num_frames);
+    }
+    for (size_t i = 0; i < page_count; i++) {
+        memory->map_entry(pages[i].process_id, pages[i].page_number) =
+            {pages[i].frame_id, pages[i].valid != 0, pages[i].cow != 0, pages[i].huge != 0};
+    }
+    for (size_t i = 0; i < mapping_count; i++) {
+        if (mappings[i].frame_id < 0 || mappings[i].frame_id >= image.num_frames) return nullptr;
+        memory->reverse_map_[mappings[i].frame_id].push_back({mappings[i].process_id,
+                                                              mappings[i].page_number});
+    }
+    for (size_t i = 0; i < fifo_count; i++) {
+        if (fifo[i] < 0 || fifo[i] >= image.num_frames) return nullptr;
+        memory->fifo_queue_.push(fifo[i]);
+    }
+    for (size_t i = 0; i < lru_count; i++) {
+        if (lru[i] < 0 || lru[i] >= image.num_frames ||
+            memory->lru_pos_[lru[i]] != memory->lru_list_.end()) return nullptr;
+        memory->lru_pos_[lru[i]] = memory->lru_list_.insert(memory->lru_list_.end(), lru[i]);
+    }
+    for (size_t i = 0; i < pool_count; i++) {
+        memory->zswap_bytes_ += pool[i].bytes;
+        memory->zswap_index_[page_key(pool[i].process_id, pool[i].page_number)] =
+            memory->zswap_pool_.insert(memory->zswap_pool_.end(), pool[i]);
+    }
+    // Los bloques huge se reconstruyen desde las entradas marcadas
+    memory->huge_factor_ = image.huge_factor;
+    memory->tlb_entries_ = image.tlb_entries;
+    memory->huge_blocks_.assign(image.huge_factor > 1 ? image.num_frames / image.huge_factor : 0, 0);
+    for (size_t i = 0; i < page_count; i++) {
+        if (pages[i].huge != 0 && pages[i].valid != 0) {
+            size_t block = static_cast<size_t>(pages[i].frame_id / image.huge_factor);
+            if (block >= memory->huge_blocks_.size()) return nullptr;
+            memory->huge_blocks_[block] = 1;
+        }
+    }
+    for (size_t i = 0; i < tlb_count; i++) {
+        memory->tlb_index_[tlb[i]] = memory->tlb_lru_.insert(memory->tlb_lru_.end(), tlb[i]);
+    }
+    memory->promotions_ = image.promotions;
+    memory->promotion_failures_ = image.promotion_failures;
+    memory->demotions_ = image.demotions;
+    memory->migrated_pages_ = image.migrated_pages;
+    memory->tlb_hits_ = image.tlb_hits;
+    memory->tlb_misses_ = image.tlb_misses;
+    memory->zswap_budget_ = image.zswap_budget;
+    memory->decompress_time_ = image.decompress_time;
+    memory->zswap_stores_ = image.zswap_stores;
+    memory->zswap_rejects_ = image.zswap_rejects;
+    memory->zswap_hits_ = image.zswap_hits;
+    memory->zswap_writebacks_ = image.zswap_writebacks;
+    memory->zswap_stored_bytes_ = image.zswap_stored_bytes;
+    memory->clock_hand_ = image.clock_hand;
+    memory->total_accesses_ = image.total_accesses;
+    memory->page_faults_ = image.page_faults;
+    memory->page_hits_ = image.page_hits;
+    memory->cow_faults_ = image.cow_faults;
+    memory->current_time_ = image.current_time;
+    memory->occupied_count_ = image.occupied_count;
+    
+    // El buddy se reconstruye liberando los frames sin página: con fusión
+    // inmediata el estado solo depende del conjunto libre
+    memory->buddy_.reserve_all();
+    for (int f = 0; f < image.num_frames; f++) {
+        if (!memory->frames_[f].occupied) {
+            memory->buddy_.free(f, 0);
+        }
+    }
+    memory->verbose_ = true;
+    return memory;
+}
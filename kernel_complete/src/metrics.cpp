@@ -0,0 +1,128 @@
+#include "../include/metrics.hpp"
+#include "../include/utils.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <limits>
+
+void LogHistogram::reset() {
+    counts_.fill(0);
+    count_ = 0;
+    sum_ = 0;
+    min_ = std::numeric_limits<uint64_t>::max();
+    max_ = 0;
+}
+
+uint64_t LogHistogram::bucket_upper(int bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return static_cast<uint64_t>(bucket);
+    }
+    int shift = bucket / SUB_BUCKETS - 1;
+    uint64_t sub = static_cast<uint64_t>(bucket % SUB_BUCKETS);
+    uint64_t lower = (static_cast<uint64_t>(SUB_BUCKETS) | sub) << shift;
+    return lower + ((uint64_t(1) << shift) - 1);
+}
+
+uint64_t LogHistogram::percentile(double q) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    // Rango del cuantil (1-indexado) y recorrido acumulado
+    uint64_t rank = static_cast<uint64_t>(q * count_ + 0.999999);
+    rank = std::max<uint64_t>(1, std::min(rank, count_));
+
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKETS; b++) {
+        seen += counts_[b];
+        if (seen >= rank) {
+            return std::min(bucket_upper(b), max_);
+        }
+    }
+    return max_;
+}
+
+void SchedulerMetrics::reset() {
+    response_.reset();
+    wait_.reset();
+    turnaround_.reset();
+    for (auto& cls : by_burst_) {
+        cls.slowdown.reset();
+    }
+    rate_sum_ = 0.0;
+    rate_sq_sum_ = 0.0;
+    completed_ = 0;
+}
+
+int SchedulerMetrics::burst_class(int burst) {
+    int cls = burst <= 1 ? 0 : 31 - __builtin_clz(static_cast<unsigned>(burst));
+    return std::min(cls, BURST_CLASSES - 1);
+}
+
+void SchedulerMetrics::record_completion(int burst, SimTime wait, SimTime turnaround) {
+    wait_.record(static_cast<uint64_t>(wait));
+    turnaround_.record(static_cast<uint64_t>(turnaround));
+    completed_++;
+
+    if (burst > 0 && turnaround > 0) {
+        double slowdown = static_cast<double>(turnaround) / burst;
+        by_burst_[burst_class(burst)].slowdown.record(static_cast<uint64_t>(slowdown * 100.0 + 0.5));
+
+        double rate = 1.0 / slowdown;
+        rate_sum_ += rate;
+        rate_sq_sum_ += rate * rate;
+    }
+}
+
+double SchedulerMetrics::jain_index() const {
+    if (rate_sq_sum_ <= 0.0) {
+        return 1.0;
+    }
+    uint64_t n = 0;
+    for (const auto& cls : by_burst_) {
+        n += cls.slowdown.count();
+    }
+    return (rate_sum_ * rate_sum_) / (n * rate_sq_sum_);
+}
+
+void SchedulerMetrics::print_row(const std::string& label, const LogHistogram& h, double scale) {
+    std::cout << "   " << std::left << std::setw(14) << label << std::right
+              << std::setw(9) << h.mean() / scale
+              << std::setw(9) << h.percentile(0.50) / scale
+              << std::setw(9) << h.percentile(0.90) / scale
+              << std::setw(9) << h.percentile(0.99) / scale
+              << std::setw(9) << h.percentile(0.999) / scale
+              << std::setw(9) << h.max() / scale << std::endl;
+}
+
+void SchedulerMetrics::display() const {
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\nPercentiles (" << completed_ << " terminados, "
+              << response_.count() << " despachados):" << std::endl;
+    std::cout << "   " << std::left << std::setw(15) << "Métrica" << std::right
+              << std::setw(9) << "media" << std::setw(9) << "p50" << std::setw(9) << "p90"
+              << std::setw(9) << "p99" << std::setw(9) << "p99.9" << std::setw(10) << "máx"
+              << std::endl;
+    print_row("Respuesta", response_, 1.0);
+    print_row("Espera", wait_, 1.0);
+    print_row("Turnaround", turnaround_, 1.0);
+
+    std::cout << "\n Índice de Jain:        " << std::setprecision(4) << jain_index()
+              << std::setprecision(2) << " (burst/turnaround)" << std::endl;
+
+    std::cout << "\nSlowdown por ráfaga (turnaround / burst):" << std::endl;
+    for (int cls = 0; cls < BURST_CLASSES; cls++) {
+        const LogHistogram& h = by_burst_[cls].slowdown;
+        if (h.count() == 0) {
+            continue;
+        }
+        long long low = 1LL << cls;
+        long long high = cls == BURST_CLASSES - 1 ? -1 : (2LL << cls) - 1;
+        std::string label = "[";
+        label.append(std::to_string(low)).append(",")
+             .append(high < 0 ? std::string("∞") : std::to_string(high)).append("]");
+        std::cout << "   " << std::left << std::setw(14) << label << std::right
+                  << " n=" << std::setw(7) << h.count()
+                  << "  media=" << std::setw(8) << h.mean() / 100.0
+                  << "  p99=" << std::setw(8) << h.percentile(0.99) / 100.0 << std::endl;
+    }
+}
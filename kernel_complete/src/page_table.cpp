@@ -0,0 +1,169 @@
+#include "../include/page_table.hpp"
+#include "../include/memory.hpp"
+#include "../include/workload.hpp"
+#include "../include/utils.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+
+InvertedPageTable::InvertedPageTable(int frames)
+    : group_mask_(0),
+      size_(0),
+      tombstones_(0),
+      lookups_(0),
+      probes_(0),
+      rehashes_(0) {
+    // Al menos el doble de slots que frames: carga ≤ 1/2 sin COW
+    size_t groups = 1;
+    while (groups * GROUP < static_cast<size_t>(std::max(frames, 1)) * 2) {
+        groups <<= 1;
+    }
+    keys_.assign(groups * GROUP, EMPTY);
+    values_.resize(groups * GROUP);
+    group_mask_ = groups - 1;
+}
+
+long long InvertedPageTable::locate(uint64_t key) const {
+    lookups_++;
+    size_t group = home_group(key);
+    for (size_t step = 0; step <= group_mask_; step++) {
+        probes_++;
+        const uint64_t* slots = &keys_[group * GROUP];
+        unsigned hit = match(slots, key);
+        if (hit != 0) {
+            return static_cast<long long>(group * GROUP) + __builtin_ctz(hit);
+        }
+        // Un grupo con huecos nunca fue saltado por una inserción
+        if (match(slots, EMPTY) != 0) {
+            return -1;
+        }
+        group = (group + 1) & group_mask_;
+    }
+    return -1;
+}
+
+PageTableEntry* InvertedPageTable::find(int process_id, int page_number) {
+    long long slot = locate(make_key(process_id, page_number));
+    return slot < 0 ? nullptr : &values_[slot];
+}
+
+const PageTableEntry* InvertedPageTable::find(int process_id, int page_number) const {
+    long long slot = locate(make_key(process_id, page_number));
+    return slot < 0 ? nullptr : &values_[slot];
+}
+
+PageTableEntry& InvertedPageTable::insert(int process_id, int page_number) {
+    uint64_t key = make_key(process_id, page_number);
+    long long slot = locate(key);
+    if (slot >= 0) {
+        return values_[slot];
+    }
+
+    // Carga máxima 7/8 contando lápidas: crecer si hay muchas vivas, si no purgar
+    if ((size_ + tombstones_ + 1) * 8 > keys_.size() * 7) {
+        size_t groups = group_mask_ + 1;
+        rehash(size_ * 2 >= keys_.size() ? groups * 2 : groups);
+    }
+
+    // Primer slot libre o lápida en la secuencia de sondeo
+    size_t group = home_group(key);
+    while (true) {
+        uint64_t* slots = &keys_[group * GROUP];
+        unsigned open = match(slots, EMPTY) | match(slots, TOMBSTONE);
+        if (open != 0) {
+            size_t index = group * GROUP + __builtin_ctz(open);
+            if (keys_[index] == TOMBSTONE) {
+                tombstones_--;
+            }
+            keys_[index] = key;
+            size_++;
+            return values_[index];
+        }
+        group = (group + 1) & group_mask_;
+    }
+}
+
+bool InvertedPageTable::erase(int process_id, int page_number) {
+    long long slot = locate(make_key(process_id, page_number));
+    if (slot < 0) {
+        return false;
+    }
+    // Si el grupo ya tenía huecos ninguna búsqueda pasa de él: el slot queda vacío
+    const uint64_t* slots = &keys_[(slot / GROUP) * GROUP];
+    if (match(slots, EMPTY) != 0) {
+        keys_[slot] = EMPTY;
+    } else {
+        keys_[slot] = TOMBSTONE;
+        tombstones_++;
+    }
+    size_--;
+    return true;
+}
+
+void InvertedPageTable::rehash(size_t groups) {
+    std::vector<uint64_t> old_keys(groups * GROUP, EMPTY);
+    std::vector<PageTableEntry> old_values(groups * GROUP);
+    old_keys.swap(keys_);
+    old_values.swap(values_);
+    group_mask_ = groups - 1;
+    size_ = 0;
+    tombstones_ = 0;
+    rehashes_++;
+
+    for (size_t i = 0; i < old_keys.size(); i++) {
+        if (old_keys[i] < TOMBSTONE) {
+            size_t group = home_group(old_keys[i]);
+            while (match(&keys_[group * GROUP], EMPTY) == 0) {
+                group = (group + 1) & group_mask_;
+            }
+            size_t index = group * GROUP + __builtin_ctz(match(&keys_[group * GROUP], EMPTY));
+            keys_[index] = old_keys[i];
+            values_[index] = old_values[i];
+            size_++;
+        }
+    }
+}
+
+void run_page_table_bench(int processes, int pages_per_process, int frames, uint64_t seed) {
+    std::cout << Color::BOLD << Color::BLUE << "\n▶ Page tables: " << processes << " procesos × "
+              << pages_per_process << " páginas dispersas sobre " << frames << " frames"
+              << Color::RESET << std::endl;
+
+    // Espacio de direcciones disperso: vpn al azar en 31 bits por proceso
+    Xoshiro256 rng(seed);
+    std::vector<int> pages(static_cast<size_t>(processes) * pages_per_process);
+    for (auto& page : pages) {
+        page = static_cast<int>(rng.below(1ULL << 31));
+    }
+    long long accesses = static_cast<long long>(pages.size()) * 4;
+    std::vector<uint32_t> trace(static_cast<size_t>(accesses));
+    for (auto& index : trace) {
+        index = static_cast<uint32_t>(rng.below(pages.size()));
+    }
+
+    std::cout << std::left << "   " << std::setw(11) << "Tabla" << std::right
+              << std::setw(12) << "ns/acceso" << std::setw(10) << "Faults"
+              << std::setw(10) << "Entradas" << std::setw(14) << "Memoria (KB)"
+              << std::setw(12) << "B/frame" << std::endl;
+    for (bool inverted : {false, true}) {
+        MemoryManager memory(frames, ReplacementPolicy::LRU, false);
+        memory.set_inverted(inverted);
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t index : trace) {
+            memory.access_page(static_cast<int>(index) / pages_per_process + 1, pages[index]);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        size_t bytes = memory.translation_bytes();
+        std::cout << std::fixed << std::setprecision(2) << std::left << "   "
+                  << std::setw(11) << (inverted ? "invertida" : "directa") << std::right
+                  << std::setw(12) << seconds * 1e9 / accesses
+                  << std::setw(10) << memory.get_page_faults()
+                  << std::setw(10) << memory.get_mapped_pages()
+                  << std::setw(14) << bytes / 1024.0
+                  << std::setw(12) << static_cast<double>(bytes) / frames << std::endl;
+    }
+    std::cout << std::endl;
+}
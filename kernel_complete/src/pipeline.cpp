@@ -0,0 +1,299 @@
+#include "../include/pipeline.hpp"
+#include "../include/utils.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    long long elapsed_ns(Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(b - a).count();
+    }
+
+    void pin_current_thread(int core) {
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+        (void)core;
+#endif
+    }
+
+    // Trabajo simulado: espera activa para que la etapa ocupe su núcleo
+    void spin_for(int ns) {
+        auto end = Clock::now() + std::chrono::nanoseconds(ns);
+        while (Clock::now() < end) {
+        }
+    }
+}
+
+Pipeline::Pipeline(const PipelineConfig& config)
+    : config_(config),
+      next_item_(0) {
+    config_.capacity = std::max(1, config_.capacity);
+    config_.batch = std::max(1, config_.batch);
+    for (size_t i = 0; i + 1 < config_.stages.size(); i++) {
+        queues_.push_back(std::make_unique<ProducerConsumer>(config_.capacity, false));
+    }
+    for (const auto& stage : config_.stages) {
+        stats_.emplace_back(stage.workers, WorkerStats{0, 0, 0, 0});
+        live_workers_.push_back(std::make_unique<std::atomic<int>>(stage.workers));
+    }
+}
+
+void Pipeline::worker(int stage, int index, int core) {
+    if (core >= 0) {
+        pin_current_thread(core);
+    }
+    WorkerStats& stats = stats_[stage][index];
+    ProducerConsumer* input = stage > 0 ? queues_[stage - 1].get() : nullptr;
+    ProducerConsumer* output = stage + 1 < static_cast<int>(config_.stages.size()) ? queues_[stage].get() : nullptr;
+    int work_ns = config_.stages[stage].work_ns;
+    std::vector<int> batch(config_.batch);
+
+    while (true) {
+        auto t0 = Clock::now();
+        int n;
+        if (input) {
+            n = input->take_batch(batch.data(), config_.batch);
+        } else {
+            // La fuente reparte los ids en lotes entre sus workers
+            long long first = next_item_.fetch_add(config_.batch);
+            n = static_cast<int>(std::clamp<long long>(config_.items - first, 0, config_.batch));
+            for (int i = 0; i < n; i++) {
+                batch[i] = static_cast<int>(first + i);
+            }
+        }
+        auto t1 = Clock::now();
+        stats.input_wait_ns += elapsed_ns(t0, t1);
+        if (n == 0) {
+            break;
+        }
+
+        for (int i = 0; i < n; i++) {
+            spin_for(work_ns);
+        }
+        auto t2 = Clock::now();
+        stats.busy_ns += elapsed_ns(t1, t2);
+
+        if (output) {
+            output->put_batch(batch.data(), n);
+        }
+        stats.output_wait_ns += elapsed_ns(t2, Clock::now());
+        stats.items += n;
+    }
+
+    // El último worker de la etapa cierra su salida: fin de flujo hacia adelante
+    if (live_workers_[stage]->fetch_sub(1) == 1 && output) {
+        output->close();
+    }
+}
+
+PipelineReport Pipeline::run() {
+    PipelineReport report;
+    report.items = config_.items;
+    report.queues.resize(queues_.size());
+
+    int cores = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    int next_core = 0;
+    std::vector<std::thread> threads;
+    auto start = Clock::now();
+    for (int s = 0; s < static_cast<int>(config_.stages.size()); s++) {
+        for (int w = 0; w < config_.stages[s].workers; w++) {
+            int core = config_.pin ? next_core++ % cores : -1;
+            threads.emplace_back(&Pipeline::worker, this, s, w, core);
+        }
+    }
+
+    // Monitor: muestras cada 100 µs; al llegar a 4096 se descarta una de cada
+    // dos y se duplica el intervalo, así la serie cubre toda la corrida
+    std::atomic<bool> done{false};
+    std::thread monitor([this, &report, &done] {
+        auto interval = std::chrono::microseconds(100);
+        while (!done.load(std::memory_order_relaxed)) {
+            for (size_t q = 0; q < queues_.size(); q++) {
+                report.queues[q].samples.push_back(queues_[q]->get_occupancy());
+            }
+            if (!report.queues.empty() && report.queues[0].samples.size() >= 4096) {
+                for (auto& queue : report.queues) {
+                    for (size_t i = 0; i < queue.samples.size() / 2; i++) {
+                        queue.samples[i] = queue.samples[2 * i];
+                    }
+                    queue.samples.resize(queue.samples.size() / 2);
+                }
+                interval *= 2;
+            }
+            std::this_thread::sleep_for(interval);
+        }
+    });
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    done = true;
+    monitor.join();
+
+    double worst = -1.0;
+    report.bottleneck = 0;
+    for (size_t s = 0; s < config_.stages.size(); s++) {
+        StageReport stage{config_.stages[s].name, config_.stages[s].workers, config_.stages[s].work_ns,
+                          0, 0.0, 0.0, 0.0};
+        for (const auto& w : stats_[s]) {
+            stage.items += w.items;
+            stage.busy_seconds += w.busy_ns * 1e-9;
+            stage.input_wait_seconds += w.input_wait_ns * 1e-9;
+            stage.output_wait_seconds += w.output_wait_ns * 1e-9;
+        }
+        double utilization = stage.busy_seconds / (stage.workers * report.seconds);
+        if (utilization > worst) {
+            worst = utilization;
+            report.bottleneck = static_cast<int>(s);
+        }
+        report.stages.push_back(stage);
+    }
+    for (size_t q = 0; q < queues_.size(); q++) {
+        report.queues[q].capacity = queues_[q]->get_capacity();
+        report.queues[q].producer_blocks = queues_[q]->get_producer_blocks();
+        report.queues[q].consumer_blocks = queues_[q]->get_consumer_blocks();
+    }
+    return report;
+}
+
+bool Pipeline::parse_stages(const std::string& spec, std::vector<StageConfig>& stages) {
+    stages.clear();
+    std::istringstream list(spec);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        std::istringstream fields(item);
+        StageConfig stage;
+        std::string workers, work;
+        if (!std::getline(fields, stage.name, ':') || !std::getline(fields, workers, ':') ||
+            !std::getline(fields, work) || stage.name.empty()) {
+            return false;
+        }
+        stage.workers = std::atoi(workers.c_str());
+        stage.work_ns = std::atoi(work.c_str());
+        if (stage.workers <= 0 || stage.work_ns < 0) {
+            return false;
+        }
+        stages.push_back(stage);
+    }
+    return !stages.empty();
+}
+
+void Pipeline::display_report(const PipelineReport& report, const PipelineConfig& config) {
+    print_header("PIPELINE");
+
+    double elapsed = report.seconds;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << " Items:                 " << report.items << " (lotes de " << config.batch
+              << ", buffers de " << config.capacity << (config.pin ? ", hilos fijados" : "") << ")" << std::endl;
+    std::cout << " Tiempo:                " << elapsed * 1000 << " ms" << std::endl;
+    std::cout << " Throughput:            " << report.items / elapsed / 1000 << " K items/s" << std::endl;
+
+    // Capacidad = items/s que la etapa sostendría sin esperar a nadie
+    std::cout << "\n " << std::left << std::setw(12) << "Etapa" << std::right
+              << std::setw(8) << "Workers" << std::setw(9) << "ns/item" << std::setw(12) << "K items/s"
+              << std::setw(12) << "Capacidad" << std::setw(8) << "Util%" << std::setw(10) << "Entrada%"
+              << std::setw(9) << "Salida%" << std::endl;
+    print_separator(80);
+    for (size_t s = 0; s < report.stages.size(); s++) {
+        const StageReport& stage = report.stages[s];
+        double worker_time = stage.workers * elapsed;
+        double capacity = stage.busy_seconds > 0 ? stage.items * stage.workers / stage.busy_seconds : 0.0;
+        std::cout << (static_cast<int>(s) == report.bottleneck ? Color::RED : "")
+                  << " " << std::left << std::setw(12) << stage.name << std::right
+                  << std::setw(8) << stage.workers << std::setw(9) << stage.work_ns
+                  << std::setw(12) << stage.items / elapsed / 1000
+                  << std::setw(12) << capacity / 1000
+                  << std::setw(8) << 100.0 * stage.busy_seconds / worker_time
+                  << std::setw(10) << 100.0 * stage.input_wait_seconds / worker_time
+                  << std::setw(9) << 100.0 * stage.output_wait_seconds / worker_time
+                  << Color::RESET << std::endl;
+    }
+
+    if (!report.queues.empty()) {
+        // Tamaño sugerido: un lote en vuelo por worker a cada lado (doble buffer);
+        // más capacidad solo absorbe ráfagas, no sube la tasa de la etapa lenta
+        std::cout << "\n " << std::left << std::setw(24) << "Buffer" << std::right
+                  << std::setw(6) << "Cap" << std::setw(8) << "Media" << std::setw(8) << "Lleno%"
+                  << std::setw(8) << "Vacío%" << std::setw(10) << "Bloq P/C" << std::setw(10) << "Sugerido"
+                  << "  Ocupación en el tiempo" << std::endl;
+        print_separator(100);
+        const char* levels[] = {" ", "▁", "▂", "▃", "▄", "▅", "▆", "▇", "█"};
+        for (size_t q = 0; q < report.queues.size(); q++) {
+            const QueueReport& queue = report.queues[q];
+            size_t n = queue.samples.size();
+            double sum = 0;
+            int full = 0, empty = 0;
+            for (int sample : queue.samples) {
+                sum += sample;
+                full += sample >= queue.capacity ? 1 : 0;
+                empty += sample == 0 ? 1 : 0;
+            }
+            int suggested = 2 * config.batch * std::max(report.stages[q].workers, report.stages[q + 1].workers);
+            std::string name = report.stages[q].name + " → " + report.stages[q + 1].name;
+
+            std::cout << " " << std::left << std::setw(26) << name << std::right
+                      << std::setw(6) << queue.capacity
+                      << std::setw(8) << (n > 0 ? sum / n : 0.0)
+                      << std::setw(8) << (n > 0 ? 100.0 * full / n : 0.0)
+                      << std::setw(8) << (n > 0 ? 100.0 * empty / n : 0.0)
+                      << std::setw(10) << (std::to_string(queue.producer_blocks).append("/")
+                                               .append(std::to_string(queue.consumer_blocks)))
+                      << std::setw(10) << suggested << "  ";
+            // Línea de tiempo: 40 columnas con la ocupación media de cada tramo
+            const int columns = 40;
+            for (int c = 0; c < columns && n > 0; c++) {
+                size_t begin = n * c / columns, end = std::max(begin + 1, n * (c + 1) / columns);
+                double mean = 0;
+                for (size_t i = begin; i < end && i < n; i++) {
+                    mean += queue.samples[i];
+                }
+                mean /= static_cast<double>(end - begin);
+                std::cout << levels[static_cast<int>(std::min(8.0, 8.0 * mean / queue.capacity + 0.5))];
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    // El cuello de botella llena los buffers anteriores y vacía los siguientes
+    const StageReport& slow = report.stages[report.bottleneck];
+    double per_worker = slow.busy_seconds > 0 ? slow.items / slow.busy_seconds : 0.0;
+    std::cout << Color::RED << "\n Cuello de botella: " << slow.name << " ("
+              << 100.0 * slow.busy_seconds / (slow.workers * elapsed) << "% ocupada)" << Color::RESET << std::endl;
+    std::cout << "  └─ Cada worker extra suma hasta " << per_worker / 1000
+              << " K items/s mientras otra etapa no pase a limitar" << std::endl;
+    std::cout << std::endl;
+}
+
+void run_pipeline_capacity_sweep(PipelineConfig config, const std::vector<int>& capacities) {
+    print_header("PIPELINE - BARRIDO DE BUFFERS");
+    std::cout << " " << std::setw(10) << "Capacidad" << std::setw(14) << "K items/s"
+              << std::setw(10) << "Bloq P" << "  Cuello de botella" << std::endl;
+    print_separator(60);
+    std::cout << std::fixed << std::setprecision(2);
+    for (int capacity : capacities) {
+        config.capacity = capacity;
+        Pipeline pipeline(config);
+        PipelineReport report = pipeline.run();
+        int blocks = 0;
+        for (const auto& queue : report.queues) {
+            blocks += queue.producer_blocks;
+        }
+        std::cout << " " << std::setw(10) << capacity << std::setw(14) << report.items / report.seconds / 1000
+                  << std::setw(10) << blocks << "  " << report.stages[report.bottleneck].name << std::endl;
+    }
+    std::cout << std::endl;
+}
@@ -1,32 +1,236 @@
 #include "../include/process.hpp"
 #include "../include/utils.hpp"
 #include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 
-Process::Process(int pid, int burst_time) 
-    : pid_(pid), 
-      state_(ProcessState::NEW),
-      burst_time_(burst_time),
-      remaining_time_(burst_time),
-      wait_time_(0),
-      turnaround_time_(0),
-      arrival_time_(0) {
-}
-
-void Process::execute() {
-    if (remaining_time_ > 0) {
-        remaining_time_--;
-        if (remaining_time_ == 0) {
-            state_ = ProcessState::TERMINATED;
+int ProcessTable::add(int burst_time, SimTime arrival_time) {
+    state_.push_back(static_cast<uint8_t>(ProcessState::NEW));
+    burst_time_.push_back(burst_time);
+    remaining_time_.push_back(burst_time);
+    wait_time_.push_back(0);
+    turnaround_time_.push_back(0);
+    arrival_time_.push_back(arrival_time);
+    first_dispatch_.push_back(-1);
+    address_space_.push_back(0);
+    page_faults_.push_back(0);
+    ready_since_.push_back(0);
+    cpu_until_io_.push_back(0);
+    waiting_io_.push_back(0);
+    io_count_.push_back(0);
+    return size();
+}
+
+int ProcessTable::add_image(const ProcessImage& image) {
+    int pid = add(image.burst_time, image.arrival_time);
+    int i = pid - 1;
+    state_[i] = static_cast<uint8_t>(image.state);
+    remaining_time_[i] = image.remaining_time;
+    wait_time_[i] = image.wait_time;
+    turnaround_time_[i] = image.turnaround_time;
+    first_dispatch_[i] = image.first_dispatch;
+    address_space_[i] = image.address_space;
+    page_faults_[i] = image.page_faults;
+    ready_since_[i] = image.ready_since;
+    cpu_until_io_[i] = image.cpu_until_io;
+    waiting_io_[i] = image.waiting_io != 0 ? 1 : 0;
+    io_count_[i] = image.io_count;
+    return pid;
+}
+
+void ProcessTable::reserve(size_t count) {
+    state_.reserve(count);
+    burst_time_.reserve(count);
+    remaining_time_.reserve(count);
+    wait_time_.reserve(count);
+    turnaround_time_.reserve(count);
+    arrival_time_.reserve(count);
+    first_dispatch_.reserve(count);
+    address_space_.reserve(count);
+    page_faults_.reserve(count);
+    ready_since_.reserve(count);
+    cpu_until_io_.reserve(count);
+    waiting_io_.reserve(count);
+    io_count_.reserve(count);
+}
+
+ProcessImage ProcessTable::get_image(int pid) const {
+    int i = pid - 1;
+    return {pid, state_[i], burst_time_[i], remaining_time_[i], wait_time_[i],
+            turnaround_time_[i], arrival_time_[i], first_dispatch_[i], address_space_[i],
+            page_faults_[i], ready_since_[i], cpu_until_io_[i], waiting_io_[i], io_count_[i]};
+}
+
+// Los bucles masivos usan comparaciones sin saltos sobre punteros crudos
+// para que el compilador los vectorice (bytes de estado → máscaras de 32 bits)
+
+void ProcessTable::increment_ready_waits() {
+    const uint8_t* state = state_.data();
+    SimTime* wait = wait_time_.data();
+    const uint8_t ready = static_cast<uint8_t>(ProcessState::READY);
+    const size_t n = state_.size();
+    for (size_t i = 0; i < n; i++) {
+        wait[i] += (state[i] == ready);
+    }
+}
+
+void ProcessTable::mark_ready_since(SimTime now) {
+    const uint8_t* state = state_.data();
+    SimTime* since = ready_since_.data();
+    const uint8_t ready = static_cast<uint8_t>(ProcessState::READY);
+    const size_t n = state_.size();
+    for (size_t i = 0; i < n; i++) {
+        since[i] = state[i] == ready ? now : since[i];
+    }
+}
+
+void ProcessTable::flush_ready_waits(SimTime now) {
+    const uint8_t* state = state_.data();
+    SimTime* wait = wait_time_.data();
+    SimTime* since = ready_since_.data();
+    const uint8_t ready = static_cast<uint8_t>(ProcessState::READY);
+    const size_t n = state_.size();
+    for (size_t i = 0; i < n; i++) {
+        SimTime mask = -static_cast<SimTime>(state[i] == ready);
+        SimTime elapsed = (now - since[i]) & mask;
+        wait[i] += elapsed;
+        since[i] += elapsed;
+    }
+}
+
+void ProcessTable::set_address_space_all(int pages) {
+    std::fill(address_space_.begin(), address_space_.end(), pages);
+}
+
+std::array<int, ProcessTable::STATE_COUNT> ProcessTable::count_states() const {
+    std::array<int, STATE_COUNT> counts{};
+    const uint8_t* state = state_.data();
+    const size_t n = state_.size();
+    size_t i = 0;
+#if defined(__GNUC__)
+    // 16 contadores de 8 bits por estado (vectores de GCC/Clang): comparar da
+    // 0xFF por byte y restarlo suma 1. Se vuelcan cada 255 vectores para no desbordar.
+    typedef uint8_t Bytes16 __attribute__((vector_size(16)));
+    while (i + 16 <= n) {
+        Bytes16 lanes[STATE_COUNT] = {};
+        const size_t end = std::min(n - (n - i) % 16, i + 255 * 16);
+        for (; i < end; i += 16) {
+            Bytes16 chunk;
+            std::memcpy(&chunk, state + i, sizeof(chunk));
+            for (int s = 0; s < STATE_COUNT; s++) {
+                lanes[s] -= (Bytes16)(chunk == static_cast<uint8_t>(s));
+            }
+        }
+        for (int s = 0; s < STATE_COUNT; s++) {
+            for (int l = 0; l < 16; l++) {
+                counts[s] += lanes[s][l];
+            }
         }
     }
+#endif
+    for (; i < n; i++) {
+        counts[state[i]]++;
+    }
+    return counts;
+}
+
+long long ProcessTable::sum_if_terminated(const std::vector<SimTime>& field) const {
+    const uint8_t* state = state_.data();
+    const SimTime* values = field.data();
+    const uint8_t terminated = static_cast<uint8_t>(ProcessState::TERMINATED);
+    const size_t n = state_.size();
+    long long sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += values[i] & -static_cast<SimTime>(state[i] == terminated);
+    }
+    return sum;
+}
+
+long long ProcessTable::sum_terminated_wait() const {
+    return sum_if_terminated(wait_time_);
+}
+
+long long ProcessTable::sum_terminated_turnaround() const {
+    return sum_if_terminated(turnaround_time_);
+}
+
+long long ProcessTable::sum_page_faults() const {
+    long long sum = 0;
+    for (int32_t faults : page_faults_) {
+        sum += faults;
+    }
+    return sum;
+}
+
+long long ProcessTable::sum_io_count() const {
+    long long sum = 0;
+    for (int32_t count : io_count_) {
+        sum += count;
+    }
+    return sum;
+}
+
+void ProcessTable::benchmark(int processes) {
+    ProcessTable table;
+    table.reserve(processes);
+    uint32_t lcg = 12345;
+    for (int i = 0; i < processes; i++) {
+        table.add(1 + i % 100, i);
+        lcg = lcg * 1664525u + 1013904223u;
+        table.state_[i] = static_cast<uint8_t>((lcg >> 24) % STATE_COUNT);
+    }
+    
+    // Cada operación se repite hasta acumular ~1 GB leído
+    auto measure = [processes](const char* name, size_t bytes_per_process, auto&& op) {
+        size_t bytes = bytes_per_process * processes;
+        int reps = static_cast<int>(std::max<size_t>(1, (size_t(1) << 30) / bytes));
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < reps; r++) {
+            op();
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "   " << std::left << std::setw(24) << name << std::right
+                  << std::setw(9) << elapsed / reps * 1e9 / processes << " ns/proc"
+                  << std::setw(9) << bytes * reps / elapsed / 1e9 << " GB/s" << std::endl;
+    };
+    
+    print_header("OPERACIONES MASIVAS SOBRE LA TABLA SoA");
+    std::cout << " Procesos:              " << processes << std::endl;
+    std::cout << std::fixed << std::setprecision(2) << std::endl;
+    
+    long long sink = 0;
+    measure("Espera +1 (READY)", 17, [&table] { table.increment_ready_waits(); });
+    measure("Volcado de espera", 25, [&table] { table.flush_ready_waits(1000); });
+    measure("Conteo de estados", 1, [&table, &sink] { sink += table.count_states()[0]; });
+    measure("Suma de turnaround", 9, [&table, &sink] { sink += table.sum_terminated_turnaround(); });
+    std::cout << "\n (control: " << sink % 10 << ")" << std::endl << std::endl;
+}
+
+void Process::execute() const {
+    int32_t& remaining = table_->remaining_time_[index_];
+    if (remaining > 0) {
+        remaining--;
+        if (remaining == 0) {
+            set_state(ProcessState::TERMINATED);
+        }
+    }
+}
+
+void Process::execute(int ticks) const {
+    int32_t& remaining = table_->remaining_time_[index_];
+    remaining -= std::min(ticks, remaining);
+    if (remaining == 0) {
+        set_state(ProcessState::TERMINATED);
+    }
 }
 
-void Process::calculate_turnaround(int current_time) {
-    turnaround_time_ = current_time - arrival_time_;
+void Process::calculate_turnaround(SimTime current_time) const {
+    table_->turnaround_time_[index_] = current_time - get_arrival_time();
 }
 
 std::string Process::state_to_string() const {
-    switch (state_) {
+    switch (get_state()) {
         case ProcessState::NEW: return "NEW";
         case ProcessState::READY: return "READY";
         case ProcessState::RUNNING: return "RUNNING";
@@ -38,7 +242,7 @@ std::string Process::state_to_string() const {
 
 void Process::print_info() const {
     std::string color;
-    switch (state_) {
+    switch (get_state()) {
         case ProcessState::RUNNING: color = Color::GREEN; break;
         case ProcessState::READY: color = Color::YELLOW; break;
         case ProcessState::BLOCKED: color = Color::BLUE; break;
@@ -47,11 +251,11 @@ void Process::print_info() const {
     }
     
     std::cout << color
-              << std::setw(6) << pid_
+              << std::setw(6) << get_pid()
               << std::setw(12) << state_to_string()
-              << std::setw(8) << burst_time_
-              << std::setw(10) << remaining_time_
-              << std::setw(10) << wait_time_
-              << std::setw(12) << turnaround_time_
+              << std::setw(8) << get_burst_time()
+              << std::setw(10) << get_remaining_time()
+              << std::setw(10) << get_wait_time()
+              << std::setw(12) << get_turnaround_time()
               << Color::RESET << std::endl;
 }
@@ -0,0 +1,164 @@
+#include "../include/program.hpp"
+#include "../include/workload.hpp"
+#include <new>
+#include <vector>
+
+namespace {
+    constexpr size_t FRAME_GRANULE = 64;
+    constexpr size_t SIZE_CLASSES = 16;              // Frames de hasta 1 KB
+    constexpr size_t BLOCK_BYTES = 64 * 1024;
+
+    struct FreeFrame {
+        FreeFrame* next;
+    };
+
+    struct PoolState {
+        FreeFrame* free_lists[SIZE_CLASSES] = {};
+        std::vector<void*> blocks;
+        char* cursor = nullptr;
+        size_t left = 0;
+        FramePool::Stats stats{0, 0, 0, 0};
+
+        ~PoolState() {
+            for (void* block : blocks) {
+                ::operator delete(block);
+            }
+        }
+    };
+
+    thread_local PoolState pool;
+
+    size_t size_class(size_t bytes) {
+        return (bytes + FRAME_GRANULE - 1) / FRAME_GRANULE - 1;
+    }
+}
+
+void* FramePool::allocate(size_t bytes) {
+    pool.stats.allocations++;
+    pool.stats.live++;
+
+    size_t cls = size_class(bytes);
+    if (cls >= SIZE_CLASSES) {
+        return ::operator new(bytes);
+    }
+    if (FreeFrame* frame = pool.free_lists[cls]) {
+        pool.free_lists[cls] = frame->next;
+        pool.stats.reused++;
+        return frame;
+    }
+
+    // Cortar un frame nuevo del bloque actual
+    size_t size = (cls + 1) * FRAME_GRANULE;
+    if (pool.left < size) {
+        pool.cursor = static_cast<char*>(::operator new(BLOCK_BYTES));
+        pool.left = BLOCK_BYTES;
+        pool.blocks.push_back(pool.cursor);
+        pool.stats.reserved_bytes += BLOCK_BYTES;
+    }
+    void* frame = pool.cursor;
+    pool.cursor += size;
+    pool.left -= size;
+    return frame;
+}
+
+void FramePool::release(void* frame, size_t bytes) {
+    pool.stats.live--;
+
+    size_t cls = size_class(bytes);
+    if (cls >= SIZE_CLASSES) {
+        ::operator delete(frame);
+        return;
+    }
+    FreeFrame* node = static_cast<FreeFrame*>(frame);
+    node->next = pool.free_lists[cls];
+    pool.free_lists[cls] = node;
+}
+
+FramePool::Stats FramePool::stats() {
+    return pool.stats;
+}
+
+std::string Program::op_to_string(ProgramOpKind kind) {
+    switch (kind) {
+        case ProgramOpKind::COMPUTE: return "compute";
+        case ProgramOpKind::ACCESS: return "access";
+        case ProgramOpKind::PRODUCE: return "produce";
+        case ProgramOpKind::CONSUME: return "consume";
+        case ProgramOpKind::IO: return "io";
+        case ProgramOpKind::SLEEP: return "sleep";
+        default: return "unknown";
+    }
+}
+
+namespace {
+    // Ráfagas de CPU separadas en fases
+    Program cpu_program(int bursts, int length) {
+        for (int i = 0; i < bursts; i++) {
+            co_await sys::compute(length);
+        }
+    }
+
+    // Poco CPU y largas esperas (editor, shell)
+    Program interactive_program(int rounds, uint64_t seed) {
+        Xoshiro256 rng(seed);
+        for (int i = 0; i < rounds; i++) {
+            co_await sys::compute(1 + static_cast<int>(rng.below(3)));
+            co_await sys::sleep(10 + static_cast<int>(rng.below(40)));
+        }
+    }
+
+    Program producer_program(int items, int work) {
+        for (int i = 0; i < items; i++) {
+            co_await sys::compute(work);
+            co_await sys::produce(i);
+        }
+    }
+
+    // El trabajo depende del valor consumido
+    Program consumer_program(int items, int work) {
+        for (int i = 0; i < items; i++) {
+            int item = co_await sys::consume();
+            co_await sys::compute(work + item % 2);
+        }
+    }
+
+    // Localidad: working set de 4 páginas que se desplaza cada 50 referencias
+    Program memory_program(int refs, int pages, uint64_t seed) {
+        Xoshiro256 rng(seed);
+        int base = 0;
+        for (int i = 0; i < refs; i++) {
+            if (i % 50 == 49) {
+                base = static_cast<int>(rng.below(pages - 4));
+            }
+            co_await sys::compute(1);
+            co_await sys::access(base + static_cast<int>(rng.below(4)));
+        }
+    }
+
+    Program io_program(int rounds, int cpu) {
+        for (int i = 0; i < rounds; i++) {
+            co_await sys::compute(cpu);
+            co_await sys::io(6);
+        }
+    }
+}
+
+bool Program::make(const std::string& kind, int index, Program& program) {
+    static const char* const MIX[] = {"cpu", "interactive", "producer", "consumer", "memory", "io"};
+    if (kind == "mix") {
+        return make(MIX[index % 6], index / 6, program);
+    }
+
+    Xoshiro256 rng(static_cast<uint64_t>(index) + 1);
+    int spread = static_cast<int>(rng.below(4));
+
+    // Productores y consumidores con el mismo índice mueven la misma cantidad
+    if (kind == "cpu") program = cpu_program(2 + spread, 5 + static_cast<int>(rng.below(16)));
+    else if (kind == "interactive") program = interactive_program(3 + 2 * spread, rng.next());
+    else if (kind == "producer") program = producer_program(8, 1 + spread);
+    else if (kind == "consumer") program = consumer_program(8, 1 + spread);
+    else if (kind == "memory") program = memory_program(20 + 20 * spread, 64, rng.next());
+    else if (kind == "io") program = io_program(2 + spread, 2 + static_cast<int>(rng.below(7)));
+    else return false;
+    return true;
+}
@@ -0,0 +1,223 @@
+#include "../include/realtime.hpp"
+#include "../include/utils.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+RealTimeClass::RealTimeClass(SimulationKernel& kernel, RtPolicy policy, bool verbose)
+    : kernel_(kernel),
+      policy_(policy),
+      verbose_(verbose),
+      next_seq_(0),
+      busy_ticks_(0) {
+
+    static std::atomic<long long> next_generation{0};
+    generation_ = ++next_generation;
+
+    kernel_.on(EventType::RT_RELEASE, [this](const Event& e) { handle_release(e); });
+
+    if (verbose_) {
+        std::cout << Color::GREEN << "[RT] Clase de tiempo real " << policy_to_string(policy)
+                  << " activa" << Color::RESET << std::endl;
+    }
+}
+
+RealTimeClass::~RealTimeClass() {
+    kernel_.on(EventType::RT_RELEASE, nullptr);
+}
+
+double RealTimeClass::admission_bound(size_t tasks) const {
+    if (policy_ == RtPolicy::EDF || tasks == 0) {
+        return 1.0;
+    }
+    double n = static_cast<double>(tasks);
+    return n * (std::pow(2.0, 1.0 / n) - 1.0);
+}
+
+double RealTimeClass::utilization() const {
+    // Densidad: con deadline < período cuenta C/D
+    double total = 0.0;
+    for (const auto& task : tasks_) {
+        total += static_cast<double>(task.wcet) / task.deadline;
+    }
+    return total;
+}
+
+bool RealTimeClass::admit(int period, int wcet, int deadline, bool force, std::string& reason) {
+    if (deadline <= 0) {
+        deadline = period;
+    }
+    if (period <= 0 || wcet <= 0 || wcet > deadline || deadline > period) {
+        reason = "se requiere 0 < wcet ≤ deadline ≤ período";
+        return false;
+    }
+    if (tasks_.size() >= 0xFFFF) {
+        reason = "demasiadas tareas";
+        return false;
+    }
+
+    double load = utilization() + static_cast<double>(wcet) / deadline;
+    double bound = admission_bound(tasks_.size() + 1);
+    if (load > bound + 1e-9 && !force) {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(3) << "U=" << load << " supera la cota "
+            << bound << " de " << policy_to_string(policy_);
+        reason = out.str();
+        return false;
+    }
+
+    PeriodicTask task{};
+    task.id = static_cast<int>(tasks_.size());
+    task.period = period;
+    task.wcet = wcet;
+    task.deadline = deadline;
+    task.next_release = kernel_.now();
+    tasks_.push_back(task);
+
+    // Primera liberación inmediata; cada liberación programa la siguiente
+    kernel_.schedule(kernel_.now(), EventType::RT_RELEASE, -1, (generation_ << 16) | task.id);
+    return true;
+}
+
+void RealTimeClass::handle_release(const Event& event) {
+    if ((event.data >> 16) != generation_) {
+        return;
+    }
+    PeriodicTask& task = tasks_[event.data & 0xFFFF];
+    SimTime release = kernel_.now();
+
+    Job job;
+    job.key = policy_ == RtPolicy::EDF ? release + task.deadline : task.period;
+    job.seq = next_seq_++;
+    job.task = task.id;
+    job.remaining = task.wcet;
+    job.release = release;
+    job.deadline = release + task.deadline;
+    ready_.push_back(job);
+    std::push_heap(ready_.begin(), ready_.end(), lower_priority);
+
+    task.released++;
+    task.next_release = release + task.period;
+    kernel_.schedule(task.next_release, EventType::RT_RELEASE, -1, event.data);
+}
+
+SimTime RealTimeClass::next_release() const {
+    SimTime next = SimulationKernel::NEVER;
+    for (const auto& task : tasks_) {
+        next = std::min(next, task.next_release);
+    }
+    return next;
+}
+
+SimTime RealTimeClass::slice_budget(SimTime limit) const {
+    // Solo una liberación puede cambiar el tope del heap
+    return std::min<SimTime>({static_cast<SimTime>(ready_.front().remaining),
+                              next_release() - kernel_.now(),
+                              limit - kernel_.now()});
+}
+
+void RealTimeClass::execute(SimTime ticks) {
+    Job& job = ready_.front();
+    job.remaining -= static_cast<int>(ticks);
+    busy_ticks_ += ticks;
+    if (job.remaining > 0) {
+        return;
+    }
+
+    SimTime now = kernel_.now();
+    PeriodicTask& task = tasks_[job.task];
+    SimTime response = now - job.release;
+    task.completed++;
+    task.response.record(static_cast<uint64_t>(response));
+    task.response_sum += static_cast<double>(response);
+    task.response_sq_sum += static_cast<double>(response) * response;
+
+    if (now > job.deadline) {
+        task.missed++;
+        if (verbose_) {
+            std::cout << Color::RED << "[t=" << now << "] RT" << task.id
+                      << " DEADLINE PERDIDO (lateness=" << now - job.deadline << ")"
+                      << Color::RESET << std::endl;
+        }
+    }
+    std::pop_heap(ready_.begin(), ready_.end(), lower_priority);
+    ready_.pop_back();
+}
+
+void RealTimeClass::display_stats(long long total_ticks) const {
+    print_header("TIEMPO REAL - " + policy_to_string(policy_));
+
+    long long released = 0, completed = 0, missed = 0;
+    for (const auto& task : tasks_) {
+        released += task.released;
+        completed += task.completed;
+        missed += task.missed;
+    }
+    // Trabajos en cola que ya pasaron su deadline
+    long long overdue = std::count_if(ready_.begin(), ready_.end(),
+                                      [this](const Job& job) { return job.deadline < kernel_.now(); });
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << " Tareas:                " << tasks_.size() << std::endl;
+    std::cout << " Utilización:           " << utilization() << " (cota "
+              << admission_bound(tasks_.size()) << ")" << std::endl;
+    std::cout << std::setprecision(2);
+    std::cout << " CPU de tiempo real:    " << busy_ticks_ << " ticks ("
+              << (total_ticks > 0 ? 100.0 * busy_ticks_ / total_ticks : 0.0) << "%)" << std::endl;
+    std::cout << " Trabajos liberados:    " << released << std::endl;
+    std::cout << "  ├─ Terminados:        " << completed << std::endl;
+    std::cout << "  ├─ Deadline perdido:  " << missed << " ("
+              << (completed > 0 ? 100.0 * missed / completed : 0.0) << "%)" << std::endl;
+    std::cout << "  └─ Vencidos en cola:  " << overdue << std::endl;
+
+    if (tasks_.empty()) {
+        std::cout << std::endl;
+        return;
+    }
+
+    // Lateness = respuesta - deadline (negativa = holgura); jitter = máx - mín de respuesta
+    std::cout << "\n " << std::left << std::setw(5) << "ID" << std::right
+              << std::setw(6) << "T" << std::setw(6) << "C" << std::setw(6) << "D"
+              << std::setw(9) << "Trabajos" << std::setw(8) << "Miss%"
+              << std::setw(9) << "Lat p50" << std::setw(9) << "Lat p99" << std::setw(9) << "Lat máx"
+              << std::setw(8) << "Jitter" << std::setw(8) << "σ resp" << std::endl;
+    print_separator(84);
+    for (const auto& task : tasks_) {
+        const LogHistogram& r = task.response;
+        double mean = task.completed > 0 ? task.response_sum / task.completed : 0.0;
+        double variance = task.completed > 0 ? task.response_sq_sum / task.completed - mean * mean : 0.0;
+        long long d = task.deadline;
+
+        std::cout << " " << std::left << std::setw(5) << ("RT" + std::to_string(task.id)) << std::right
+                  << std::setw(6) << task.period << std::setw(6) << task.wcet << std::setw(6) << d
+                  << std::setw(9) << task.completed
+                  << std::setw(8) << (task.completed > 0 ? 100.0 * task.missed / task.completed : 0.0);
+        if (task.completed > 0) {
+            std::cout << std::setw(9) << static_cast<long long>(r.percentile(0.5)) - d
+                      << std::setw(9) << static_cast<long long>(r.percentile(0.99)) - d
+                      << std::setw(9) << static_cast<long long>(r.max()) - d
+                      << std::setw(8) << r.max() - r.min()
+                      << std::setw(8) << std::sqrt(std::max(0.0, variance));
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+std::string RealTimeClass::policy_to_string(RtPolicy policy) {
+    switch (policy) {
+        case RtPolicy::EDF: return "EDF";
+        case RtPolicy::RM: return "RM";
+        default: return "UNKNOWN";
+    }
+}
+
+bool RealTimeClass::parse_policy(const std::string& name, RtPolicy& policy) {
+    if (name == "edf") policy = RtPolicy::EDF;
+    else if (name == "rm") policy = RtPolicy::RM;
+    else return false;
+    return true;
+}
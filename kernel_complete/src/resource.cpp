@@ -0,0 +1,668 @@
+#include "../include/resource.hpp"
+#include "../include/workload.hpp"
+#include "../include/utils.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+
+namespace {
+    constexpr size_t MAX_ROWS = 40;
+    constexpr size_t MAX_LISTED = 6;                 // Dueños o esperas por fila
+}
+
+ResourceManager::ResourceManager(ResourceMode mode, bool verbose)
+    : mode_(mode),
+      verbose_(verbose),
+      epoch_(0),
+      requests_(0),
+      granted_(0),
+      waits_(0),
+      postponements_(0),
+      deadlocks_(0),
+      false_cycles_(0),
+      safety_checks_(0),
+      fast_safe_(0) {}
+
+ResourceManager::Proc& ResourceManager::proc(int pid) {
+    if (pid >= static_cast<int>(procs_.size())) {
+        procs_.resize(std::max<size_t>(static_cast<size_t>(pid) + 1, procs_.size() * 2));
+    }
+    return procs_[pid];
+}
+
+int ResourceManager::find(const std::vector<Units>& list, int id) {
+    for (size_t i = 0; i < list.size(); i++) {
+        if (list[i].id == id) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void ResourceManager::add_units(std::vector<Units>& list, int id, int units) {
+    int i = find(list, id);
+    if (i >= 0) {
+        list[i].units += units;
+    } else {
+        list.push_back({id, units});
+    }
+}
+
+void ResourceManager::remove_units(std::vector<Units>& list, int id, int units) {
+    int i = find(list, id);
+    list[i].units -= units;
+    if (list[i].units == 0) {
+        list[i] = list.back();
+        list.pop_back();
+    }
+}
+
+int ResourceManager::held_units(int pid, int resource) const {
+    if (pid < 0 || pid >= static_cast<int>(procs_.size())) {
+        return 0;
+    }
+    int i = find(procs_[pid].held, resource);
+    return i >= 0 ? procs_[pid].held[i].units : 0;
+}
+
+int ResourceManager::add_resource(const std::string& name, int units) {
+    resources_.push_back({name, units, units, {}, {}});
+    work_epoch_.push_back(0);
+    work_.push_back(0);
+    range_next_.push_back(0);
+    range_end_.push_back(0);
+    return static_cast<int>(resources_.size()) - 1;
+}
+
+bool ResourceManager::set_claim(int pid, int resource, int max_units) {
+    if (pid < 0 || resource < 0 || resource >= get_resource_count() || max_units <= 0 ||
+        max_units > resources_[resource].total || max_units < held_units(pid, resource)) {
+        return false;
+    }
+    Proc& p = proc(pid);
+    int i = find(p.claims, resource);
+    if (i >= 0) {
+        p.claims[i].units = max_units;
+    } else {
+        p.claims.push_back({resource, max_units});
+    }
+    return true;
+}
+
+void ResourceManager::assign(int pid, int resource, int units) {
+    Resource& res = resources_[resource];
+    Proc& p = procs_[pid];
+    res.available -= units;
+    add_units(res.holders, pid, units);
+    if (p.held.empty()) {
+        p.holder_slot = static_cast<int>(holders_.size());
+        holders_.push_back(pid);
+    }
+    add_units(p.held, resource, units);
+}
+
+void ResourceManager::unassign(int pid, int resource, int units) {
+    Resource& res = resources_[resource];
+    Proc& p = procs_[pid];
+    res.available += units;
+    remove_units(res.holders, pid, units);
+    remove_units(p.held, resource, units);
+    if (p.held.empty()) {
+        int moved = holders_.back();
+        holders_[p.holder_slot] = moved;
+        procs_[moved].holder_slot = p.holder_slot;
+        holders_.pop_back();
+        p.holder_slot = -1;
+    }
+}
+
+void ResourceManager::start_wait(int pid, int resource, int units, bool postponed) {
+    Proc& p = procs_[pid];
+    p.waiting = resource;
+    p.wanted = units;
+    p.postponed = postponed;
+    resources_[resource].waiters.push_back(pid);
+    if (postponed) {
+        postponed_.push_back(pid);
+    }
+}
+
+void ResourceManager::stop_wait(int pid) {
+    Proc& p = procs_[pid];
+    std::vector<int>& waiters = resources_[p.waiting].waiters;
+    waiters.erase(std::find(waiters.begin(), waiters.end(), pid));
+    if (p.postponed) {
+        postponed_.erase(std::find(postponed_.begin(), postponed_.end(), pid));
+    }
+    p.waiting = -1;
+    p.wanted = 0;
+    p.postponed = false;
+}
+
+int ResourceManager::work(int resource) {
+    if (work_epoch_[resource] != epoch_) {
+        work_epoch_[resource] = epoch_;
+        work_[resource] = resources_[resource].available;
+    }
+    return work_[resource];
+}
+
+bool ResourceManager::reduce(const std::vector<int>& procs, bool by_claims) {
+    // Reducción de Holt: termina quien tiene lo que le falta, devuelve lo suyo
+    // y despierta a las demandas de ese recurso que ya alcanzan. Las demandas
+    // se ordenan por recurso y unidades, así cada una se mira una sola vez.
+    epoch_++;
+    if (unsatisfied_.size() < procs_.size()) {
+        unsatisfied_.resize(procs_.size());
+    }
+    demands_.clear();
+    stack_.clear();
+    for (int pid : procs) {
+        const Proc& p = procs_[pid];
+        int count = 0;
+        if (by_claims) {
+            for (const Units& claim : p.claims) {
+                int i = find(p.held, claim.id);
+                int need = claim.units - (i >= 0 ? p.held[i].units : 0);
+                if (need > work(claim.id)) {
+                    demands_.push_back({claim.id, need, pid});
+                    count++;
+                }
+            }
+        } else if (p.waiting >= 0 && p.wanted > work(p.waiting)) {
+            demands_.push_back({p.waiting, p.wanted, pid});
+            count++;
+        }
+        unsatisfied_[pid] = count;
+        if (count == 0) {
+            stack_.push_back(pid);
+        }
+    }
+
+    std::sort(demands_.begin(), demands_.end(), [](const Demand& a, const Demand& b) {
+        return a.resource != b.resource ? a.resource < b.resource : a.units < b.units;
+    });
+    for (size_t i = 0; i < demands_.size(); i++) {
+        int resource = demands_[i].resource;
+        if (i == 0 || demands_[i - 1].resource != resource) {
+            range_next_[resource] = static_cast<int>(i);
+        }
+        range_end_[resource] = static_cast<int>(i) + 1;
+    }
+
+    size_t finished = 0;
+    while (!stack_.empty()) {
+        int pid = stack_.back();
+        stack_.pop_back();
+        finished++;
+        for (const Units& held : procs_[pid].held) {
+            work(held.id);
+            int& available = work_[held.id];
+            available += held.units;
+            int& next = range_next_[held.id];
+            while (next < range_end_[held.id] && demands_[next].units <= available) {
+                if (--unsatisfied_[demands_[next].pid] == 0) {
+                    stack_.push_back(demands_[next].pid);
+                }
+                next++;
+            }
+        }
+    }
+
+    for (const Demand& demand : demands_) {
+        range_next_[demand.resource] = 0;
+        range_end_[demand.resource] = 0;
+    }
+    return finished == procs.size();
+}
+
+bool ResourceManager::closes_deadlock(int pid) {
+    // Las aristas nuevas salen de pid: hay ciclo solo si desde sus dueños se
+    // vuelve a pid. Los que no esperan no tienen aristas y cortan la búsqueda.
+    epoch_++;
+    stack_.clear();
+    reached_.clear();
+    procs_[pid].mark = epoch_;
+    stack_.push_back(pid);
+    reached_.push_back(pid);
+    bool cycle = false;
+    while (!stack_.empty()) {
+        int waiter = stack_.back();
+        stack_.pop_back();
+        int resource = procs_[waiter].waiting;
+        if (resource < 0) {
+            continue;
+        }
+        for (const Units& holder : resources_[resource].holders) {
+            if (holder.id == pid) {
+                cycle = cycle || waiter != pid;
+                continue;
+            }
+            Proc& next = procs_[holder.id];
+            if (next.mark != epoch_) {
+                next.mark = epoch_;
+                stack_.push_back(holder.id);
+                reached_.push_back(holder.id);
+            }
+        }
+    }
+    detect_nodes_.record(reached_.size());
+
+    // Con varias instancias otro dueño puede liberar lo que falta: el ciclo
+    // es interbloqueo solo si la reducción del conjunto alcanzado no termina
+    if (!cycle) {
+        return false;
+    }
+    if (reduce(reached_, false)) {
+        false_cycles_++;
+        return false;
+    }
+    return true;
+}
+
+bool ResourceManager::safe_after(int pid, int resource, int units) {
+    // Si después de conceder lo que le falta a pid todavía entra en lo libre,
+    // pid puede terminar primero y devolver más de lo que se llevó: el orden
+    // seguro anterior sigue valiendo y no hace falta reducir
+    assign(pid, resource, units);
+    bool fits = true;
+    for (const Units& claim : procs_[pid].claims) {
+        fits = fits && claim.units - held_units(pid, claim.id) <= resources_[claim.id].available;
+    }
+    if (fits) {
+        unassign(pid, resource, units);
+        fast_safe_++;
+        return true;
+    }
+
+    // Los procesos sin unidades no traban a nadie: alcanza con reducir a los dueños
+    safety_checks_++;
+    check_nodes_.record(holders_.size());
+    bool safe = reduce(holders_, true);
+    unassign(pid, resource, units);
+    return safe;
+}
+
+RequestResult ResourceManager::request(int pid, int resource, int units) {
+    requests_++;
+    if (pid < 0 || resource < 0 || resource >= get_resource_count() || units <= 0 ||
+        units > resources_[resource].total) {
+        return RequestResult::INVALID;
+    }
+    Proc& p = proc(pid);
+    int claim = find(p.claims, resource);
+    int held = held_units(pid, resource);
+    if (p.waiting >= 0 || (claim >= 0 && held + units > p.claims[claim].units) ||
+        (mode_ == ResourceMode::AVOID && claim < 0)) {
+        return RequestResult::INVALID;
+    }
+
+    Resource& res = resources_[resource];
+    RequestResult result;
+    if (res.available >= units &&
+        (mode_ == ResourceMode::DETECT || safe_after(pid, resource, units))) {
+        assign(pid, resource, units);
+        granted_++;
+        result = RequestResult::GRANTED;
+    } else if (res.available >= units) {
+        start_wait(pid, resource, units, true);
+        postponements_++;
+        result = RequestResult::POSTPONED;
+    } else {
+        start_wait(pid, resource, units, false);
+        if (mode_ == ResourceMode::DETECT && closes_deadlock(pid)) {
+            stop_wait(pid);
+            deadlocks_++;
+            result = RequestResult::DEADLOCK;
+        } else {
+            waits_++;
+            result = RequestResult::WAITING;
+        }
+    }
+
+    if (verbose_) {
+        const std::string& color = result == RequestResult::GRANTED ? Color::GREEN
+                                 : result == RequestResult::DEADLOCK ? Color::RED : Color::YELLOW;
+        std::cout << color << "[RECURSO] P" << pid << " pide " << units << " de " << res.name
+                  << ": " << result_to_string(result) << " (libres " << res.available << "/"
+                  << res.total << ")" << Color::RESET << std::endl;
+    }
+    return result;
+}
+
+bool ResourceManager::try_grant(int pid) {
+    Proc& p = procs_[pid];
+    int resource = p.waiting;
+    int units = p.wanted;
+    if (resources_[resource].available < units) {
+        return false;
+    }
+    if (mode_ == ResourceMode::AVOID && !safe_after(pid, resource, units)) {
+        if (!p.postponed) {
+            p.postponed = true;
+            postponed_.push_back(pid);
+        }
+        return false;
+    }
+    stop_wait(pid);
+    assign(pid, resource, units);
+    granted_++;
+    if (verbose_) {
+        std::cout << Color::CYAN << "[RECURSO] P" << pid << " obtiene " << units << " de "
+                  << resources_[resource].name << " (esperaba)" << Color::RESET << std::endl;
+    }
+    if (granted_callback_) {
+        granted_callback_(pid);
+    }
+    return true;
+}
+
+void ResourceManager::wake_waiters(int resource) {
+    // Se atiende en orden de llegada a todo el que entre en lo liberado; con
+    // el banquero, el primero que sigue inseguro corta la pasada (cada intento
+    // puede costar una reducción de todos los dueños)
+    std::vector<int> waiters = resources_[resource].waiters;
+    for (int pid : waiters) {
+        if (resources_[resource].available == 0) {
+            break;
+        }
+        if (!try_grant(pid) && procs_[pid].postponed) {
+            break;
+        }
+    }
+}
+
+void ResourceManager::retry_postponed() {
+    // Una liberación puede volver seguro lo que el banquero aplazó en otro recurso
+    std::vector<int> postponed = postponed_;
+    for (int pid : postponed) {
+        const Proc& p = procs_[pid];
+        if (p.waiting >= 0 && resources_[p.waiting].available >= p.wanted && !try_grant(pid)) {
+            break;
+        }
+    }
+}
+
+int ResourceManager::release(int pid, int resource, int units) {
+    int held = held_units(pid, resource);
+    if (resource < 0 || resource >= get_resource_count() || held == 0) {
+        return 0;
+    }
+    int count = units <= 0 ? held : std::min(units, held);
+    unassign(pid, resource, count);
+    if (verbose_) {
+        std::cout << Color::CYAN << "[RECURSO] P" << pid << " libera " << count << " de "
+                  << resources_[resource].name << Color::RESET << std::endl;
+    }
+    wake_waiters(resource);
+    if (mode_ == ResourceMode::AVOID) {
+        retry_postponed();
+    }
+    return count;
+}
+
+void ResourceManager::release_all(int pid) {
+    if (pid < 0 || pid >= static_cast<int>(procs_.size())) {
+        return;
+    }
+    if (procs_[pid].waiting >= 0) {
+        stop_wait(pid);
+    }
+    std::vector<Units> held = procs_[pid].held;
+    for (const Units& units : held) {
+        unassign(pid, units.id, units.units);
+    }
+    for (const Units& units : held) {
+        wake_waiters(units.id);
+    }
+    if (mode_ == ResourceMode::AVOID) {
+        retry_postponed();
+    }
+}
+
+bool ResourceManager::full_scan() {
+    // Todos los que tienen o esperan algo, sin importar dónde cambió el grafo
+    std::vector<int> involved = holders_;
+    for (const Resource& res : resources_) {
+        for (int pid : res.waiters) {
+            if (procs_[pid].held.empty()) {
+                involved.push_back(pid);
+            }
+        }
+    }
+    return !reduce(involved, false);
+}
+
+std::string ResourceManager::mode_to_string(ResourceMode mode) {
+    switch (mode) {
+        case ResourceMode::DETECT: return "detección";
+        case ResourceMode::AVOID: return "banquero";
+        default: return "UNKNOWN";
+    }
+}
+
+std::string ResourceManager::result_to_string(RequestResult result) {
+    switch (result) {
+        case RequestResult::GRANTED: return "concedido";
+        case RequestResult::WAITING: return "espera";
+        case RequestResult::POSTPONED: return "aplazado (estado inseguro)";
+        case RequestResult::DEADLOCK: return "rechazado (interbloqueo)";
+        case RequestResult::INVALID: return "inválido";
+        default: return "UNKNOWN";
+    }
+}
+
+void ResourceManager::display_state() const {
+    print_header("RECURSOS (" + mode_to_string(mode_) + ")");
+    if (resources_.empty()) {
+        std::cout << " Sin recursos (res-new <nombre> <unidades>)" << std::endl << std::endl;
+        return;
+    }
+
+    std::cout << " " << std::right << std::setw(4) << "Id" << "  " << std::left << std::setw(12) << "Nombre"
+              << std::right << std::setw(6) << "Total" << std::setw(7) << "Libres" << "  " << std::left
+              << std::setw(30) << "Dueños (×unidades)" << "Esperan (unidades)" << std::endl;
+    print_separator(78);
+    for (size_t r = 0; r < resources_.size() && r < MAX_ROWS; r++) {
+        const Resource& res = resources_[r];
+        std::string holders;
+        for (size_t i = 0; i < res.holders.size() && i < MAX_LISTED; i++) {
+            holders.append("P").append(std::to_string(res.holders[i].id)).append("×")
+                   .append(std::to_string(res.holders[i].units)).append(" ");
+        }
+        if (res.holders.size() > MAX_LISTED) holders.append("...");
+        std::string waiters;
+        for (size_t i = 0; i < res.waiters.size() && i < MAX_LISTED; i++) {
+            const Proc& p = procs_[res.waiters[i]];
+            waiters.append("P").append(std::to_string(res.waiters[i])).append("(")
+                   .append(std::to_string(p.wanted)).append(p.postponed ? "*) " : ") ");
+        }
+        if (res.waiters.size() > MAX_LISTED) waiters.append("...");
+        // setw cuenta bytes: "×" ocupa dos
+        int padding = 28 + static_cast<int>(std::min(res.holders.size(), MAX_LISTED));
+        std::cout << " " << std::right << std::setw(4) << r << "  " << std::left << std::setw(12) << res.name
+                  << std::right << std::setw(6) << res.total << std::setw(7) << res.available << "  "
+                  << std::left << std::setw(padding) << holders << waiters << std::endl;
+    }
+    if (resources_.size() > MAX_ROWS) {
+        std::cout << " ... " << resources_.size() - MAX_ROWS << " recursos más" << std::endl;
+    }
+    std::cout << std::right;
+
+    if (mode_ == ResourceMode::AVOID) {
+        std::cout << "\n Reclamos (tiene/máximo):" << std::endl;
+        size_t rows = 0;
+        for (size_t pid = 0; pid < procs_.size() && rows < MAX_ROWS; pid++) {
+            const Proc& p = procs_[pid];
+            if (p.claims.empty()) {
+                continue;
+            }
+            std::cout << "   P" << pid << ":";
+            for (const Units& claim : p.claims) {
+                std::cout << " " << resources_[claim.id].name << " " << held_units(static_cast<int>(pid), claim.id)
+                          << "/" << claim.units;
+            }
+            std::cout << std::endl;
+            rows++;
+        }
+        std::cout << " (* = aplazado por el banquero)" << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+void ResourceManager::display_stats() const {
+    print_header("ESTADÍSTICAS DE RECURSOS");
+
+    size_t waiting = 0;
+    for (const Resource& res : resources_) {
+        waiting += res.waiters.size();
+    }
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << " Modo:                  " << mode_to_string(mode_) << std::endl;
+    std::cout << " Recursos:              " << resources_.size() << std::endl;
+    std::cout << " Procesos con unidades: " << holders_.size() << std::endl;
+    std::cout << " Procesos esperando:    " << waiting << std::endl;
+    std::cout << "\n Pedidos:               " << requests_ << std::endl;
+    std::cout << "  ├─ Concedidos:        " << granted_ << " (incluye esperas atendidas)" << std::endl;
+    std::cout << "  ├─ Esperas:           " << waits_ << std::endl;
+    if (mode_ == ResourceMode::AVOID) {
+        std::cout << "  └─ Aplazados:         " << postponements_ << " (estado inseguro)" << std::endl;
+        std::cout << "\n Chequeos de seguridad: " << fast_safe_ + safety_checks_ << " (" << fast_safe_
+                  << " directos), reducciones de " << check_nodes_.mean() << " procesos de media (máx "
+                  << check_nodes_.max() << ")" << std::endl;
+    } else {
+        std::cout << "  └─ Interbloqueos:     " << deadlocks_ << " rechazados, " << false_cycles_
+                  << " ciclos sin interbloqueo" << std::endl;
+        std::cout << "\n Búsquedas por bloqueo: " << detect_nodes_.count() << ", procesos visitados: media "
+                  << detect_nodes_.mean() << ", p99 " << detect_nodes_.percentile(0.99)
+                  << ", máx " << detect_nodes_.max() << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+void run_resource_bench(int processes, int resources, long long requests, uint64_t seed) {
+    // Cada proceso reclama 3 recursos de 1 a 3 unidades y los toma de a una
+    // unidad, en el orden de sus reclamos (distinto en cada proceso, así hay
+    // ciclos). Con todo en la mano suelta todo y vuelve a empezar; un pedido
+    // rechazado por interbloqueo lo aborta igual.
+    constexpr int CLAIMS = 3;
+    Xoshiro256 rng(seed);
+    std::vector<int> units(static_cast<size_t>(resources));
+    for (int& u : units) {
+        u = 1 + static_cast<int>(rng.below(3));
+    }
+    std::vector<std::pair<int, int>> claims(static_cast<size_t>(processes) * CLAIMS);
+    for (size_t i = 0; i < claims.size(); i++) {
+        // Recursos distintos dentro de cada proceso (si alcanzan)
+        int resource;
+        bool repeated;
+        do {
+            resource = static_cast<int>(rng.below(static_cast<uint32_t>(resources)));
+            repeated = false;
+            for (size_t j = i - i % CLAIMS; j < i; j++) {
+                repeated = repeated || claims[j].first == resource;
+            }
+        } while (repeated && resources >= CLAIMS);
+        claims[i] = {resource, 1 + static_cast<int>(rng.below(static_cast<uint32_t>(units[resource])))};
+    }
+
+    std::cout << Color::BOLD << Color::BLUE << "\n▶ Recursos: " << processes << " procesos, " << resources
+              << " recursos, " << requests << " pedidos" << Color::RESET << std::endl;
+    std::cout << std::left << "   " << std::setw(11) << "Modo" << std::right
+              << std::setw(10) << "Pedidos" << std::setw(10) << "ns medio" << std::setw(10) << "ns p99"
+              << std::setw(11) << "Visitados" << std::setw(9) << "Máx" << std::setw(9) << "Esperas"
+              << std::setw(11) << "Aplazados" << std::setw(12) << "Interbloq." << std::endl;
+
+    double incremental_ns = 0;
+    LogHistogram scan_ns;
+    long long scan_deadlocks = 0;
+    for (ResourceMode mode : {ResourceMode::DETECT, ResourceMode::AVOID}) {
+        ResourceManager manager(mode, false);
+        for (int r = 0; r < resources; r++) {
+            manager.add_resource(std::string("r").append(std::to_string(r)), units[r]);
+        }
+        for (int pid = 0; pid < processes; pid++) {
+            for (int k = 0; k < CLAIMS; k++) {
+                const auto& claim = claims[static_cast<size_t>(pid) * CLAIMS + k];
+                manager.set_claim(pid, claim.first, claim.second);
+            }
+        }
+
+        // El banquero revisa a todos los dueños en cada pedido: se corta antes
+        long long limit = mode == ResourceMode::AVOID
+                        ? std::min(requests, std::max<long long>(1000, 2000000000LL / std::max(processes, 1)))
+                        : requests;
+        long long scan_every = std::max<long long>(1, limit / 50);
+
+        Xoshiro256 steps(seed ^ 0x5EED);
+        LogHistogram request_ns;
+        long long done = 0;
+        long long waits = 0;
+        long long postponed = 0;
+        long long deadlocks = 0;
+        while (done < limit) {
+            // Desde un PID al azar, el primero que no espera
+            int pid = static_cast<int>(steps.below(static_cast<uint32_t>(processes)));
+            int skipped = 0;
+            while (manager.is_waiting(pid) && skipped < processes) {
+                pid = (pid + 1) % processes;
+                skipped++;
+            }
+            if (skipped == processes) {
+                break;
+            }
+            const std::pair<int, int>* claim = nullptr;
+            for (int k = 0; k < CLAIMS && claim == nullptr; k++) {
+                const auto& next = claims[static_cast<size_t>(pid) * CLAIMS + k];
+                if (manager.held_units(pid, next.first) < next.second) {
+                    claim = &next;
+                }
+            }
+            if (claim == nullptr) {
+                manager.release_all(pid);
+                continue;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            RequestResult result = manager.request(pid, claim->first, 1);
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            request_ns.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+            done++;
+            if (result == RequestResult::WAITING) waits++;
+            else if (result == RequestResult::POSTPONED) postponed++;
+            else if (result == RequestResult::DEADLOCK) {
+                deadlocks++;
+                manager.release_all(pid);
+            }
+
+            if (mode == ResourceMode::DETECT && done % scan_every == 0) {
+                auto scan_start = std::chrono::steady_clock::now();
+                bool deadlocked = manager.full_scan();
+                auto scan_elapsed = std::chrono::steady_clock::now() - scan_start;
+                scan_ns.record(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(scan_elapsed).count()));
+                if (deadlocked) scan_deadlocks++;
+            }
+        }
+
+        const LogHistogram& visited = manager.get_detect_nodes();
+        std::cout << std::fixed << std::setprecision(1) << std::left << "   "
+                  << std::setw(12) << ResourceManager::mode_to_string(mode) << std::right
+                  << std::setw(10) << done << std::setw(10) << request_ns.mean()
+                  << std::setw(10) << request_ns.percentile(0.99);
+        if (mode == ResourceMode::DETECT) {
+            std::cout << std::setw(11) << visited.mean() << std::setw(9) << visited.max();
+            incremental_ns = request_ns.mean();
+        } else {
+            std::cout << std::setw(11) << "-" << std::setw(9) << "-";
+        }
+        std::cout << std::setw(9) << waits << std::setw(11) << postponed << std::setw(12) << deadlocks << std::endl;
+    }
+
+    std::cout << " Detección completa (" << scan_ns.count() << " pasadas): " << std::setprecision(1)
+              << scan_ns.mean() / 1000.0 << " µs media, p99 " << scan_ns.percentile(0.99) / 1000.0
+              << " µs = ×" << std::setprecision(0) << scan_ns.mean() / std::max(incremental_ns, 1.0)
+              << " el pedido incremental; interbloqueos hallados: " << scan_deadlocks << std::endl;
+    std::cout << " (Visitados = procesos recorridos por la búsqueda de cada bloqueo)" << std::endl << std::endl;
+}
@@ -0,0 +1,480 @@
+#include "../include/sampler.hpp"
+#include "../include/utils.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <limits>
+
+namespace {
+    constexpr int NAME_BYTES = 16;
+    constexpr int SPARK_WIDTH = 60;
+    constexpr int MAX_ROWS = 20;
+
+    double per_thousand(long long now, long long prev, double ticks) {
+        return ticks > 0 ? 1000.0 * static_cast<double>(now - prev) / ticks : 0.0;
+    }
+
+    double percent(long long part, long long whole) {
+        return whole > 0 ? 100.0 * static_cast<double>(part) / static_cast<double>(whole) : 0.0;
+    }
+
+    const std::vector<MetricSpec> CATALOG = {
+        {"ready", "Procesos en la cola de listos",
+         [](const StatsSnapshot& s, const StatsSnapshot&, double) { return static_cast<double>(s.ready); }},
+        {"blocked", "Procesos bloqueados (fault, E/S, programas)",
+         [](const StatsSnapshot& s, const StatsSnapshot&, double) { return static_cast<double>(s.blocked); }},
+        {"procs", "Procesos en la tabla",
+         [](const StatsSnapshot& s, const StatsSnapshot&, double) { return static_cast<double>(s.processes); }},
+        {"cpu", "Utilización de CPU en el intervalo (%)",
+         [](const StatsSnapshot& s, const StatsSnapshot& p, double) {
+             long long busy = s.busy_ticks - p.busy_ticks;
+             return percent(busy, busy + s.idle_ticks - p.idle_ticks);
+         }},
+        {"done", "Procesos terminados por 1000 ticks",
+         [](const StatsSnapshot& s, const StatsSnapshot& p, double t) { return per_thousand(s.completed, p.completed, t); }},
+        {"faults", "Page faults por 1000 ticks",
+         [](const StatsSnapshot& s, const StatsSnapshot& p, double t) { return per_thousand(s.page_faults, p.page_faults, t); }},
+        {"fault%", "Faults por cada 100 accesos del intervalo",
+         [](const StatsSnapshot& s, const StatsSnapshot& p, double) {
+             return percent(s.page_faults - p.page_faults, s.accesses - p.accesses);
+         }},
+        {"free", "Frames libres",
+         [](const StatsSnapshot& s, const StatsSnapshot&, double) { return static_cast<double>(s.free_frames); }},
+        {"buffer", "Ocupación del buffer productor-consumidor",
+         [](const StatsSnapshot& s, const StatsSnapshot&, double) { return static_cast<double>(s.buffer_occupancy); }},
+        {"produced", "Items producidos por 1000 ticks",
+         [](const StatsSnapshot& s, const StatsSnapshot& p, double t) { return per_thousand(s.produced, p.produced, t); }},
+        {"events", "Eventos procesados por tick",
+         [](const StatsSnapshot& s, const StatsSnapshot& p, double t) {
+             return t > 0 ? static_cast<double>(s.events_processed - p.events_processed) / t : 0.0;
+         }},
+        {"resp", "Respuesta media acumulada (ticks)",
+         [](const StatsSnapshot& s, const StatsSnapshot&, double) { return s.response_mean; }},
+    };
+
+    long long level_step(SimTime every, int level) {
+        long long step = every;
+        for (int l = 0; l < level; l++) step *= MetricsSampler::FACTOR;
+        return step;
+    }
+}
+
+bool parse_sampler_option(const std::string& token, SamplerConfig& config) {
+    size_t eq = token.find('=');
+    if (eq == std::string::npos) {
+        return false;
+    }
+    std::string key = token.substr(0, eq);
+    std::string value = token.substr(eq + 1);
+    if (key == "every" || key == "cap") {
+        long long number = std::atoll(value.c_str());
+        if (number <= 0 || (key == "cap" && number > 1 << 20)) {
+            return false;
+        }
+        if (key == "every") config.every = number;
+        else config.capacity = static_cast<int>(number);
+        return true;
+    }
+    if (key == "file") {
+        config.path = value;
+        return !value.empty();
+    }
+    if (key == "metrics") {
+        std::vector<std::string> names;
+        size_t start = 0;
+        while (start <= value.size()) {
+            size_t comma = value.find(',', start);
+            std::string name = value.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+            if (MetricsSampler::find_metric(name) == nullptr) {
+                return false;
+            }
+            names.push_back(name);
+            if (comma == std::string::npos) break;
+            start = comma + 1;
+        }
+        config.metrics = names;
+        return true;
+    }
+    return false;
+}
+
+const std::vector<MetricSpec>& MetricsSampler::catalog() {
+    return CATALOG;
+}
+
+const MetricSpec* MetricsSampler::find_metric(const std::string& name) {
+    for (const auto& spec : CATALOG) {
+        if (name == spec.name) {
+            return &spec;
+        }
+    }
+    return nullptr;
+}
+
+void MetricsSampler::list_metrics() {
+    print_header("MÉTRICAS MUESTREABLES");
+    for (const auto& spec : CATALOG) {
+        std::cout << "  " << std::left << std::setw(10) << spec.name << spec.description << std::endl;
+    }
+    std::cout << std::right << std::endl;
+}
+
+MetricsSampler::MetricsSampler(SimulationKernel& kernel, Source source, const SamplerConfig& config)
+    : kernel_(kernel),
+      source_(std::move(source)),
+      config_(config),
+      blocks_written_(0),
+      bytes_written_(0),
+      sample_seconds_(0) {
+    for (const auto& name : config_.metrics) {
+        if (const MetricSpec* spec = find_metric(name)) {
+            metrics_.push_back(spec);
+        }
+    }
+    size_t capacity = static_cast<size_t>(config_.capacity);
+    for (Level& level : levels_) {
+        level.times.assign(capacity, 0);
+        level.values.assign(metrics_.size() * 3 * capacity, 0.0f);
+        level.sum.assign(metrics_.size(), 0.0);
+        level.min.assign(metrics_.size(), 0.0f);
+        level.max.assign(metrics_.size(), 0.0f);
+    }
+    previous_ = source_();
+
+    if (!config_.path.empty()) {
+        file_.open(config_.path, std::ios::binary | std::ios::trunc);
+        if (file_) {
+            SampleFileHeader header{};
+            std::memcpy(header.magic, "KSIMSTS1", sizeof(header.magic));
+            header.version = 1;
+            header.metric_count = static_cast<uint32_t>(metrics_.size());
+            header.period = config_.every;
+            header.levels = LEVELS;
+            header.factor = FACTOR;
+            file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (const MetricSpec* spec : metrics_) {
+                char name[NAME_BYTES] = {};
+                std::strncpy(name, spec->name, NAME_BYTES - 1);
+                file_.write(name, NAME_BYTES);
+            }
+            bytes_written_ = static_cast<long long>(sizeof(header) + metrics_.size() * NAME_BYTES);
+            file_.flush();
+        }
+    }
+
+    static std::atomic<long long> next_generation{0};
+    generation_ = ++next_generation;
+    kernel_.on(EventType::SAMPLE, [this](const Event& e) { handle_sample(e); });
+    kernel_.schedule(kernel_.now() + config_.every, EventType::SAMPLE, -1, generation_);
+}
+
+MetricsSampler::~MetricsSampler() {
+    kernel_.on(EventType::SAMPLE, nullptr);
+    flush();
+}
+
+int MetricsSampler::slot_of(const Level& level, int age) const {
+    return (level.head - level.size + age + 2 * config_.capacity) % config_.capacity;
+}
+
+void MetricsSampler::handle_sample(const Event& event) {
+    if (event.data != generation_) {
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+
+    StatsSnapshot snapshot = source_();
+    double ticks = static_cast<double>(snapshot.sim_time - previous_.sim_time);
+    std::vector<float> values(metrics_.size());
+    for (size_t m = 0; m < metrics_.size(); m++) {
+        values[m] = static_cast<float>(metrics_[m]->compute(snapshot, previous_, ticks));
+    }
+    previous_ = snapshot;
+    push(0, event.time, values.data(), values.data(), values.data());
+    kernel_.schedule(event.time + config_.every, EventType::SAMPLE, -1, generation_);
+
+    sample_seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void MetricsSampler::push(int index, SimTime time, const float* mean, const float* min, const float* max) {
+    Level& level = levels_[index];
+    int slot = level.head;
+    level.times[slot] = time;
+    for (size_t m = 0; m < metrics_.size(); m++) {
+        cell(level, m, MEAN, slot) = mean[m];
+        cell(level, m, MIN, slot) = min[m];
+        cell(level, m, MAX, slot) = max[m];
+    }
+    level.head = (level.head + 1) % config_.capacity;
+    level.size = std::min(level.size + 1, config_.capacity);
+    level.points++;
+    if (file_) {
+        level.unwritten++;
+        if (level.unwritten == std::min(BLOCK_ROWS, config_.capacity)) {
+            write_block(index, level.unwritten);
+        }
+    }
+
+    // Cada FACTOR puntos forman uno del nivel siguiente
+    if (index + 1 >= LEVELS) {
+        return;
+    }
+    if (level.pending == 0) {
+        std::fill(level.sum.begin(), level.sum.end(), 0.0);
+        std::fill(level.min.begin(), level.min.end(), std::numeric_limits<float>::max());
+        std::fill(level.max.begin(), level.max.end(), std::numeric_limits<float>::lowest());
+    }
+    for (size_t m = 0; m < metrics_.size(); m++) {
+        level.sum[m] += mean[m];
+        level.min[m] = std::min(level.min[m], min[m]);
+        level.max[m] = std::max(level.max[m], max[m]);
+    }
+    if (++level.pending == FACTOR) {
+        level.pending = 0;
+        std::vector<float> averages(metrics_.size());
+        for (size_t m = 0; m < metrics_.size(); m++) {
+            averages[m] = static_cast<float>(level.sum[m] / FACTOR);
+        }
+        push(index + 1, time, averages.data(), level.min.data(), level.max.data());
+    }
+}
+
+void MetricsSampler::write_block(int index, int rows) {
+    Level& level = levels_[index];
+    int first = slot_of(level, level.size - rows);
+
+    SampleBlockHeader header{};
+    header.level = static_cast<uint32_t>(index);
+    header.rows = static_cast<uint32_t>(rows);
+    header.first_time = level.times[first];
+    header.step = level_step(config_.every, index);
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // Columnas completas, una tras otra; el anillo puede dar la vuelta en medio
+    int stats = index == 0 ? 1 : 3;
+    int head_rows = std::min(rows, config_.capacity - first);
+    for (size_t m = 0; m < metrics_.size(); m++) {
+        for (int stat = 0; stat < stats; stat++) {
+            const float* column = &level.values[(m * 3 + stat) * config_.capacity];
+            file_.write(reinterpret_cast<const char*>(column + first), sizeof(float) * head_rows);
+            file_.write(reinterpret_cast<const char*>(column), sizeof(float) * (rows - head_rows));
+        }
+    }
+    file_.flush();
+
+    bytes_written_ += static_cast<long long>(sizeof(header) + sizeof(float) * rows * stats * metrics_.size());
+    blocks_written_++;
+    level.unwritten = 0;
+}
+
+void MetricsSampler::flush() {
+    if (!file_) {
+        return;
+    }
+    for (int index = 0; index < LEVELS; index++) {
+        if (levels_[index].unwritten > 0) {
+            write_block(index, levels_[index].unwritten);
+        }
+    }
+}
+
+void MetricsSampler::display(int index) const {
+    const Level& level = levels_[index];
+    long long step = level_step(config_.every, index);
+    print_header("HISTORIA DE MÉTRICAS (×" + std::to_string(step / config_.every) + ")");
+    if (level.size == 0) {
+        std::cout << " Sin puntos todavía en este nivel (uno cada " << step << " ticks)" << std::endl << std::endl;
+        return;
+    }
+
+    std::cout << " Un punto cada " << step << " ticks, " << level.size << " en memoria: t="
+              << level.times[slot_of(level, 0)] << ".." << level.times[slot_of(level, level.size - 1)] << std::endl;
+    std::cout << "\n " << std::left << std::setw(10) << "Métrica" << std::right << std::setw(11) << "Mín"
+              << std::setw(10) << "Media" << std::setw(11) << "Máx" << std::setw(11) << "Último"
+              << "  Historia (media)" << std::endl;
+    print_separator(51 + SPARK_WIDTH);
+
+    const char* bars[] = {"▁", "▂", "▃", "▄", "▅", "▆", "▇", "█"};
+    int width = std::min(level.size, SPARK_WIDTH);
+    std::cout << std::fixed << std::setprecision(2);
+    for (size_t m = 0; m < metrics_.size(); m++) {
+        // Columnas del sparkline: media de las medias de cada tramo del anillo
+        std::vector<double> buckets(static_cast<size_t>(width), 0.0);
+        double low = std::numeric_limits<double>::max();
+        double high = std::numeric_limits<double>::lowest();
+        double sum = 0;
+        for (int b = 0; b < width; b++) {
+            int from = b * level.size / width;
+            int to = (b + 1) * level.size / width;
+            for (int age = from; age < to; age++) {
+                buckets[b] += cell(level, m, MEAN, slot_of(level, age));
+            }
+            buckets[b] /= std::max(1, to - from);
+        }
+        for (int age = 0; age < level.size; age++) {
+            int slot = slot_of(level, age);
+            low = std::min<double>(low, cell(level, m, MIN, slot));
+            high = std::max<double>(high, cell(level, m, MAX, slot));
+            sum += cell(level, m, MEAN, slot);
+        }
+        double spark_low = *std::min_element(buckets.begin(), buckets.end());
+        double spark_high = *std::max_element(buckets.begin(), buckets.end());
+
+        std::string spark;
+        for (double value : buckets) {
+            int bar = spark_high > spark_low ? static_cast<int>((value - spark_low) / (spark_high - spark_low) * 7.999) : 0;
+            spark.append(bars[bar]);
+        }
+        std::cout << " " << std::left << std::setw(9) << metrics_[m]->name << std::right
+                  << std::setw(10) << low << std::setw(10) << sum / level.size << std::setw(10) << high
+                  << std::setw(10) << cell(level, m, MEAN, slot_of(level, level.size - 1))
+                  << "  " << spark << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+void MetricsSampler::display_stats() const {
+    print_header("MUESTREADOR DE MÉTRICAS");
+
+    size_t bytes = 0;
+    for (const Level& level : levels_) {
+        bytes += level.times.size() * sizeof(SimTime) + level.values.size() * sizeof(float);
+    }
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << " Período:               " << config_.every << " ticks" << std::endl;
+    std::cout << " Métricas:              ";
+    for (size_t m = 0; m < metrics_.size(); m++) {
+        std::cout << (m ? ", " : "") << metrics_[m]->name;
+    }
+    std::cout << std::endl;
+    std::cout << " Anillos:               " << LEVELS << " niveles × " << config_.capacity << " puntos ("
+              << bytes / 1024.0 << " KB fijos)" << std::endl;
+    for (int index = 0; index < LEVELS; index++) {
+        const Level& level = levels_[index];
+        long long step = level_step(config_.every, index);
+        std::cout << "  " << (index + 1 < LEVELS ? "├─" : "└─") << " ×" << std::left << std::setw(4)
+                  << step / config_.every << std::right << std::setw(9) << level.points << " puntos, "
+                  << level.size << " en memoria (" << level.size * step << " ticks)" << std::endl;
+    }
+    long long samples = levels_[0].points;
+    std::cout << " Costo por muestra:     "
+              << (samples > 0 ? sample_seconds_ * 1e9 / samples : 0.0) << " ns" << std::endl;
+    if (config_.path.empty()) {
+        std::cout << " Archivo:               ninguno" << std::endl;
+    } else {
+        std::cout << " Archivo:               " << config_.path << (file_ ? "" : " (ERROR de escritura)")
+                  << std::endl;
+        std::cout << "  └─ " << blocks_written_ << " bloques, " << bytes_written_ << " bytes";
+        if (samples > 0) {
+            std::cout << " (" << static_cast<double>(bytes_written_) / samples << " por muestra cruda)";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+bool read_sample_file(const std::string& path, int level, const std::string& csv) {
+    std::ifstream in(path, std::ios::binary);
+    SampleFileHeader header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, "KSIMSTS1", sizeof(header.magic)) != 0 || header.version != 1) {
+        std::cout << Color::RED << "Error: " << path << " no es un archivo de muestras" << Color::RESET << std::endl;
+        return false;
+    }
+    std::vector<std::string> names;
+    for (uint32_t m = 0; m < header.metric_count; m++) {
+        char name[NAME_BYTES];
+        in.read(name, NAME_BYTES);
+        names.emplace_back(name, strnlen(name, NAME_BYTES));
+    }
+
+    // Columnas del nivel pedido: media y, si agrega, mínimo y máximo
+    int stats = level == 0 ? 1 : 3;
+    std::vector<SimTime> times;
+    std::vector<std::vector<float>> columns(names.size() * stats);
+    std::vector<long long> blocks(header.levels, 0);
+    SampleBlockHeader block{};
+    std::vector<float> buffer;
+    while (in.read(reinterpret_cast<char*>(&block), sizeof(block))) {
+        int block_stats = block.level == 0 ? 1 : 3;
+        buffer.resize(static_cast<size_t>(block.rows) * block_stats * names.size());
+        if (!in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size() * sizeof(float)))) {
+            break;                      // Bloque incompleto: el muestreador sigue escribiendo
+        }
+        if (block.level < header.levels) {
+            blocks[block.level]++;
+        }
+        if (static_cast<int>(block.level) != level) {
+            continue;
+        }
+        for (uint32_t row = 0; row < block.rows; row++) {
+            times.push_back(block.first_time + static_cast<SimTime>(row) * block.step);
+        }
+        for (size_t c = 0; c < columns.size(); c++) {
+            const float* column = buffer.data() + c * block.rows;
+            columns[c].insert(columns[c].end(), column, column + block.rows);
+        }
+    }
+
+    if (!csv.empty()) {
+        std::ofstream out(csv, std::ios::trunc);
+        if (!out) {
+            std::cout << Color::RED << "Error: no se pudo escribir " << csv << Color::RESET << std::endl;
+            return false;
+        }
+        out << "tiempo";
+        for (const auto& name : names) {
+            out << "," << name;
+            if (stats == 3) out << "," << name << "_min," << name << "_max";
+        }
+        out << "\n";
+        for (size_t row = 0; row < times.size(); row++) {
+            out << times[row];
+            for (size_t c = 0; c < columns.size(); c++) {
+                out << "," << columns[c][row];
+            }
+            out << "\n";
+        }
+        std::cout << Color::GREEN << "[MUESTRAS] " << times.size() << " filas del nivel ×"
+                  << level_step(1, level) << " → " << csv << Color::RESET << std::endl;
+        return true;
+    }
+
+    print_header("ARCHIVO DE MUESTRAS");
+    std::cout << " Archivo:               " << path << std::endl;
+    std::cout << " Período:               " << header.period << " ticks, " << names.size() << " métricas" << std::endl;
+    std::cout << " Bloques por nivel:    ";
+    for (uint32_t l = 0; l < header.levels; l++) {
+        std::cout << " ×" << level_step(1, static_cast<int>(l)) << "=" << blocks[l];
+    }
+    std::cout << std::endl;
+    std::cout << " Nivel ×" << level_step(1, level) << ":             " << times.size() << " puntos (medias)" << std::endl;
+    if (times.empty()) {
+        std::cout << std::endl;
+        return true;
+    }
+
+    std::cout << "\n " << std::right << std::setw(10) << "t";
+    for (const auto& name : names) {
+        std::cout << std::setw(10) << name;
+    }
+    std::cout << std::endl;
+    print_separator(11 + 10 * static_cast<int>(names.size()));
+    size_t stride = (times.size() + MAX_ROWS - 1) / MAX_ROWS;
+    std::cout << std::fixed << std::setprecision(2);
+    for (size_t row = 0; row < times.size(); row++) {
+        if (row % stride != 0 && row + 1 != times.size()) {
+            continue;
+        }
+        std::cout << " " << std::setw(10) << times[row];
+        for (size_t m = 0; m < names.size(); m++) {
+            std::cout << std::setw(10) << columns[m * stats][row];
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl;
+    return true;
+}
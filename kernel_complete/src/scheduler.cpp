@@ -1,66 +1,449 @@
 #include "../include/scheduler.hpp"
+#include "../include/memory.hpp"
+#include "../include/workload.hpp"
+#include "../include/device.hpp"
+#include "../include/realtime.hpp"
+#include "../include/group.hpp"
+#include "../include/tuner.hpp"
+#include "../include/resource.hpp"
+#include "../include/checkpoint.hpp"
 #include "../include/utils.hpp"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
 
-RoundRobinScheduler::RoundRobinScheduler(int quantum)
+RoundRobinScheduler::RoundRobinScheduler(int quantum, SimulationKernel* kernel)
     : quantum_(quantum),
       current_quantum_(0),
-      current_process_(nullptr),
+      slice_quantum_(quantum),
+      running_pid_(-1),
       next_pid_(1),
-      current_time_(0) {
+      verbose_(true),
+      active_processes_(0),
+      blocked_count_(0),
+      io_blocked_count_(0),
+      resource_blocked_count_(0),
+      kernel_(kernel),
+      slice_in_flight_(false),
+      event_mode_(false),
+      arrival_source_(nullptr),
+      stream_pending_(false),
+      memory_(nullptr),
+      references_(nullptr),
+      fault_service_time_(0),
+      refs_per_tick_(1),
+      devices_(nullptr),
+      realtime_(nullptr),
+      groups_(nullptr),
+      resources_(nullptr),
+      tuner_(nullptr),
+      switch_cost_(0),
+      switch_left_(0),
+      last_pid_(-1),
+      switches_(0),
+      switch_ticks_(0),
+      busy_ticks_(0),
+      idle_ticks_(0),
+      paging_idle_ticks_(0),
+      io_idle_ticks_(0),
+      fault_blocks_(0),
+      mpl_sum_(0),
+      live_programs_(0),
+      program_sleeping_(0),
+      program_resumes_(0),
+      program_ops_{} {
+    
+    if (kernel_ == nullptr) {
+        own_kernel_ = std::make_unique<SimulationKernel>();
+        kernel_ = own_kernel_.get();
+    }
+    
+    // Eventos que atiende el scheduler
+    kernel_->on(EventType::ARRIVAL, [this](const Event& e) {
+        create_process(static_cast<int>(e.data));
+    });
+    kernel_->on(EventType::STREAM_ARRIVAL, [this](const Event& e) {
+        stream_pending_ = false;
+        create_process(static_cast<int>(e.data));
+        pull_next_arrival();
+    });
+    kernel_->on(EventType::SLICE_END, [this](const Event& e) { handle_slice_end(e); });
+    kernel_->on(EventType::FAULT_SERVICE, [this](const Event& e) { handle_fault_service(e); });
+    kernel_->on(EventType::PROGRAM_WAKE, [this](const Event& e) { handle_program_wake(e); });
+}
+
+void RoundRobinScheduler::enable_paging(MemoryManager* memory, WorkloadGenerator* references,
+                                        int fault_service_time, int refs_per_tick) {
+    memory_ = memory;
+    references_ = references;
+    fault_service_time_ = fault_service_time;
+    refs_per_tick_ = refs_per_tick;
+    memory_->attach_clock(kernel_);
+    
+    // Los procesos existentes heredan el espacio de direcciones de la carga
+    int pages = references_->get_config().pages_per_process;
+    table_.set_address_space_all(pages);
+    
+    if (verbose_) {
+        std::cout << Color::GREEN << "[CPU+MEM] Modo acoplado activo (fault="
+                  << fault_service_time << " ticks, refs/tick=" << refs_per_tick << ")"
+                  << Color::RESET << std::endl;
+    }
+}
+
+void RoundRobinScheduler::disable_paging() {
+    // Los faults pendientes se siguen sirviendo por eventos del kernel
+    if (memory_ != nullptr) {
+        memory_->attach_clock(nullptr);
+    }
+    memory_ = nullptr;
+    references_ = nullptr;
+}
+
+void RoundRobinScheduler::enable_io(DeviceManager* devices) {
+    devices_ = devices;
+    devices_->set_wake_callback([this](int pid) { handle_io_completion(pid); });
+    
+    for (int pid = 1; pid <= table_.size(); pid++) {
+        // Los programas emiten su propia E/S
+        Process proc = table_.get(pid);
+        if (proc.get_state() != ProcessState::TERMINATED && !is_program(pid)) {
+            proc.set_cpu_until_io(devices_->draw_cpu_burst());
+        }
+    }
+}
+
+void RoundRobinScheduler::disable_io() {
+    devices_ = nullptr;
+    
+    // Sin dispositivos nadie va a interrumpir: liberar a los que esperan E/S
+    for (int pid = 1; pid <= table_.size(); pid++) {
+        Process proc = table_.get(pid);
+        proc.set_cpu_until_io(0);
+        if (proc.is_waiting_io()) {
+            proc.set_waiting_io(false);
+            io_blocked_count_--;
+            if (proc.get_state() == ProcessState::BLOCKED) {
+                wake(pid);
+            }
+        }
+    }
+}
+
+void RoundRobinScheduler::enable_resources(ResourceManager* resources) {
+    disable_resources();
+    resources_ = resources;
+    resources_->set_grant_callback([this](int pid) { handle_resource_grant(pid); });
+}
+
+void RoundRobinScheduler::disable_resources() {
+    if (resources_ == nullptr) {
+        return;
+    }
+    // Sin gestor nadie va a conceder: liberar a los que esperan un recurso
+    for (int pid = 1; pid <= table_.size(); pid++) {
+        if (table_.get(pid).get_state() == ProcessState::BLOCKED && resources_->is_waiting(pid)) {
+            resource_blocked_count_--;
+            make_ready(pid);
+        }
+    }
+    resources_->set_grant_callback(nullptr);
+    resources_ = nullptr;
 }
 
 void RoundRobinScheduler::create_process(int burst_time) {
-    auto process = std::make_shared<Process>(next_pid_++, burst_time);
-    process->set_state(ProcessState::READY);
-    process->set_arrival_time(current_time_);
-    processes_.push_back(process);
-    ready_queue_.push(process);
-    
-    std::cout << Color::GREEN << "[t=" << current_time_ << "] "
-              << "Proceso P" << process->get_pid() 
-              << " creado (burst=" << burst_time << ")" 
-              << Color::RESET << std::endl;
+    int pid = table_.add(burst_time, now());
+    next_pid_ = pid + 1;
+    Process process = table_.get(pid);
+    if (references_ != nullptr) {
+        process.set_address_space(references_->get_config().pages_per_process);
+    }
+    if (devices_ != nullptr) {
+        process.set_cpu_until_io(devices_->draw_cpu_burst());
+    }
+    make_ready(pid);
+    active_processes_++;
+    
+    if (verbose_) {
+        std::cout << Color::GREEN << "[t=" << now() << "] "
+                  << "Proceso P" << pid 
+                  << " creado (burst=" << burst_time << ")" 
+                  << Color::RESET << std::endl;
+    }
+}
+
+int RoundRobinScheduler::fork_process(int pid) {
+    // El frame de una corrutina no se puede duplicar
+    if (!table_.contains(pid) || is_program(pid) ||
+        table_.get(pid).get_state() == ProcessState::TERMINATED) {
+        return -1;
+    }
+    Process parent = table_.get(pid);
+    create_process(parent.get_remaining_time());
+    int child = table_.size();
+    table_.get(child).set_address_space(parent.get_address_space());
+    if (groups_ != nullptr) {
+        groups_->move(child, groups_->group_of(pid), true);
+    }
+    return child;
+}
+
+void RoundRobinScheduler::submit_arrival(SimTime time, int burst_time) {
+    kernel_->schedule(time, EventType::ARRIVAL, -1, burst_time);
+}
+
+void RoundRobinScheduler::set_arrival_source(ArrivalSource* source) {
+    arrival_source_ = source;
+    pull_next_arrival();
+}
+
+void RoundRobinScheduler::pull_next_arrival() {
+    // Solo una llegada de la fuente en la cola: nada se materializa por adelantado
+    if (arrival_source_ == nullptr || stream_pending_) {
+        return;
+    }
+    SimTime time;
+    int burst;
+    if (arrival_source_->next_arrival(time, burst)) {
+        kernel_->schedule(time, EventType::STREAM_ARRIVAL, -1, burst);
+        stream_pending_ = true;
+    }
+}
+
+int RoundRobinScheduler::create_program(Program program) {
+    int pid = table_.add(0, now());
+    next_pid_ = pid + 1;
+    programs_.resize(pid);
+    programs_[pid - 1] = std::move(program);
+    active_processes_++;
+    live_programs_++;
+    
+    if (verbose_) {
+        std::cout << Color::GREEN << "[t=" << now() << "] "
+                  << "Programa P" << pid << " creado"
+                  << Color::RESET << std::endl;
+    }
+    
+    // Correr hasta la primera operación: normalmente su primera ráfaga
+    resume_program(pid);
+    return pid;
+}
+
+void RoundRobinScheduler::set_channel_capacity(int capacity) {
+    channel_.capacity = std::max(1, capacity);
+    
+    // Con más capacidad entran productores que esperaban
+    while (static_cast<int>(channel_.items.size()) < channel_.capacity) {
+        int producer = pop_waiter(channel_.waiting_producers);
+        if (producer < 0) {
+            break;
+        }
+        channel_.items.push_back(programs_[producer - 1].current().arg);
+        channel_.produced++;
+        kernel_->schedule(now(), EventType::PROGRAM_WAKE, producer);
+    }
+}
+
+void RoundRobinScheduler::resume_program(int pid) {
+    Process proc = table_.get(pid);
+    Program& program = programs_[pid - 1];
+    
+    // Las operaciones que no bloquean se atienden en el mismo instante
+    while (true) {
+        program_resumes_++;
+        if (!program.resume()) {
+            finish_process(pid);
+            return;
+        }
+        const ProgramOp& op = program.current();
+        program_ops_[static_cast<int>(op.kind)]++;
+        
+        switch (op.kind) {
+            case ProgramOpKind::COMPUTE:
+                proc.assign_burst(std::max(1, op.arg));
+                if (pid != running_pid_) {
+                    make_ready(pid);
+                }
+                return;
+            
+            case ProgramOpKind::ACCESS:
+                // Sin memoria acoplada la referencia no cuesta nada
+                if (memory_ != nullptr && !memory_->access_page(pid, op.arg)) {
+                    proc.record_page_fault();
+                    block_for_fault(pid, now() + fault_service());
+                    return;
+                }
+                break;
+            
+            case ProgramOpKind::PRODUCE: {
+                // Un consumidor en espera recibe el valor directamente
+                int consumer = pop_waiter(channel_.waiting_consumers);
+                if (consumer > 0) {
+                    programs_[consumer - 1].set_result(op.arg);
+                    channel_.produced++;
+                    channel_.consumed++;
+                    kernel_->schedule(now(), EventType::PROGRAM_WAKE, consumer);
+                } else if (static_cast<int>(channel_.items.size()) < channel_.capacity) {
+                    channel_.items.push_back(op.arg);
+                    channel_.produced++;
+                } else {
+                    channel_.waiting_producers.push_back(pid);
+                    channel_.producer_blocks++;
+                    program_wait(pid);
+                    return;
+                }
+                break;
+            }
+            
+            case ProgramOpKind::CONSUME: {
+                if (channel_.items.empty()) {
+                    channel_.waiting_consumers.push_back(pid);
+                    channel_.consumer_blocks++;
+                    program_wait(pid);
+                    return;
+                }
+                program.set_result(channel_.items.front());
+                channel_.items.pop_front();
+                channel_.consumed++;
+                
+                // El primer productor en espera ocupa el hueco y despierta
+                int producer = pop_waiter(channel_.waiting_producers);
+                if (producer > 0) {
+                    channel_.items.push_back(programs_[producer - 1].current().arg);
+                    channel_.produced++;
+                    kernel_->schedule(now(), EventType::PROGRAM_WAKE, producer);
+                }
+                break;
+            }
+            
+            case ProgramOpKind::IO:
+                if (devices_ != nullptr) {
+                    block_for_io(pid);
+                    return;
+                }
+                // Sin discos la E/S es una espera fija
+                [[fallthrough]];
+            
+            case ProgramOpKind::SLEEP:
+            default:
+                program_wait(pid);
+                kernel_->schedule(now() + std::max(1, op.arg), EventType::PROGRAM_WAKE, pid);
+                return;
+        }
+    }
+}
+
+void RoundRobinScheduler::program_wait(int pid) {
+    block(pid);
+    program_sleeping_++;
+    
+    if (verbose_) {
+        std::cout << Color::BLUE << "[t=" << now() << "] "
+                  << "P" << pid << " BLOCKED en "
+                  << Program::op_to_string(programs_[pid - 1].current().kind)
+                  << Color::RESET << std::endl;
+    }
+}
+
+int RoundRobinScheduler::pop_waiter(std::deque<int>& waiters) {
+    // Los programas matados mientras esperaban se descartan aquí
+    while (!waiters.empty()) {
+        int pid = waiters.front();
+        waiters.pop_front();
+        if (is_program(pid)) {
+            return pid;
+        }
+    }
+    return -1;
+}
+
+void RoundRobinScheduler::handle_program_wake(const Event& event) {
+    int pid = event.pid;
+    if (!is_program(pid) || table_.get(pid).get_state() != ProcessState::BLOCKED) {
+        return;
+    }
+    program_sleeping_--;
+    resume_program(pid);
 }
 
 void RoundRobinScheduler::tick() {
-    current_time_++;
+    // Entregar eventos del instante actual (despertares, llegadas) y avanzar el reloj
+    kernel_->advance_to(kernel_->now() + 1);
+    
+    // Un trabajo de tiempo real listo se lleva el tick; el proceso RR queda en pausa
+    if (realtime_ != nullptr && realtime_->has_ready()) {
+        mpl_sum_ += active_processes_;
+        update_wait_times();
+        busy_ticks_++;
+        realtime_->execute(1);
+        return;
+    }
     
     // Si no hay proceso en CPU, hacer dispatch
-    if (current_process_ == nullptr && !ready_queue_.empty()) {
+    if (running_pid_ < 0 && has_ready()) {
         dispatch_next();
     }
     
+    // El cambio de contexto ocupa la CPU sin avanzar al proceso
+    if (running_pid_ >= 0 && switch_left_ > 0) {
+        switch_left_--;
+        switch_ticks_++;
+        idle_ticks_++;
+        mpl_sum_ += active_processes_;
+        update_wait_times();
+        return;
+    }
+    
+    // En modo acoplado el proceso primero referencia memoria; si falla se bloquea.
+    // Los programas referencian memoria solo con sus operaciones de acceso.
+    if (running_pid_ >= 0 && memory_ != nullptr && !is_program(running_pid_) &&
+        !issue_references()) {
+        block_for_fault(running_pid_, now() + fault_service());
+    }
+    mpl_sum_ += active_processes_;
+    
+    // Los que siguen en READY esperan durante este tick
+    update_wait_times();
+    
+    if (running_pid_ < 0) {
+        account_idle(1);
+    }
+    
     // Ejecutar el proceso en CPU
-    if (current_process_ != nullptr) {
-        current_process_->execute();
+    if (running_pid_ >= 0) {
+        busy_ticks_++;
+        running().execute();
         current_quantum_++;
+        charge_group(1);
+        if (devices_ != nullptr && running().get_cpu_until_io() > 0) {
+            running().set_cpu_until_io(running().get_cpu_until_io() - 1);
+        }
         
-        // Verificar si terminó
-        if (current_process_->get_state() == ProcessState::TERMINATED) {
-            current_process_->calculate_turnaround(current_time_);
-            std::cout << Color::RED << "[t=" << current_time_ << "] "
-                      << "P" << current_process_->get_pid() << " TERMINADO"
-                      << " (TAT=" << current_process_->get_turnaround_time() << ")"
-                      << Color::RESET << std::endl;
-            current_process_ = nullptr;
-            current_quantum_ = 0;
+        // Verificar si terminó (un programa pasa a su siguiente operación)
+        if (running().get_state() == ProcessState::TERMINATED) {
+            complete_burst();
+        }
+        // Fin de la ráfaga de CPU: emitir E/S
+        else if (io_due()) {
+            block_for_io(running_pid_);
         }
+        
         // Verificar quantum expirado
-        else if (current_quantum_ >= quantum_) {
-            std::cout << Color::YELLOW << "[t=" << current_time_ << "] "
-                      << "P" << current_process_->get_pid() 
-                      << " QUANTUM EXPIRADO (restante=" 
-                      << current_process_->get_remaining_time() << ")"
-                      << Color::RESET << std::endl;
+        if (running_pid_ >= 0 && current_quantum_ >= slice_quantum_) {
+            if (verbose_) {
+                std::cout << Color::YELLOW << "[t=" << now() << "] "
+                          << "P" << running().get_pid() 
+                          << " QUANTUM EXPIRADO (restante=" 
+                          << running().get_remaining_time() << ")"
+                          << Color::RESET << std::endl;
+            }
+            preempt_current();
+        }
+        // El grupo agotó su quota: el proceso espera la recarga en READY
+        if (running_pid_ >= 0 && groups_ != nullptr && groups_->is_throttled(running_pid_)) {
             preempt_current();
         }
     }
-    
-    // Actualizar tiempos de espera
-    update_wait_times();
 }
 
 void RoundRobinScheduler::run(int n) {
@@ -73,43 +456,542 @@ void RoundRobinScheduler::run(int n) {
     }
     
     std::cout << Color::BLUE << Color::BOLD 
-              << "\n Simulación completada (t=" << current_time_ << ")\n" 
+              << "\n Simulación completada (t=" << now() << ")\n" 
               << Color::RESET << std::endl;
 }
 
+void RoundRobinScheduler::run_until(SimTime limit) {
+    // A partir de aquí la espera se mide por timestamps, no tick a tick
+    table_.mark_ready_since(now());
+    event_mode_ = true;
+    
+    while (true) {
+        // Despachar solo cuando ya no quedan eventos del instante actual
+        if (!slice_in_flight_ && kernel_->now() < limit &&
+            kernel_->next_time() > kernel_->now()) {
+            if (realtime_ != nullptr && realtime_->has_ready()) {
+                start_realtime_slice(limit);
+            } else {
+                if (running_pid_ < 0) {
+                    dispatch_next();
+                }
+                if (running_pid_ >= 0) {
+                    start_slice(limit);
+                }
+            }
+        }
+        
+        // Contabilizar de un solo golpe el intervalo hasta el próximo evento
+        SimTime next = kernel_->next_time();
+        SimTime gap = std::min(next, limit) - kernel_->now();
+        if (gap > 0) {
+            mpl_sum_ += active_processes_ * gap;
+            if (!slice_in_flight_) {
+                account_idle(gap);
+            }
+        }
+        
+        // En limit solo se cierra la porción en curso; el resto de eventos de
+        // ese instante queda para el siguiente tick, como en el modo por ticks
+        bool due = next < limit ||
+                   (next == limit && kernel_->peek().type == EventType::SLICE_END);
+        if (!due) {
+            break;
+        }
+        kernel_->step();
+    }
+    
+    kernel_->advance_to(limit);
+    flush_ready_waits();
+    event_mode_ = false;
+}
+
+void RoundRobinScheduler::start_slice(SimTime limit) {
+    // La porción se corta en limit para poder retomar luego tick a tick
+    // Un cambio de contexto pendiente va al principio de la porción
+    SimTime overhead = switch_left_;
+    SimTime budget = std::min<SimTime>({slice_quantum_ - current_quantum_,
+                                        running().get_remaining_time(),
+                                        limit - kernel_->now() - overhead});
+    if (devices_ != nullptr && running().get_cpu_until_io() > 0) {
+        budget = std::min<SimTime>(budget, running().get_cpu_until_io());
+    }
+    // Una liberación de tiempo real puede quitarle la CPU
+    if (realtime_ != nullptr) {
+        budget = std::min<SimTime>(budget, realtime_->next_release() - kernel_->now() - overhead);
+    }
+    // La porción no pasa de lo que le queda de quota a su grupo
+    if (groups_ != nullptr) {
+        budget = std::min<SimTime>(budget, groups_->slice_budget(running_pid_));
+    }
+    if (budget <= 0) {
+        // El cambio no entra antes del corte: como en el modo por ticks se
+        // cobra la parte que entra y el resto queda pendiente en switch_left_
+        SimTime cutoff = limit;
+        if (realtime_ != nullptr) {
+            cutoff = std::min<SimTime>(cutoff, realtime_->next_release());
+        }
+        SimTime partial = std::min<SimTime>(overhead, cutoff - kernel_->now());
+        if (partial <= 0) {
+            return;
+        }
+        switch_left_ -= static_cast<int>(partial);
+        switch_ticks_ += partial;
+        idle_ticks_ += partial;
+        slice_in_flight_ = true;
+        kernel_->schedule(kernel_->now() + partial, EventType::SLICE_END, running().get_pid(), 0);
+        return;
+    }
+    
+    // En modo acoplado se emiten ya las referencias de cada tick de la porción:
+    // nadie más toca la memoria mientras este proceso ocupa la CPU
+    SimTime executed = budget;
+    int faulted = 0;
+    long long service = 0;
+    if (memory_ != nullptr && !is_program(running_pid_)) {
+        for (SimTime i = 0; i < budget; i++) {
+            if (!issue_references()) {
+                executed = i;
+                faulted = 1;
+                service = fault_service();
+                break;
+            }
+        }
+    }
+    
+    switch_left_ = 0;
+    switch_ticks_ += overhead;
+    idle_ticks_ += overhead;
+    
+    // El costo del fault viaja en el evento: disco o descompresión de zswap
+    slice_in_flight_ = true;
+    kernel_->schedule(kernel_->now() + overhead + executed + faulted, EventType::SLICE_END,
+                      running().get_pid(), (service << 32) | (executed * 2 + faulted));
+}
+
+void RoundRobinScheduler::start_realtime_slice(SimTime limit) {
+    // Corre el trabajo más prioritario hasta que termine o llegue otra liberación
+    SimTime budget = realtime_->slice_budget(limit);
+    slice_in_flight_ = true;
+    kernel_->schedule(kernel_->now() + budget, EventType::SLICE_END, -1, budget);
+}
+
+void RoundRobinScheduler::handle_slice_end(const Event& event) {
+    slice_in_flight_ = false;
+    if (event.pid < 0) {
+        // Porción de tiempo real: el proceso RR en CPU no avanzó
+        busy_ticks_ += event.data;
+        realtime_->execute(event.data);
+        return;
+    }
+    int executed = static_cast<int>((event.data & 0xFFFFFFFF) / 2);
+    bool faulted = (event.data % 2) != 0;
+    int service = static_cast<int>(event.data >> 32);
+    
+    busy_ticks_ += executed;
+    running().execute(executed);
+    current_quantum_ += executed;
+    charge_group(executed);
+    if (devices_ != nullptr && running().get_cpu_until_io() > 0) {
+        running().set_cpu_until_io(running().get_cpu_until_io() - executed);
+    }
+    
+    if (faulted) {
+        // El tick del fault no hace trabajo útil
+        block_for_fault(running_pid_, now() + service);
+        account_idle(1);
+    } else if (running().get_state() == ProcessState::TERMINATED) {
+        complete_burst();
+    } else if (io_due()) {
+        block_for_io(running_pid_);
+    }
+    
+    if (running_pid_ >= 0 && current_quantum_ >= slice_quantum_) {
+        if (verbose_) {
+            std::cout << Color::YELLOW << "[t=" << now() << "] "
+                      << "P" << running().get_pid() 
+                      << " QUANTUM EXPIRADO (restante=" 
+                      << running().get_remaining_time() << ")"
+                      << Color::RESET << std::endl;
+        }
+        preempt_current();
+    }
+    if (running_pid_ >= 0 && groups_ != nullptr && groups_->is_throttled(running_pid_)) {
+        preempt_current();
+    }
+    // Si no, la porción se cortó en el límite y el proceso sigue en CPU
+}
+
+void RoundRobinScheduler::handle_fault_service(const Event& event) {
+    if (!table_.contains(event.pid)) {
+        return;
+    }
+    
+    // Un proceso matado mientras esperaba no vuelve a la cola
+    if (!blocked_by_fault(event.pid)) {
+        return;
+    }
+    blocked_count_--;
+    
+    if (verbose_) {
+        std::cout << Color::CYAN << "[t=" << now() << "] "
+                  << "P" << event.pid << " fault servido → READY"
+                  << Color::RESET << std::endl;
+    }
+    wake(event.pid);
+}
+
+bool RoundRobinScheduler::issue_references() {
+    int pid = running().get_pid();
+    
+    for (int r = 0; r < refs_per_tick_; r++) {
+        if (!memory_->access_page(pid, references_->next_page(pid))) {
+            running().record_page_fault();
+            return false;
+        }
+    }
+    return true;
+}
+
+void RoundRobinScheduler::block(int pid) {
+    table_.get(pid).set_state(ProcessState::BLOCKED);
+    if (pid == running_pid_) {
+        release_cpu(false);
+        running_pid_ = -1;
+        current_quantum_ = 0;
+    }
+}
+
+int RoundRobinScheduler::fault_service() const {
+    // Un fault servido desde el pool comprimido no va a disco
+    return memory_->last_fault_from_pool() ? memory_->get_decompress_time() : fault_service_time_;
+}
+
+void RoundRobinScheduler::block_for_fault(int pid, SimTime until) {
+    // PAGE FAULT: el proceso espera el servicio fuera de la CPU
+    block(pid);
+    blocked_count_++;
+    fault_blocks_++;
+    kernel_->schedule(until, EventType::FAULT_SERVICE, pid);
+    
+    if (verbose_) {
+        std::cout << Color::BLUE << "[t=" << now() << "] "
+                  << "P" << pid << " BLOCKED por page fault (hasta t="
+                  << until << ")"
+                  << Color::RESET << std::endl;
+    }
+}
+
+void RoundRobinScheduler::block_for_io(int pid) {
+    // Ráfaga de E/S: el proceso se bloquea hasta la interrupción del dispositivo
+    Process proc = table_.get(pid);
+    block(pid);
+    proc.set_waiting_io(true);
+    proc.record_io();
+    io_blocked_count_++;
+    
+    devices_->submit(pid);
+    if (!is_program(pid)) {
+        proc.set_cpu_until_io(devices_->draw_cpu_burst());
+    }
+    
+    if (verbose_) {
+        std::cout << Color::BLUE << "[t=" << now() << "] "
+                  << "P" << pid << " BLOCKED por E/S"
+                  << Color::RESET << std::endl;
+    }
+}
+
+bool RoundRobinScheduler::io_due() {
+    return devices_ != nullptr && !is_program(running_pid_) && running().get_cpu_until_io() == 0;
+}
+
+bool RoundRobinScheduler::blocked_by_fault(int pid) {
+    Process proc = table_.get(pid);
+    if (proc.get_state() != ProcessState::BLOCKED || proc.is_waiting_io() ||
+        (resources_ != nullptr && resources_->is_waiting(pid))) {
+        return false;
+    }
+    // Un programa bloqueado en otra operación espera un PROGRAM_WAKE
+    return !is_program(pid) || programs_[pid - 1].current().kind == ProgramOpKind::ACCESS;
+}
+
+void RoundRobinScheduler::handle_io_completion(int pid) {
+    if (!table_.contains(pid)) {
+        return;
+    }
+    Process proc = table_.get(pid);
+    if (!proc.is_waiting_io()) {
+        return;
+    }
+    proc.set_waiting_io(false);
+    io_blocked_count_--;
+    
+    // Un proceso matado mientras esperaba no vuelve a la cola
+    if (proc.get_state() != ProcessState::BLOCKED) {
+        return;
+    }
+    
+    if (verbose_) {
+        std::cout << Color::CYAN << "[t=" << now() << "] "
+                  << "P" << pid << " E/S completada → READY"
+                  << Color::RESET << std::endl;
+    }
+    wake(pid);
+}
+
+void RoundRobinScheduler::wait_for_resource(int pid) {
+    // Uno que está en la cola de listos se bloquea cuando le toca el despacho
+    if (resources_ != nullptr && pid == running_pid_ && resources_->is_waiting(pid)) {
+        block_for_resource(pid);
+    }
+}
+
+void RoundRobinScheduler::block_for_resource(int pid) {
+    block(pid);
+    resource_blocked_count_++;
+    if (verbose_) {
+        std::cout << Color::BLUE << "[t=" << now() << "] "
+                  << "P" << pid << " BLOCKED esperando un recurso"
+                  << Color::RESET << std::endl;
+    }
+}
+
+void RoundRobinScheduler::handle_resource_grant(int pid) {
+    // Si todavía estaba en la cola de listos no hay nada que despertar
+    if (!table_.contains(pid) || table_.get(pid).get_state() != ProcessState::BLOCKED) {
+        return;
+    }
+    resource_blocked_count_--;
+    if (verbose_) {
+        std::cout << Color::CYAN << "[t=" << now() << "] "
+                  << "P" << pid << " recurso concedido → READY"
+                  << Color::RESET << std::endl;
+    }
+    // Un programa sigue con la ráfaga que tenía: no se reanuda la corrutina
+    make_ready(pid);
+}
+
+bool RoundRobinScheduler::skip_on_dispatch(int pid) {
+    // Terminados con kill mientras esperaban en la cola, o que pidieron un
+    // recurso estando listos y siguen esperándolo
+    if (table_.get(pid).get_state() == ProcessState::TERMINATED) {
+        return true;
+    }
+    if (resources_ != nullptr && resources_->is_waiting(pid)) {
+        block_for_resource(pid);
+        return true;
+    }
+    return false;
+}
+
+void RoundRobinScheduler::account_idle(SimTime ticks) {
+    // CPU ociosa: se atribuye a paging o a E/S según quién está bloqueado
+    idle_ticks_ += ticks;
+    if (blocked_count_ > 0) {
+        paging_idle_ticks_ += ticks;
+    } else if (io_blocked_count_ > 0) {
+        io_idle_ticks_ += ticks;
+    }
+}
+
+void RoundRobinScheduler::finish_process(int pid) {
+    Process proc = table_.get(pid);
+    proc.set_state(ProcessState::TERMINATED);
+    proc.calculate_turnaround(now());
+    metrics_.record_completion(proc.get_burst_time(),
+                               proc.get_wait_time(),
+                               proc.get_turnaround_time());
+    if (verbose_) {
+        std::cout << Color::RED << "[t=" << now() << "] "
+                  << "P" << pid << " TERMINADO"
+                  << " (TAT=" << proc.get_turnaround_time() << ")"
+                  << Color::RESET << std::endl;
+    }
+    if (is_program(pid)) {
+        programs_[pid - 1].reset();
+        live_programs_--;
+    }
+    if (pid == running_pid_) {
+        release_cpu(false);
+        running_pid_ = -1;
+        current_quantum_ = 0;
+    }
+    active_processes_--;
+    if (resources_ != nullptr) {
+        resources_->release_all(pid);
+    }
+}
+
+void RoundRobinScheduler::complete_burst() {
+    // Un programa no termina con su ráfaga: se reanuda para la siguiente operación
+    if (is_program(running_pid_)) {
+        running().set_state(ProcessState::RUNNING);
+        resume_program(running_pid_);
+    } else {
+        finish_process(running_pid_);
+    }
+}
+
+void RoundRobinScheduler::make_ready(int pid) {
+    Process proc = table_.get(pid);
+    proc.set_state(ProcessState::READY);
+    proc.set_ready_since(now());
+    if (groups_ != nullptr) {
+        groups_->enqueue(pid);
+    } else {
+        ready_queue_.push(pid);
+    }
+}
+
+void RoundRobinScheduler::wake(int pid) {
+    // Un programa completa la operación que lo bloqueó y sigue hasta su próxima ráfaga
+    if (is_program(pid)) {
+        resume_program(pid);
+    } else {
+        make_ready(pid);
+    }
+}
+
 void RoundRobinScheduler::dispatch_next() {
-    if (!ready_queue_.empty()) {
-        current_process_ = ready_queue_.front();
-        ready_queue_.pop();
-        current_process_->set_state(ProcessState::RUNNING);
+    int pid = -1;
+    if (groups_ != nullptr) {
+        do {
+            pid = groups_->pick();
+        } while (pid >= 0 && skip_on_dispatch(pid));
+    } else {
+        while (!ready_queue_.empty() && skip_on_dispatch(ready_queue_.front())) {
+            ready_queue_.pop();
+        }
+        if (!ready_queue_.empty()) {
+            pid = ready_queue_.front();
+            ready_queue_.pop();
+        }
+    }
+    
+    if (pid >= 0) {
+        running_pid_ = pid;
+        running().set_state(ProcessState::RUNNING);
         current_quantum_ = 0;
         
-        std::cout << Color::CYAN << "[t=" << current_time_ << "] "
-                  << "DISPATCH → P" << current_process_->get_pid() 
-                  << " entra en CPU"
-                  << Color::RESET << std::endl;
+        // El tuner ajusta al cerrar cada ventana y da el quantum de la clase
+        if (tuner_ != nullptr) {
+            if (tuner_->due(now())) {
+                tuner_->update(now());
+                quantum_ = tuner_->get_quantum(QuantumTuner::INTERACTIVE);
+            }
+            slice_quantum_ = tuner_->quantum_for(pid);
+        } else {
+            slice_quantum_ = quantum_;
+        }
+        if (pid != last_pid_) {
+            switches_++;
+        }
+        switch_left_ = pid != last_pid_ ? switch_cost_ : 0;
+        last_pid_ = pid;
+        
+        if (groups_ != nullptr) {
+            groups_->record_dispatch(pid, now() - running().get_ready_since());
+        }
+        if (event_mode_) {
+            running().add_wait_time(now() - running().get_ready_since());
+        }
+        if (!running().was_dispatched()) {
+            // En modo tick el reloj ya marca el final del tick que empieza ahora
+            running().set_first_dispatch(event_mode_ ? now() : now() - 1);
+            metrics_.record_response(running().get_response_time());
+            if (tuner_ != nullptr) {
+                tuner_->record_response(running().get_response_time());
+            }
+        }
+        
+        if (verbose_) {
+            std::cout << Color::CYAN << "[t=" << now() << "] "
+                      << "DISPATCH → P" << running().get_pid() 
+                      << " entra en CPU"
+                      << Color::RESET << std::endl;
+        }
+    }
+}
+
+void RoundRobinScheduler::set_quantum(int quantum) {
+    quantum_ = quantum;
+    if (tuner_ == nullptr) {
+        slice_quantum_ = quantum;
+    }
+}
+
+void RoundRobinScheduler::release_cpu(bool preempted) {
+    // Ráfaga observada: desde el despacho hasta soltar la CPU
+    if (tuner_ != nullptr && current_quantum_ > 0) {
+        tuner_->record_burst(running_pid_, current_quantum_, preempted);
+    }
+}
+
+bool RoundRobinScheduler::has_ready() const {
+    return groups_ != nullptr ? groups_->has_ready() : !ready_queue_.empty();
+}
+
+size_t RoundRobinScheduler::get_ready_count() const {
+    return groups_ != nullptr ? groups_->ready_count() : ready_queue_.size();
+}
+
+void RoundRobinScheduler::charge_group(long long ticks) {
+    if (groups_ != nullptr && running_pid_ >= 0) {
+        groups_->charge(running_pid_, ticks);
+    }
+}
+
+void RoundRobinScheduler::enable_groups(GroupScheduler* groups) {
+    disable_groups();
+    groups_ = groups;
+    // Los que ya esperaban entran a su grupo en el mismo orden
+    while (!ready_queue_.empty()) {
+        groups_->enqueue(ready_queue_.front());
+        ready_queue_.pop();
     }
 }
 
+void RoundRobinScheduler::disable_groups() {
+    if (groups_ == nullptr) {
+        return;
+    }
+    for (int pid : groups_->drain()) {
+        ready_queue_.push(pid);
+    }
+    groups_ = nullptr;
+}
+
+bool RoundRobinScheduler::move_to_group(int pid, int group) {
+    if (groups_ == nullptr || !table_.contains(pid) || group < 0 ||
+        group >= groups_->get_group_count() ||
+        table_.get(pid).get_state() == ProcessState::TERMINATED) {
+        return false;
+    }
+    groups_->move(pid, group, table_.get(pid).get_state() == ProcessState::READY);
+    return true;
+}
+
 void RoundRobinScheduler::preempt_current() {
-    if (current_process_ != nullptr) {
-        current_process_->set_state(ProcessState::READY);
-        ready_queue_.push(current_process_);
-        current_process_ = nullptr;
+    if (running_pid_ >= 0) {
+        release_cpu(true);
+        make_ready(running_pid_);
+        running_pid_ = -1;
         current_quantum_ = 0;
     }
 }
 
 void RoundRobinScheduler::update_wait_times() {
-    for (auto& proc : processes_) {
-        if (proc->get_state() == ProcessState::READY) {
-            proc->increment_wait_time();
-        }
-    }
+    table_.increment_ready_waits();
 }
 
-void RoundRobinScheduler::list_processes() const {
-    print_header("PROCESOS (t=" + std::to_string(current_time_) + ")");
+void RoundRobinScheduler::flush_ready_waits() {
+    // Volcar la espera medida por timestamps antes de volver al modo por ticks
+    table_.flush_ready_waits(now());
+}
+
+void RoundRobinScheduler::list_processes() {
+    print_header("PROCESOS (t=" + std::to_string(now()) + ")");
     
     std::cout << std::left 
               << std::setw(6) << "PID"
@@ -121,8 +1003,8 @@ void RoundRobinScheduler::list_processes() const {
               << std::endl;
     print_separator(60);
     
-    for (const auto& proc : processes_) {
-        proc->print_info();
+    for (int pid = 1; pid <= table_.size(); pid++) {
+        table_.get(pid).print_info();
     }
     std::cout << std::endl;
 }
@@ -130,29 +1012,22 @@ void RoundRobinScheduler::list_processes() const {
 void RoundRobinScheduler::show_stats() const {
     print_header("ESTADÍSTICAS DE SCHEDULER");
     
-    int total_wait = 0;
-    int total_turnaround = 0;
-    int completed = 0;
-    int running = 0;
-    int ready = 0;
+    // Reducciones sobre arreglos contiguos
+    auto counts = table_.count_states();
+    int completed = counts[static_cast<int>(ProcessState::TERMINATED)];
+    int running = counts[static_cast<int>(ProcessState::RUNNING)];
+    int ready = counts[static_cast<int>(ProcessState::READY)];
+    int blocked = counts[static_cast<int>(ProcessState::BLOCKED)];
+    long long total_wait = completed > 0 ? table_.sum_terminated_wait() : 0;
+    long long total_turnaround = completed > 0 ? table_.sum_terminated_turnaround() : 0;
     
-    for (const auto& proc : processes_) {
-        if (proc->get_state() == ProcessState::TERMINATED) {
-            total_wait += proc->get_wait_time();
-            total_turnaround += proc->get_turnaround_time();
-            completed++;
-        } else if (proc->get_state() == ProcessState::RUNNING) {
-            running++;
-        } else if (proc->get_state() == ProcessState::READY) {
-            ready++;
-        }
-    }
-    
-    std::cout << " Tiempo actual:         " << current_time_ << std::endl;
-    std::cout << " Quantum:               " << quantum_ << std::endl;
-    std::cout << " Procesos totales:      " << processes_.size() << std::endl;
+    std::cout << " Tiempo actual:         " << now() << std::endl;
+    std::cout << " Quantum:               " << quantum_ << (tuner_ ? " (ajustado por el tuner)" : "")
+              << std::endl;
+    std::cout << " Procesos totales:      " << table_.size() << std::endl;
     std::cout << "  ├─ En ejecución:      " << running << std::endl;
     std::cout << "  ├─ Listos (READY):    " << ready << std::endl;
+    std::cout << "  ├─ Bloqueados:        " << blocked << std::endl;
     std::cout << "  └─ Terminados:        " << completed << std::endl;
     
     if (completed > 0) {
@@ -163,21 +1038,40 @@ void RoundRobinScheduler::show_stats() const {
         std::cout << "   └─ Turnaround promedio: " 
                   << (double)total_turnaround / completed << " unidades" << std::endl;
     }
+    metrics_.display();
     std::cout << std::endl;
 }
 
 void RoundRobinScheduler::kill_process(int pid) {
-    auto it = std::find_if(processes_.begin(), processes_.end(),
-                          [pid](const auto& p) { return p->get_pid() == pid; });
-    
-    if (it != processes_.end()) {
-        (*it)->set_state(ProcessState::TERMINATED);
-        (*it)->calculate_turnaround(current_time_);
+    if (table_.contains(pid)) {
+        Process proc = table_.get(pid);
+        if (proc.get_state() == ProcessState::BLOCKED && resources_ != nullptr &&
+            resources_->is_waiting(pid)) {
+            resource_blocked_count_--;
+        } else if (blocked_by_fault(pid)) {
+            blocked_count_--;
+        } else if (is_program(pid) && proc.get_state() == ProcessState::BLOCKED &&
+                   !proc.is_waiting_io()) {
+            program_sleeping_--;
+        }
+        if (is_program(pid)) {
+            // Liberar el frame: las colas del buffer lo descartan al llegar su turno
+            programs_[pid - 1].reset();
+            live_programs_--;
+        }
+        if (proc.get_state() != ProcessState::TERMINATED) {
+            active_processes_--;
+        }
+        proc.set_state(ProcessState::TERMINATED);
+        proc.calculate_turnaround(now());
         
-        if (current_process_ && current_process_->get_pid() == pid) {
-            current_process_ = nullptr;
+        if (running_pid_ == pid) {
+            running_pid_ = -1;
             current_quantum_ = 0;
         }
+        if (resources_ != nullptr) {
+            resources_->release_all(pid);
+        }
         
         std::cout << Color::RED << "[KILL] Proceso P" << pid 
                   << " terminado forzosamente" << Color::RESET << std::endl;
@@ -186,3 +1080,209 @@ void RoundRobinScheduler::kill_process(int pid) {
                   << " no encontrado" << Color::RESET << std::endl;
     }
 }
+
+void RoundRobinScheduler::show_program_stats() const {
+    print_header("PROGRAMAS (t=" + std::to_string(now()) + ")");
+    
+    FramePool::Stats pool = FramePool::stats();
+    std::cout << " Programas vivos:       " << live_programs_ << std::endl;
+    std::cout << "  ├─ Esperando:         " << program_sleeping_ << " (sleep o buffer)" << std::endl;
+    std::cout << "  └─ Reanudaciones:     " << program_resumes_ << std::endl;
+    
+    std::cout << "\n Operaciones cedidas:" << std::endl;
+    for (int k = 0; k < static_cast<int>(ProgramOpKind::COUNT); k++) {
+        std::cout << "   " << (k + 1 < static_cast<int>(ProgramOpKind::COUNT) ? "├─ " : "└─ ")
+                  << std::left << std::setw(10) << Program::op_to_string(static_cast<ProgramOpKind>(k))
+                  << std::right << program_ops_[k] << std::endl;
+    }
+    
+    std::cout << "\n Buffer compartido:" << std::endl;
+    std::cout << "   ├─ Ocupación:          " << channel_.items.size() << " / " << channel_.capacity << std::endl;
+    std::cout << "   ├─ Producidos:         " << channel_.produced << std::endl;
+    std::cout << "   ├─ Consumidos:         " << channel_.consumed << std::endl;
+    std::cout << "   └─ Bloqueos prod/cons: " << channel_.producer_blocks << " / "
+              << channel_.consumer_blocks << std::endl;
+    
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\n Frames de corrutina:" << std::endl;
+    std::cout << "   ├─ Entregados:         " << pool.allocations << " ("
+              << (pool.allocations > 0 ? 100.0 * pool.reused / pool.allocations : 0.0)
+              << "% reutilizados)" << std::endl;
+    std::cout << "   ├─ En uso:             " << pool.live << std::endl;
+    std::cout << "   └─ Reservado:          " << pool.reserved_bytes / 1024 << " KB" << std::endl;
+    std::cout << std::endl;
+}
+
+void RoundRobinScheduler::show_utilization_stats() const {
+    print_header("UTILIZACIÓN DE CPU (t=" + std::to_string(now()) + ")");
+    
+    long long total = busy_ticks_ + idle_ticks_;
+    long long total_faults = table_.sum_page_faults();
+    long long total_io = table_.sum_io_count();
+    int completed = table_.count_states()[static_cast<int>(ProcessState::TERMINATED)];
+    long long total_turnaround = table_.sum_terminated_turnaround();
+    
+    std::cout << " Modo acoplado:         " << (memory_ ? "ACTIVO" : "INACTIVO") << std::endl;
+    if (memory_) {
+        std::cout << "  ├─ Servicio de fault:  " << fault_service_time_ << " ticks" << std::endl;
+        std::cout << "  └─ Referencias/tick:   " << refs_per_tick_ << std::endl;
+    }
+    std::cout << " E/S:                   " << (devices_ ? "ACTIVA" : "INACTIVA") << std::endl;
+    
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\n Utilización de CPU:" << std::endl;
+    std::cout << "   ├─ Ticks útiles:       " << busy_ticks_ << " ("
+              << (total > 0 ? 100.0 * busy_ticks_ / total : 0.0) << "%)" << std::endl;
+    std::cout << "   ├─ Ticks ociosos:      " << idle_ticks_ << std::endl;
+    std::cout << "   ├─ Perdidos por paging: " << paging_idle_ticks_ << " ("
+              << (total > 0 ? 100.0 * paging_idle_ticks_ / total : 0.0) << "%)" << std::endl;
+    std::cout << "   └─ Esperando E/S:      " << io_idle_ticks_ << " ("
+              << (total > 0 ? 100.0 * io_idle_ticks_ / total : 0.0) << "%)" << std::endl;
+    if (switch_cost_ > 0 || switch_ticks_ > 0) {
+        std::cout << "\n Cambios de contexto:   " << switches_ << " × " << switch_cost_ << " ticks = "
+                  << switch_ticks_ << " (" << (total > 0 ? 100.0 * switch_ticks_ / total : 0.0)
+                  << "%, cuentan como ociosos)" << std::endl;
+    }
+    
+    std::cout << "\n Paginación:" << std::endl;
+    std::cout << "   ├─ Bloqueos por fault: " << fault_blocks_ << std::endl;
+    std::cout << "   ├─ Faults por proceso: " << total_faults << std::endl;
+    std::cout << "   ├─ Bloqueados ahora:   " << blocked_count_ << std::endl;
+    std::cout << "   └─ MPL promedio:       "
+              << (total > 0 ? (double)mpl_sum_ / total : 0.0) << std::endl;
+    
+    std::cout << "\n E/S y throughput:" << std::endl;
+    std::cout << "   ├─ Ráfagas de E/S:     " << total_io << std::endl;
+    std::cout << "   ├─ Esperando E/S ahora: " << io_blocked_count_ << std::endl;
+    std::cout << "   ├─ Throughput:         "
+              << (now() > 0 ? 1000.0 * completed / now() : 0.0) << " procesos/1000 ticks" << std::endl;
+    std::cout << "   └─ Turnaround promedio: "
+              << (completed > 0 ? (double)total_turnaround / completed : 0.0) << " ticks" << std::endl;
+    
+    // Thrashing: más de la mitad del tiempo perdido esperando faults
+    if (total > 0 && paging_idle_ticks_ * 2 > total) {
+        std::cout << Color::RED << "\n THRASHING: reducir la multiprogramación o agregar frames"
+                  << Color::RESET << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+namespace {
+    struct SchedulerImage {
+        int quantum;
+        int current_quantum;
+        int running_pid;
+        int next_pid;
+        int active_processes;
+        int blocked_count;
+        int io_blocked_count;
+        int slice_in_flight;
+        int stream_pending;
+        int paging;
+        int fault_service_time;
+        int refs_per_tick;
+        long long busy_ticks;
+        long long idle_ticks;
+        long long paging_idle_ticks;
+        long long io_idle_ticks;
+        long long fault_blocks;
+        long long mpl_sum;
+        int slice_quantum;
+        int switch_cost;
+        int switch_left;
+        int last_pid;
+        long long switches;
+        long long switch_ticks;
+    };
+}
+
+void RoundRobinScheduler::save_state(CheckpointWriter& writer) const {
+    SchedulerImage image{quantum_, current_quantum_, get_running_pid(), next_pid_,
+                         active_processes_, blocked_count_, io_blocked_count_,
+                         slice_in_flight_ ? 1 : 0, stream_pending_ ? 1 : 0,
+                         memory_ != nullptr ? 1 : 0, fault_service_time_, refs_per_tick_,
+                         busy_ticks_, idle_ticks_, paging_idle_ticks_, io_idle_ticks_,
+                         fault_blocks_, mpl_sum_, slice_quantum_, switch_cost_, switch_left_,
+                         last_pid_, switches_, switch_ticks_};
+    writer.add_one(CheckpointSection::SCHEDULER, image);
+
+    std::vector<ProcessImage> table;
+    table.reserve(table_.size());
+    for (int pid = 1; pid <= table_.size(); pid++) {
+        table.push_back(table_.get_image(pid));
+    }
+    writer.add_vector(CheckpointSection::PROCESSES, table);
+
+    // La cola de listos se guarda como PIDs en orden de atención
+    std::vector<int> ready;
+    std::queue<int> copy = ready_queue_;
+    while (!copy.empty()) {
+        ready.push_back(copy.front());
+        copy.pop();
+    }
+    writer.add_vector(CheckpointSection::READY_QUEUE, ready);
+    writer.add_one(CheckpointSection::SCHED_METRICS, metrics_);
+    kernel_->save_state(writer);
+}
+
+std::unique_ptr<RoundRobinScheduler> RoundRobinScheduler::from_checkpoint(const CheckpointReader& reader,
+                                                                          bool& paging) {
+    SchedulerImage image;
+    size_t process_count, ready_count;
+    const ProcessImage* table = reader.records<ProcessImage>(CheckpointSection::PROCESSES, process_count);
+    const int* ready = reader.records<int>(CheckpointSection::READY_QUEUE, ready_count);
+    if (!reader.read_one(CheckpointSection::SCHEDULER, image) || table == nullptr || ready == nullptr ||
+        image.quantum <= 0 || image.slice_quantum <= 0 || image.switch_cost < 0 ||
+        image.switch_left < 0) {
+        return nullptr;
+    }
+
+    auto scheduler = std::make_unique<RoundRobinScheduler>(image.quantum);
+    if (!scheduler->kernel_->load_state(reader) ||
+        !reader.read_one(CheckpointSection::SCHED_METRICS, scheduler->metrics_)) {
+        return nullptr;
+    }
+
+    // PID n vive en la posición n-1 de la tabla
+    scheduler->table_.reserve(process_count);
+    for (size_t i = 0; i < process_count; i++) {
+        // El estado indexa los contadores de count_states
+        if (table[i].pid != static_cast<int>(i) + 1 ||
+            table[i].state < 0 || table[i].state >= ProcessTable::STATE_COUNT) {
+            return nullptr;
+        }
+        scheduler->table_.add_image(table[i]);
+    }
+    for (size_t i = 0; i < ready_count; i++) {
+        if (!scheduler->table_.contains(ready[i])) return nullptr;
+        scheduler->ready_queue_.push(ready[i]);
+    }
+    if (image.running_pid != -1 && !scheduler->table_.contains(image.running_pid)) {
+        return nullptr;
+    }
+    scheduler->running_pid_ = image.running_pid;
+
+    scheduler->current_quantum_ = image.current_quantum;
+    scheduler->slice_quantum_ = image.slice_quantum;
+    scheduler->next_pid_ = image.next_pid;
+    scheduler->active_processes_ = image.active_processes;
+    scheduler->blocked_count_ = image.blocked_count;
+    scheduler->io_blocked_count_ = image.io_blocked_count;
+    scheduler->slice_in_flight_ = image.slice_in_flight != 0;
+    scheduler->stream_pending_ = image.stream_pending != 0;
+    scheduler->fault_service_time_ = image.fault_service_time;
+    scheduler->refs_per_tick_ = image.refs_per_tick;
+    scheduler->busy_ticks_ = image.busy_ticks;
+    scheduler->idle_ticks_ = image.idle_ticks;
+    scheduler->paging_idle_ticks_ = image.paging_idle_ticks;
+    scheduler->io_idle_ticks_ = image.io_idle_ticks;
+    scheduler->fault_blocks_ = image.fault_blocks;
+    scheduler->mpl_sum_ = image.mpl_sum;
+    scheduler->switch_cost_ = image.switch_cost;
+    scheduler->switch_left_ = image.switch_left;
+    scheduler->last_pid_ = image.last_pid;
+    scheduler->switches_ = image.switches;
+    scheduler->switch_ticks_ = image.switch_ticks;
+    paging = image.paging != 0;
+    return scheduler;
+}
@@ -0,0 +1,191 @@
+#include "../include/simulation.hpp"
+#include "../include/checkpoint.hpp"
+#include "../include/utils.hpp"
+#include <iostream>
+#include <algorithm>
+
+void EventQueue::push(const Event& event) {
+    int index;
+    if (!free_nodes_.empty()) {
+        index = free_nodes_.back();
+        free_nodes_.pop_back();
+        nodes_[index] = {event, -1, -1};
+    } else {
+        index = static_cast<int>(nodes_.size());
+        nodes_.push_back({event, -1, -1});
+    }
+    root_ = meld(root_, index);
+    size_++;
+}
+
+int EventQueue::meld(int a, int b) {
+    if (a == -1) return b;
+    if (b == -1) return a;
+    if (earlier(nodes_[b].event, nodes_[a].event)) {
+        std::swap(a, b);
+    }
+    // b pasa a ser el primer hijo de a
+    nodes_[b].sibling = nodes_[a].child;
+    nodes_[a].child = b;
+    return a;
+}
+
+void EventQueue::pop() {
+    if (root_ == -1) return;
+
+    int old_root = root_;
+    int child = nodes_[old_root].child;
+    free_nodes_.push_back(old_root);
+    size_--;
+
+    // Primera pasada: fusionar hijos de a pares, izquierda a derecha
+    scratch_.clear();
+    while (child != -1) {
+        int first = child;
+        int second = nodes_[first].sibling;
+        child = second == -1 ? -1 : nodes_[second].sibling;
+        nodes_[first].sibling = -1;
+        if (second != -1) nodes_[second].sibling = -1;
+        scratch_.push_back(meld(first, second));
+    }
+
+    // Segunda pasada: fusionar de derecha a izquierda
+    int result = -1;
+    for (auto it = scratch_.rbegin(); it != scratch_.rend(); ++it) {
+        result = meld(result, *it);
+    }
+    root_ = result;
+}
+
+void EventQueue::clear() {
+    nodes_.clear();
+    free_nodes_.clear();
+    root_ = -1;
+    size_ = 0;
+}
+
+std::vector<Event> EventQueue::snapshot() const {
+    std::vector<Event> events;
+    events.reserve(size_);
+    std::vector<int> stack;
+    if (root_ != -1) stack.push_back(root_);
+    while (!stack.empty()) {
+        int node = stack.back();
+        stack.pop_back();
+        events.push_back(nodes_[node].event);
+        if (nodes_[node].child != -1) stack.push_back(nodes_[node].child);
+        if (nodes_[node].sibling != -1) stack.push_back(nodes_[node].sibling);
+    }
+    return events;
+}
+
+namespace {
+    struct KernelImage {
+        SimTime now;
+        long long next_seq;
+        long long events_processed;
+        uint64_t peak_pending;
+    };
+}
+
+SimulationKernel::SimulationKernel()
+    : now_(0),
+      next_seq_(0),
+      events_processed_(0),
+      peak_pending_(0),
+      observe_every_(1),
+      since_observe_(0) {
+}
+
+void SimulationKernel::schedule(SimTime at, EventType type, int pid, long long data) {
+    pending_.push({std::max(at, now_), next_seq_++, type, pid, data});
+    peak_pending_ = std::max(peak_pending_, pending_.size());
+}
+
+void SimulationKernel::on(EventType type, Handler handler) {
+    handlers_[static_cast<size_t>(type)] = std::move(handler);
+}
+
+void SimulationKernel::set_observer(std::function<void()> observer, long long every) {
+    observer_ = std::move(observer);
+    observe_every_ = std::max(1LL, every);
+    since_observe_ = 0;
+}
+
+bool SimulationKernel::step() {
+    if (pending_.empty()) {
+        return false;
+    }
+
+    Event event = pending_.top();
+    pending_.pop();
+    now_ = event.time;
+    events_processed_++;
+
+    const Handler& handler = handlers_[static_cast<size_t>(event.type)];
+    if (handler) {
+        handler(event);
+    }
+    notify();
+    return true;
+}
+
+void SimulationKernel::run_until(SimTime limit) {
+    while (!pending_.empty() && pending_.top().time <= limit) {
+        step();
+    }
+    now_ = std::max(now_, limit);
+}
+
+void SimulationKernel::advance_to(SimTime time) {
+    while (!pending_.empty() && pending_.top().time < time) {
+        step();
+    }
+    now_ = std::max(now_, time);
+    notify();
+}
+
+void SimulationKernel::display_stats() const {
+    print_header("NÚCLEO DE EVENTOS DISCRETOS");
+
+    std::cout << " Reloj virtual:         " << now_ << std::endl;
+    std::cout << " Eventos procesados:    " << events_processed_ << std::endl;
+    std::cout << "  ├─ Pendientes:        " << pending_.size() << std::endl;
+    std::cout << "  └─ Pico pendientes:   " << peak_pending_ << std::endl;
+    std::cout << "\nCola de eventos:       Pairing heap (tiempo, tipo, FIFO en empates)" << std::endl;
+    std::cout << std::endl;
+}
+
+void SimulationKernel::save_state(CheckpointWriter& writer) const {
+    KernelImage image{now_, next_seq_, events_processed_, peak_pending_};
+    writer.add_one(CheckpointSection::KERNEL, image);
+    writer.add_vector(CheckpointSection::EVENTS, pending_.snapshot());
+}
+
+bool SimulationKernel::load_state(const CheckpointReader& reader) {
+    KernelImage image;
+    size_t count;
+    const Event* events = reader.records<Event>(CheckpointSection::EVENTS, count);
+    if (!reader.read_one(CheckpointSection::KERNEL, image) || events == nullptr) {
+        return false;
+    }
+    now_ = image.now;
+    next_seq_ = image.next_seq;
+    events_processed_ = image.events_processed;
+    peak_pending_ = image.peak_pending;
+
+    // El tipo indexa la tabla de handlers: se valida antes de tocar la cola
+    for (size_t i = 0; i < count; i++) {
+        int type = static_cast<int>(events[i].type);
+        if (type < 0 || type >= static_cast<int>(EventType::COUNT)) {
+            return false;
+        }
+    }
+
+    // Se conserva la secuencia original: el orden de desempate no cambia
+    pending_.clear();
+    for (size_t i = 0; i < count; i++) {
+        pending_.push(events[i]);
+    }
+    return true;
+}
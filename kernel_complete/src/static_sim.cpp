@@ -0,0 +1,247 @@
+#include "../include/static_sim.hpp"
+#include "../include/scheduler.hpp"
+#include "../include/memory.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+using namespace static_sim;
+
+template class StaticSimulator<RoundRobin, FifoReplacement, NullSink, StatsLevel::COUNTERS>;
+template class StaticSimulator<RoundRobin, LruReplacement, NullSink, StatsLevel::COUNTERS>;
+template class StaticSimulator<RoundRobin, ClockReplacement, NullSink, StatsLevel::COUNTERS>;
+template class StaticSimulator<RoundRobin, LruReplacement, NullSink, StatsLevel::FULL>;
+template class StaticSimulator<RoundRobin, LruReplacement, RingSink<1024>, StatsLevel::FULL>;
+template class StaticSimulator<RoundRobin, LruReplacement, ConsoleSink, StatsLevel::FULL>;
+template class StaticSimulator<RoundRobin, NoPaging, NullSink, StatsLevel::NONE>;
+template class StaticSimulator<Fcfs, NoPaging, NullSink, StatsLevel::COUNTERS>;
+template class StaticSimulator<ShortestJob, LruReplacement, NullSink, StatsLevel::FULL>;
+
+namespace {
+    template <class Sched, class Repl, class Sink, StatsLevel LEVEL>
+    StaticResult run_config(const StaticParams& params) {
+        StaticSimulator<Sched, Repl, Sink, LEVEL> simulator(params);
+        return simulator.run();
+    }
+
+    // El anillo se muestra al terminar: es lo único que guarda
+    StaticResult run_ring(const StaticParams& params) {
+        StaticSimulator<RoundRobin, LruReplacement, RingSink<1024>, StatsLevel::FULL> simulator(params);
+        StaticResult result = simulator.run();
+        simulator.get_sink().display();
+        return result;
+    }
+
+    template <class Sched, class Repl, class Sink, StatsLevel LEVEL>
+    constexpr StaticConfig entry(const char* name, StaticResult (*run)(const StaticParams&)) {
+        return StaticConfig{name, Sched::NAME, Repl::NAME, Sink::NAME, LEVEL, run};
+    }
+
+    template <class Sched, class Repl, class Sink, StatsLevel LEVEL>
+    constexpr StaticConfig entry(const char* name) {
+        return entry<Sched, Repl, Sink, LEVEL>(name, &run_config<Sched, Repl, Sink, LEVEL>);
+    }
+
+    const std::vector<StaticConfig> CONFIGS = {
+        entry<RoundRobin, FifoReplacement, NullSink, StatsLevel::COUNTERS>("rr-fifo"),
+        entry<RoundRobin, LruReplacement, NullSink, StatsLevel::COUNTERS>("rr-lru"),
+        entry<RoundRobin, ClockReplacement, NullSink, StatsLevel::COUNTERS>("rr-clock"),
+        entry<RoundRobin, LruReplacement, NullSink, StatsLevel::FULL>("rr-lru-full"),
+        entry<RoundRobin, LruReplacement, RingSink<1024>, StatsLevel::FULL>("rr-lru-ring", &run_ring),
+        entry<RoundRobin, LruReplacement, ConsoleSink, StatsLevel::FULL>("rr-lru-trace"),
+        entry<RoundRobin, NoPaging, NullSink, StatsLevel::NONE>("rr-cpu"),
+        entry<Fcfs, NoPaging, NullSink, StatsLevel::COUNTERS>("fcfs-cpu"),
+        entry<ShortestJob, LruReplacement, NullSink, StatsLevel::FULL>("sjf-lru-full"),
+    };
+
+    // Una corrida del scheduler general con los mismos parámetros
+    struct GeneralRun {
+        long long completed;
+        long long page_faults;
+        long long accesses;
+        double seconds;
+    };
+
+    GeneralRun run_general(const StaticParams& params, bool paging, ReplacementPolicy policy) {
+        SimulationKernel kernel;
+        RoundRobinScheduler scheduler(params.quantum, &kernel);
+        scheduler.set_verbose(false);
+        WorkloadGenerator workload(params.workload);
+        std::unique_ptr<MemoryManager> memory;
+        if (paging) {
+            memory = std::make_unique<MemoryManager>(params.frames, policy, false);
+            scheduler.enable_paging(memory.get(), &workload, params.fault_service, params.refs_per_tick);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        scheduler.set_arrival_source(&workload);
+        scheduler.run_until(params.ticks);
+        scheduler.set_arrival_source(nullptr);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        GeneralRun run{};
+        run.completed = static_cast<long long>(scheduler.get_metrics().completed());
+        run.page_faults = memory ? memory->get_page_faults() : 0;
+        run.accesses = memory ? memory->get_total_accesses() : 0;
+        run.seconds = seconds;
+        return run;
+    }
+
+    void print_bench_row(const std::string& label, double seconds, double baseline, SimTime ticks,
+                         long long completed, long long faults, long long accesses) {
+        std::cout << std::fixed << std::setprecision(2) << std::left << "   "
+                  << std::setw(22) << label << std::right
+                  << std::setw(10) << seconds * 1e9 / ticks
+                  << std::setw(9);
+        if (baseline > 0) {
+            std::cout << baseline / std::max(seconds, 1e-9);
+        } else {
+            std::cout << "-";
+        }
+        std::cout << std::setw(12) << completed
+                  << std::setw(10) << (accesses > 0 ? 100.0 * faults / accesses : 0.0) << std::endl;
+    }
+}
+
+const char* static_sim::trace_kind_to_string(TraceKind kind) {
+    switch (kind) {
+        case TraceKind::ARRIVAL: return "LLEGADA";
+        case TraceKind::DISPATCH: return "DISPATCH";
+        case TraceKind::PREEMPT: return "QUANTUM";
+        case TraceKind::FAULT: return "FAULT";
+        case TraceKind::WAKE: return "DESPIERTA";
+        case TraceKind::FINISH: return "TERMINADO";
+        default: return "?";
+    }
+}
+
+void ConsoleSink::record(SimTime time, TraceKind kind, int pid, long long data) {
+    const std::string& color = kind == TraceKind::FINISH ? Color::RED
+                             : kind == TraceKind::FAULT ? Color::YELLOW
+                             : kind == TraceKind::ARRIVAL ? Color::GREEN : Color::CYAN;
+    std::cout << color << "[t=" << time << "] " << trace_kind_to_string(kind) << " P" << pid
+              << " (" << data << ")" << Color::RESET << '\n';
+}
+
+bool parse_static_option(const std::string& token, StaticParams& params) {
+    size_t eq = token.find('=');
+    if (eq == std::string::npos) {
+        return false;
+    }
+    std::string key = token.substr(0, eq);
+    int value = std::atoi(token.c_str() + eq + 1);
+    if (value <= 0) {
+        return false;
+    }
+    if (key == "q") params.quantum = value;
+    else if (key == "frames") params.frames = value;
+    else if (key == "fault") params.fault_service = value;
+    else if (key == "refs") params.refs_per_tick = value;
+    else return false;
+    return true;
+}
+
+const std::vector<StaticConfig>& static_configs() {
+    return CONFIGS;
+}
+
+const StaticConfig* find_static_config(const std::string& name) {
+    for (const auto& config : CONFIGS) {
+        if (name == config.name) {
+            return &config;
+        }
+    }
+    return nullptr;
+}
+
+std::string stats_level_to_string(StatsLevel level) {
+    switch (level) {
+        case StatsLevel::NONE: return "ninguna";
+        case StatsLevel::COUNTERS: return "contadores";
+        case StatsLevel::FULL: return "completa";
+        default: return "UNKNOWN";
+    }
+}
+
+void list_static_configs() {
+    print_header("CONFIGURACIONES COMPILADAS");
+    std::cout << " " << std::left << std::setw(15) << "Nombre" << std::setw(8) << "Plan."
+              << std::setw(9) << "Reempl." << std::setw(10) << "Trazas" << "Estadísticas" << std::endl;
+    print_separator(56);
+    for (const auto& config : CONFIGS) {
+        std::cout << " " << std::left << std::setw(15) << config.name << std::setw(8) << config.scheduling
+                  << std::setw(9) << config.replacement << std::setw(10) << config.sink
+                  << stats_level_to_string(config.level) << std::endl;
+    }
+    std::cout << std::right << std::endl;
+}
+
+void display_static_result(const StaticConfig& config, const StaticParams& params,
+                           const StaticResult& result) {
+    std::cout << Color::BLUE << Color::BOLD << "\n▶ " << config.name << ": " << params.ticks
+              << " ticks (q=" << params.quantum << ", frames=" << params.frames << ", fault="
+              << params.fault_service << ", refs=" << params.refs_per_tick << ")"
+              << Color::RESET << std::endl;
+
+    long long total = result.busy_ticks + result.idle_ticks;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "   ├─ Llegadas:           " << result.arrivals << std::endl;
+    std::cout << "   ├─ Terminados:         " << result.completed << std::endl;
+    std::cout << "   ├─ Utilización CPU:    "
+              << (total > 0 ? 100.0 * result.busy_ticks / total : 0.0) << "%" << std::endl;
+    if (config.level != StatsLevel::NONE) {
+        std::cout << "   ├─ Despachos:          " << result.dispatches << std::endl;
+        if (result.accesses > 0) {
+            std::cout << "   ├─ Page faults:        " << result.page_faults << " ("
+                      << 100.0 * result.page_faults / result.accesses << "% de "
+                      << result.accesses << " accesos)" << std::endl;
+        }
+    }
+    if (config.level == StatsLevel::FULL) {
+        std::cout << "   ├─ Respuesta:          media " << result.response_mean
+                  << ", p99 " << result.response_p99 << std::endl;
+        std::cout << "   ├─ Turnaround:         media " << result.turnaround_mean
+                  << ", p99 " << result.turnaround_p99 << std::endl;
+        std::cout << "   ├─ Índice de Jain:     " << std::setprecision(4) << result.jain
+                  << std::setprecision(2) << std::endl;
+    }
+    std::cout << "   ├─ Tiempo real:        " << result.seconds * 1000 << " ms" << std::endl;
+    std::cout << "   └─ ns/tick:            " << result.seconds * 1e9 / params.ticks << std::endl;
+    std::cout << std::endl;
+}
+
+void run_static_bench(const StaticParams& params) {
+    std::cout << Color::BOLD << Color::BLUE << "\n▶ Núcleo compilado vs scheduler general: "
+              << params.ticks << " ticks (q=" << params.quantum << ", frames=" << params.frames
+              << ", fault=" << params.fault_service << ", refs=" << params.refs_per_tick << ")"
+              << Color::RESET << std::endl;
+    std::cout << std::left << "   " << std::setw(22) << "Configuración" << std::right
+              << std::setw(10) << "ns/tick" << std::setw(9) << "×"
+              << std::setw(12) << "Terminados" << std::setw(10) << "Faults%" << std::endl;
+
+    // Cada política del scheduler general contra sus instancias compiladas
+    struct Pair {
+        const char* label;
+        bool paging;
+        ReplacementPolicy policy;
+        std::vector<const char*> configs;
+    };
+    const std::vector<Pair> pairs = {
+        {"general RR", false, ReplacementPolicy::FIFO, {"rr-cpu"}},
+        {"general RR+FIFO", true, ReplacementPolicy::FIFO, {"rr-fifo"}},
+        {"general RR+LRU", true, ReplacementPolicy::LRU, {"rr-lru", "rr-lru-full"}},
+        {"general RR+CLOCK", true, ReplacementPolicy::CLOCK, {"rr-clock"}},
+    };
+    for (const auto& pair : pairs) {
+        GeneralRun general = run_general(params, pair.paging, pair.policy);
+        print_bench_row(pair.label, general.seconds, 0.0, params.ticks, general.completed,
+                        general.page_faults, general.accesses);
+        for (const char* name : pair.configs) {
+            const StaticConfig* config = find_static_config(name);
+            StaticResult result = config->run(params);
+            print_bench_row(std::string("  ").append(name), result.seconds, general.seconds, params.ticks,
+                            result.completed, result.page_faults, result.accesses);
+        }
+    }
+    std::cout << " (× = aceleración sobre la fila general de arriba)" << std::endl << std::endl;
+}
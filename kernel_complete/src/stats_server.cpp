@@ -0,0 +1,247 @@
+#include "../include/stats_server.hpp"
+#include "../include/scheduler.hpp"
+#include "../include/memory.hpp"
+#include "../include/sync.hpp"
+#include "../include/utils.hpp"
+#include <iostream>
+#include <sstream>
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    bool make_address(const std::string& path, sockaddr_un& address) {
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+            return false;
+        }
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        return true;
+    }
+
+    template <typename V>
+    void metric(std::ostringstream& out, const char* name, const char* type, const char* help, V value) {
+        out << "# HELP kernel_sim_" << name << ' ' << help << '\n'
+            << "# TYPE kernel_sim_" << name << ' ' << type << '\n'
+            << "kernel_sim_" << name << ' ' << value << '\n';
+    }
+}
+
+StatsServer::StatsServer()
+    : publications_(0),
+      listen_fd_(-1),
+      stopping_(false),
+      scrapes_(0),
+      read_retries_(0) {
+}
+
+StatsServer::~StatsServer() {
+    stop();
+}
+
+bool StatsServer::start(const std::string& path) {
+    stop();
+
+    sockaddr_un address;
+    if (!make_address(path, address)) {
+        error_ = "ruta de socket vacía o demasiado larga";
+        return false;
+    }
+
+    // Un socket que quedó de una corrida anterior se reemplaza; otro archivo no
+    struct stat info;
+    if (::lstat(path.c_str(), &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            error_ = std::string(path).append(" existe y no es un socket");
+            return false;
+        }
+        ::unlink(path.c_str());
+    }
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0 ||
+        ::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(fd, 16) < 0) {
+        error_ = std::strerror(errno);
+        if (fd >= 0) ::close(fd);
+        return false;
+    }
+
+    listen_fd_ = fd;
+    path_ = path;
+    error_.clear();
+    stopping_.store(false);
+    thread_ = std::thread(&StatsServer::serve, this);
+    return true;
+}
+
+void StatsServer::stop() {
+    if (listen_fd_ < 0) {
+        return;
+    }
+    stopping_.store(true);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    ::close(listen_fd_);
+    ::unlink(path_.c_str());
+    listen_fd_ = -1;
+}
+
+void StatsServer::publish(const StatsSnapshot& snapshot) {
+    StatsSnapshot stamped = snapshot;
+    stamped.publications = ++publications_;
+    snapshot_.write(stamped);
+}
+
+void StatsServer::serve() {
+    pollfd waiting{listen_fd_, POLLIN, 0};
+    while (!stopping_.load()) {
+        // Timeout corto para notar stop() sin señales
+        if (::poll(&waiting, 1, 100) <= 0) {
+            continue;
+        }
+        int client = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) {
+            continue;
+        }
+
+        StatsSnapshot snapshot;
+        read_retries_.fetch_add(snapshot_.read(snapshot), std::memory_order_relaxed);
+        std::string body = format(snapshot);
+
+        const char* data = body.data();
+        size_t left = body.size();
+        while (left > 0) {
+            ssize_t sent = ::send(client, data, left, MSG_NOSIGNAL);
+            if (sent < 0 && errno == EINTR) continue;
+            if (sent <= 0) break;
+            data += sent;
+            left -= static_cast<size_t>(sent);
+        }
+        ::close(client);
+        scrapes_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+StatsSnapshot StatsServer::capture(RoundRobinScheduler& scheduler, const MemoryManager* memory,
+                                   const ProducerConsumer* buffer) {
+    StatsSnapshot s{};
+    const SimulationKernel& kernel = scheduler.get_kernel();
+    s.sim_time = kernel.now();
+    s.events_processed = kernel.get_events_processed();
+    s.events_pending = static_cast<long long>(kernel.get_pending());
+
+    // Solo contadores O(1): nada de recorrer la tabla de procesos
+    const SchedulerMetrics& metrics = scheduler.get_metrics();
+    s.processes = scheduler.get_process_count();
+    s.ready = static_cast<long long>(scheduler.get_ready_count());
+    s.running = scheduler.get_running_pid() >= 0 ? 1 : 0;
+    s.blocked = scheduler.get_blocked_count();
+    s.completed = static_cast<long long>(metrics.completed());
+    s.busy_ticks = scheduler.get_busy_ticks();
+    s.idle_ticks = scheduler.get_idle_ticks();
+    s.response_mean = metrics.response().mean();
+    s.wait_mean = metrics.wait().mean();
+    s.turnaround_mean = metrics.turnaround().mean();
+
+    if (memory) {
+        s.memory_enabled = 1;
+        s.frames = memory->get_num_frames();
+        s.free_frames = memory->get_buddy().get_free_frames();
+        s.accesses = memory->get_total_accesses();
+        s.page_faults = memory->get_page_faults();
+        s.cow_faults = memory->get_cow_faults();
+        s.zswap_hits = memory->get_zswap_hits();
+    }
+
+    if (buffer) {
+        s.sync_enabled = 1;
+        s.buffer_capacity = buffer->get_capacity();
+        s.buffer_occupancy = buffer->get_occupancy();
+        s.produced = buffer->get_total_produced();
+        s.consumed = buffer->get_total_consumed();
+        s.producer_blocks = buffer->get_producer_blocks();
+        s.consumer_blocks = buffer->get_consumer_blocks();
+    }
+    return s;
+}
+
+std::string StatsServer::format(const StatsSnapshot& s) {
+    std::ostringstream out;
+    metric(out, "time_ticks", "gauge", "Reloj virtual", s.sim_time);
+    metric(out, "events_processed_total", "counter", "Eventos procesados por el kernel", s.events_processed);
+    metric(out, "events_pending", "gauge", "Eventos pendientes", s.events_pending);
+    metric(out, "snapshot_publications_total", "counter", "Snapshots publicados", s.publications);
+
+    metric(out, "processes_total", "counter", "Procesos creados", s.processes);
+    metric(out, "processes_ready", "gauge", "Procesos en la cola de listos", s.ready);
+    metric(out, "processes_running", "gauge", "Procesos en CPU", s.running);
+    metric(out, "processes_blocked", "gauge", "Procesos bloqueados (fault, E/S, programa)", s.blocked);
+    metric(out, "processes_completed_total", "counter", "Procesos terminados", s.completed);
+    metric(out, "cpu_busy_ticks_total", "counter", "Ticks de CPU con trabajo", s.busy_ticks);
+    metric(out, "cpu_idle_ticks_total", "counter", "Ticks de CPU ociosos", s.idle_ticks);
+    metric(out, "response_mean_ticks", "gauge", "Respuesta media", s.response_mean);
+    metric(out, "wait_mean_ticks", "gauge", "Espera media de los terminados", s.wait_mean);
+    metric(out, "turnaround_mean_ticks", "gauge", "Turnaround medio de los terminados", s.turnaround_mean);
+
+    metric(out, "memory_enabled", "gauge", "Memoria inicializada", s.memory_enabled);
+    if (s.memory_enabled) {
+        metric(out, "memory_frames", "gauge", "Frames físicos", s.frames);
+        metric(out, "memory_free_frames", "gauge", "Frames libres en el buddy", s.free_frames);
+        metric(out, "memory_accesses_total", "counter", "Accesos a memoria", s.accesses);
+        metric(out, "memory_page_faults_total", "counter", "Page faults", s.page_faults);
+        metric(out, "memory_cow_faults_total", "counter", "Fallos copy-on-write", s.cow_faults);
+        metric(out, "memory_zswap_hits_total", "counter", "Faults servidos por zswap", s.zswap_hits);
+    }
+
+    metric(out, "sync_enabled", "gauge", "Buffer productor-consumidor inicializado", s.sync_enabled);
+    if (s.sync_enabled) {
+        metric(out, "sync_buffer_capacity", "gauge", "Capacidad del buffer", s.buffer_capacity);
+        metric(out, "sync_buffer_occupancy", "gauge", "Items en el buffer", s.buffer_occupancy);
+        metric(out, "sync_produced_total", "counter", "Items producidos", s.produced);
+        metric(out, "sync_consumed_total", "counter", "Items consumidos", s.consumed);
+        metric(out, "sync_producer_blocks_total", "counter", "Bloqueos del productor", s.producer_blocks);
+        metric(out, "sync_consumer_blocks_total", "counter", "Bloqueos del consumidor", s.consumer_blocks);
+    }
+    return out.str();
+}
+
+std::string StatsServer::scrape(const std::string& path) {
+    sockaddr_un address;
+    if (!make_address(path, address)) {
+        return "";
+    }
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return "";
+    }
+    std::string body;
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0) {
+        char chunk[4096];
+        ssize_t n;
+        while ((n = ::read(fd, chunk, sizeof(chunk))) > 0 || (n < 0 && errno == EINTR)) {
+            if (n > 0) body.append(chunk, static_cast<size_t>(n));
+        }
+    }
+    ::close(fd);
+    return body;
+}
+
+void StatsServer::display_stats() const {
+    print_header("SERVIDOR DE ESTADÍSTICAS");
+
+    std::cout << " Socket:                "
+              << (is_running() ? Color::GREEN + path_ : Color::YELLOW + "detenido") << Color::RESET
+              << std::endl;
+    std::cout << " Snapshots publicados:  " << publications_ << std::endl;
+    std::cout << " Lecturas servidas:     " << scrapes_.load() << std::endl;
+    std::cout << " Reintentos de lectura: " << read_retries_.load()
+              << " (seqlock: el lector repite, la simulación no espera)" << std::endl;
+    std::cout << " Snapshot:              " << sizeof(StatsSnapshot) << " bytes" << std::endl;
+    std::cout << std::endl;
+}
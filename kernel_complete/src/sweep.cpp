@@ -0,0 +1,365 @@
+#include "../include/sweep.hpp"
+#include "../include/scheduler.hpp"
+#include "../include/simulation.hpp"
+#include "../include/utils.hpp"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <sstream>
+
+WorkStealingPool::WorkStealingPool(int threads)
+    : threads_(std::max(1, threads)),
+      steals_(0) {
+    for (int i = 0; i < threads_; i++) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+}
+
+bool WorkStealingPool::pop_local(int worker, size_t& task) {
+    WorkerQueue& queue = *queues_[worker];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(int thief, size_t& task) {
+    // Recorrer las víctimas empezando por la vecina para repartir la contención
+    for (int offset = 1; offset < threads_; offset++) {
+        WorkerQueue& victim = *queues_[(thief + offset) % threads_];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            steals_++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::run(size_t count, const std::function<void(size_t)>& task) {
+    // Reparto inicial en bloques contiguos; el robo equilibra los puntos lentos
+    for (int w = 0; w < threads_; w++) {
+        size_t begin = count * w / threads_;
+        size_t end = count * (w + 1) / threads_;
+        auto& tasks = queues_[w]->tasks;
+        tasks.clear();
+        for (size_t i = begin; i < end; i++) {
+            tasks.push_back(i);
+        }
+    }
+
+    // No se agregan tareas durante la corrida: sin trabajo propio ni robable, el hilo termina
+    auto worker = [this, &task](int id) {
+        size_t index;
+        while (pop_local(id, index) || steal(id, index)) {
+            task(index);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int w = 1; w < threads_; w++) {
+        pool.emplace_back(worker, w);
+    }
+    worker(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+SweepRunner::SweepRunner(const SweepGrid& grid)
+    : grid_(grid),
+      threads_used_(0),
+      steals_(0),
+      elapsed_(0.0) {
+
+    // Sin E/S la dimensión de disco tiene un único valor
+    std::vector<DiskPolicy> disks = grid_.disk_policies;
+    bool with_io = !disks.empty();
+    if (!with_io) {
+        disks.push_back(DiskPolicy::FCFS);
+    }
+
+    // Orden fijo de la grilla: las réplicas de una configuración quedan contiguas
+    for (int quantum : grid_.quanta) {
+        for (int frames : grid_.frames) {
+            for (int zswap : grid_.zswap) {
+                // El pool sale de la misma RAM: debe quedar al menos un frame
+                if (zswap >= frames) {
+                    continue;
+                }
+                for (ReplacementPolicy replacement : grid_.replacements) {
+                    for (DiskPolicy disk : disks) {
+                        for (int r = 0; r < grid_.replicas; r++) {
+                            points_.push_back({quantum, frames, zswap, replacement, with_io, disk, r});
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+uint64_t SweepRunner::replica_seed(uint64_t base, int replica) {
+    // Misma semilla para todas las configuraciones de una réplica (números aleatorios comunes)
+    Xoshiro256 mixer(base + 0x9E3779B97F4A7C15ULL * static_cast<uint64_t>(replica));
+    return mixer.next();
+}
+
+SweepRunner::Sample SweepRunner::simulate(const Point& point) const {
+    // Instancia completamente aislada: kernel, scheduler, memoria, carga y discos propios
+    WorkloadConfig config = grid_.workload;
+    config.seed = replica_seed(grid_.workload.seed, point.replica);
+
+    SimulationKernel kernel;
+    RoundRobinScheduler scheduler(point.quantum, &kernel);
+    scheduler.set_verbose(false);
+    MemoryManager memory(point.frames - point.zswap, point.replacement, false);
+    if (point.zswap > 0) {
+        memory.enable_zswap(point.zswap, grid_.decompress_time);
+    }
+    WorkloadGenerator workload(config);
+    scheduler.enable_paging(&memory, &workload, grid_.fault_service_time, grid_.refs_per_tick);
+
+    std::unique_ptr<DeviceManager> devices;
+    if (point.with_io) {
+        devices = std::make_unique<DeviceManager>(kernel, grid_.disks, point.disk_policy,
+                                                  grid_.cpu_between_io, config.seed, false);
+        scheduler.enable_io(devices.get());
+    }
+
+    scheduler.set_arrival_source(&workload);
+    scheduler.run_until(grid_.ticks);
+    scheduler.set_arrival_source(nullptr);
+
+    const SchedulerMetrics& metrics = scheduler.get_metrics();
+    long long total = scheduler.get_busy_ticks() + scheduler.get_idle_ticks();
+
+    Sample sample;
+    sample.completed = static_cast<double>(metrics.completed());
+    sample.throughput = 1000.0 * metrics.completed() / grid_.ticks;
+    sample.response_mean = metrics.response().mean();
+    sample.response_p99 = static_cast<double>(metrics.response().percentile(0.99));
+    sample.turnaround_mean = metrics.turnaround().mean();
+    sample.turnaround_p99 = static_cast<double>(metrics.turnaround().percentile(0.99));
+    sample.cpu_utilization = total > 0 ? 100.0 * scheduler.get_busy_ticks() / total : 0.0;
+    sample.fault_rate = memory.get_fault_rate() * 100.0;
+    sample.pool_hit_rate = memory.get_pool_hit_rate() * 100.0;
+    sample.jain = metrics.jain_index();
+    sample.events = static_cast<double>(kernel.get_events_processed());
+    return sample;
+}
+
+void SweepRunner::run(int threads) {
+    samples_.assign(points_.size(), Sample{});
+
+    auto start = std::chrono::steady_clock::now();
+    WorkStealingPool pool(threads);
+    pool.run(points_.size(), [this](size_t i) { samples_[i] = simulate(points_[i]); });
+    elapsed_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    threads_used_ = pool.get_threads();
+    steals_ = pool.get_steals();
+    aggregate();
+}
+
+void SweepRunner::aggregate() {
+    // Promedios en orden de índice: mismo resultado con cualquier cantidad de hilos
+    rows_.clear();
+    int replicas = grid_.replicas;
+    for (size_t first = 0; first < points_.size(); first += replicas) {
+        const Point& p = points_[first];
+        SweepRow row{p.quantum, p.frames, p.zswap, p.replacement, p.with_io, p.disk_policy,
+                     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+        for (int r = 0; r < replicas; r++) {
+            const Sample& s = samples_[first + r];
+            row.completed += s.completed;
+            row.throughput += s.throughput;
+            row.response_mean += s.response_mean;
+            row.response_p99 += s.response_p99;
+            row.turnaround_mean += s.turnaround_mean;
+            row.turnaround_p99 += s.turnaround_p99;
+            row.cpu_utilization += s.cpu_utilization;
+            row.fault_rate += s.fault_rate;
+            row.pool_hit_rate += s.pool_hit_rate;
+            row.jain += s.jain;
+            row.events += s.events;
+        }
+        for (double* field : {&row.completed, &row.throughput, &row.response_mean,
+                              &row.response_p99, &row.turnaround_mean, &row.turnaround_p99,
+                              &row.cpu_utilization, &row.fault_rate, &row.pool_hit_rate,
+                              &row.jain, &row.events}) {
+            *field /= replicas;
+        }
+        rows_.push_back(row);
+    }
+}
+
+bool SweepRunner::write_csv(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    out << "quantum,frames,zswap,replacement,disk,replicas,completed,throughput,"
+           "response_mean,response_p99,turnaround_mean,turnaround_p99,"
+           "cpu_utilization,fault_rate,pool_hit_rate,jain,events\n";
+    out << std::fixed << std::setprecision(4);
+    for (const auto& row : rows_) {
+        out << row.quantum << ',' << row.frames << ',' << row.zswap << ','
+            << MemoryManager::policy_to_string(row.replacement) << ','
+            << (row.with_io ? DeviceManager::policy_to_string(row.disk_policy) : "none") << ','
+            << grid_.replicas << ',' << row.completed << ',' << row.throughput << ','
+            << row.response_mean << ',' << row.response_p99 << ','
+            << row.turnaround_mean << ',' << row.turnaround_p99 << ','
+            << row.cpu_utilization << ',' << row.fault_rate << ','
+            << row.pool_hit_rate << ',' << row.jain << ',' << row.events << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+bool SweepRunner::write_json(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    out << std::fixed << std::setprecision(4);
+    out << "{\n  \"ticks\": " << grid_.ticks
+        << ",\n  \"seed\": " << grid_.workload.seed
+        << ",\n  \"replicas\": " << grid_.replicas
+        << ",\n  \"rows\": [\n";
+    for (size_t i = 0; i < rows_.size(); i++) {
+        const SweepRow& row = rows_[i];
+        out << "    {\"quantum\": " << row.quantum
+            << ", \"frames\": " << row.frames
+            << ", \"zswap\": " << row.zswap
+            << ", \"replacement\": \"" << MemoryManager::policy_to_string(row.replacement) << '"'
+            << ", \"disk\": \""
+            << (row.with_io ? DeviceManager::policy_to_string(row.disk_policy) : "none") << '"'
+            << ", \"completed\": " << row.completed
+            << ", \"throughput\": " << row.throughput
+            << ", \"response_mean\": " << row.response_mean
+            << ", \"response_p99\": " << row.response_p99
+            << ", \"turnaround_mean\": " << row.turnaround_mean
+            << ", \"turnaround_p99\": " << row.turnaround_p99
+            << ", \"cpu_utilization\": " << row.cpu_utilization
+            << ", \"fault_rate\": " << row.fault_rate
+            << ", \"pool_hit_rate\": " << row.pool_hit_rate
+            << ", \"jain\": " << row.jain
+            << ", \"events\": " << row.events << '}'
+            << (i + 1 < rows_.size() ? "," : "") << '\n';
+    }
+    out << "  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+void SweepRunner::display_summary() const {
+    print_header("BARRIDO DE PARÁMETROS");
+
+    double total_events = 0.0;
+    for (const auto& sample : samples_) {
+        total_events += sample.events;
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << " Puntos simulados:      " << points_.size()
+              << " (" << rows_.size() << " configuraciones × " << grid_.replicas << " réplicas)" << std::endl;
+    std::cout << " Ticks por punto:       " << grid_.ticks << std::endl;
+    std::cout << " Hilos:                 " << threads_used_ << std::endl;
+    std::cout << "  └─ Robos de trabajo:  " << steals_ << std::endl;
+    std::cout << " Tiempo real:           " << elapsed_ * 1000 << " ms" << std::endl;
+    std::cout << " Puntos/seg:            " << (elapsed_ > 0 ? points_.size() / elapsed_ : 0.0) << std::endl;
+    std::cout << " Eventos/seg:           "
+              << (elapsed_ > 0 ? total_events / elapsed_ / 1e6 : 0.0) << " M" << std::endl;
+
+    // Mejor configuración por throughput (el p99 solo es comparable entre iguales)
+    auto best = std::max_element(rows_.begin(), rows_.end(),
+                                 [](const SweepRow& a, const SweepRow& b) {
+                                     return a.throughput < b.throughput;
+                                 });
+    if (best != rows_.end()) {
+        std::cout << Color::GREEN << "\n Mayor throughput: " << best->throughput
+                  << " procesos/1000 ticks, p99 turnaround " << best->turnaround_p99
+                  << " (q=" << best->quantum << ", frames=" << best->frames
+                  << (best->zswap > 0 ? ", zswap=" + std::to_string(best->zswap) : "")
+                  << ", " << MemoryManager::policy_to_string(best->replacement)
+                  << (best->with_io ? ", " + DeviceManager::policy_to_string(best->disk_policy) : "")
+                  << ")" << Color::RESET << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+bool parse_sweep_option(const std::string& token, SweepGrid& grid, int& threads) {
+    size_t eq = token.find('=');
+    if (eq == std::string::npos) {
+        return false;
+    }
+    std::string key = token.substr(0, eq);
+    std::vector<std::string> values;
+    std::stringstream list(token.substr(eq + 1));
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        if (!item.empty()) values.push_back(item);
+    }
+    if (values.empty()) {
+        return false;
+    }
+
+    auto to_ints = [&values](std::vector<int>& out) {
+        out.clear();
+        for (const auto& v : values) {
+            int n = std::atoi(v.c_str());
+            if (n <= 0) return false;
+            out.push_back(n);
+        }
+        return true;
+    };
+
+    std::vector<int> numbers;
+    if (key == "q") return to_ints(grid.quanta);
+    if (key == "frames") return to_ints(grid.frames);
+    if (key == "zswap") {
+        // 0 = sin pool, para comparar contra la misma RAM sin comprimir
+        grid.zswap.clear();
+        for (const auto& v : values) {
+            int n = std::atoi(v.c_str());
+            if (n < 0 || (n == 0 && v != "0")) return false;
+            grid.zswap.push_back(n);
+        }
+        return true;
+    }
+    if (key == "repl") {
+        grid.replacements.clear();
+        for (const auto& v : values) {
+            ReplacementPolicy policy;
+            if (!MemoryManager::parse_policy(v, policy)) return false;
+            grid.replacements.push_back(policy);
+        }
+        return true;
+    }
+    if (key == "disk") {
+        grid.disk_policies.clear();
+        for (const auto& v : values) {
+            DiskPolicy policy;
+            if (!DeviceManager::parse_policy(v, policy)) return false;
+            grid.disk_policies.push_back(policy);
+        }
+        return true;
+    }
+    if (!to_ints(numbers) || numbers.size() != 1) {
+        return false;
+    }
+    if (key == "reps") grid.replicas = numbers[0];
+    else if (key == "threads") threads = numbers[0];
+    else if (key == "fault") grid.fault_service_time = numbers[0];
+    else if (key == "decomp") grid.decompress_time = numbers[0];
+    else if (key == "refs") grid.refs_per_tick = numbers[0];
+    else return false;
+    return true;
+}
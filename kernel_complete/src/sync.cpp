@@ -1,13 +1,16 @@
 #include "../include/sync.hpp"
+#include "../include/checkpoint.hpp"
 #include "../include/utils.hpp"
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
-ProducerConsumer::ProducerConsumer(int buffer_size)
+ProducerConsumer::ProducerConsumer(int buffer_size, bool verbose)
     : buffer_size_(buffer_size),
       count_(0),
       in_(0),
       out_(0),
+      closed_(false),
       total_produced_(0),
       total_consumed_(0),
       producer_blocks_(0),
@@ -15,6 +18,9 @@ ProducerConsumer::ProducerConsumer(int buffer_size)
     
     buffer_.resize(buffer_size, -1);
     
+    if (!verbose) {
+        return;
+    }
     std::cout << Color::GREEN << "[SYNC] Buffer inicializado (tamaño=" 
               << buffer_size << ")" << Color::RESET << std::endl;
 }
@@ -80,6 +86,77 @@ bool ProducerConsumer::consume(int& item) {
     return true;
 }
 
+void ProducerConsumer::put_batch(const int* items, int n) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    int done = 0;
+    while (done < n) {
+        if (count_ >= buffer_size_) {
+            producer_blocks_++;
+            not_full_.wait(lock, [this] { return count_ < buffer_size_; });
+        }
+        // Todo lo que entre de una vez, en tramos contiguos del buffer circular
+        int chunk = std::min(n - done, buffer_size_ - count_);
+        for (int i = 0; i < chunk; i++) {
+            buffer_[in_] = items[done + i];
+            in_ = in_ + 1 == buffer_size_ ? 0 : in_ + 1;
+        }
+        count_ += chunk;
+        total_produced_ += chunk;
+        done += chunk;
+        not_empty_.notify_all();
+    }
+}
+
+int ProducerConsumer::take_batch(int* items, int max) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (count_ == 0 && !closed_) {
+        consumer_blocks_++;
+        not_empty_.wait(lock, [this] { return count_ > 0 || closed_; });
+    }
+    int taken = std::min(max, count_);
+    for (int i = 0; i < taken; i++) {
+        items[i] = buffer_[out_];
+        out_ = out_ + 1 == buffer_size_ ? 0 : out_ + 1;
+    }
+    count_ -= taken;
+    total_consumed_ += taken;
+    if (taken > 0) {
+        not_full_.notify_all();
+    }
+    return taken;
+}
+
+void ProducerConsumer::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    not_empty_.notify_all();
+}
+
+int ProducerConsumer::get_occupancy() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return count_;
+}
+
+int ProducerConsumer::get_total_produced() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return total_produced_;
+}
+
+int ProducerConsumer::get_total_consumed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return total_consumed_;
+}
+
+int ProducerConsumer::get_producer_blocks() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return producer_blocks_;
+}
+
+int ProducerConsumer::get_consumer_blocks() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return consumer_blocks_;
+}
+
 void ProducerConsumer::display_buffer() const {
     std::lock_guard<std::mutex> lock(mutex_);
     
@@ -172,6 +249,7 @@ void ProducerConsumer::reset() {
     count_ = 0;
     in_ = 0;
     out_ = 0;
+    closed_ = false;
     total_produced_ = 0;
     total_consumed_ = 0;
     producer_blocks_ = 0;
@@ -184,3 +262,48 @@ void ProducerConsumer::reset() {
     std::cout << Color::CYAN << "[SYNC] Buffer reiniciado" 
               << Color::RESET << std::endl;
 }
+
+namespace {
+    struct BufferImage {
+        int buffer_size;
+        int count;
+        int in;
+        int out;
+        int total_produced;
+        int total_consumed;
+        int producer_blocks;
+        int consumer_blocks;
+    };
+}
+
+void ProducerConsumer::save_state(CheckpointWriter& writer) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    BufferImage image{buffer_size_, count_, in_, out_, total_produced_, total_consumed_,
+                      producer_blocks_, consumer_blocks_};
+    writer.add_one(CheckpointSection::BUFFER, image);
+    writer.add_vector(CheckpointSection::BUFFER_ITEMS, buffer_);
+}
+
+std::unique_ptr<ProducerConsumer> ProducerConsumer::from_checkpoint(const CheckpointReader& reader) {
+    BufferImage image;
+    size_t count;
+    const int* items = reader.records<int>(CheckpointSection::BUFFER_ITEMS, count);
+    if (!reader.read_one(CheckpointSection::BUFFER, image) || items == nullptr ||
+        image.buffer_size <= 0 || count != static_cast<size_t>(image.buffer_size) ||
+        image.count < 0 || image.count > image.buffer_size ||
+        image.in < 0 || image.in >= image.buffer_size ||
+        image.out < 0 || image.out >= image.buffer_size ||
+        (image.out + image.count) % image.buffer_size != image.in) {
+        return nullptr;
+    }
+    auto pc = std::make_unique<ProducerConsumer>(image.buffer_size);
+    pc->buffer_.assign(items, items + count);
+    pc->count_ = image.count;
+    pc->in_ = image.in;
+    pc->out_ = image.out;
+    pc->total_produced_ = image.total_produced;
+    pc->total_consumed_ = image.total_consumed;
+    pc->producer_blocks_ = image.producer_blocks;
+    pc->consumer_blocks_ = image.consumer_blocks;
+    return pc;
+}
@@ -0,0 +1,359 @@
+#include "../include/trace.hpp"
+#include "../include/utils.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <cctype>
+#include <climits>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+    // Cursor de campos sobre una línea: SWF separa por espacios o tabs
+    // (varios seguidos cuentan como uno), CSV por comas
+    class FieldCursor {
+    public:
+        FieldCursor(std::string_view line, TraceFormat format) : rest_(line), csv_(format == TraceFormat::CSV) {}
+
+        bool next(std::string_view& field) {
+            if (csv_) {
+                if (done_) return false;
+                size_t comma = rest_.find(',');
+                field = trim(rest_.substr(0, comma));
+                if (comma == std::string_view::npos) {
+                    done_ = true;
+                } else {
+                    rest_.remove_prefix(comma + 1);
+                }
+                return true;
+            }
+            size_t start = rest_.find_first_not_of(" \t");
+            if (start == std::string_view::npos) return false;
+            rest_.remove_prefix(start);
+            size_t stop = rest_.find_first_of(" \t");
+            field = rest_.substr(0, stop);
+            rest_.remove_prefix(stop == std::string_view::npos ? rest_.size() : stop);
+            return true;
+        }
+
+    private:
+        std::string_view rest_;
+        bool csv_;
+        bool done_ = false;
+
+        static std::string_view trim(std::string_view s) {
+            while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+            while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) s.remove_suffix(1);
+            return s;
+        }
+    };
+
+    bool parse_number(std::string_view field, double& value) {
+        if (!field.empty() && field.front() == '+') field.remove_prefix(1);
+        auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+        return result.ec == std::errc() && result.ptr == field.data() + field.size();
+    }
+
+    bool iequals(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); i++) {
+            char c = a[i] >= 'A' && a[i] <= 'Z' ? static_cast<char>(a[i] - 'A' + 'a') : a[i];
+            if (c != b[i]) return false;
+        }
+        return true;
+    }
+
+    bool matches_any(std::string_view name, std::initializer_list<std::string_view> options) {
+        for (auto option : options) {
+            if (iequals(name, option)) return true;
+        }
+        return false;
+    }
+}
+
+TraceReader::TraceReader(const std::string& path, const TraceOptions& options, SimTime start)
+    : fd_(-1),
+      path_(path),
+      format_(TraceFormat::SWF),
+      options_(options),
+      block_(BLOCK_SIZE),
+      begin_(0),
+      end_(0),
+      eof_(false),
+      discarding_(false),
+      submit_column_(1),
+      runtime_column_(3),
+      procs_column_(7),
+      alt_procs_column_(4),
+      header_checked_(false),
+      start_(start),
+      first_submit_(0.0),
+      last_time_(start),
+      lines_(0),
+      jobs_(0),
+      comments_(0),
+      skipped_(0),
+      reordered_(0),
+      bytes_(0),
+      burst_sum_(0),
+      procs_sum_(0) {
+    if (options_.scale <= 0.0) {
+        options_.scale = 1.0;
+    }
+    if (path.size() >= 4 && iequals(std::string_view(path).substr(path.size() - 4), ".csv")) {
+        format_ = TraceFormat::CSV;
+        submit_column_ = 0;
+        runtime_column_ = 1;
+        procs_column_ = 2;
+        alt_procs_column_ = -1;
+    }
+
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        error_ = std::string("No se pudo abrir ").append(path).append(": ").append(std::strerror(errno));
+        eof_ = true;
+        return;
+    }
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+}
+
+TraceReader::~TraceReader() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+std::string TraceReader::format_to_string(TraceFormat format) {
+    return format == TraceFormat::SWF ? "SWF" : "CSV";
+}
+
+bool TraceReader::refill() {
+    if (eof_) return false;
+
+    // Lo que queda sin consumir es el comienzo de una línea incompleta
+    size_t tail = end_ - begin_;
+    if (tail == BLOCK_SIZE) {
+        // Línea más larga que el bloque: se descarta entera
+        skipped_++;
+        discarding_ = true;
+        begin_ = end_ = 0;
+        tail = 0;
+    } else if (begin_ > 0) {
+        std::memmove(block_.data(), block_.data() + begin_, tail);
+        begin_ = 0;
+        end_ = tail;
+    }
+
+    ssize_t n;
+    do {
+        n = ::read(fd_, block_.data() + end_, BLOCK_SIZE - end_);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) {
+        if (n < 0) {
+            error_ = std::string("Error de lectura: ").append(std::strerror(errno));
+        }
+        eof_ = true;
+        return false;
+    }
+    end_ += static_cast<size_t>(n);
+    bytes_ += n;
+    return true;
+}
+
+bool TraceReader::next_line(std::string_view& line) {
+    for (;;) {
+        const char* data = block_.data();
+        const void* newline = std::memchr(data + begin_, '\n', end_ - begin_);
+
+        if (discarding_) {
+            if (newline == nullptr) {
+                begin_ = end_;
+                if (!refill()) return false;
+                continue;
+            }
+            begin_ = static_cast<size_t>(static_cast<const char*>(newline) - data) + 1;
+            discarding_ = false;
+            continue;
+        }
+
+        if (newline != nullptr) {
+            size_t stop = static_cast<size_t>(static_cast<const char*>(newline) - data);
+            line = std::string_view(data + begin_, stop - begin_);
+            begin_ = stop + 1;
+        } else if (!refill()) {
+            // Última línea sin '\n'
+            if (begin_ == end_) return false;
+            line = std::string_view(data + begin_, end_ - begin_);
+            begin_ = end_;
+        } else {
+            continue;
+        }
+
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        return true;
+    }
+}
+
+void TraceReader::read_csv_header(std::string_view line) {
+    FieldCursor fields(line, TraceFormat::CSV);
+    std::string_view name;
+    int column = 0;
+    while (fields.next(name)) {
+        if (matches_any(name, {"submit", "submit_time", "arrival", "arrival_time"})) {
+            submit_column_ = column;
+        } else if (matches_any(name, {"runtime", "run_time", "duration", "burst"})) {
+            runtime_column_ = column;
+        } else if (matches_any(name, {"procs", "processors", "cpus", "req_procs"})) {
+            procs_column_ = column;
+        }
+        column++;
+    }
+}
+
+bool TraceReader::parse_job(std::string_view line, double& submit, double& runtime, int& procs) {
+    FieldCursor fields(line, format_);
+    std::string_view field;
+    bool has_submit = false, has_runtime = false;
+    double requested = -1.0, allocated = -1.0;
+
+    int last = std::max({submit_column_, runtime_column_, procs_column_, alt_procs_column_});
+    for (int column = 0; column <= last && fields.next(field); column++) {
+        if (column == submit_column_) {
+            has_submit = parse_number(field, submit);
+            if (!has_submit) return false;
+        } else if (column == runtime_column_) {
+            has_runtime = parse_number(field, runtime);
+            if (!has_runtime) return false;
+        } else if (column == procs_column_) {
+            if (!parse_number(field, requested)) requested = -1.0;
+        } else if (column == alt_procs_column_) {
+            if (!parse_number(field, allocated)) allocated = -1.0;
+        }
+    }
+    if (!has_submit || !has_runtime) {
+        return false;
+    }
+
+    // SWF usa -1 para "sin dato": se toman los asignados si no hay pedidos
+    double count = requested > 0 ? requested : allocated;
+    procs = count >= 1.0 ? static_cast<int>(std::min(count, 1e6)) : 1;
+    return true;
+}
+
+bool TraceReader::next_arrival(SimTime& time, int& burst) {
+    std::string_view line;
+    while ((options_.max_jobs <= 0 || jobs_ < options_.max_jobs) && next_line(line)) {
+        lines_++;
+
+        size_t start = line.find_first_not_of(" \t");
+        if (start == std::string_view::npos) {
+            continue;
+        }
+        line.remove_prefix(start);
+
+        if (line.front() == ';' || line.front() == '#') {
+            comments_++;
+            continue;
+        }
+        if (format_ == TraceFormat::CSV && !header_checked_) {
+            header_checked_ = true;
+            char c = line.front();
+            if (!(std::isdigit(static_cast<unsigned char>(c)) || c == '-' || c == '+' || c == '.')) {
+                read_csv_header(line);
+                comments_++;
+                continue;
+            }
+        }
+
+        double submit = 0.0, runtime = 0.0;
+        int procs = 1;
+        if (!parse_job(line, submit, runtime, procs) || !(runtime > 0.0) || submit < 0.0) {
+            // Trabajos cancelados antes de correr (runtime -1 o 0) o línea inválida
+            skipped_++;
+            continue;
+        }
+
+        if (jobs_ == 0) {
+            first_submit_ = submit;
+        }
+        double offset = std::llround((submit - first_submit_) / options_.scale);
+        SimTime t = start_ + static_cast<SimTime>(std::max(0.0, offset));
+        if (t < last_time_) {
+            reordered_++;
+            t = last_time_;
+        }
+        last_time_ = t;
+
+        double work = runtime * (options_.use_procs ? procs : 1) / options_.scale;
+        double ticks = std::ceil(std::min(work, static_cast<double>(INT_MAX / 2)));
+        burst = std::max(1, static_cast<int>(ticks));
+        time = t;
+
+        jobs_++;
+        burst_sum_ += burst;
+        procs_sum_ += procs;
+        return true;
+    }
+    return false;
+}
+
+void TraceReader::display_stats() const {
+    print_header("TRAZA DE TRABAJOS");
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << " Archivo:               " << path_ << " (" << format_to_string(format_) << ")" << std::endl;
+    std::cout << " Escala:                " << options_.scale << " s de traza por tick, ráfaga "
+              << (options_.use_procs ? "= runtime × procesadores" : "= runtime") << std::endl;
+    if (options_.max_jobs > 0) {
+        std::cout << " Límite:                " << options_.max_jobs << " trabajos" << std::endl;
+    }
+    std::cout << " Leído:                 " << bytes_ / 1024 << " KB, " << lines_ << " líneas" << std::endl;
+    std::cout << " Trabajos entregados:   " << jobs_ << std::endl;
+    std::cout << " Comentarios:           " << comments_ << std::endl;
+    std::cout << " Descartados:           " << skipped_ << " (cancelados o mal formados)" << std::endl;
+    std::cout << " Fuera de orden:        " << reordered_ << std::endl;
+    if (jobs_ > 0) {
+        std::cout << " Ráfaga media:          " << static_cast<double>(burst_sum_) / jobs_ << " ticks" << std::endl;
+        std::cout << " Procesadores medios:   " << static_cast<double>(procs_sum_) / jobs_ << std::endl;
+        std::cout << " Última llegada:        t=" << last_time_ << std::endl;
+    }
+    std::cout << " Buffer:                " << BLOCK_SIZE / 1024 << " KB fijos" << std::endl;
+    std::cout << " Estado:                "
+              << (exhausted() ? Color::YELLOW + "agotada" : Color::GREEN + "con trabajos pendientes")
+              << Color::RESET << std::endl;
+    std::cout << std::endl;
+}
+
+void TraceReader::benchmark(const std::string& path, const TraceOptions& options) {
+    TraceReader reader(path, options, 0);
+    if (!reader.is_open()) {
+        std::cout << Color::RED << "✗ " << reader.get_error() << Color::RESET << std::endl;
+        return;
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    SimTime time;
+    int burst;
+    while (reader.next_arrival(time, burst)) {
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    reader.display_stats();
+
+    double megabytes = reader.bytes_ / (1024.0 * 1024.0);
+    std::cout << Color::CYAN << "▶ Parser" << Color::RESET << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << " Tiempo:                " << seconds << " s" << std::endl;
+    std::cout << std::setprecision(1);
+    std::cout << " Throughput:            " << (seconds > 0 ? megabytes / seconds : 0.0) << " MB/s, "
+              << std::setprecision(0) << (seconds > 0 ? reader.jobs_ / seconds : 0.0) << " trabajos/s"
+              << std::endl;
+    std::cout << std::endl;
+}
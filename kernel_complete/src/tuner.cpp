@@ -0,0 +1,231 @@
+#include "../include/tuner.hpp"
+#include "../include/scheduler.hpp"
+#include "../include/workload.hpp"
+#include "../include/utils.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Menos ráfagas que esto en la ventana: el quantum de la clase no se toca
+    constexpr uint64_t MIN_SAMPLES = 16;
+    constexpr size_t MAX_ROWS = 24;
+}
+
+bool parse_tuner_option(const std::string& token, TunerConfig& config) {
+    size_t eq = token.find('=');
+    if (eq == std::string::npos) {
+        return false;
+    }
+    std::string key = token.substr(0, eq);
+    double value = std::atof(token.c_str() + eq + 1);
+    if (key == "min" && value >= 1) config.min_quantum = static_cast<int>(value);
+    else if (key == "max" && value >= 1) config.max_quantum = static_cast<int>(value);
+    else if (key == "pct" && value > 0 && value < 100) config.percentile = value / 100.0;
+    else if (key == "overhead" && value > 0 && value < 100) config.overhead = value / 100.0;
+    else if (key == "resp" && value >= 0) config.response_target = static_cast<int>(value);
+    else if (key == "window" && value >= 1) config.window = static_cast<SimTime>(value);
+    else return false;
+    return config.min_quantum <= config.max_quantum;
+}
+
+QuantumTuner::QuantumTuner(const TunerConfig& config, int initial_quantum, int switch_cost, SimTime now)
+    : config_(config),
+      switch_cost_(switch_cost),
+      preempted_(0),
+      next_update_(now + config.window),
+      total_bursts_(0) {
+    int start = std::clamp(initial_quantum, config_.min_quantum, config_.max_quantum);
+    quantum_ = {start, start};
+}
+
+int QuantumTuner::overhead_floor() const {
+    if (switch_cost_ <= 0) {
+        return 0;
+    }
+    return static_cast<int>(std::ceil(switch_cost_ * (1.0 - config_.overhead) / config_.overhead));
+}
+
+void QuantumTuner::record_burst(int pid, int length, bool preempted) {
+    int process_class = INTERACTIVE;
+    if (config_.mode == TunerMode::CLASS) {
+        process_class = class_of(pid);
+        // La clase sigue a la última ráfaga: agotar el quantum la vuelve batch
+        if (pid >= static_cast<int>(batch_.size())) {
+            batch_.resize(std::max<size_t>(static_cast<size_t>(pid) + 1, batch_.size() * 2), 0);
+        }
+        batch_[pid] = preempted ? 1 : 0;
+    }
+    // Expropiada: solo se sabe que la ráfaga era más larga
+    bursts_[process_class].record(static_cast<uint64_t>(length) + (preempted ? 1 : 0));
+    if (preempted) preempted_++;
+    total_bursts_++;
+}
+
+void QuantumTuner::update(SimTime now) {
+    Step step{};
+    step.time = now;
+    uint64_t bursts = bursts_[INTERACTIVE].count() + bursts_[BATCH].count();
+    step.preempted = bursts > 0 ? 100.0 * preempted_ / bursts : 0.0;
+    step.response_p99 = response_.count() > 0 ? response_.percentile(0.99) : 0;
+    bool over = config_.response_target > 0 && response_.count() >= MIN_SAMPLES &&
+                step.response_p99 > static_cast<uint64_t>(config_.response_target);
+
+    int floor = overhead_floor();
+    for (int c = INTERACTIVE; c <= BATCH; c++) {
+        const LogHistogram& h = bursts_[c];
+        step.samples[c] = static_cast<long long>(h.count());
+        step.burst_percentile[c] = h.count() > 0 ? h.percentile(config_.percentile) : 0;
+        if (h.count() >= MIN_SAMPLES) {
+            int& q = quantum_[c];
+            long long want = static_cast<long long>(step.burst_percentile[c]);
+            // La respuesta la empeoran las porciones largas: se recorta el
+            // quantum global o el de batch, nunca por debajo del piso de costo
+            if (over && (config_.mode == TunerMode::GLOBAL || c == BATCH)) {
+                want = std::min<long long>(want, q * 3 / 4);
+                step.response_capped = true;
+            }
+            want = std::clamp<long long>(std::max<long long>(want, floor),
+                                         config_.min_quantum, config_.max_quantum);
+            long long diff = want - q;
+            q += static_cast<int>(diff > 0 ? (diff + 1) / 2 : -((-diff + 1) / 2));
+        }
+        step.quantum[c] = quantum_[c];
+    }
+    trajectory_.push_back(step);
+
+    for (auto& h : bursts_) h.reset();
+    response_.reset();
+    preempted_ = 0;
+    next_update_ = now + config_.window;
+}
+
+std::string QuantumTuner::mode_to_string(TunerMode mode) {
+    switch (mode) {
+        case TunerMode::GLOBAL: return "global";
+        case TunerMode::CLASS: return "por clase";
+        default: return "UNKNOWN";
+    }
+}
+
+void QuantumTuner::display_stats() const {
+    print_header("AJUSTE DE QUANTUM");
+
+    bool by_class = config_.mode == TunerMode::CLASS;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << " Modo:                  " << mode_to_string(config_.mode) << std::endl;
+    std::cout << " Quantum actual:        " << quantum_[INTERACTIVE];
+    if (by_class) {
+        std::cout << " interactivos, " << quantum_[BATCH] << " batch";
+    }
+    std::cout << " (rango " << config_.min_quantum << ".." << config_.max_quantum << ")" << std::endl;
+    std::cout << " Objetivo de ráfagas:   p" << config_.percentile * 100 << " cabe en un quantum" << std::endl;
+    std::cout << " Cambio de contexto:    " << switch_cost_ << " ticks (piso " << overhead_floor()
+              << " para costo ≤ " << config_.overhead * 100 << "%)" << std::endl;
+    std::cout << " Objetivo de respuesta: ";
+    if (config_.response_target > 0) {
+        std::cout << "p99 ≤ " << config_.response_target << " ticks" << std::endl;
+    } else {
+        std::cout << "ninguno" << std::endl;
+    }
+    std::cout << " Ventana:               " << config_.window << " ticks, "
+              << trajectory_.size() << " ajustes, " << total_bursts_ << " ráfagas" << std::endl;
+
+    if (trajectory_.empty()) {
+        std::cout << std::endl;
+        return;
+    }
+
+    // Trayectoria: a lo sumo MAX_ROWS ventanas repartidas, siempre con la última
+    std::cout << "\n " << std::right << std::setw(9) << "t" << std::setw(6) << "q";
+    if (by_class) std::cout << std::setw(9) << "q batch";
+    std::cout << std::setw(11) << "p ráfaga";
+    if (by_class) std::cout << std::setw(9) << "p batch";
+    std::cout << std::setw(10) << "Ráfagas" << std::setw(9) << "Exprop%" << std::setw(10) << "Resp p99"
+              << std::setw(8) << "Recorte" << std::endl;
+    print_separator(by_class ? 79 : 61);
+
+    size_t stride = (trajectory_.size() + MAX_ROWS - 1) / MAX_ROWS;
+    for (size_t i = 0; i < trajectory_.size(); i++) {
+        if (i % stride != 0 && i + 1 != trajectory_.size()) {
+            continue;
+        }
+        const Step& s = trajectory_[i];
+        std::cout << " " << std::setw(9) << s.time << std::setw(6) << s.quantum[INTERACTIVE];
+        if (by_class) std::cout << std::setw(9) << s.quantum[BATCH];
+        std::cout << std::setw(10) << s.burst_percentile[INTERACTIVE];
+        if (by_class) std::cout << std::setw(9) << s.burst_percentile[BATCH];
+        std::cout << std::setw(9) << s.samples[INTERACTIVE] + s.samples[BATCH]
+                  << std::setw(9) << s.preempted << std::setw(10) << s.response_p99
+                  << std::setw(8) << (s.response_capped ? "sí" : "") << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+void run_tuner_bench(const WorkloadConfig& workload, SimTime ticks, int switch_cost,
+                     const TunerConfig& config) {
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << Color::BOLD << Color::BLUE << "\n▶ Quantum fijo vs ajustado: " << ticks
+              << " ticks, cambio de contexto " << switch_cost << " ticks, λ=" << workload.arrival_rate
+              << ", ráfaga media " << workload.burst_mean << Color::RESET << std::endl;
+    std::cout << std::left << "   " << std::setw(14) << "Quantum" << std::right
+              << std::setw(12) << "Thr/1000t" << std::setw(10) << "Resp p50" << std::setw(10) << "Resp p99"
+              << std::setw(10) << "TAT medio" << std::setw(10) << "TAT p99" << std::setw(10) << "Cambio%"
+              << std::setw(10) << "Final" << std::endl;
+
+    struct Variant {
+        std::string label;
+        int quantum;
+        bool tuned;
+        TunerMode mode;
+    };
+    std::vector<Variant> variants;
+    for (int q : {1, 2, 4, 8, 16, 32, 64}) {
+        variants.push_back({std::string("fijo ").append(std::to_string(q)), q, false, TunerMode::GLOBAL});
+    }
+    variants.push_back({"auto global", 4, true, TunerMode::GLOBAL});
+    variants.push_back({"auto clase", 4, true, TunerMode::CLASS});
+
+    for (const auto& variant : variants) {
+        SimulationKernel kernel;
+        RoundRobinScheduler scheduler(variant.quantum, &kernel);
+        scheduler.set_verbose(false);
+        scheduler.set_switch_cost(switch_cost);
+        WorkloadGenerator generator(workload);
+
+        TunerConfig tuned = config;
+        tuned.mode = variant.mode;
+        QuantumTuner tuner(tuned, variant.quantum, switch_cost, kernel.now());
+        if (variant.tuned) {
+            scheduler.enable_tuner(&tuner);
+        }
+
+        scheduler.set_arrival_source(&generator);
+        scheduler.run_until(ticks);
+        scheduler.set_arrival_source(nullptr);
+        scheduler.disable_tuner();
+
+        const SchedulerMetrics& metrics = scheduler.get_metrics();
+        std::string final_quantum = std::to_string(variant.tuned ? tuner.get_quantum(QuantumTuner::INTERACTIVE)
+                                                                 : variant.quantum);
+        if (variant.tuned && variant.mode == TunerMode::CLASS) {
+            final_quantum.append("/").append(std::to_string(tuner.get_quantum(QuantumTuner::BATCH)));
+        }
+        std::cout << std::fixed << std::setprecision(2) << std::left << "   "
+                  << std::setw(14) << variant.label << std::right
+                  << std::setw(12) << 1000.0 * metrics.completed() / ticks
+                  << std::setw(10) << metrics.response().percentile(0.5)
+                  << std::setw(10) << metrics.response().percentile(0.99)
+                  << std::setw(10) << metrics.turnaround().mean()
+                  << std::setw(10) << metrics.turnaround().percentile(0.99)
+                  << std::setw(10) << 100.0 * scheduler.get_switch_ticks() / ticks
+                  << std::setw(10) << final_quantum << std::endl;
+    }
+    std::cout << " (auto: objetivo p" << config.percentile * 100 << " de ráfagas, costo ≤ "
+              << config.overhead * 100 << "%";
+    if (config.response_target > 0) {
+        std::cout << ", respuesta p99 ≤ " << config.response_target;
+    }
+    std::cout << "; Final = quantum al terminar, interactivos/batch por clase)" << std::endl << std::endl;
+}
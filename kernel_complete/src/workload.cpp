@@ -0,0 +1,387 @@
+#include "../include/workload.hpp"
+#include "../include/scheduler.hpp"
+#include "../include/memory.hpp"
+#include "../include/checkpoint.hpp"
+#include "../include/utils.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+WorkloadGenerator::WorkloadGenerator(const WorkloadConfig& config)
+    : config_(config),
+      rng_(config.seed),
+      page_rng_(config.seed ^ 0x5DEECE66DULL),
+      next_arrival_time_(0.0),
+      arrivals_generated_(0),
+      bursts_generated_(0),
+      pages_generated_(0),
+      phase_changes_(0) {
+
+    // Normalizar parámetros para no generar rangos inválidos
+    config_.pages_per_process = std::max(1, config_.pages_per_process);
+    config_.working_set = std::clamp(config_.working_set, 1, config_.pages_per_process);
+    config_.phase_length = std::max(1, config_.phase_length);
+    config_.max_burst = std::max(1, config_.max_burst);
+
+    build_zipf_table();
+    next_arrival_time_ = next_interarrival();
+}
+
+void WorkloadGenerator::build_zipf_table() {
+    // P(rank k) ∝ 1 / k^s sobre el working set
+    int n = config_.working_set;
+    std::vector<double> weights(n);
+    double total = 0.0;
+    for (int k = 0; k < n; k++) {
+        weights[k] = 1.0 / std::pow(k + 1, config_.zipf_s);
+        total += weights[k];
+    }
+
+    // Construcción de la tabla alias (Vose)
+    zipf_prob_.assign(n, 0.0);
+    zipf_alias_.assign(n, 0);
+    std::vector<int> small, large;
+    std::vector<double> scaled(n);
+    for (int k = 0; k < n; k++) {
+        scaled[k] = weights[k] * n / total;
+        (scaled[k] < 1.0 ? small : large).push_back(k);
+    }
+    while (!small.empty() && !large.empty()) {
+        int s = small.back(); small.pop_back();
+        int l = large.back(); large.pop_back();
+        zipf_prob_[s] = scaled[s];
+        zipf_alias_[s] = l;
+        scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+        (scaled[l] < 1.0 ? small : large).push_back(l);
+    }
+    for (int k : large) zipf_prob_[k] = 1.0;
+    for (int k : small) zipf_prob_[k] = 1.0;
+}
+
+int WorkloadGenerator::sample_zipf() {
+    uint32_t column = page_rng_.below(static_cast<uint32_t>(zipf_prob_.size()));
+    return page_rng_.uniform() < zipf_prob_[column] ? column : zipf_alias_[column];
+}
+
+double WorkloadGenerator::next_interarrival() {
+    if (config_.arrival_rate <= 0.0) {
+        return INFINITY;
+    }
+    // Inversa de la exponencial: -ln(U) / λ
+    return -std::log1p(-rng_.uniform()) / config_.arrival_rate;
+}
+
+int WorkloadGenerator::next_burst() {
+    bursts_generated_++;
+    double value = 1.0;
+
+    switch (config_.burst_dist) {
+        case BurstDistribution::EXPONENTIAL:
+            value = -std::log1p(-rng_.uniform()) * config_.burst_mean;
+            break;
+        case BurstDistribution::PARETO: {
+            // x_m elegido para que la media sea burst_mean
+            double alpha = std::max(1.01, config_.pareto_alpha);
+            double xm = config_.burst_mean * (alpha - 1.0) / alpha;
+            value = xm / std::pow(1.0 - rng_.uniform(), 1.0 / alpha);
+            break;
+        }
+        case BurstDistribution::BIMODAL:
+            value = rng_.uniform() < config_.bimodal_short_prob
+                        ? config_.bimodal_short : config_.bimodal_long;
+            break;
+    }
+
+    if (!(value < config_.max_burst)) {
+        return config_.max_burst;
+    }
+    return std::max(1, static_cast<int>(std::ceil(value)));
+}
+
+bool WorkloadGenerator::next_arrival(SimTime& time, int& burst) {
+    if (std::isinf(next_arrival_time_)) {
+        return false;
+    }
+    time = static_cast<SimTime>(std::floor(next_arrival_time_));
+    burst = next_burst();
+    next_arrival_time_ += next_interarrival();
+    arrivals_generated_++;
+    return true;
+}
+
+WorkloadGenerator::Locality& WorkloadGenerator::locality_for(int process_id) {
+    size_t index = static_cast<size_t>(std::max(0, process_id));
+    if (index >= locality_.size()) {
+        locality_.resize(std::max(index + 1, locality_.size() * 2));
+    }
+    Locality& loc = locality_[index];
+    if (!loc.initialized) {
+        loc.initialized = true;
+        start_phase(loc);
+    }
+    return loc;
+}
+
+void WorkloadGenerator::start_phase(Locality& loc) {
+    // Nueva fase: se desplaza la ventana de localidad
+    int span = config_.pages_per_process - config_.working_set + 1;
+    loc.phase_base = static_cast<int>(page_rng_.below(static_cast<uint32_t>(span)));
+    loc.refs_in_phase = 0;
+    loc.cursor = 0;
+}
+
+int WorkloadGenerator::next_page(int process_id) {
+    pages_generated_++;
+    Locality& loc = locality_for(process_id);
+
+    if (loc.refs_in_phase >= config_.phase_length) {
+        start_phase(loc);
+        phase_changes_++;
+    }
+    loc.refs_in_phase++;
+
+    switch (config_.page_pattern) {
+        case PagePattern::ZIPF:
+            return loc.phase_base + sample_zipf();
+        case PagePattern::SEQUENTIAL: {
+            int page = (loc.phase_base + loc.cursor) % config_.pages_per_process;
+            loc.cursor++;
+            return page;
+        }
+        case PagePattern::LOOP: {
+            int page = loc.phase_base + loc.cursor;
+            loc.cursor = (loc.cursor + 1) % config_.working_set;
+            return page;
+        }
+    }
+    return loc.phase_base;
+}
+
+void WorkloadGenerator::run(RoundRobinScheduler& scheduler, MemoryManager* memory,
+                            int ticks, int refs_per_tick) {
+    bool sched_verbose = scheduler.is_verbose();
+    bool mem_verbose = memory ? memory->is_verbose() : false;
+    scheduler.set_verbose(false);
+    if (memory) memory->set_verbose(false);
+
+    long long arrivals = 0;
+    long long references = 0;
+    int start_faults = memory ? memory->get_page_faults() : 0;
+    int start_accesses = memory ? memory->get_total_accesses() : 0;
+    auto start = std::chrono::steady_clock::now();
+
+    // Las llegadas arrancan desde el reloj actual del scheduler
+    if (next_arrival_time_ < scheduler.get_current_time()) {
+        next_arrival_time_ = scheduler.get_current_time() + next_interarrival();
+    }
+
+    for (int i = 0; i < ticks; i++) {
+        // Llegadas de Poisson que caen dentro de este tick
+        double horizon = scheduler.get_current_time() + 1;
+        while (next_arrival_time_ < horizon) {
+            scheduler.create_process(next_burst());
+            next_arrival_time_ += next_interarrival();
+            arrivals++;
+        }
+
+        scheduler.tick();
+
+        // El proceso en CPU emite sus referencias a memoria
+        // (en modo acoplado ya las emite el propio scheduler)
+        int pid = scheduler.get_running_pid();
+        if (memory && pid > 0 && !scheduler.is_paging_enabled()) {
+            for (int r = 0; r < refs_per_tick; r++) {
+                memory->access_page(pid, next_page(pid));
+            }
+        }
+    }
+    if (memory) {
+        references = memory->get_total_accesses() - start_accesses;
+    }
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    arrivals_generated_ += arrivals;
+    scheduler.set_verbose(sched_verbose);
+    if (memory) memory->set_verbose(mem_verbose);
+
+    long long events = arrivals + ticks + references;
+    std::cout << Color::BLUE << Color::BOLD << "\n▶ Carga sintética: " << ticks
+              << " ticks (t=" << scheduler.get_current_time() << ")" << Color::RESET << std::endl;
+    std::cout << "   ├─ Llegadas:           " << arrivals << std::endl;
+    std::cout << "   ├─ Referencias:        " << references << std::endl;
+    if (memory) {
+        std::cout << "   ├─ Page faults:        " << memory->get_page_faults() - start_faults << std::endl;
+    }
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "   └─ Eventos/seg:        "
+              << (elapsed > 0 ? events / elapsed / 1e6 : 0.0) << " M" << std::endl;
+    std::cout << std::endl;
+}
+
+void WorkloadGenerator::run_events(RoundRobinScheduler& scheduler, MemoryManager* memory,
+                                   SimTime ticks) {
+    bool sched_verbose = scheduler.is_verbose();
+    bool mem_verbose = memory ? memory->is_verbose() : false;
+    scheduler.set_verbose(false);
+    if (memory) memory->set_verbose(false);
+
+    SimulationKernel& kernel = scheduler.get_kernel();
+    long long start_events = kernel.get_events_processed();
+    long long start_arrivals = arrivals_generated_;
+    int start_faults = memory ? memory->get_page_faults() : 0;
+    auto start = std::chrono::steady_clock::now();
+
+    if (next_arrival_time_ < kernel.now()) {
+        next_arrival_time_ = kernel.now() + next_interarrival();
+    }
+
+    // El scheduler pide cada llegada al procesar la anterior
+    scheduler.set_arrival_source(this);
+    scheduler.run_until(kernel.now() + ticks);
+    scheduler.set_arrival_source(nullptr);
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    scheduler.set_verbose(sched_verbose);
+    if (memory) memory->set_verbose(mem_verbose);
+
+    long long events = kernel.get_events_processed() - start_events;
+    std::cout << Color::BLUE << Color::BOLD << "\n▶ Simulación por eventos: " << ticks
+              << " ticks virtuales (t=" << kernel.now() << ")" << Color::RESET << std::endl;
+    std::cout << "   ├─ Llegadas:           " << arrivals_generated_ - start_arrivals << std::endl;
+    std::cout << "   ├─ Eventos:            " << events << std::endl;
+    if (memory) {
+        std::cout << "   ├─ Page faults:        " << memory->get_page_faults() - start_faults << std::endl;
+    }
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "   ├─ Tiempo real:        " << elapsed * 1000 << " ms" << std::endl;
+    std::cout << "   └─ Eventos/seg:        "
+              << (elapsed > 0 ? events / elapsed / 1e6 : 0.0) << " M" << std::endl;
+    std::cout << std::endl;
+}
+
+void WorkloadGenerator::benchmark(long long events) {
+    auto start = std::chrono::steady_clock::now();
+
+    // Mezcla: una llegada + ráfaga por cada 8 referencias a memoria
+    long long checksum = 0;
+    int pid = 1;
+    for (long long i = 0; i < events; i++) {
+        if ((i & 7) == 0) {
+            checksum += static_cast<long long>(next_interarrival());
+            checksum += next_burst();
+            pid = pid % 64 + 1;
+        } else {
+            checksum += next_page(pid);
+        }
+    }
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << Color::GREEN << "[WORKLOAD] " << events << " eventos en "
+              << elapsed * 1000 << " ms (" << (elapsed > 0 ? events / elapsed / 1e6 : 0.0)
+              << " M eventos/seg, checksum=" << checksum << ")" << Color::RESET << std::endl;
+}
+
+void WorkloadGenerator::display_config() const {
+    print_header("CARGA SINTÉTICA");
+
+    std::cout << " Semilla:               " << config_.seed << std::endl;
+    std::cout << " Llegadas (λ):          " << config_.arrival_rate << " por tick" << std::endl;
+    std::cout << " Ráfagas:               " << burst_to_string(config_.burst_dist)
+              << " (media=" << config_.burst_mean << ")" << std::endl;
+    std::cout << " Páginas:               " << pattern_to_string(config_.page_pattern)
+              << " (espacio=" << config_.pages_per_process
+              << ", ws=" << config_.working_set
+              << ", fase=" << config_.phase_length << ")" << std::endl;
+    std::cout << std::endl;
+}
+
+void WorkloadGenerator::display_stats() const {
+    display_config();
+    std::cout << " Generado:" << std::endl;
+    std::cout << "   ├─ Llegadas:           " << arrivals_generated_ << std::endl;
+    std::cout << "   ├─ Ráfagas:            " << bursts_generated_ << std::endl;
+    std::cout << "   ├─ Referencias:        " << pages_generated_ << std::endl;
+    std::cout << "   └─ Cambios de fase:    " << phase_changes_ << std::endl;
+    std::cout << std::endl;
+}
+
+std::string WorkloadGenerator::burst_to_string(BurstDistribution dist) {
+    switch (dist) {
+        case BurstDistribution::EXPONENTIAL: return "exp";
+        case BurstDistribution::PARETO: return "pareto";
+        case BurstDistribution::BIMODAL: return "bimodal";
+        default: return "UNKNOWN";
+    }
+}
+
+std::string WorkloadGenerator::pattern_to_string(PagePattern pattern) {
+    switch (pattern) {
+        case PagePattern::ZIPF: return "zipf";
+        case PagePattern::SEQUENTIAL: return "seq";
+        case PagePattern::LOOP: return "loop";
+        default: return "UNKNOWN";
+    }
+}
+
+bool WorkloadGenerator::parse_burst(const std::string& name, BurstDistribution& dist) {
+    if (name == "exp") dist = BurstDistribution::EXPONENTIAL;
+    else if (name == "pareto") dist = BurstDistribution::PARETO;
+    else if (name == "bimodal") dist = BurstDistribution::BIMODAL;
+    else return false;
+    return true;
+}
+
+bool WorkloadGenerator::parse_pattern(const std::string& name, PagePattern& pattern) {
+    if (name == "zipf") pattern = PagePattern::ZIPF;
+    else if (name == "seq") pattern = PagePattern::SEQUENTIAL;
+    else if (name == "loop") pattern = PagePattern::LOOP;
+    else return false;
+    return true;
+}
+
+namespace {
+    struct WorkloadImage {
+        WorkloadConfig config;
+        Xoshiro256 rng;
+        Xoshiro256 page_rng;
+        double next_arrival_time;
+        long long arrivals_generated;
+        long long bursts_generated;
+        long long pages_generated;
+        long long phase_changes;
+    };
+}
+
+void WorkloadGenerator::save_state(CheckpointWriter& writer) const {
+    WorkloadImage image{config_, rng_, page_rng_, next_arrival_time_, arrivals_generated_,
+                        bursts_generated_, pages_generated_, phase_changes_};
+    writer.add_one(CheckpointSection::WORKLOAD, image);
+    writer.add_vector(CheckpointSection::LOCALITY, locality_);
+}
+
+std::unique_ptr<WorkloadGenerator> WorkloadGenerator::from_checkpoint(const CheckpointReader& reader) {
+    WorkloadImage image;
+    if (!reader.read_one(CheckpointSection::WORKLOAD, image) ||
+        static_cast<int>(image.config.burst_dist) < 0 ||
+        static_cast<int>(image.config.burst_dist) > static_cast<int>(BurstDistribution::BIMODAL) ||
+        static_cast<int>(image.config.page_pattern) < 0 ||
+        static_cast<int>(image.config.page_pattern) > static_cast<int>(PagePattern::LOOP)) {
+        return nullptr;
+    }
+    // El constructor reconstruye la tabla de Zipf; luego se pisa el estado
+    auto workload = std::make_unique<WorkloadGenerator>(image.config);
+    if (!reader.read_vector(CheckpointSection::LOCALITY, workload->locality_)) {
+        return nullptr;
+    }
+    workload->rng_ = image.rng;
+    workload->page_rng_ = image.page_rng;
+    workload->next_arrival_time_ = image.next_arrival_time;
+    workload->arrivals_generated_ = image.arrivals_generated;
+    workload->bursts_generated_ = image.bursts_generated;
+    workload->pages_generated_ = image.pages_generated;
+    workload->phase_changes_ = image.phase_changes;
+    return workload;
+}
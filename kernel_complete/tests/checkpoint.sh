@@ -0,0 +1,94 @@
+#!/usr/bin/env bash
+# Checkpoints: continuar desde un archivo en un simulador nuevo da lo mismo
+# que no haberse detenido (también tras guardar lo recién cargado y con un
+# cambio de contexto a medio cobrar), no se guarda con el tuner activo, el
+# buddy allocator queda con las mismas listas libres, y un archivo corrupto
+# o truncado se rechaza.
+source "$(dirname "$0")/cli.sh"
+
+SETUP=("new 5" "new 12" "mem-init 24 fifo" "wl-init 17 0.1" "couple 3 1"
+       "pc-init 4" "produce 7" "produce 8")
+STATS=(cpu-stats paging-stats mem-stats pc-buffer)
+
+# roundtrip <nombre> <comando de avance> [comandos extra de preparación]
+roundtrip() {
+    local name="$1" advance="$2"
+    shift 2
+    local SETUP=("${SETUP[@]}" "$@")
+    sim "${SETUP[@]}" "$advance" "$advance" "${STATS[@]}" |
+        from 'ESTADÍSTICAS DE SCHEDULER' > "$WORK/straight"
+    expect "$WORK/straight" "UTILIZACIÓN DE CPU" "$name: faltan estadísticas"
+    sim "${SETUP[@]}" "$advance" "save $WORK/$name.ck" > "$WORK/saved"
+    expect "$WORK/saved" 'Guardado en' "$name: save falló"
+    sim "load $WORK/$name.ck" "$advance" "${STATS[@]}" |
+        from 'ESTADÍSTICAS DE SCHEDULER' > "$WORK/resumed"
+    same "$WORK/straight" "$WORK/resumed" "$name: continuar desde el checkpoint cambia el resultado"
+
+    # Un checkpoint de un estado recién cargado también continúa igual
+    sim "load $WORK/$name.ck" "save $WORK/$name.again" > /dev/null
+    sim "load $WORK/$name.again" "$advance" "${STATS[@]}" |
+        from 'ESTADÍSTICAS DE SCHEDULER' > "$WORK/resumed"
+    same "$WORK/straight" "$WORK/resumed" "$name: guardar lo recién cargado pierde estado"
+}
+
+roundtrip ticks "wl-run 1000"
+roundtrip events "des-run 1000"
+roundtrip ctx-ticks "wl-run 1497" "ctx-cost 2"
+roundtrip ctx-events "des-run 1497" "ctx-cost 3"
+
+sim "${SETUP[@]}" "tune-init" "des-run 200" "save $WORK/tuned.ck" > "$WORK/saved"
+reject "$WORK/saved" 'Guardado en' "tuner: se guardó con el tuner activo"
+[ ! -e "$WORK/tuned.ck" ] || fail "tuner: quedó un checkpoint con el tuner activo"
+
+# El buddy se reconstruye exacto: mismas listas libres por orden (los
+# contadores de divisiones, fusiones y asignados no forman parte del estado)
+buddy_lists() {
+    from 'BUDDY ALLOCATOR' | grep -a -E '^ *(├─ Libres|└─ Bloque|[0-9]+ )' |
+        awk '{ if ($1 ~ /^[0-9]+$/) print $1, $2, $3, $5; else print }'
+}
+sim "mem-init 100 lru" "wl-init 17 0.1" "couple 3 1" "des-run 150" buddy-stats \
+    "save $WORK/buddy.ck" | buddy_lists > "$WORK/before"
+expect "$WORK/before" 'Libres: +54' "buddy: la carga no dejó frames libres repartidos"
+sim "load $WORK/buddy.ck" buddy-stats | buddy_lists > "$WORK/after"
+same "$WORK/before" "$WORK/after" "buddy: las listas libres cambian al cargar"
+
+# Offset del primer registro de una sección (ids de CheckpointSection)
+section_offset() {
+    local count i
+    count=$(od -An -t u4 -j 12 -N 4 "$1" | tr -d ' ')
+    for ((i = 0; i < count; i++)); do
+        if [ "$(od -An -t u4 -j $((24 + 24 * i)) -N 4 "$1" | tr -d ' ')" -eq "$2" ]; then
+            od -An -t u8 -j $((24 + 24 * i + 8)) -N 8 "$1" | tr -d ' '
+            return
+        fi
+    done
+    fail "no hay sección $2"
+}
+
+# corrupt <nombre> <sección> <byte dentro del registro> <int32>
+corrupt() {
+    local name="$1" offset value
+    offset=$(($(section_offset "$WORK/events.ck" "$2") + $3))
+    value=$(($4 & 0xFFFFFFFF))
+    cp "$WORK/events.ck" "$WORK/bad.ck"
+    printf "$(printf '\\%03o\\%03o\\%03o\\%03o' $((value & 255)) $((value >> 8 & 255)) \
+        $((value >> 16 & 255)) $((value >> 24 & 255)))" |
+        dd of="$WORK/bad.ck" bs=1 seek="$offset" conv=notrunc status=none
+    sim "load $WORK/bad.ck" > "$WORK/load"
+    expect "$WORK/load" 'checkpoint corrupto' "$name: se aceptó un checkpoint corrupto"
+    reject "$WORK/load" 'Restaurado' "$name: se aceptó un checkpoint corrupto"
+}
+
+corrupt "tipo de evento" 2 16 99
+corrupt "estado de proceso" 4 4 200
+corrupt "política de reemplazo" 7 4 7
+corrupt "aguja del reloj" 7 8 -1
+corrupt "frame de página" 9 8 5000
+corrupt "orden FIFO" 10 0 999999
+corrupt "cuenta del buffer" 14 4 9999
+
+head -c 1000 "$WORK/events.ck" > "$WORK/short.ck"
+sim "load $WORK/short.ck" > "$WORK/load"
+reject "$WORK/load" 'Restaurado' "se aceptó un checkpoint truncado"
+
+echo "OK"
@@ -0,0 +1,49 @@
+# Utilidades de las pruebas de regresión por CLI. Cada prueba se corre como
+#   bash tests/<prueba>.sh <ruta a kernel-sim>
+# y alimenta al simulador con un guion de comandos por stdin.
+
+SIM="$1"
+if [ ! -x "$SIM" ]; then
+    echo "Uso: $0 <kernel-sim>" >&2
+    exit 2
+fi
+
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+# Corre el guion (argumentos, uno por línea) y deja la salida sin colores.
+# Las líneas con tiempo real del host cambian entre corridas y se descartan.
+sim() {
+    printf '%s\n' "$@" exit | "$SIM" 2>&1 | sed 's/\x1b\[[0-9;]*m//g' |
+        grep -av -E 'Tiempo real|Eventos/seg|ms\)$'
+}
+
+# Desde la primera línea que contiene el patrón hasta el final
+from() {
+    sed -n "/$1/,\$p"
+}
+
+fail() {
+    echo "FALLO: $*" >&2
+    exit 1
+}
+
+# same <esperado> <obtenido> <descripción>
+same() {
+    if ! diff "$1" "$2" > "$WORK/diff"; then
+        head -20 "$WORK/diff" >&2
+        fail "$3"
+    fi
+}
+
+# expect <archivo> <regex> <descripción>
+expect() {
+    grep -a -q -E "$2" "$1" || fail "$3 (falta: $2)"
+}
+
+# reject <archivo> <regex> <descripción>
+reject() {
+    if grep -a -q -E "$2" "$1"; then
+        fail "$3 (sobra: $2)"
+    fi
+}
@@ -0,0 +1,30 @@
+#!/usr/bin/env bash
+# El modo por eventos (des-run) da los mismos resultados que el modo por
+# ticks (wl-run) con la misma carga: CPU sola, acoplada a memoria con cada
+# política de reemplazo, con zswap, con E/S y con costo de cambio de
+# contexto (incluido un cambio que queda partido por el final de la corrida).
+source "$(dirname "$0")/cli.sh"
+
+compare() {
+    local name="$1" ticks="$2"
+    shift 2
+    sim "new 5" "new 12" "wl-init 17 0.1" "$@" "wl-run $ticks" cpu-stats paging-stats |
+        from 'ESTADÍSTICAS DE SCHEDULER' > "$WORK/tick"
+    sim "new 5" "new 12" "wl-init 17 0.1" "$@" "des-run $ticks" cpu-stats paging-stats |
+        from 'ESTADÍSTICAS DE SCHEDULER' > "$WORK/event"
+    expect "$WORK/tick" 'UTILIZACIÓN DE CPU' "$name: faltan estadísticas"
+    same "$WORK/tick" "$WORK/event" "$name: wl-run y des-run difieren"
+}
+
+compare "cpu" 3000
+compare "clock" 2999 "mem-init 32 clock" "couple 3 1"
+compare "fifo" 2000 "mem-init 24 fifo" "couple 4 2"
+compare "lru+io" 2999 "mem-init 32 lru" "couple 3 1" "io-init 2 scan 6"
+compare "zswap" 2500 "mem-init 16 clock" "mem-zswap 8 2" "couple 6 1"
+for ticks in 1501 2997 2998 3000; do
+    compare "ctx-cost 2" $ticks "ctx-cost 2"
+    compare "ctx-cost 3+clock" $ticks "ctx-cost 3" "quantum 5" "mem-init 32 clock" "couple 3 1"
+    compare "ctx-cost 2+edf" $ticks "ctx-cost 2" "rt-init edf" "rt-new 50 7" "rt-new 23 3"
+done
+
+echo "OK"
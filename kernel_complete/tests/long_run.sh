@@ -0,0 +1,28 @@
+#!/usr/bin/env bash
+# El reloj de 64 bits: una corrida que pasa de 2^31 ticks sigue con
+# instantes, turnaround y faults positivos, el checkpoint los conserva y
+# los percentiles y Jain miden esperas de más de 2^31 ticks.
+source "$(dirname "$0")/cli.sh"
+
+LATE=("new 1" "des-run 2147483640" "mem-init 8 clock" "wl-init 17 0" "couple 3 1"
+      "new 40" "new 30")
+
+sim "${LATE[@]}" "des-run 200" cpu-stats > "$WORK/out"
+reject "$WORK/out" 't=-' "reloj: el tiempo se volvió negativo"
+expect "$WORK/out" 'Tiempo actual: +2147483840' "reloj: la corrida no llegó al final"
+expect "$WORK/out" 'Turnaround promedio: 93\.00' "reloj: turnaround mal medido pasado 2^31"
+from 'ESTADÍSTICAS DE SCHEDULER' < "$WORK/out" > "$WORK/straight"
+
+sim "${LATE[@]}" "des-run 100" "save $WORK/late.ck" > "$WORK/saved"
+expect "$WORK/saved" 'Guardado en' "checkpoint: save falló"
+sim "load $WORK/late.ck" "des-run 100" cpu-stats | from 'ESTADÍSTICAS DE SCHEDULER' > "$WORK/resumed"
+same "$WORK/straight" "$WORK/resumed" "checkpoint: continuar pasado 2^31 cambia el resultado"
+
+# P3 espera 4·10⁹ ticks detrás de dos ráfagas enormes
+sim "quantum 2000000000" "new 2000000000" "new 2000000000" "new 5" "des-run 4000000010" \
+    cpu-stats > "$WORK/out"
+expect "$WORK/out" 'Turnaround +3333333335\.00' "métricas: media de turnaround truncada"
+expect "$WORK/out" 'p99=800000001\.00' "métricas: slowdown truncado"
+expect "$WORK/out" 'Índice de Jain: +0\.6000' "métricas: Jain truncado"
+
+echo "OK"
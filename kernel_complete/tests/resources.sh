@@ -0,0 +1,47 @@
+#!/usr/bin/env bash
+# Recursos con interbloqueos: las unidades se liberan al terminar o al matar
+# al dueño, quien espera queda BLOCKED hasta que se le concede, un ciclo se
+# rechaza, el banquero aplaza los pedidos inseguros y no se guarda un
+# checkpoint con procesos bloqueados por recursos.
+source "$(dirname "$0")/cli.sh"
+
+# Al terminar P1 el disco pasa a P2 (y no queda a nombre de P1)
+sim res-init "res-new disk 1" "new 2" "new 50" "res-req 1 0 1" "run 10" \
+    "res-req 2 0 1" res-state > "$WORK/out"
+expect "$WORK/out" 'P1 TERMINADO' "fin: P1 no terminó"
+expect "$WORK/out" 'disk +1 +0 +P2×1 *$' "fin: P2 no obtuvo el disco liberado"
+
+# Quien espera queda BLOCKED y despierta cuando el dueño termina
+sim res-init "res-new disk 1" "new 4" "new 20" "res-req 1 0 1" "run 2" \
+    "res-req 2 0 1" "run 6" res-state > "$WORK/out"
+expect "$WORK/out" 'P2 pide 1 de disk: espera' "espera: el pedido no quedó en espera"
+expect "$WORK/out" 'P2 BLOCKED esperando un recurso' "espera: P2 no se bloqueó"
+expect "$WORK/out" 'P2 recurso concedido → READY' "espera: P2 no despertó"
+expect "$WORK/out" 'disk +1 +0 +P2×1 *$' "espera: el disco no pasó a P2"
+
+# Un ciclo se rechaza; matar al dueño libera sus unidades y despierta al otro
+CYCLE=(res-init "res-new a 1" "res-new b 1" "new 30" "new 30" "res-req 1 0"
+       "res-req 2 1" "run 4" "res-req 2 0" "run 3" "res-req 1 1")
+sim "${CYCLE[@]}" "save $WORK/blocked.ck" "kill 1" res-state "run 3" > "$WORK/out"
+expect "$WORK/out" 'P1 pide 1 de b: rechazado \(interbloqueo\)' "ciclo: no se detectó el interbloqueo"
+expect "$WORK/out" 'bloqueados esperando recursos' "ciclo: se guardó con procesos bloqueados"
+[ ! -e "$WORK/blocked.ck" ] || fail "ciclo: quedó un checkpoint con procesos bloqueados"
+expect "$WORK/out" '  a +1 +0 +P2×1 *$' "kill: las unidades de P1 no pasaron a P2"
+expect "$WORK/out" 'DISPATCH → P2' "kill: P2 no volvió a la CPU"
+
+# El banquero aplaza el pedido inseguro y lo concede cuando el dueño termina
+sim "res-init banker" "res-new m 2" "new 4" "new 20" "res-claim 1 0 2" "res-claim 2 0 2" \
+    "res-req 1 0 1" "run 2" "res-req 2 0 1" "run 8" res-state > "$WORK/out"
+expect "$WORK/out" 'P2 pide 1 de m: aplazado \(estado inseguro\)' "banquero: no aplazó el pedido inseguro"
+expect "$WORK/out" 'P2 recurso concedido → READY' "banquero: P2 no despertó"
+expect "$WORK/out" '  m +2 +1 +P2×1 *$' "banquero: P2 no obtuvo la unidad"
+
+# Con muchos procesos: la detección completa coincide con la incremental y
+# el banquero nunca llega a un interbloqueo
+sim "res-bench 200 50 20000" > "$WORK/out"
+expect "$WORK/out" 'interbloqueos hallados: 0' "bench: la detección incremental dejó interbloqueos"
+awk '$1 == "banquero" && $NF != 0 { exit 1 }' "$WORK/out" ||
+    fail "bench: el banquero llegó a un interbloqueo"
+expect "$WORK/out" '^ *banquero ' "bench: falta la fila del banquero"
+
+echo "OK"
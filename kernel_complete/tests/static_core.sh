@@ -0,0 +1,29 @@
+#!/usr/bin/env bash
+# El núcleo compilado por políticas (static-bench) termina los mismos
+# procesos y tiene la misma tasa de faults que el scheduler general en cada
+# configuración, con y sin presión de memoria.
+source "$(dirname "$0")/cli.sh"
+
+# Cada fila compilada se compara con la fila "general" que la precede
+check() {
+    local name="$1" rate="$2"
+    shift 2
+    sim "wl-init 23 $rate" "static-bench 4000 $*" | from 'Núcleo compilado' > "$WORK/bench"
+    awk '
+        /^ +general / { terminated = $(NF - 1); faults = $NF; generals++; next }
+        generals > 0 && NF >= 5 && $(NF - 1) ~ /^[0-9]+$/ {
+            rows++
+            if ($(NF - 1) != terminated || $NF != faults) {
+                print "  " $1 ": " $(NF - 1) " terminados, " $NF "% faults; general: " \
+                      terminated ", " faults "%"
+                bad++
+            }
+        }
+        END { if (generals < 4 || rows < generals || bad > 0) exit 1 }
+    ' "$WORK/bench" >&2 || fail "$name: el núcleo compilado difiere del scheduler general"
+}
+
+check "thrashing" 0.1 "frames=16"
+check "holgado" 0.02 "q=2 frames=64 fault=8 refs=2"
+
+echo "OK"
@@ -0,0 +1,20 @@
+#!/usr/bin/env bash
+# El barrido escribe la misma tabla byte a byte con cualquier cantidad de
+# hilos: las semillas dependen solo de la réplica y se agrega en orden.
+source "$(dirname "$0")/cli.sh"
+
+GRID="q=2,4 frames=16,32 repl=fifo,lru,clock disk=fcfs,scan reps=2"
+for threads in 1 3 8; do
+    sim "wl-init 11 0.05" "sweep 1500 $WORK/t$threads.csv $GRID threads=$threads" \
+        "sweep 1500 $WORK/t$threads.json $GRID threads=$threads" > "$WORK/out$threads"
+    [ -s "$WORK/t$threads.csv" ] || fail "sweep no escribió $WORK/t$threads.csv"
+done
+
+rows=$(($(wc -l < "$WORK/t1.csv") - 1))
+[ "$rows" -eq 24 ] || fail "se esperaban 24 configuraciones y hay $rows"
+for threads in 3 8; do
+    cmp -s "$WORK/t1.csv" "$WORK/t$threads.csv" || fail "CSV con $threads hilos distinto del de 1 hilo"
+    cmp -s "$WORK/t1.json" "$WORK/t$threads.json" || fail "JSON con $threads hilos distinto del de 1 hilo"
+done
+
+echo "OK"